@@ -189,6 +189,31 @@ MStatus PolyCubeNodeTranslator::import(const UsdPrim& prim, MObject& parent)
 }
 \endcode
 
+\b Batched \b Import
+
+When a stage containing thousands of your prims is loaded, creating each node individually (and reading its attribute
+values from USD one prim at a time) can dominate the load time. If you override supportsBatchImport to return true,
+import will be replaced by three steps when the prims are loaded by the proxy shape:
+
+\li \b queueNodeCreation : add the creation of your node(s) to an MDagModifier that is shared by all of the prims.
+    The nodes are created with a single call to doIt once every prim has been queued.
+\li \b prefetch : read the values you need from the prim into your own type derived from TranslatorPrefetchData.
+    This is called for many prims in parallel, so it must not call into Maya.
+\li \b importAttributes : register the created node with the context, and set its attribute values from the data
+    returned by prefetch.
+
+If the nodes of the batch cannot be created, the modifier is undone and each prim is imported with import instead, so
+import must still be implemented. The Camera and Mesh translators are examples of the batched import.
+
+\code
+MStatus PolyCubeNodeTranslator::queueNodeCreation(const UsdPrim& prim, MObject& parent, MDagModifier& modifier, MObject& createdObj)
+{
+  MStatus status;
+  createdObj = modifier.createNode("mesh", parent, &status);
+  return status;
+}
+\endcode
+
 \b Post \b Import
 
 Having generated all of the nodes you need to, you might end up needing to hook those nodes to other prims.
@@ -449,6 +474,18 @@ ExportFlag PolyCubeNodeTranslator::canExport(const MObject& obj)
 }
 \endcode
 
+Since this canExport inspects the connections of the node, the translator must be asked about every mesh. If your
+canExport only tests the type of the node (e.g. a single call to hasFn), then override canExportDependsOnNodeTypeOnly
+to return true. The TranslatorManufacture will then query your translator once per node type, and cache the result
+for all other nodes of that type, which can significantly speed up the export of large scenes.
+
+\code
+bool MyLocatorTranslator::canExportDependsOnNodeTypeOnly() const
+{
+  return true;
+}
+\endcode
+
 \b exportObject
 
 Finally, if the object can be exported by your translator, and it is the best translator available, then
@@ -17,6 +17,7 @@
 #include "AL/usdmaya/StageCache.h"
 #include "AL/usdmaya/DebugCodes.h"
 #include "AL/usdmaya/TypeIDs.h"
+#include "AL/usdmaya/fileio/translators/TranslatorBase.h"
 #include "AL/usdmaya/nodes/LayerManager.h"
 #include "AL/usdmaya/nodes/ProxyShape.h"
 #include "AL/usdmaya/nodes/Transform.h"
@@ -44,6 +45,7 @@
 #include "maya/MFnDependencyNode.h"
 #include "maya/MItDependencyNodes.h"
 #include "maya/MSelectionList.h"
+#include "maya/MStringArray.h"
 
 #include <iostream>
 
@@ -225,6 +227,8 @@ AL::event::CallbackId Global::m_postRead;
 AL::event::CallbackId Global::m_fileNew;
 AL::event::CallbackId Global::m_preExport;
 AL::event::CallbackId Global::m_postExport;
+AL::event::CallbackId Global::m_pluginLoad;
+AL::event::CallbackId Global::m_pluginUnload;
 
 //----------------------------------------------------------------------------------------------------------------------
 
@@ -381,6 +385,23 @@ static void postFileRead(void*)
     return;
   }
 
+  MFnDependencyNode fn;
+
+  // All of the proxy shape attributes have now been read, so start opening the layers of every stage before the
+  // LayerManager is loaded, and before the proxy shapes open their stages one after another.
+  for(const MObjectHandle& handle : nodes::ProxyShape::GetUnloadedProxyShapes())
+  {
+    if(!(handle.isValid() && handle.isAlive()))
+    {
+      continue;
+    }
+    fn.setObject(handle.object());
+    if(fn.typeId() == nodes::ProxyShape::kTypeId)
+    {
+      ((nodes::ProxyShape*)fn.userNode())->prefetchStage();
+    }
+  }
+
   nodes::LayerManager* layerManager = nodes::LayerManager::findManager();
   if (layerManager)
   {
@@ -388,7 +409,6 @@ static void postFileRead(void*)
     AL_MAYA_CHECK_ERROR2(layerManager->clearSerialisationAttributes(), "postFileRead");
   }
 
-  MFnDependencyNode fn;
   {
     std::vector<MObjectHandle>& unloadedProxies = nodes::ProxyShape::GetUnloadedProxyShapes();
     unsigned int numUnloadedProxies = unloadedProxies.size();
@@ -509,6 +529,13 @@ static void postFileExport(void* p)
   postFileSave(p);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+static void onMayaPluginChanged(const MStringArray&, void*)
+{
+  // a (re)loaded plugin may register node types with MTypeIds that have been cached by the translator manufactures
+  fileio::translators::TranslatorManufacture::invalidateLookupCaches();
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void Global::onPluginLoad()
 {
@@ -522,6 +549,8 @@ void Global::onPluginLoad()
   m_postRead = manager.registerCallback(postFileRead, "AfterFileRead", "usdmaya_postFileRead", 0x1000);
   m_preExport = manager.registerCallback(preFileExport, "BeforeExport", "usdmaya_preFileExport", 0x1000);
   m_postExport = manager.registerCallback(postFileExport, "AfterExport", "usdmaya_postFileExport", 0x1000);
+  m_pluginLoad = manager.registerCallback(onMayaPluginChanged, "AfterPluginLoad", "usdmaya_onPluginLoad", 0x1000);
+  m_pluginUnload = manager.registerCallback(onMayaPluginChanged, "AfterPluginUnload", "usdmaya_onPluginUnload", 0x1000);
 
   TF_DEBUG(ALUSDMAYA_EVENTS).Msg("Registering USD plugins\n");
   // Let USD know about the additional plugins
@@ -552,6 +581,8 @@ void Global::onPluginUnload()
   manager.unregisterCallback(m_postRead);
   manager.unregisterCallback(m_preExport);
   manager.unregisterCallback(m_postExport);
+  manager.unregisterCallback(m_pluginLoad);
+  manager.unregisterCallback(m_pluginUnload);
   StageCache::removeCallbacks();
 
   AL::maya::event::MayaEventManager::freeInstance();
@@ -71,6 +71,8 @@ private:
   static AL::event::CallbackId m_fileNew;  ///< callback used to flush the USD caches after a file new
   static AL::event::CallbackId m_preExport; ///< callback prior to exporting the scene (so we can store the session layer)
   static AL::event::CallbackId m_postExport; ///< callback after exporting
+  static AL::event::CallbackId m_pluginLoad; ///< callback after a maya plugin is loaded (invalidates the translator lookup caches)
+  static AL::event::CallbackId m_pluginUnload; ///< callback after a maya plugin is unloaded
 
 #if defined(WANT_UFE_BUILD)
   class UfeSelectionObserver;
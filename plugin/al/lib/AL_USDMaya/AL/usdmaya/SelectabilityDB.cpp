@@ -5,9 +5,10 @@ namespace usdmaya {
 
 bool SelectabilityDB::isPathUnselectable(const SdfPath& path) const
 {
-  for(SdfPath unselectablePath : m_unselectablePaths)
+  // the paths are sorted, so look up each ancestor rather than testing every unselectable path
+  for(SdfPath ancestor = path; ancestor.IsAbsolutePath(); ancestor = ancestor.GetParentPath())
   {
-    if(path.HasPrefix(unselectablePath))
+    if(std::binary_search(m_unselectablePaths.begin(), m_unselectablePaths.end(), ancestor))
     {
       return true;
     }
@@ -60,10 +61,17 @@ void SelectabilityDB::addPathAsUnselectable(const SdfPath& path)
   }
 }
 
+void SelectabilityDB::removeHierarchyAsUnselectable(const SdfPath& path)
+{
+  // erasing a range leaves the remaining paths sorted
+  auto range = SdfPathFindPrefixedRange(m_unselectablePaths.begin(), m_unselectablePaths.end(), path);
+  m_unselectablePaths.erase(range.first, range.second);
+}
+
 bool SelectabilityDB::removeUnselectablePath(const SdfPath& path)
 {
-  auto foundPathEntry = std::find(m_unselectablePaths.begin(), m_unselectablePaths.end(), path);
-  if(foundPathEntry != m_unselectablePaths.end())
+  auto foundPathEntry = std::lower_bound(m_unselectablePaths.begin(), m_unselectablePaths.end(), path);
+  if(foundPathEntry != m_unselectablePaths.end() && *foundPathEntry == path)
   {
     m_unselectablePaths.erase(foundPathEntry);
     return true;
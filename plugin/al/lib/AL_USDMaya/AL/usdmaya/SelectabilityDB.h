@@ -59,6 +59,13 @@ public:
   AL_USDMAYA_PUBLIC
   void removePathAsUnselectable(const SdfPath& path);
 
+  ///-------------------------------------------------------------------------------------------------------------------
+  /// \brief  Removes a path, and any paths beneath it, from the unselectable list
+  /// \param  path the root of the hierarchy to remove from the unselectable list
+  ///-------------------------------------------------------------------------------------------------------------------
+  AL_USDMAYA_PUBLIC
+  void removeHierarchyAsUnselectable(const SdfPath& path);
+
 private:
   inline void sort(){std::sort(m_unselectablePaths.begin(), m_unselectablePaths.end());}
   bool addUnselectablePath(const SdfPath& path);
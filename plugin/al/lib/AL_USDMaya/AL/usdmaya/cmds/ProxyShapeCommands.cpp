@@ -1051,7 +1051,7 @@ MStatus ProxyShapeSelect::doIt(const MArgList& args)
 
         SdfPath path(AL::maya::utils::convert(pathString));
 
-        if(!proxy->selectabilityDB().isPathUnselectable(path) && path.IsAbsolutePath())
+        if(path.IsAbsolutePath() && !proxy->isPathUnselectable(path))
         {
           auto insertResult = unorderedPaths.insert(path);
           if (insertResult.second) {
@@ -45,6 +45,7 @@
 
 #include <pxr/base/tf/type.h>
 #include <pxr/base/vt/dictionary.h>
+#include <pxr/base/work/loops.h>
 #include <pxr/usd/kind/registry.h>
 #include <pxr/usd/usd/modelAPI.h>
 #include <pxr/usd/usd/variantSets.h>
@@ -278,6 +279,20 @@ void ProxyShapePostLoadProcess::createSchemaPrims(
                                           " will read default values\n");
     }
 
+    // The prims of translators that support it are imported as a batch. The nodes for all of those prims are queued
+    // on a single modifier, the values they need are then read from USD in parallel, and finally their attributes
+    // are set once all of the nodes exist.
+    struct BatchedPrim
+    {
+      UsdPrim prim;
+      MObject parent;
+      MObject created;
+      fileio::translators::TranslatorRefPtr translator;
+      fileio::translators::TranslatorPrefetchDataPtr data;
+    };
+    std::vector<BatchedPrim> batch;
+    MDagModifier batchModifier;
+
     auto it = objsToCreate.begin();
     const auto end = objsToCreate.end();
     for(; it != end; ++it)
@@ -298,6 +313,24 @@ void ProxyShapePostLoadProcess::createSchemaPrims(
 
       TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShapePostLoadProcess::createSchemaPrims prim=%s\n", prim.GetPath().GetText());
 
+      if(param.batchImport() && translator && translator->supportsBatchImport() &&
+         (param.forceTranslatorImport() || translator->importableByDefault()))
+      {
+        BatchedPrim batched;
+        batched.prim = prim;
+        batched.parent = object;
+        batched.translator = translator;
+        if(translator->queueNodeCreation(prim, batched.parent, batchModifier, batched.created))
+        {
+          batch.push_back(std::move(batched));
+        }
+        else
+        {
+          std::cerr << "Error: unable to load schema prim node: '" << prim.GetName().GetString() << "' that has type: '" << prim.GetTypeName() << "'" << std::endl;
+        }
+        continue;
+      }
+
       //if(!context->hasEntry(prim.GetPath(), prim.GetTypeName()))
       {
         AL_BEGIN_PROFILE_SECTION(SchemaPrims);
@@ -315,6 +348,79 @@ void ProxyShapePostLoadProcess::createSchemaPrims(
         }
       }
     }
+
+    if(!batch.empty())
+    {
+      TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShapePostLoadProcess::createSchemaPrims batch importing %zu prims\n", batch.size());
+
+      AL_BEGIN_PROFILE_SECTION(BatchCreateNodes);
+      const bool nodesCreated = batchModifier.doIt();
+      AL_END_PROFILE_SECTION();
+      if(!nodesCreated)
+      {
+        // the modifier does not say which node failed, so remove any that were created, and import each of the prims
+        // on its own (which reports the prims that fail)
+        batchModifier.undoIt();
+        std::cerr << "Error: unable to create the nodes for " << batch.size() << " schema prims, importing them individually:" << std::endl;
+        for(const auto& batched : batch)
+        {
+          std::cerr << "  " << batched.prim.GetPath().GetString() << std::endl;
+        }
+
+        for(auto& batched : batch)
+        {
+          const UsdPrim& prim = batched.prim;
+          AL_BEGIN_PROFILE_SECTION(SchemaPrims);
+          MObject created;
+          if(!fileio::importSchemaPrim(prim, batched.parent, created, context, batched.translator, param))
+          {
+            std::cerr << "Error: unable to load schema prim node: '" << prim.GetName().GetString() << "' that has type: '" << prim.GetTypeName() << "'" << std::endl;
+          }
+          AL_END_PROFILE_SECTION();
+
+          auto dataPlugins = translatorManufacture.getExtraDataPlugins(created);
+          for(auto dataPlugin : dataPlugins)
+          {
+            dataPlugin->import(prim, created);
+          }
+        }
+        batch.clear();
+      }
+
+      AL_BEGIN_PROFILE_SECTION(BatchPrefetch);
+      WorkParallelForN(batch.size(), [&batch](size_t begin, size_t end)
+      {
+        for(size_t i = begin; i < end; ++i)
+        {
+          batch[i].data = batch[i].translator->prefetch(batch[i].prim);
+        }
+      });
+      AL_END_PROFILE_SECTION();
+
+      for(auto& batched : batch)
+      {
+        const UsdPrim& prim = batched.prim;
+        TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("SchemaPrims::importSchemaPrim batch import %s\n", prim.GetPath().GetText());
+
+        AL_BEGIN_PROFILE_SECTION(SchemaPrims);
+        if(batched.translator->importAttributes(prim, batched.created, batched.data.get()) != MS::kSuccess)
+        {
+          std::cerr << "Error: unable to load schema prim node: '" << prim.GetName().GetString() << "' that has type: '" << prim.GetTypeName() << "'" << std::endl;
+        }
+        else
+        {
+          context->registerItem(prim, batched.parent);
+        }
+        batched.data.reset();
+        AL_END_PROFILE_SECTION();
+
+        auto dataPlugins = translatorManufacture.getExtraDataPlugins(batched.created);
+        for(auto dataPlugin : dataPlugins)
+        {
+          dataPlugin->import(prim, batched.created);
+        }
+      }
+    }
   }
   AL_END_PROFILE_SECTION();
 }
@@ -72,7 +72,9 @@ public:
 
   /// \brief  After transforms exist to parent the custom plugin-prim types (i.e. after a call to
   ///         createTranformChainsForSchemaPrims), this method should be called to call the plugin translators for all
-  ///         those nodes that should be imported into the Maya Scene.
+  ///         those nodes that should be imported into the Maya Scene. Unless disabled in the params, the prims of
+  ///         translators that support the batched import are imported together (see
+  ///         TranslatorAbstract::supportsBatchImport).
   /// \param  proxy the proxy shape to create the schema prims on
   /// \param  objsToCreate the mapping returned from createTranformChainsForSchemaPrims
   /// \param  param the translator plugin options
@@ -30,6 +30,23 @@
 #include "maya/MAnimUtil.h"
 #include "maya/MNodeClass.h"
 
+#include "pxr/base/gf/matrix4d.h"
+#include "pxr/base/gf/matrix4f.h"
+#include "pxr/base/gf/vec2d.h"
+#include "pxr/base/gf/vec2f.h"
+#include "pxr/base/gf/vec3d.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/gf/vec4d.h"
+#include "pxr/base/gf/vec4f.h"
+#include "pxr/base/work/dispatcher.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/usd/sdf/changeBlock.h"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <unordered_set>
+
 namespace AL {
 namespace usdmaya {
 namespace fileio {
@@ -44,6 +61,145 @@ const static std::array<MFn::Type, 4> g_nodeTypesConsiderToBeAnimation {
 //----------------------------------------------------------------------------------------------------------------------
 const static AnimationCheckTransformAttributes g_AnimationCheckTransformAttributes;
 
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T>
+inline bool appendVectorComponents(const VtValue& value, std::vector<double>& components)
+{
+  if(!value.IsHolding<T>())
+    return false;
+  const typename T::ScalarType* data = value.UncheckedGet<T>().GetArray();
+  components.insert(components.end(), data, data + sizeof(T) / sizeof(typename T::ScalarType));
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// appends the components of a float, double, vector or matrix value. Returns false for any other type.
+bool appendComponents(const VtValue& value, std::vector<double>& components)
+{
+  if(value.IsHolding<float>())
+  {
+    components.push_back(value.UncheckedGet<float>());
+    return true;
+  }
+  if(value.IsHolding<double>())
+  {
+    components.push_back(value.UncheckedGet<double>());
+    return true;
+  }
+  return appendVectorComponents<GfVec3f>(value, components) ||
+         appendVectorComponents<GfVec3d>(value, components) ||
+         appendVectorComponents<GfVec2f>(value, components) ||
+         appendVectorComponents<GfVec2d>(value, components) ||
+         appendVectorComponents<GfVec4f>(value, components) ||
+         appendVectorComponents<GfVec4d>(value, components) ||
+         appendVectorComponents<GfMatrix4d>(value, components) ||
+         appendVectorComponents<GfMatrix4f>(value, components);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// finds the samples of a float, vector or matrix attribute that can be interpolated from the remaining samples
+void findReducibleSamples(const SdfLayerHandle& layer, const SdfPath& path, const double tolerance,
+                          std::vector<double>& removed)
+{
+  const std::set<double> sampleTimes = layer->ListTimeSamplesForPath(path);
+  if(sampleTimes.size() < 3)
+    return;
+
+  const std::vector<double> times(sampleTimes.begin(), sampleTimes.end());
+  std::vector<double> components;
+  size_t stride = 0;
+  for(const double time : times)
+  {
+    VtValue value;
+    if(!layer->QueryTimeSample(path, time, &value) || !appendComponents(value, components))
+      return;
+    if(!stride)
+      stride = components.size();
+    else
+    if(components.size() % stride)
+      return;
+  }
+  if(components.size() != stride * times.size())
+    return;
+
+  // greedily extend each segment from the last kept sample for as long as the samples within it can be interpolated.
+  // Each sample within a segment limits the slope of the line from the first sample to a range (the slopes that pass
+  // within the tolerance of it), so the ranges are narrowed as the segment grows, rather than checking every sample
+  // in the segment again for each new end sample.
+  std::vector<double> minSlope(stride);
+  std::vector<double> maxSlope(stride);
+  size_t first = 0;
+  const size_t n = times.size();
+  while(first + 1 < n)
+  {
+    const double* const a = components.data() + first * stride;
+    std::fill(minSlope.begin(), minSlope.end(), -std::numeric_limits<double>::infinity());
+    std::fill(maxSlope.begin(), maxSlope.end(), std::numeric_limits<double>::infinity());
+
+    size_t last = first + 1;
+    while(last + 1 < n)
+    {
+      // the current end sample would be within the segment, so narrow the ranges to pass within tolerance of it
+      const double* const c = components.data() + last * stride;
+      const double invTime = 1.0 / (times[last] - times[first]);
+      for(size_t j = 0; j < stride; ++j)
+      {
+        minSlope[j] = std::max(minSlope[j], (c[j] - tolerance - a[j]) * invTime);
+        maxSlope[j] = std::min(maxSlope[j], (c[j] + tolerance - a[j]) * invTime);
+      }
+
+      // the next sample can end the segment if the line to it is within each of the ranges
+      const double* const b = components.data() + (last + 1) * stride;
+      const double invEndTime = 1.0 / (times[last + 1] - times[first]);
+      bool interpolates = true;
+      for(size_t j = 0; j < stride && interpolates; ++j)
+      {
+        const double slope = (b[j] - a[j]) * invEndTime;
+        interpolates = (slope >= minSlope[j] && slope <= maxSlope[j]);
+      }
+      if(!interpolates)
+        break;
+      ++last;
+    }
+    for(size_t i = first + 1; i < last; ++i)
+    {
+      removed.push_back(times[i]);
+    }
+    first = last;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// finds the layer and path that the samples of the attribute are written to
+inline SdfPath specPath(const UsdAttribute& attribute, SdfLayerHandle& layer)
+{
+  const UsdEditTarget& target = attribute.GetStage()->GetEditTarget();
+  layer = target.GetLayer();
+  return target.MapToSpecPath(attribute.GetPath());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// erases the samples found for each attribute. This must be done serially, as layers do not support concurrent edits.
+size_t eraseSamples(const std::vector<SdfLayerHandle>& layers, const SdfPathVector& paths,
+                    const std::vector<std::vector<double>>& times)
+{
+  SdfChangeBlock changeBlock;
+  size_t count = 0;
+  for(size_t i = 0, n = paths.size(); i < n; ++i)
+  {
+    for(const double time : times[i])
+    {
+      layers[i]->EraseTimeSample(paths[i], time);
+    }
+    count += times[i].size();
+  }
+  return count;
+}
+
+} // anon
+
 //----------------------------------------------------------------------------------------------------------------------
 bool AnimationTranslator::considerToBeAnimation(const MFn::Type nodeType)
 {
@@ -272,11 +428,62 @@ void AnimationTranslator::exportAnimation(const ExporterParams& params)
      (startMesh != endMesh) ||
      (!m_animatedNodes.empty()))
   {
+    // The mesh export contexts are created once, and re-used for every frame.
+    const size_t numMeshes = m_animatedMeshes.size();
+    std::vector<UsdGeomMesh> meshes;
+    std::vector<std::unique_ptr<AL::usdmaya::utils::MeshExportContext>> meshContexts;
+    meshes.reserve(numMeshes);
+    meshContexts.reserve(numMeshes);
+    for(auto it = startMesh; it != endMesh; ++it)
+    {
+      meshes.emplace_back(it->second.GetPrim());
+      meshContexts.emplace_back(new AL::usdmaya::utils::MeshExportContext(it->first, meshes.back(), UsdTimeCode::Default()));
+    }
+
+    // The mesh points are gathered from maya on the main thread. They are then handed to a worker thread which writes
+    // them into the layer, while the main thread moves onto evaluating the next frame. USD does not support writing
+    // into a layer from multiple threads at once, so the main thread waits for the previous frame to be written
+    // before it performs any of its own writes.
+    std::vector<VtArray<GfVec3f>> gatheredPoints(numMeshes);
+    std::vector<VtArray<GfVec3f>> pendingPoints(numMeshes);
+    std::vector<uint8_t> gathered(numMeshes, 0);
+    std::vector<uint8_t> pending(numMeshes, 0);
+    WorkDispatcher writer;
+
+    // The duplicate samples are removed as each frame is written. The mesh points are filtered separately, as they are
+    // written by the worker thread.
+    std::vector<UsdAttribute> attributes;
+    std::vector<UsdAttribute> meshAttributes;
+    for(auto it = startAttrib; it != endAttrib; ++it)
+      attributes.push_back(it->second);
+    for(auto it = startAttribScaled; it != endAttribScaled; ++it)
+      attributes.push_back(it->second.attr);
+    for(auto it = startTransformAttrib; it != endTransformAttrib; ++it)
+      attributes.push_back(it->second);
+    for(auto it = startMesh; it != endMesh; ++it)
+      meshAttributes.push_back(it->second);
+    std::unique_ptr<AnimationSampleFilter> filter;
+    std::unique_ptr<AnimationSampleFilter> meshFilter;
+    if(params.m_filterSample)
+    {
+      filter.reset(new AnimationSampleFilter(attributes));
+      meshFilter.reset(new AnimationSampleFilter(meshAttributes));
+    }
+
     double increment = 1.0 / std::max(1U, params.m_subSamples);
     for(double t = params.m_minFrame, e = params.m_maxFrame + 1e-3f; t < e; t += increment)
     {
       MAnimControl::setCurrentTime(t);
       UsdTimeCode timeCode(t);
+
+      for(size_t i = 0; i < numMeshes; ++i)
+      {
+        gatheredPoints[i] = VtArray<GfVec3f>();
+        gathered[i] = *meshContexts[i] && meshContexts[i]->copyVertexData(gatheredPoints[i]);
+      }
+
+      writer.Wait();
+
       for(auto it = startAttrib; it != endAttrib; ++it)
       {
         /// \todo This feels wrong. Split the DgNodeTranslator class into 3 ...
@@ -297,20 +504,211 @@ void AnimationTranslator::exportAnimation(const ExporterParams& params)
       {
         translators::TransformTranslator::copyAttributeValue(it->first, it->second, timeCode);
       }
-      for(auto it = startMesh; it != endMesh; ++it)
-      {
-        UsdGeomMesh mesh(it->second.GetPrim());
-        AL::usdmaya::utils::MeshExportContext context(it->first, mesh, timeCode);
-        context.copyVertexData(timeCode);
-      }
       for(auto nodeAnim : m_animatedNodes)
       {
         nodeAnim.m_translator->exportCustomAnim(nodeAnim.m_path, nodeAnim.m_prim, timeCode);
       }
+
+      if(filter)
+      {
+        filter->samplesWritten(t);
+      }
+
+      if(numMeshes)
+      {
+        std::swap(gatheredPoints, pendingPoints);
+        std::swap(gathered, pending);
+        AnimationSampleFilter* const pointsFilter = meshFilter.get();
+        writer.Run([&meshContexts, &pendingPoints, &pending, pointsFilter, timeCode]() {
+          SdfChangeBlock changeBlock;
+          for(size_t i = 0, n = meshContexts.size(); i < n; ++i)
+          {
+            if(pending[i])
+            {
+              meshContexts[i]->writeVertexData(pendingPoints[i], timeCode);
+            }
+          }
+          if(pointsFilter)
+          {
+            pointsFilter->samplesWritten(timeCode.GetValue());
+          }
+        });
+      }
+    }
+    writer.Wait();
+
+    // the attributes written by custom translators are unknown until now, so they are filtered after the export.
+    // Those may include attributes that have already been filtered, which are skipped.
+    const size_t numFilteredAttributes = attributes.size();
+    std::unordered_set<SdfPath, SdfPath::Hash> attributePaths;
+    for(const UsdAttribute& attribute : attributes)
+    {
+      attributePaths.insert(attribute.GetPath());
+    }
+    for(auto nodeAnim : m_animatedNodes)
+    {
+      for(const UsdAttribute& attribute : nodeAnim.m_prim.GetAuthoredAttributes())
+      {
+        if(attribute.ValueMightBeTimeVarying() && attributePaths.insert(attribute.GetPath()).second)
+        {
+          attributes.push_back(attribute);
+        }
+      }
+    }
+
+    if(filter)
+    {
+      filter->finish();
+      meshFilter->finish();
+      AnimationSampleFilter::removeDuplicateSamples(
+          std::vector<UsdAttribute>(attributes.begin() + numFilteredAttributes, attributes.end()));
+    }
+    if(params.m_reduceTolerance > 0)
+    {
+      AnimationSampleFilter::reduceSamples(attributes, params.m_reduceTolerance);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool AnimationSampleFilter::Channel::add(VtValue&& value, const double time, double& removeTime)
+{
+  bool removePrevious = false;
+  if(!m_previous.IsEmpty() && value == m_previous)
+  {
+    // only the first and last samples of a run of identical samples are needed
+    removePrevious = m_previousIsDuplicate;
+    removeTime = m_previousTime;
+    m_previousIsDuplicate = true;
+  }
+  else
+  {
+    m_previous = std::move(value);
+    m_previousIsDuplicate = false;
+  }
+  m_previousTime = time;
+  return removePrevious;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+AnimationSampleFilter::AnimationSampleFilter(const std::vector<UsdAttribute>& attributes)
+  : m_layer(), m_channels(), m_numRemoved(0)
+{
+  SdfPathSet paths;
+  for(const UsdAttribute& attribute : attributes)
+  {
+    if(!attribute)
+      continue;
+    const SdfPath path = specPath(attribute, m_layer);
+    if(paths.insert(path).second)
+    {
+      m_channels.emplace_back();
+      m_channels.back().m_path = path;
     }
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+void AnimationSampleFilter::samplesWritten(const double time)
+{
+  if(m_channels.empty())
+    return;
+
+  // reading the samples back (and comparing them) is done concurrently, however the layer can only be edited serially
+  std::vector<double> removeTimes(m_channels.size());
+  std::vector<uint8_t> remove(m_channels.size(), 0);
+  WorkParallelForN(m_channels.size(), [this, time, &removeTimes, &remove](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      VtValue value;
+      if(m_layer->QueryTimeSample(m_channels[i].m_path, time, &value))
+      {
+        remove[i] = m_channels[i].add(std::move(value), time, removeTimes[i]);
+      }
+    }
+  });
+
+  SdfChangeBlock changeBlock;
+  for(size_t i = 0, n = m_channels.size(); i < n; ++i)
+  {
+    if(remove[i])
+    {
+      m_layer->EraseTimeSample(m_channels[i].m_path, removeTimes[i]);
+      ++m_numRemoved;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void AnimationSampleFilter::finish()
+{
+  SdfChangeBlock changeBlock;
+  for(Channel& channel : m_channels)
+  {
+    if(channel.m_previousIsDuplicate)
+    {
+      m_layer->EraseTimeSample(channel.m_path, channel.m_previousTime);
+      ++m_numRemoved;
+    }
+    channel.m_previous = VtValue();
+    channel.m_previousIsDuplicate = false;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t AnimationSampleFilter::removeDuplicateSamples(const std::vector<UsdAttribute>& attributes)
+{
+  const size_t numAttributes = attributes.size();
+  std::vector<SdfLayerHandle> layers(numAttributes);
+  SdfPathVector paths(numAttributes);
+  std::vector<std::vector<double>> removed(numAttributes);
+  WorkParallelForN(numAttributes, [&](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      if(!attributes[i])
+        continue;
+      paths[i] = specPath(attributes[i], layers[i]);
+      Channel channel;
+      double removeTime;
+      for(const double time : layers[i]->ListTimeSamplesForPath(paths[i]))
+      {
+        VtValue value;
+        if(layers[i]->QueryTimeSample(paths[i], time, &value) && channel.add(std::move(value), time, removeTime))
+        {
+          removed[i].push_back(removeTime);
+        }
+      }
+      if(channel.m_previousIsDuplicate)
+      {
+        removed[i].push_back(channel.m_previousTime);
+      }
+    }
+  });
+  return eraseSamples(layers, paths, removed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t AnimationSampleFilter::reduceSamples(const std::vector<UsdAttribute>& attributes, const double tolerance)
+{
+  const size_t numAttributes = attributes.size();
+  std::vector<SdfLayerHandle> layers(numAttributes);
+  SdfPathVector paths(numAttributes);
+  std::vector<std::vector<double>> removed(numAttributes);
+  WorkParallelForN(numAttributes, [&](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      if(!attributes[i])
+        continue;
+      paths[i] = specPath(attributes[i], layers[i]);
+      findReducibleSamples(layers[i], paths[i], tolerance, removed[i]);
+    }
+  });
+  return eraseSamples(layers, paths, removed);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 AnimationCheckTransformAttributes::AnimationCheckTransformAttributes()
 {
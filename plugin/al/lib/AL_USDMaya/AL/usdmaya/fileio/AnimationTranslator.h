@@ -32,6 +32,7 @@
 #include <utility>
 
 #include "pxr/pxr.h"
+#include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/usd/stage.h"
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -254,6 +255,75 @@ private:
   MObject m_inheritTransformAttribute;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Removes redundant time samples from exported attributes. The samples of each attribute are inspected as each
+///         frame is written, so only the previous value of each attribute is held in memory. Of each run of identical
+///         samples only the first and last are kept (a run at the end of the range keeps only its first), which leaves
+///         the interpolated values unchanged.
+///
+///         Once the whole range has been written, the samples of float, vector and matrix attributes may optionally be
+///         reduced further, by removing those that can be linearly interpolated from the kept samples within a
+///         tolerance.
+/// \ingroup   fileio
+//----------------------------------------------------------------------------------------------------------------------
+class AnimationSampleFilter
+{
+public:
+
+  /// \brief  ctor
+  /// \param  attributes the attributes that will have a sample written on each frame. The attributes must all be on
+  ///         the same stage, and the samples are filtered in the layer targeted by the stage's edit target.
+  AL_USDMAYA_PUBLIC
+  AnimationSampleFilter(const std::vector<UsdAttribute>& attributes);
+
+  /// \brief  call after the samples for a frame have been written. Where the new sample of an attribute extends a run
+  ///         of identical samples, the previous sample of the attribute is removed.
+  /// \param  time the time at which the samples were written
+  AL_USDMAYA_PUBLIC
+  void samplesWritten(double time);
+
+  /// \brief  call after the last frame has been written, to remove the duplicate samples at the end of the range
+  AL_USDMAYA_PUBLIC
+  void finish();
+
+  /// \brief  returns the number of samples removed so far
+  inline size_t numRemoved() const
+    { return m_numRemoved; }
+
+  /// \brief  removes the duplicate samples of attributes whose samples were not filtered as they were written.
+  ///         The attributes are inspected concurrently.
+  /// \param  attributes the attributes to filter
+  /// \return the number of samples removed
+  AL_USDMAYA_PUBLIC
+  static size_t removeDuplicateSamples(const std::vector<UsdAttribute>& attributes);
+
+  /// \brief  removes the samples of float, double, vector and matrix attributes that can be linearly interpolated from
+  ///         the remaining samples, such that no component of the removed samples differs from the interpolated value
+  ///         by more than the tolerance. The first and last samples are always kept, and attributes of other types are
+  ///         ignored. The attributes are inspected concurrently.
+  /// \param  attributes the attributes to reduce
+  /// \param  tolerance the maximum error allowed in each component
+  /// \return the number of samples removed
+  AL_USDMAYA_PUBLIC
+  static size_t reduceSamples(const std::vector<UsdAttribute>& attributes, double tolerance);
+
+private:
+  struct Channel
+  {
+    /// records the next sample of the channel. Returns true if the previous sample is now within a run of identical
+    /// samples, in which case removeTime is set to the time of the sample to remove.
+    bool add(VtValue&& value, double time, double& removeTime);
+
+    SdfPath m_path;
+    VtValue m_previous;
+    double m_previousTime = 0;
+    bool m_previousIsDuplicate = false;
+  };
+  SdfLayerHandle m_layer;
+  std::vector<Channel> m_channels;
+  size_t m_numRemoved;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 } // fileio
 } // usdmaya
@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include "AL/usdmaya/DebugCodes.h"
 #include "AL/usdmaya/fileio/AnimationTranslator.h"
 #include "AL/usdmaya/fileio/Export.h"
 #include "AL/usdmaya/fileio/NodeFactory.h"
@@ -249,57 +250,9 @@ struct Export::Impl
     }
   }
 
-  void filterSample()
-  {
-    std::vector<double> timeSamples;
-    std::vector<double> dupSamples;
-    for (auto prim : m_stage->Traverse())
-    {
-      std::vector<UsdAttribute> attributes = prim.GetAuthoredAttributes();
-      for (auto attr : attributes)
-      {
-        timeSamples.clear();
-        dupSamples.clear();
-        attr.GetTimeSamples(&timeSamples);
-        VtValue prevSampleBlob;
-        for (auto sample : timeSamples)
-        {
-          VtValue currSampleBlob;
-          attr.Get(&currSampleBlob, sample);
-          if (prevSampleBlob == currSampleBlob)
-          {
-            dupSamples.emplace_back(sample);
-          }
-          else
-          {
-            prevSampleBlob = currSampleBlob;
-            // only clear samples between constant segment
-            if (dupSamples.size() > 1)
-            {
-              dupSamples.pop_back();
-              for (auto dup : dupSamples)
-              {
-                attr.ClearAtTime(dup);
-              }
-            }
-            dupSamples.clear();
-          }
-        }
-        for (auto dup : dupSamples)
-        {
-          attr.ClearAtTime(dup);
-        }
-      }
-    }
-  }
-
-  void doExport(const char* const filename, bool toFilter = false, SdfPath defaultPrim = SdfPath())
+  void doExport(const char* const filename, SdfPath defaultPrim = SdfPath())
   {
     setDefaultPrimIfOnlyOneRoot(defaultPrim);
-    if (toFilter)
-    {
-      filterSample();
-    }
     m_stage->GetRootLayer()->Save();
     m_nodeMap.clear();
   }
@@ -979,7 +932,15 @@ void Export::doExport()
   }
 
   m_impl->processInstances();
-  m_impl->doExport(m_params.m_fileName.asChar(), m_params.m_filterSample, defaultPrim);
+  m_impl->doExport(m_params.m_fileName.asChar(), defaultPrim);
+
+  const translators::TranslatorManufacture::LookupStats& stats = m_translatorManufacture.lookupStats();
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("Export: translator lookups %llu hits / %llu misses, "
+                                      "extra data plugin lookups %llu hits / %llu misses\n",
+                                      (unsigned long long)stats.translatorHits,
+                                      (unsigned long long)stats.translatorMisses,
+                                      (unsigned long long)stats.extraDataHits,
+                                      (unsigned long long)stats.extraDataMisses);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1074,6 +1035,10 @@ MStatus ExportCommand::doIt(const MArgList& args)
   {
     AL_MAYA_CHECK_ERROR(argData.getFlagArgument("fs", 0, m_params.m_filterSample), "ALUSDExport: Unable to fetch \"filter sample\" argument");
   }
+  if (argData.isFlagSet("rt", &status))
+  {
+    AL_MAYA_CHECK_ERROR(argData.getFlagArgument("rt", 0, m_params.m_reduceTolerance), "ALUSDExport: Unable to fetch \"reduce tolerance\" argument");
+  }
   if(argData.isFlagSet("eac", &status))
   {
     AL_MAYA_CHECK_ERROR(argData.getFlagArgument("eac", 0, m_params.m_extensiveAnimationCheck), "ALUSDExport: Unable to fetch \"extensive animation check\" argument");
@@ -1169,6 +1134,8 @@ MSyntax ExportCommand::createSyntax()
   AL_MAYA_CHECK_ERROR2(status, errorString);
   status = syntax.addFlag("-fs", "-filterSample", MSyntax::kBoolean);
   AL_MAYA_CHECK_ERROR2(status, errorString);
+  status = syntax.addFlag("-rt", "-reduceTolerance", MSyntax::kDouble);
+  AL_MAYA_CHECK_ERROR2(status, errorString);
   status = syntax.addFlag("-eac", "-extensiveAnimationCheck", MSyntax::kBoolean);
   AL_MAYA_CHECK_ERROR2(status, errorString);
   status = syntax.addFlag("-ss", "-subSamples", MSyntax::kUnsigned);
@@ -1204,6 +1171,10 @@ ExportCommand Overview:
 
   The exporter can remove samples that contain the same data for adjacent samples
     1. AL_usdmaya_ExportCommand -f "<path/to/out/file.usd>" -fs
+
+  The animation of float, vector and matrix attributes can be reduced to the samples that cannot be linearly
+  interpolated from their neighbours within a tolerance:
+    1. AL_usdmaya_ExportCommand -f "<path/to/out/file.usd>" -ani -reduceTolerance 0.001
 )";
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -98,6 +98,7 @@ MStatus ExportTranslator::writer(const MFileObject& file, const AL::maya::utils:
     params.m_animTranslator = new AnimationTranslator;
   }
   params.m_filterSample = options.getBool(kFilterSample);
+  params.m_reduceTolerance = options.getFloat(kReduceTolerance);
   if(params.m_selected)
   {
     MGlobal::getActiveSelectionList(params.m_nodes);
@@ -21,13 +21,20 @@
 #include "pxr/base/tf/type.h"
 #include "pxr/usd/usd/schemaBase.h"
 
+#include "maya/MFnDependencyNode.h"
+#include "maya/MTypeId.h"
+
 namespace AL {
 namespace usdmaya {
 namespace fileio {
 namespace translators {
 
+//----------------------------------------------------------------------------------------------------------------------
+std::atomic<uint32_t> TranslatorManufacture::s_cacheGeneration(0);
+
 //----------------------------------------------------------------------------------------------------------------------
 TranslatorManufacture::TranslatorManufacture(TranslatorContextPtr context)
+  : m_cacheGeneration(s_cacheGeneration.load())
 {
   std::set<TfType> loadedTypes;
   std::set<TfType> derivedTypes;
@@ -73,6 +80,50 @@ TranslatorManufacture::TranslatorManufacture(TranslatorContextPtr context)
       }
     }
   }
+
+  // translators that only test the node type can have their canExport result cached per node type
+  for(auto& it : m_translatorsMap)
+  {
+    if(it.second->canExportDependsOnNodeTypeOnly())
+      m_nodeTypeTranslators.push_back(it.second);
+    else
+      m_nodeTranslators.push_back(it.second);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorManufacture::clearLookupCache()
+{
+  m_translatorCache.clear();
+  m_extraDataCache.clear();
+  m_cacheGeneration = s_cacheGeneration.load();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorManufacture::invalidateLookupCaches()
+{
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorManufacture::invalidateLookupCaches\n");
+  ++s_cacheGeneration;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorManufacture::validateLookupCache()
+{
+  if(m_cacheGeneration != s_cacheGeneration.load())
+  {
+    clearLookupCache();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint64_t TranslatorManufacture::nodeTypeKey(const MObject& mayaObject) const
+{
+  // The MFn::Type alone is ambiguous for plugin nodes (e.g. every MPxNode is a kPluginDependNode), so combine it with
+  // the MTypeId of the node. Objects that are not dependency nodes are keyed by their MFn::Type only.
+  MStatus status;
+  MFnDependencyNode fn(mayaObject, &status);
+  const uint32_t typeId = status ? fn.typeId().id() : 0;
+  return (uint64_t(mayaObject.apiType()) << 32) | typeId;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -91,16 +142,43 @@ TranslatorManufacture::RefPtr TranslatorManufacture::get(const TfToken type_name
 //----------------------------------------------------------------------------------------------------------------------
 TranslatorManufacture::RefPtr TranslatorManufacture::get(const MObject& mayaObject)
 {
-  TranslatorManufacture::RefPtr base;
-  TranslatorManufacture::RefPtr derived;
-  for(auto& it : m_translatorsMap)
+  validateLookupCache();
+
+  const uint64_t key = nodeTypeKey(mayaObject);
+  auto cached = m_translatorCache.find(key);
+  if(cached == m_translatorCache.end())
   {
-    ExportFlag mode = it.second->canExport(mayaObject);
+    ++m_lookupStats.translatorMisses;
+    CachedTranslators translators;
+    for(auto& it : m_nodeTypeTranslators)
+    {
+      ExportFlag mode = it->canExport(mayaObject);
+      switch(mode)
+      {
+      case ExportFlag::kNotSupported: break;
+      case ExportFlag::kFallbackSupport: translators.base = it; break;
+      case ExportFlag::kSupported: translators.derived = it; break;
+      default:
+        break;
+      }
+    }
+    cached = m_translatorCache.emplace(key, translators).first;
+  }
+  else
+  {
+    ++m_lookupStats.translatorHits;
+  }
+
+  TranslatorManufacture::RefPtr base = cached->second.base;
+  TranslatorManufacture::RefPtr derived = cached->second.derived;
+  for(auto& it : m_nodeTranslators)
+  {
+    ExportFlag mode = it->canExport(mayaObject);
     switch(mode)
     {
     case ExportFlag::kNotSupported: break;
-    case ExportFlag::kFallbackSupport: base = it.second; break;
-    case ExportFlag::kSupported: derived = it.second; break;
+    case ExportFlag::kFallbackSupport: base = it; break;
+    case ExportFlag::kSupported: derived = it; break;
     default:
       break;
     }
@@ -111,7 +189,20 @@ TranslatorManufacture::RefPtr TranslatorManufacture::get(const MObject& mayaObje
 //----------------------------------------------------------------------------------------------------------------------
 std::vector<TranslatorManufacture::ExtraDataPluginPtr> TranslatorManufacture::getExtraDataPlugins(const MObject& mayaObject)
 {
-  std::vector<TranslatorManufacture::ExtraDataPluginPtr> ptrs;
+  validateLookupCache();
+
+  // the plugins only test the MFn::Type, and the type name of plugin nodes, so the result is the same for every node
+  // of a given type.
+  const uint64_t key = nodeTypeKey(mayaObject);
+  auto cached = m_extraDataCache.find(key);
+  if(cached != m_extraDataCache.end())
+  {
+    ++m_lookupStats.extraDataHits;
+    return cached->second;
+  }
+  ++m_lookupStats.extraDataMisses;
+
+  std::vector<TranslatorManufacture::ExtraDataPluginPtr>& ptrs = m_extraDataCache[key];
   for(auto plugin : m_extraDataPlugins)
   {
     MFn::Type type = plugin->getFnType();
@@ -18,6 +18,7 @@
 #include "../../Api.h"
 #include "AL/maya/utils/Api.h"
 
+#include "maya/MDagModifier.h"
 #include "maya/MDagPath.h"
 
 #include "pxr/base/tf/refBase.h"
@@ -26,7 +27,10 @@
 #include "pxr/base/tf/registryManager.h"
 #include "pxr/usd/usd/prim.h"
 
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <functional>
 #include "AL/usdmaya/fileio/translators/TranslatorContext.h"
@@ -45,6 +49,19 @@ enum class ExportFlag
   kSupported
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Base class for the data a translator reads from USD in the prefetch step of a batched import. Translators
+///         that support the batched import derive their own type from this to hold the attribute values of a prim.
+/// \ingroup   translators
+//----------------------------------------------------------------------------------------------------------------------
+struct TranslatorPrefetchData
+{
+  /// \brief  dtor
+  virtual ~TranslatorPrefetchData() {}
+};
+
+typedef std::unique_ptr<TranslatorPrefetchData> TranslatorPrefetchDataPtr;
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  The base class interface of all translator plugins. The absolute minimum a translator plugin must implement
 ///         are the following 3 methods:
@@ -163,10 +180,54 @@ public:
   virtual MStatus update(const UsdPrim& prim)
     { return MStatus::kNotImplemented; }
 
+  /// \brief  Override this method and return true if the translator implements the batched import, i.e.
+  ///         queueNodeCreation, prefetch and importAttributes. When many prims are imported at once (e.g. by
+  ///         ProxyShapePostLoadProcess::createSchemaPrims), those methods are used in place of import: the nodes
+  ///         for all of the prims are created with a single MDagModifier::doIt, the values are then read from USD
+  ///         in parallel, and finally the attributes of each node are set.
+  /// \return true if your plugin supports the batched import, false otherwise.
+  virtual bool supportsBatchImport() const
+    { return false; }
+
+  /// \brief  Batched import, step 1: add the creation of the Maya node(s) for the prim to the modifier. The modifier
+  ///         is shared by all of the prims in the batch, and doIt is only called once they have all been queued,
+  ///         so do not attempt to set any attribute values here.
+  /// \param  prim the usd prim to be imported into maya
+  /// \param  parent the AL_usd_Transform node to parent your DAG objects under
+  /// \param  modifier the modifier the node creation should be added to
+  /// \param  createdObj the returned handle to the node that will be created
+  /// \return MS::kSuccess if all ok
+  virtual MStatus queueNodeCreation(const UsdPrim& prim, MObject& parent, MDagModifier& modifier, MObject& createdObj)
+    { return MStatus::kNotImplemented; }
+
+  /// \brief  Batched import, step 2: read the values importAttributes needs from the prim. This is called for many
+  ///         prims concurrently from worker threads, so it must only read from USD, and must not call into Maya.
+  /// \param  prim the usd prim being imported
+  /// \return the values read from the prim (which are passed to importAttributes)
+  virtual TranslatorPrefetchDataPtr prefetch(const UsdPrim& prim) const
+    { return TranslatorPrefetchDataPtr(); }
+
+  /// \brief  Batched import, step 3: once the nodes of the batch exist, this is called to set the attribute values of
+  ///         the node created for the prim.
+  /// \param  prim the usd prim being imported
+  /// \param  createdObj the node returned from queueNodeCreation
+  /// \param  data the values returned from prefetch
+  /// \return MS::kSuccess if all ok
+  virtual MStatus importAttributes(const UsdPrim& prim, MObject& createdObj, const TranslatorPrefetchData* data)
+    { return MStatus::kNotImplemented; }
+
   /// \brief  Method used to test a Maya node to see whether it can be exported.
   virtual ExportFlag canExport(const MObject& obj)
     { return ExportFlag::kNotSupported; }
 
+  /// \brief  Override this method and return true if the result of canExport depends only on the type of the Maya node
+  ///         (e.g. it only performs MObject::hasFn tests). The TranslatorManufacture will then call canExport once
+  ///         per node type, and re-use that result for all other nodes of the same type. If your translator inspects
+  ///         the attributes or connections of the node, leave this returning false.
+  /// \return true if the result of canExport can be cached per node type
+  virtual bool canExportDependsOnNodeTypeOnly() const
+    { return false; }
+
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -250,6 +311,15 @@ public:
   typedef TfRefPtr<ExtraDataPluginBase> ExtraDataPluginPtr; ///< handle to a plug-in transla
   typedef std::vector<RefPtr> RefPtrVector;
 
+  /// \brief  counters for the per node type caches used by get(const MObject&) and getExtraDataPlugins
+  struct LookupStats
+  {
+    uint64_t translatorHits = 0; ///< number of get(const MObject&) calls that found the node type in the cache
+    uint64_t translatorMisses = 0; ///< number of get(const MObject&) calls that had to query every translator
+    uint64_t extraDataHits = 0; ///< number of getExtraDataPlugins calls that found the node type in the cache
+    uint64_t extraDataMisses = 0; ///< number of getExtraDataPlugins calls that had to query every plugin
+  };
+
   /// \brief  constructs a registry of translator plugins that are currently registered within usd maya. This construction
   ///         should only happen once per-proxy shape.
   /// \param  context the translator context for this registry
@@ -274,9 +344,43 @@ public:
   AL_USDMAYA_PUBLIC
   std::vector<ExtraDataPluginPtr> getExtraDataPlugins(const MObject& mayaObject);
 
+  /// \brief  returns the hit/miss counters of the node type caches since construction (or the last call to
+  ///         resetLookupStats)
+  const LookupStats& lookupStats() const
+    { return m_lookupStats; }
+
+  /// \brief  resets the hit/miss counters of the node type caches
+  void resetLookupStats()
+    { m_lookupStats = LookupStats(); }
+
+  /// \brief  clears the node type caches of this registry. They will be re-populated on demand.
+  AL_USDMAYA_PUBLIC
+  void clearLookupCache();
+
+  /// \brief  clears the node type caches of all registries. This is called whenever a Maya plugin is loaded or
+  ///         unloaded, since that may register a new node type with a previously used MTypeId.
+  AL_USDMAYA_PUBLIC
+  static void invalidateLookupCaches();
+
+private:
+  struct CachedTranslators
+  {
+    RefPtr base;
+    RefPtr derived;
+  };
+  uint64_t nodeTypeKey(const MObject& mayaObject) const;
+  void validateLookupCache();
+
 private:
   std::unordered_map<std::string, TranslatorRefPtr> m_translatorsMap;
   std::vector<ExtraDataPluginPtr> m_extraDataPlugins;
+  std::vector<TranslatorRefPtr> m_nodeTypeTranslators;
+  std::vector<TranslatorRefPtr> m_nodeTranslators;
+  std::unordered_map<uint64_t, CachedTranslators> m_translatorCache;
+  std::unordered_map<uint64_t, std::vector<ExtraDataPluginPtr>> m_extraDataCache;
+  LookupStats m_lookupStats;
+  uint32_t m_cacheGeneration;
+  static std::atomic<uint32_t> s_cacheGeneration;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -19,6 +19,9 @@
 #include "maya/MSelectionList.h"
 #include "maya/MFnDagNode.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace AL {
 namespace usdmaya {
 namespace fileio {
@@ -40,28 +43,112 @@ UsdStageRefPtr TranslatorContext::getUsdStage() const
 void TranslatorContext::validatePrims()
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::validatePrims ** VALIDATE PRIMS **\n");
-  for(auto it : m_primMapping)
+  for(const auto& it : m_primMapping)
   {
-    if(it.objectHandle().isValid() && it.objectHandle().isAlive())
+    if(!it.path().IsEmpty() && it.objectHandle().isValid() && it.objectHandle().isAlive())
     {
       TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::validatePrims ** VALID HANDLE DETECTED %s **\n", it.path().GetText());
     }
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+TranslatorContext::PrimLookup& TranslatorContext::findOrInsert(const UsdPrim& prim, const MObject& mayaObj)
+{
+  LookupIndex& entry = m_primIndex[prim.GetPath()];
+  if(entry.index < 0)
+  {
+    if(m_freeLookups.empty())
+    {
+      entry.index = int32_t(m_primMapping.size());
+      m_primMapping.emplace_back(prim.GetPath(), prim.GetTypeName(), mayaObj);
+    }
+    else
+    {
+      entry.index = int32_t(m_freeLookups.back());
+      m_freeLookups.pop_back();
+      m_primMapping[entry.index] = PrimLookup(prim.GetPath(), prim.GetTypeName(), mayaObj);
+    }
+  }
+  return m_primMapping[entry.index];
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::insert(const PrimLookup& lookup)
+{
+  LookupIndex& entry = m_primIndex[lookup.path()];
+  if(entry.index >= 0)
+  {
+    m_primMapping[entry.index] = lookup;
+  }
+  else
+  if(m_freeLookups.empty())
+  {
+    entry.index = int32_t(m_primMapping.size());
+    m_primMapping.push_back(lookup);
+  }
+  else
+  {
+    entry.index = int32_t(m_freeLookups.back());
+    m_freeLookups.pop_back();
+    m_primMapping[entry.index] = lookup;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::erase(const SdfPath& path)
+{
+  auto it = m_primIndex.find(path);
+  if(it == m_primIndex.end() || it->second.index < 0)
+  {
+    return;
+  }
+
+  const uint32_t index = uint32_t(it->second.index);
+  m_primMapping[index] = PrimLookup(SdfPath(), TfToken(), MObject::kNullObj);
+  m_freeLookups.push_back(index);
+  it->second.index = -1;
+
+  // prune the entry (and any ancestors that were only there to hold it) from the index if nothing else remains beneath
+  SdfPath current = path;
+  while(!current.IsAbsoluteRootPath() && !current.IsEmpty())
+  {
+    auto range = m_primIndex.FindSubtreeRange(current);
+    if(range.first == m_primIndex.end() || range.first->second.index >= 0 || std::next(range.first) != range.second)
+    {
+      break;
+    }
+    m_primIndex.erase(range.first);
+    current = current.GetParentPath();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TranslatorContext::findSubtree(const SdfPath& path, std::vector<uint32_t>& indices) const
+{
+  auto range = m_primIndex.FindSubtreeRange(path);
+  for(auto it = range.first; it != range.second; ++it)
+  {
+    if(it->second.index >= 0)
+    {
+      indices.push_back(uint32_t(it->second.index));
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 bool TranslatorContext::getTransform(const SdfPath& path, MObjectHandle& object)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getTransform %s\n", path.GetText());
-  auto it = find(path);
-  if(it != m_primMapping.end())
+  const PrimLookup* lookup = find(path);
+  if(lookup)
   {
-    if(!it->objectHandle().isValid())
+    if(!lookup->objectHandle().isValid())
     {
       TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getTransform - invalid handle\n");
       return false;
     }
-    object = it->object();
+    object = lookup->object();
     return true;
   }
   return false;
@@ -71,23 +158,23 @@ bool TranslatorContext::getTransform(const SdfPath& path, MObjectHandle& object)
 void TranslatorContext::updatePrimTypes()
 {
   auto stage = m_proxyShape->usdStage();
-  for(auto it = m_primMapping.begin(); it != m_primMapping.end(); )
+  for(size_t i = 0, n = m_primMapping.size(); i < n; ++i)
   {
-    SdfPath path(it->path());
-    UsdPrim prim = stage->GetPrimAtPath(path);
-    if(!prim)
+    PrimLookup& lookup = m_primMapping[i];
+    if(lookup.path().IsEmpty())
     {
-      it = m_primMapping.erase(it);
+      continue;
     }
-    else
-    if(it->type() != prim.GetTypeName())
+
+    UsdPrim prim = stage->GetPrimAtPath(lookup.path());
+    if(!prim)
     {
-      it->type() = prim.GetTypeName();
-      ++it;
+      erase(SdfPath(lookup.path()));
     }
     else
+    if(lookup.type() != prim.GetTypeName())
     {
-      ++it;
+      lookup.setType(prim.GetTypeName());
     }
   }
 }
@@ -97,8 +184,8 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getMObject '%s' \n", path.GetText());
 
-  auto it = find(path);
-  if(it != m_primMapping.end())
+  const PrimLookup* it = find(path);
+  if(it)
   {
     const MTypeId zero(0);
     if(zero != typeId)
@@ -141,8 +228,8 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getMObject '%s' \n", path.GetText());
 
-  auto it = find(path);
-  if(it != m_primMapping.end())
+  const PrimLookup* it = find(path);
+  if(it)
   {
     const MTypeId zero(0);
     if(MFn::kInvalid != type)
@@ -183,8 +270,8 @@ bool TranslatorContext::getMObject(const SdfPath& path, MObjectHandle& object, M
 bool TranslatorContext::getMObjects(const SdfPath& path, MObjectHandleArray& returned)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getMObjects: %s\n", path.GetText());
-  auto it = find(path);
-  if(it != m_primMapping.end())
+  const PrimLookup* it = find(path);
+  if(it)
   {
     returned = it->createdNodes();
     return true;
@@ -196,11 +283,7 @@ bool TranslatorContext::getMObjects(const SdfPath& path, MObjectHandleArray& ret
 void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::registerItem adding entry %s[%s]\n", prim.GetPath().GetText(), object.object().apiTypeStr());
-  auto iter = findLocation(prim.GetPath());
-  if(iter == m_primMapping.end() || iter->path() != prim.GetPath())
-  {
-    iter = m_primMapping.insert(iter, PrimLookup(prim.GetPath(), prim.GetTypeName(), object.object()));
-  }
+  PrimLookup* iter = &findOrInsert(prim, object.object());
 
   if(object.object() == MObject::kNullObj)
   {
@@ -216,11 +299,7 @@ void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object)
 void TranslatorContext::insertItem(const UsdPrim& prim, MObjectHandle object)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::insertItem adding entry %s[%s]\n", prim.GetPath().GetText(), object.object().apiTypeStr());
-  auto iter = findLocation(prim.GetPath());
-  if(iter == m_primMapping.end() || iter->path() != prim.GetPath())
-  {
-    iter = m_primMapping.insert(iter, PrimLookup(prim.GetPath(), prim.GetTypeName(), object.object()));
-  }
+  PrimLookup* iter = &findOrInsert(prim, object.object());
   iter->createdNodes().push_back(object);
 
   if(object.object() == MObject::kNullObj)
@@ -238,8 +317,8 @@ void TranslatorContext::insertItem(const UsdPrim& prim, MObjectHandle object)
 void TranslatorContext::removeItems(const SdfPath& path)
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::removeItems remove under primPath=%s\n", path.GetText());
-  auto it = find(path);
-  if(it != m_primMapping.end() && it->path() == path)
+  PrimLookup* it = find(path);
+  if(it)
   {
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::removeItems removing path=%s\n", it->path().GetText());
     MDGModifier modifier1;
@@ -249,7 +328,9 @@ void TranslatorContext::removeItems(const SdfPath& path)
     bool hasDagNodes = false;
     bool hasDependNodes = false;
 
-    auto& nodes = it->createdNodes();
+    // take a copy of the nodes, since the modifiers may cause the mapping to be modified
+    MObjectHandleArray nodes;
+    nodes.swap(it->createdNodes());
     for(std::size_t j = 0, n = nodes.size(); j < n; ++j)
     {
       if(nodes[j].isAlive() && nodes[j].isValid())
@@ -289,7 +370,6 @@ void TranslatorContext::removeItems(const SdfPath& path)
         TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::removeItems Invalid MObject was registered with the primPath \"%s\"\n", path.GetText());
       }
     }
-    nodes.clear();
 
     if(hasDependNodes)
     {
@@ -309,7 +389,7 @@ void TranslatorContext::removeItems(const SdfPath& path)
       status = modifier2.doIt();
       AL_MAYA_CHECK_ERROR2(status, "failed to delete dag nodes");
     }
-    m_primMapping.erase(it);
+    erase(path);
   }
   validatePrims();
 }
@@ -343,8 +423,21 @@ MString TranslatorContext::serialise() const
   oss.str("");
   oss.clear();
 
-  for(auto it : m_primMapping)
+  // write the mappings out in path order
+  std::vector<const PrimLookup*> lookups;
+  lookups.reserve(m_primMapping.size());
+  for(const auto& it : m_primMapping)
   {
+    if(!it.path().IsEmpty())
+    {
+      lookups.push_back(&it);
+    }
+  }
+  std::sort(lookups.begin(), lookups.end(), [](const PrimLookup* a, const PrimLookup* b) { return a->path() < b->path(); });
+
+  for(const PrimLookup* lookup : lookups)
+  {
+    const PrimLookup& it = *lookup;
     oss << it.path() << "=" << it.type().GetText() << ",";
     oss << getNodeName(it.object());
     for(uint32_t i = 0; i < it.createdNodes().size(); ++i)
@@ -388,7 +481,7 @@ void TranslatorContext::deserialise(const MString& string)
       lookup.createdNodes().push_back(obj);
     }
 
-    m_primMapping.push_back(lookup);
+    insert(lookup);
   }
 
   SdfPathVector vec = m_proxyShape->getPrimPathsFromCommaJoinedString(m_proxyShape->excludedTranslatedGeometryPlug().asString());
@@ -400,34 +493,25 @@ void TranslatorContext::preRemoveEntry(const SdfPath& primPath, SdfPathVector& i
 {
   TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::preRemoveEntry primPath=%s\n", primPath.GetText());
 
-  PrimLookups::iterator end = m_primMapping.end();
-  PrimLookups::iterator range_begin = std::lower_bound(m_primMapping.begin(), end, primPath, value_compare());
-  PrimLookups::iterator range_end = range_begin;
-  for(; range_end != end; ++range_end)
-  {
-    // due to the joys of sorting, any child prims of this prim being destroyed should appear next to each
-    // other (one would assume); So if compare does not find a match (the value is something other than zero),
-    // we are no longer in the same prim root
-    const SdfPath& childPath = range_end->path();
-
-    if(!childPath.HasPrefix(primPath))
-    {
-      break;
-    }
-  }
+  std::vector<uint32_t> indices;
+  findSubtree(primPath, indices);
 
   auto stage = m_proxyShape->usdStage();
 
   // run the preTearDown stage on each prim. We will walk over the prims in the reverse order here (which will guarentee
   // the the itemsToRemove will be ordered such that the child prims will be destroyed before their parents).
-  auto iter = range_end;
-  itemsToRemove.reserve(itemsToRemove.size() + range_end - range_begin);
-  while(iter != range_begin)
+  SdfPathHashSet existingItems(itemsToRemove.begin(), itemsToRemove.end());
+  itemsToRemove.reserve(itemsToRemove.size() + indices.size());
+  for(auto iter = indices.rbegin(); iter != indices.rend(); ++iter)
   {
-    --iter;
-    PrimLookup& node = *iter;
+    // copy the path, the translators may modify the mapping during preUnloadPrim
+    const SdfPath path = m_primMapping[*iter].path();
+    if(path.IsEmpty())
+    {
+      continue;
+    }
 
-    if(std::find(itemsToRemove.begin(), itemsToRemove.end(), node.path()) != itemsToRemove.end())
+    if(!existingItems.insert(path).second)
     {
       // Same exact path has already been processed and added to the list of itemsToRemove.
       TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::preRemoveEntry skipping path thats already in "
@@ -435,16 +519,14 @@ void TranslatorContext::preRemoveEntry(const SdfPath& primPath, SdfPathVector& i
     }
     else
     {
-      itemsToRemove.push_back(node.path());
-      auto prim = stage->GetPrimAtPath(node.path());
+      itemsToRemove.push_back(path);
+      auto prim = stage->GetPrimAtPath(path);
       if (prim && callPreUnload)
       {
-        preUnloadPrim(prim, node.object());
+        preUnloadPrim(prim, m_primMapping[*iter].object());
       }
     }
   }
-
-
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -461,21 +543,17 @@ void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove)
   while(iter != itemsToRemove.end())
   {
     auto path = *iter;
-    auto node = std::lower_bound(m_primMapping.begin(), m_primMapping.end(), path, value_compare());
     bool isInTransformChain = isPrimInTransformChain(path);
 
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::removeEntries removing: %s\n", iter->GetText());
-    if(node->objectHandle().isValid() && node->objectHandle().isAlive())
+    const PrimLookup* node = find(path);
+    if(node && node->objectHandle().isValid() && node->objectHandle().isAlive())
     {
       unloadPrim(path, node->object());
     }
 
-    // The item might already have been removed by a translator...
-    if(node != m_primMapping.end() && node->path() == path)
-    {
-      // remove nodes from map
-      m_primMapping.erase(node);
-    }
+    // The item might already have been removed by a translator, in which case this does nothing
+    erase(path);
 
     if(isInTransformChain)
     {
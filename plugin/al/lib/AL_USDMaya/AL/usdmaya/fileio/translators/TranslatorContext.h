@@ -27,9 +27,11 @@
 #include "pxr/pxr.h"
 #include "pxr/base/tf/refPtr.h"
 #include "pxr/usd/usd/prim.h"
+#include "pxr/usd/sdf/pathTable.h"
 #include "pxr/base/tf/debug.h"
 #include "AL/usdmaya/DebugCodes.h"
 
+#include <deque>
 #include <vector>
 #include <string>
 #include "AL/usd/utils/ForwardDeclares.h"
@@ -61,8 +63,17 @@ struct TranslatorParameters
   inline bool forceTranslatorImport() const
     { return forcePrimImport; }
 
+  /// \brief Flag that determines if the translators that support it should import their prims as a batch
+  inline void setBatchImport(bool batch)
+    { batchPrimImport = batch; }
+
+  /// \brief Retrieves the flag that determines if the translators that support it import their prims as a batch
+  inline bool batchImport() const
+    { return batchPrimImport; }
+
 private:
   bool forcePrimImport = false;
+  bool batchPrimImport = true;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -203,10 +214,10 @@ public:
   /// \return the type name for that prim
   TfToken getTypeForPath(SdfPath path) const
   {
-    const auto it = find(path);
-    if(it != m_primMapping.end())
+    const PrimLookup* lookup = find(path);
+    if(lookup)
     {
-      return it->type();
+      return lookup->type();
     }
     TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("TranslatorContext::getTypeForPath did not find item in mapping.%s\n", path.GetText());
     return TfToken();
@@ -246,10 +257,10 @@ public:
   /// \return true if an entry is found that matches, false otherwise
   bool hasEntry(const SdfPath& path, const TfToken& type)
   {
-    auto it = find(path);
-    if(it != m_primMapping.end())
+    const PrimLookup* lookup = find(path);
+    if(lookup)
     {
-      return type == it->type();
+      return type == lookup->type();
     }
     return false;
   }
@@ -303,6 +314,11 @@ public:
     TfToken type() const
       { return m_type; }
 
+    /// \brief  set the prim type
+    /// \param  type the new type of the prim
+    void setType(const TfToken& type)
+      { m_type = type; }
+
     /// \brief  get created maya nodes
     /// \return the created maya nodes for this prim translator
     MObjectHandleArray& createdNodes()
@@ -320,8 +336,10 @@ public:
     MObjectHandleArray m_createdNodes;
   };
 
-  /// a sorted array of prim mappings
-  typedef std::vector<PrimLookup> PrimLookups;
+  /// storage for the prim mappings. Entries are indexed by path via a SdfPathTable. Removed entries have an empty
+  /// path, and their slots are re-used by later insertions. A deque is used so that appending an entry never moves the
+  /// existing ones, and references to them remain valid.
+  typedef std::deque<PrimLookup> PrimLookups;
 
   /// comparison utility (for sorting array of pointers to node references based on their path)
   struct value_compare
@@ -351,7 +369,11 @@ public:
 
   /// \brief  This is used for testing only. Do not call.
   void clearPrimMappings()
-    { m_primMapping.clear(); }
+    {
+      m_primMapping.clear();
+      m_primIndex.clear();
+      m_freeLookups.clear();
+    }
 
   /// \brief  add geometry to the exclusion list
   /// \param  newPath the path to add as an excluded translator path
@@ -412,40 +434,43 @@ private:
   /// \return true if the prim maps to a MObject inside the Maya Dag tree.
   bool isPrimInTransformChain(const SdfPath& path);
 
-  inline PrimLookups::iterator find(const SdfPath& path)
+  /// \brief  returns the lookup for the specified path, or null if the path has not been registered
+  inline PrimLookup* find(const SdfPath& path)
   {
-    PrimLookups::iterator end = m_primMapping.end();
-    PrimLookups::iterator it = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-    if(it != end)
+    auto it = m_primIndex.find(path);
+    if(it != m_primIndex.end() && it->second.index >= 0)
     {
-      if(it->path() == path)
-        return it;
+      return &m_primMapping[it->second.index];
     }
-    return end;
+    return nullptr;
   }
 
-  inline PrimLookups::const_iterator find(const SdfPath& path) const
+  /// \brief  returns the lookup for the specified path, or null if the path has not been registered
+  inline const PrimLookup* find(const SdfPath& path) const
   {
-    PrimLookups::const_iterator end = m_primMapping.end();
-    PrimLookups::const_iterator it = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-    if(it != end)
+    auto it = m_primIndex.find(path);
+    if(it != m_primIndex.end() && it->second.index >= 0)
     {
-      if(it->path() == path)
-        return it;
+      return &m_primMapping[it->second.index];
     }
-    return end;
+    return nullptr;
   }
 
-  inline PrimLookups::iterator findLocation(const SdfPath& path)
-  {
-    PrimLookups::iterator end = m_primMapping.end();
-    PrimLookups::iterator it = std::lower_bound(m_primMapping.begin(), end, path, value_compare());
-    return it;
-  }
+  /// \brief  returns the lookup for the prim, creating a new one if the path has not been registered
+  PrimLookup& findOrInsert(const UsdPrim& prim, const MObject& mayaObj);
 
+  /// \brief  adds the lookup into the mapping, replacing any existing entry at the same path
+  void insert(const PrimLookup& lookup);
+
+  /// \brief  removes the lookup for the specified path (if it exists)
+  void erase(const SdfPath& path);
+
+  /// \brief  returns the indices of all lookups that are registered at or below the specified path, with parents
+  ///         ordered before their children
+  void findSubtree(const SdfPath& path, std::vector<uint32_t>& indices) const;
 
   TranslatorContext(nodes::ProxyShape* proxyShape)
-    : m_proxyShape(proxyShape), m_primMapping()
+    : m_proxyShape(proxyShape), m_primMapping(), m_primIndex(), m_freeLookups()
     {}
 
   nodes::ProxyShape* m_proxyShape;
@@ -454,6 +479,17 @@ private:
   // a dependency node
   PrimLookups m_primMapping;
 
+  // index into m_primMapping for each registered path. The path table also contains the ancestors of every
+  // registered path, which will have an index of -1 unless they have been registered themselves.
+  struct LookupIndex
+  {
+    int32_t index = -1;
+  };
+  SdfPathTable<LookupIndex> m_primIndex;
+
+  // slots within m_primMapping that have been removed, and can be re-used
+  std::vector<uint32_t> m_freeLookups;
+
   // true to make all translators that default to not importing Prims to always import Prims via the translators
   bool m_forcePrimImport;
 
@@ -48,6 +48,8 @@ private:
   MStatus tearDown(const SdfPath& path) override;
   ExportFlag canExport(const MObject& obj) override
     { return (obj.hasFn(MFn::kDistance) ? ExportFlag::kFallbackSupport : ExportFlag::kNotSupported); }
+  bool canExportDependsOnNodeTypeOnly() const override
+    { return true; }
 };
 #endif
 
@@ -20,6 +20,9 @@
 #include "AL/maya/utils/Utils.h"
 #include "AL/maya/utils/MayaHelperMacros.h"
 
+#include "pxr/base/arch/fileSystem.h"
+#include "pxr/base/tf/fileUtils.h"
+#include "pxr/base/work/loops.h"
 #include "pxr/usd/sdf/fileFormat.h"
 #include "pxr/usd/sdf/textFileFormat.h"
 #include "pxr/usd/usd/usdaFileFormat.h"
@@ -39,6 +42,8 @@
 #include <boost/thread.hpp>
 #include <boost/thread/shared_lock_guard.hpp>
 
+#include <cstring>
+#include <fstream>
 #include <mutex>
 
 namespace {
@@ -108,6 +113,112 @@ namespace {
     }
     return dgmod.doIt();
   }
+
+  const char* const kBase64Chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  void base64Encode(const std::string& input, std::string& output)
+  {
+    output.reserve(output.size() + ((input.size() + 2) / 3) * 4);
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(input.data());
+    size_t i = 0;
+    for(const size_t n = input.size() - input.size() % 3; i < n; i += 3)
+    {
+      const uint32_t triple = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+      output += kBase64Chars[(triple >> 18) & 0x3F];
+      output += kBase64Chars[(triple >> 12) & 0x3F];
+      output += kBase64Chars[(triple >> 6) & 0x3F];
+      output += kBase64Chars[triple & 0x3F];
+    }
+    const size_t remaining = input.size() - i;
+    if(remaining)
+    {
+      const uint32_t triple = (uint32_t(data[i]) << 16) | (remaining == 2 ? uint32_t(data[i + 1]) << 8 : 0);
+      output += kBase64Chars[(triple >> 18) & 0x3F];
+      output += kBase64Chars[(triple >> 12) & 0x3F];
+      output += remaining == 2 ? kBase64Chars[(triple >> 6) & 0x3F] : '=';
+      output += '=';
+    }
+  }
+
+  bool base64Decode(const char* input, size_t length, std::string& output)
+  {
+    static const struct DecodeTable
+    {
+      DecodeTable()
+      {
+        std::fill(std::begin(values), std::end(values), -1);
+        for(int i = 0; i < 64; ++i)
+          values[uint8_t(kBase64Chars[i])] = int8_t(i);
+      }
+      int8_t values[256];
+    } table;
+
+    output.clear();
+    output.reserve((length / 4) * 3);
+    uint32_t bits = 0;
+    int numBits = 0;
+    for(size_t i = 0; i < length; ++i)
+    {
+      const char c = input[i];
+      if(c == '=')
+        break;
+      const int8_t value = table.values[uint8_t(c)];
+      if(value < 0)
+        return false;
+      bits = (bits << 6) | uint32_t(value);
+      numBits += 6;
+      if(numBits >= 8)
+      {
+        numBits -= 8;
+        output += char((bits >> numBits) & 0xFF);
+      }
+    }
+    return true;
+  }
+
+  bool readFile(const std::string& path, std::string& contents)
+  {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if(!file)
+      return false;
+    file.seekg(0, std::ios::end);
+    contents.resize(size_t(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(&contents[0], contents.size());
+    return bool(file);
+  }
+
+  bool writeFile(const std::string& path, const std::string& contents)
+  {
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!file)
+      return false;
+    file.write(contents.data(), contents.size());
+    return bool(file);
+  }
+
+  // The crate format can only be written to (and read from) a file, so the layers are round tripped through temporary
+  // files. If anything goes wrong the layer is written as text instead, which is always readable.
+  void encodeLayer(const SdfLayerRefPtr& layer, std::string& encoded)
+  {
+    const std::string tempPath = ArchMakeTmpFileName("AL_usdmaya_layer", ".usdc");
+    std::string binary;
+    const bool exported = layer->Export(tempPath) && readFile(tempPath, binary);
+    TfDeleteFile(tempPath);
+
+    encoded.clear();
+    if(exported)
+    {
+      encoded = AL::usdmaya::nodes::LayerSerialiser::kBinaryHeader;
+      base64Encode(binary, encoded);
+    }
+    else
+    {
+      TF_DEBUG(ALUSDMAYA_LAYERS).Msg("LayerSerialiser failed to export %s as usdc, falling back to text\n",
+                                     layer->GetIdentifier().c_str());
+      layer->ExportToString(&encoded);
+    }
+  }
 }
 
 namespace AL {
@@ -253,6 +364,193 @@ void LayerDatabase::_addLayer(SdfLayerRefPtr layer, const std::string& identifie
 //----------------------------------------------------------------------------------------------------------------------
 AL_MAYA_DEFINE_NODE(LayerManager, AL_USDMAYA_LAYERMANAGER, AL_usdmaya);
 
+//----------------------------------------------------------------------------------------------------------------------
+const char* const LayerSerialiser::kBinaryHeader = "#usdc base64\n";
+
+//----------------------------------------------------------------------------------------------------------------------
+LayerSerialiser::LayerSerialiser()
+  : m_encoded(), m_importedFiles(), m_mutex(), m_layersChangedKey(), m_lastEncodeCount(0), m_changeCount(0)
+{
+  TfWeakPtr<LayerSerialiser> me(this);
+  m_layersChangedKey = TfNotice::Register(me, &LayerSerialiser::onLayersChanged);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LayerSerialiser::~LayerSerialiser()
+{
+  TfNotice::Revoke(m_layersChangedKey);
+  for(const auto& imported : m_importedFiles)
+  {
+    TfDeleteFile(imported.second);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerSerialiser::discardExpiredLayers()
+{
+  for(auto it = m_encoded.begin(); it != m_encoded.end(); )
+  {
+    if(it->first)
+      ++it;
+    else
+      it = m_encoded.erase(it);
+  }
+
+  // once the layer has gone, nothing can read from the file it was imported from
+  for(auto it = m_importedFiles.begin(); it != m_importedFiles.end(); )
+  {
+    if(it->first)
+    {
+      ++it;
+    }
+    else
+    {
+      TfDeleteFile(it->second);
+      it = m_importedFiles.erase(it);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerSerialiser::onLayersChanged(const SdfNotice::LayersDidChange& notice)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_changeCount;
+  if(m_encoded.empty())
+    return;
+  for(const SdfLayerHandle& layer : notice.GetLayers())
+  {
+    m_encoded.erase(layer);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LayerSerialiser::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_encoded.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<std::shared_ptr<const std::string>> LayerSerialiser::encode(const std::vector<SdfLayerRefPtr>& layers)
+{
+  // find the retained encodings, noting the layers that need to be encoded
+  std::vector<std::shared_ptr<const std::string>> result(layers.size());
+  std::vector<std::pair<size_t, std::shared_ptr<std::string>>> toEncode;
+  size_t changeCount;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    discardExpiredLayers();
+    for(size_t i = 0, n = layers.size(); i < n; ++i)
+    {
+      auto it = m_encoded.find(SdfLayerHandle(layers[i]));
+      if(it != m_encoded.end())
+        result[i] = it->second;
+      else
+        toEncode.emplace_back(i, std::make_shared<std::string>());
+    }
+    changeCount = m_changeCount;
+  }
+
+  TF_DEBUG(ALUSDMAYA_LAYERS).Msg("LayerSerialiser::encode encoding %zu of %zu layers\n", toEncode.size(), layers.size());
+
+  // exporting a layer does not modify it, so the layers can be written concurrently. The lock is not held here, since
+  // this thread may run other tasks while it waits, and those may send change notices.
+  WorkParallelForN(toEncode.size(), [&layers, &toEncode](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      encodeLayer(layers[toEncode[i].first], *toEncode[i].second);
+    }
+  });
+
+  // if any layer changed while they were being encoded, the new encodings may be out of date, so they are not retained
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const bool retain = (changeCount == m_changeCount);
+  for(auto& encoded : toEncode)
+  {
+    if(retain)
+      m_encoded[SdfLayerHandle(layers[encoded.first])] = encoded.second;
+    result[encoded.first] = std::move(encoded.second);
+  }
+  m_lastEncodeCount = toEncode.size();
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<bool> LayerSerialiser::decode(const std::vector<SdfLayerRefPtr>& layers, const std::vector<std::string>& serialized)
+{
+  TF_DEBUG(ALUSDMAYA_LAYERS).Msg("LayerSerialiser::decode %zu layers\n", layers.size());
+
+  // decode the binary layers into temporary usdc files on worker threads. Importing the files into the layers sends
+  // change notifications, so that part is done serially.
+  const size_t headerLength = std::strlen(kBinaryHeader);
+  std::vector<std::string> tempPaths(layers.size());
+  WorkParallelForN(layers.size(), [&](size_t begin, size_t end)
+  {
+    std::string binary;
+    for(size_t i = begin; i < end; ++i)
+    {
+      const std::string& data = serialized[i];
+      if(data.compare(0, headerLength, kBinaryHeader) != 0)
+        continue;
+
+      const std::string tempPath = ArchMakeTmpFileName("AL_usdmaya_layer", ".usdc");
+      if(base64Decode(data.data() + headerLength, data.size() - headerLength, binary) && writeFile(tempPath, binary))
+      {
+        tempPaths[i] = tempPath;
+      }
+      else
+      {
+        TfDeleteFile(tempPath);
+      }
+    }
+  });
+
+  std::vector<bool> result(layers.size(), false);
+  for(size_t i = 0, n = layers.size(); i < n; ++i)
+  {
+    const SdfLayerRefPtr& layer = layers[i];
+    const std::string& data = serialized[i];
+    if(data.compare(0, headerLength, kBinaryHeader) == 0)
+    {
+      if(!tempPaths[i].empty())
+      {
+        result[i] = layer->Import(tempPaths[i]);
+        if(!result[i])
+        {
+          TfDeleteFile(tempPaths[i]);
+          tempPaths[i].clear();
+        }
+      }
+    }
+    else
+    {
+      result[i] = layer->ImportFromString(data);
+    }
+  }
+
+  // the layers have not been edited since they were serialized, so the binary data can be written out again as is
+  // (this is done after importing, as the import sends a notification that discards any retained encoding)
+  std::lock_guard<std::mutex> lock(m_mutex);
+  discardExpiredLayers();
+  for(size_t i = 0, n = layers.size(); i < n; ++i)
+  {
+    if(tempPaths[i].empty())
+      continue;
+
+    const SdfLayerHandle layer(layers[i]);
+    m_encoded[layer] = std::make_shared<const std::string>(serialized[i]);
+
+    // the layer may still read from the file it was imported from, so it is deleted when the layer is
+    std::string& importedFile = m_importedFiles[layer];
+    if(!importedFile.empty())
+      TfDeleteFile(importedFile);
+    importedFile = std::move(tempPaths[i]);
+  }
+  return result;
+}
+
 // serialization
 MObject LayerManager::m_layers = MObject::kNullObj;
 MObject LayerManager::m_identifier = MObject::kNullObj;
@@ -437,17 +735,21 @@ MStatus LayerManager::populateSerialisationAttributes()
     boost::shared_lock_guard<boost::shared_mutex> lock(m_layersMutex);
     MArrayDataBuilder builder(&dataBlock, layers(), m_layerDatabase.max_size(), &status);
     AL_MAYA_CHECK_ERROR(status, errorString);
-    std::string temp;
+    std::vector<SdfLayerRefPtr> managedLayers;
     for (const auto& layerAndIds : m_layerDatabase)
     {
-      auto& layer = layerAndIds.first;
+      managedLayers.push_back(layerAndIds.first);
+    }
+    const std::vector<std::shared_ptr<const std::string>> serialized = m_serialiser.encode(managedLayers);
+    for (size_t i = 0, n = managedLayers.size(); i < n; ++i)
+    {
+      auto& layer = managedLayers[i];
       MDataHandle layersElemHandle = builder.addLast(&status);
       AL_MAYA_CHECK_ERROR(status, errorString);
       MDataHandle idHandle = layersElemHandle.child(m_identifier);
       idHandle.setString(AL::maya::utils::convert(layer->GetIdentifier()));
       MDataHandle serializedHandle = layersElemHandle.child(m_serialized);
-      layer->ExportToString(&temp);
-      serializedHandle.setString(AL::maya::utils::convert(temp));
+      serializedHandle.setString(AL::maya::utils::convert(*serialized[i]));
       MDataHandle anonHandle = layersElemHandle.child(m_anonymous);
       anonHandle.setBool(layer->IsAnonymous());
     }
@@ -496,6 +798,9 @@ void LayerManager::loadAllLayers()
   std::string identifierVal;
   std::string serializedVal;
   SdfLayerRefPtr layer;
+  std::vector<SdfLayerRefPtr> loadedLayers;
+  std::vector<std::string> loadedIdentifiers;
+  std::vector<std::string> loadedSerialized;
   // We DON'T want to use evaluate num elements, because we don't want to trigger
   // a compute - we want the value(s) as read from the file!
   const unsigned int numElements = allLayersPlug.numElements();
@@ -583,14 +888,23 @@ void LayerManager::loadAllLayers()
         serializedVal.c_str(),
         serializedVal.length() > MAX_LAYER_CHARS ? "<truncated>\n" : ""
         );
-    if(!layer->ImportFromString(serializedVal))
+    loadedLayers.push_back(layer);
+    loadedIdentifiers.push_back(identifierVal);
+    loadedSerialized.push_back(std::move(serializedVal));
+  }
+
+  // the binary layers are decoded concurrently, so import all of the layers in one go
+  const std::vector<bool> imported = m_serialiser.decode(loadedLayers, loadedSerialized);
+  for(size_t i = 0, n = loadedLayers.size(); i < n; ++i)
+  {
+    if(!imported[i])
     {
       TF_DEBUG(ALUSDMAYA_LAYERS).Msg("...layer import failed!\n");
-      MGlobal::displayError(MString("Failed to import serialized layer: ") + serializedVal.c_str());
+      MGlobal::displayError(MString("Failed to import serialized layer: ") + loadedIdentifiers[i].c_str());
       continue;
     }
     TF_DEBUG(ALUSDMAYA_LAYERS).Msg("...layer import succeeded!\n");
-    addLayer(layer, identifierVal);
+    addLayer(loadedLayers[i], loadedIdentifiers[i]);
   }
 }
 
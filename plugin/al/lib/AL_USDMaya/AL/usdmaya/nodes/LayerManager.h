@@ -19,6 +19,9 @@
 
 #include "AL/maya/utils/NodeHelper.h"
 #include "pxr/pxr.h"
+#include "pxr/base/tf/hash.h"
+#include "pxr/base/tf/weakBase.h"
+#include "pxr/usd/sdf/notice.h"
 #include "pxr/usd/usd/stage.h"
 
 #include "maya/MPxLocatorNode.h"
@@ -27,7 +30,10 @@
 
 #include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 #include <boost/thread.hpp>
 
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -224,6 +230,75 @@ private:
   IdToLayerMap m_idToLayer;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Converts layers to and from the strings stored in the LayerManager's serialized attribute.
+///
+///         Layers are written in the binary (crate) usdc format, which is base64 encoded so that it can be held in a
+///         string attribute. The encoded form of each layer is retained between saves, and is discarded when the layer
+///         is edited (via SdfNotice::LayersDidChange), so a save only re-encodes the layers that have changed since the
+///         last one. Encoding, and the first stage of decoding, are distributed across worker threads. Layers that were
+///         serialized as text (by older versions of the plugin) can still be decoded.
+///
+///         The crate format may read the values of a layer lazily from its file, so the temporary files that binary
+///         layers are imported from are kept until the layer is destroyed (or decoded again).
+/// \ingroup nodes
+//----------------------------------------------------------------------------------------------------------------------
+class LayerSerialiser
+  : public TfWeakBase
+{
+public:
+
+  /// the header that starts the serialized form of a binary layer
+  AL_USDMAYA_PUBLIC
+  static const char* const kBinaryHeader;
+
+  /// \brief  ctor
+  AL_USDMAYA_PUBLIC
+  LayerSerialiser();
+
+  /// \brief  dtor
+  AL_USDMAYA_PUBLIC
+  ~LayerSerialiser();
+
+  /// \brief  returns the serialized form of each of the layers, encoding any that have changed since they were last
+  ///         encoded (or decoded).
+  /// \param  layers the layers to encode
+  /// \return the serialized layers, in the same order as the layers. The strings are shared with the retained
+  ///         encodings, and remain valid after those are discarded.
+  AL_USDMAYA_PUBLIC
+  std::vector<std::shared_ptr<const std::string>> encode(const std::vector<SdfLayerRefPtr>& layers);
+
+  /// \brief  replaces the contents of each layer with its serialized form.
+  /// \param  layers the layers to import the data into
+  /// \param  serialized the serialized form of each layer, in either the binary or the text format
+  /// \return true for each layer that was decoded successfully
+  AL_USDMAYA_PUBLIC
+  std::vector<bool> decode(const std::vector<SdfLayerRefPtr>& layers, const std::vector<std::string>& serialized);
+
+  /// \brief  discards all of the retained encodings
+  AL_USDMAYA_PUBLIC
+  void clear();
+
+  /// \brief  returns the number of layers whose encodings are retained
+  inline size_t size() const
+    { std::lock_guard<std::mutex> lock(m_mutex); return m_encoded.size(); }
+
+  /// \brief  returns the number of layers encoded by the last call to encode, i.e. the number that were not retained
+  inline size_t lastEncodeCount() const
+    { std::lock_guard<std::mutex> lock(m_mutex); return m_lastEncodeCount; }
+
+private:
+  void onLayersChanged(const SdfNotice::LayersDidChange& notice);
+  void discardExpiredLayers();
+
+  std::unordered_map<SdfLayerHandle, std::shared_ptr<const std::string>, TfHash> m_encoded;
+  std::unordered_map<SdfLayerHandle, std::string, TfHash> m_importedFiles;
+  mutable std::mutex m_mutex;
+  TfNotice::Key m_layersChangedKey;
+  size_t m_lastEncodeCount;
+  size_t m_changeCount;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  The layer manager node handles serialization and deserialization of all layers used by all ProxyShapes
 ///         It may temporarily contain non-dirty layers, but those will be filtered out by query operations.
@@ -306,6 +381,7 @@ public:
   void getLayerIdentifiers(MStringArray& outputNames);
 
   /// \brief  Ensures that the layers attribute will be filled out with serialized versions of all tracked layers.
+  ///         Only the layers that have been edited since the previous call are re-encoded.
   AL_USDMAYA_PUBLIC
   MStatus populateSerialisationAttributes();
 
@@ -317,6 +393,10 @@ public:
   AL_USDMAYA_PUBLIC
   void loadAllLayers();
 
+  /// \brief  returns the serialiser that converts the layers to and from the serialized attribute
+  inline LayerSerialiser& serialiser()
+    { return m_serialiser; }
+
   //--------------------------------------------------------------------------------------------------------------------
   /// Type Info & Registration
   //--------------------------------------------------------------------------------------------------------------------
@@ -351,6 +431,7 @@ private:
   static MObject _findNode();
 
   LayerDatabase m_layerDatabase;
+  LayerSerialiser m_serialiser;
 
   // Note on layerManager / multithreading:
   // I don't know that layerManager will be used in a multihreaded manenr... but I also don't know it COULDN'T be.
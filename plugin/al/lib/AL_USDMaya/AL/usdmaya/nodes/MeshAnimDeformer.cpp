@@ -19,10 +19,14 @@
 #include "AL/usdmaya/nodes/ProxyShape.h"
 #include "AL/usdmaya/StageData.h"
 #include "AL/usdmaya/utils/Utils.h"
+#include "AL/usd/utils/SIMD.h"
 
 #include "maya/MFnMesh.h"
 #include "pxr/usd/usdGeom/mesh.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
@@ -64,6 +68,154 @@ MStatus MeshAnimDeformer::initialise()
   return MS::kSuccess;
 }
 
+namespace {
+//----------------------------------------------------------------------------------------------------------------------
+/// output = a + (b - a) * t, for count floats
+void lerpFloats(float* const output, const float* const a, const float* const b, const float t, const size_t count)
+{
+  size_t i = 0;
+  #if defined(__SSE__)
+  const f128 t4 = splat4f(t);
+  for(; i + 4 <= count; i += 4)
+  {
+    const f128 a4 = loadu4f(a + i);
+    const f128 b4 = loadu4f(b + i);
+    storeu4f(output + i, add4f(a4, mul4f(sub4f(b4, a4), t4)));
+  }
+  #endif
+  for(; i < count; ++i)
+  {
+    output[i] = a[i] + (b[i] - a[i]) * t;
+  }
+}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::AnimatedAttributeCache::reset(const UsdAttribute& attribute)
+{
+  query = attribute ? UsdAttributeQuery(attribute) : UsdAttributeQuery();
+  animated = query.IsValid() && query.ValueMightBeTimeVarying();
+  lowerTime = std::numeric_limits<double>::quiet_NaN();
+  upperTime = std::numeric_limits<double>::quiet_NaN();
+  lower = VtArray<GfVec3f>();
+  upper = VtArray<GfVec3f>();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool MeshAnimDeformer::AnimatedAttributeCache::evaluate(UsdTimeCode time, float* const output, const size_t count)
+{
+  if(!animated)
+  {
+    return false;
+  }
+
+  const double t = time.GetValue();
+  double lo, hi;
+  bool hasTimeSamples = false;
+  if(!query.GetBracketingTimeSamples(t, &lo, &hi, &hasTimeSamples) || !hasTimeSamples)
+  {
+    return false;
+  }
+
+  // when stepping forwards through the frames, the previous upper sample becomes the new lower sample
+  if(lo != lowerTime)
+  {
+    if(lo == upperTime)
+    {
+      lower = upper;
+    }
+    else
+    {
+      query.Get(&lower, UsdTimeCode(lo));
+    }
+    lowerTime = lo;
+  }
+
+  const size_t numFloats = std::min(count, lower.size() * 3);
+  const float* const lowerData = reinterpret_cast<const float*>(lower.cdata());
+  // the interpolation type of the stage may be changed at any time, so is checked on each evaluation
+  const bool held = query.GetAttribute().GetStage()->GetInterpolationType() == UsdInterpolationTypeHeld;
+  if(hi == lo || t <= lo || held)
+  {
+    std::memcpy(output, lowerData, sizeof(float) * numFloats);
+    return true;
+  }
+
+  if(hi != upperTime)
+  {
+    query.Get(&upper, UsdTimeCode(hi));
+    upperTime = hi;
+  }
+
+  if(upper.size() != lower.size())
+  {
+    // USD holds the lower sample if the array sizes differ, so do the same
+    std::memcpy(output, lowerData, sizeof(float) * numFloats);
+    return true;
+  }
+
+  const float alpha = float((t - lo) / (hi - lo));
+  lerpFloats(output, lowerData, reinterpret_cast<const float*>(upper.cdata()), alpha, numFloats);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::resolveQueries(const UsdStageRefPtr& stage, const SdfPath& primPath)
+{
+  TF_DEBUG(ALUSDMAYA_GEOMETRY_DEFORMER).Msg("MeshAnimDeformer::resolveQueries %s\n", primPath.GetText());
+  if(m_resolvedStage != UsdStageWeakPtr(stage))
+  {
+    TfNotice::Revoke(m_objectsChangedNoticeKey);
+    TfWeakPtr<MeshAnimDeformer> me(this);
+    m_objectsChangedNoticeKey = TfNotice::Register(me, &MeshAnimDeformer::onObjectsChanged, UsdStageWeakPtr(stage));
+    m_resolvedStage = stage;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_resolvedPathMutex);
+    m_resolvedPath = primPath;
+  }
+
+  // any change notified while the queries are being resolved will dirty them again
+  m_queriesDirty = false;
+
+  UsdGeomMesh mesh(stage->GetPrimAtPath(primPath));
+  m_points.reset(mesh ? mesh.GetPointsAttr() : UsdAttribute());
+  m_normals.reset(mesh ? mesh.GetNormalsAttr() : UsdAttribute());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshAnimDeformer::onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdStageWeakPtr const& sender)
+{
+  // any change to the prim (or its ancestors) may change where the points and normals are resolved from
+  SdfPath resolvedPath;
+  {
+    std::lock_guard<std::mutex> lock(m_resolvedPathMutex);
+    resolvedPath = m_resolvedPath;
+  }
+  auto affectsPrim = [&resolvedPath](const SdfPath& path)
+  {
+    const SdfPath primPath = path.GetPrimPath();
+    return primPath.HasPrefix(resolvedPath) || resolvedPath.HasPrefix(primPath);
+  };
+
+  for(const SdfPath& path : notice.GetResyncedPaths())
+  {
+    if(affectsPrim(path))
+    {
+      m_queriesDirty = true;
+      return;
+    }
+  }
+  for(const SdfPath& path : notice.GetChangedInfoOnlyPaths())
+  {
+    if(affectsPrim(path))
+    {
+      m_queriesDirty = true;
+      return;
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus MeshAnimDeformer::compute(const MPlug& plug, MDataBlock& data)
 {
@@ -83,37 +235,40 @@ MStatus MeshAnimDeformer::compute(const MPlug& plug, MDataBlock& data)
 
   MObject obj = inputHandle.asMesh();
 
-  UsdStageRefPtr stage = getStage();
+  // read the stage and prim path from the data block rather than from the proxy shape, so that this node does not
+  // touch any other node when evaluated in parallel.
+  UsdStageRefPtr stage;
+  StageData* stageData = inputDataValue<StageData>(data, m_inStageData);
+  if(stageData && stageData->stage)
+  {
+    stage = stageData->stage;
+  }
+  else
+  {
+    stage = getStage();
+  }
+
+  const MString primPathStr = inputStringValue(data, m_primPath);
+  const SdfPath primPath = primPathStr.length() ? SdfPath(AL::maya::utils::convert(primPathStr)) : m_cachePath;
+
   if(stage)
   {
-    UsdPrim prim = stage->GetPrimAtPath(m_cachePath);
-    UsdGeomMesh mesh(prim);
+    if(m_queriesDirty || m_resolvedStage != UsdStageWeakPtr(stage) || m_resolvedPath != primPath)
+    {
+      resolveQueries(stage, primPath);
+    }
 
     MFnMesh fnMesh(obj);
     float* const ptr = (float*)fnMesh.getRawPoints(&status);
     if(ptr)
     {
-      UsdAttribute points = mesh.GetPointsAttr();
-      if(points.GetNumTimeSamples() > 1)
-      {
-        VtArray<GfVec3f> pointData;
-        points.Get(&pointData, usdTime);
-        const size_t numPoints = pointData.size();
-        std::memcpy(ptr, pointData.cdata(), sizeof(float) * 3 * numPoints);
-      }
+      m_points.evaluate(usdTime, ptr, size_t(fnMesh.numVertices()) * 3);
     }
 
     float* const nptr = (float*)fnMesh.getRawNormals(&status);
     if(nptr)
     {
-      UsdAttribute normals = mesh.GetNormalsAttr();
-      if(normals.GetNumTimeSamples() > 1)
-      {
-        VtArray<GfVec3f> normalData;
-        normals.Get(&normalData, usdTime);
-        const size_t numNormals = normalData.size();
-        std::memcpy(nptr, normalData.cdata(), sizeof(float) * 3 * numNormals);
-      }
+      m_normals.evaluate(usdTime, nptr, size_t(fnMesh.numNormals()) * 3);
     }
     outputHandle.set(obj);
   }
@@ -19,11 +19,21 @@
 #include "AL/maya/utils/MayaHelperMacros.h"
 #include "AL/usdmaya/utils/ForwardDeclares.h"
 #include "pxr/pxr.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/base/tf/notice.h"
+#include "pxr/base/tf/weakBase.h"
+#include "pxr/base/vt/array.h"
+#include "pxr/usd/usd/attributeQuery.h"
+#include "pxr/usd/usd/notice.h"
 #include "pxr/usd/usd/stage.h"
 #include "maya/MPxNode.h"
 #include "maya/MObjectHandle.h"
 #include "maya/MNodeMessage.h"
 
+#include <atomic>
+#include <limits>
+#include <mutex>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace AL {
@@ -31,12 +41,19 @@ namespace usdmaya {
 namespace nodes {
 
 //----------------------------------------------------------------------------------------------------------------------
-/// \brief   This node is a simple deformer that modifies 
+/// \brief   This node is a simple deformer that modifies the points and normals of the input mesh to match the
+///          animated points and normals of a UsdGeomMesh.
+///
+///          The attribute queries for the points and normals are resolved once, and the time samples either side of
+///          the last evaluated time are retained, so that consecutive frames and subframes between the same samples do
+///          not need to re-read the attributes from USD. Subframes are interpolated by the node itself. The stage is
+///          read through the inStageData attribute, so the node can be evaluated in parallel.
 /// \ingroup nodes
 //----------------------------------------------------------------------------------------------------------------------
 class MeshAnimDeformer
   : public MPxNode,
-    public AL::maya::utils::NodeHelper
+    public AL::maya::utils::NodeHelper,
+    public TfWeakBase
 {
 public:
 
@@ -46,7 +63,10 @@ public:
      {}
 
   inline ~MeshAnimDeformer()
-    { MNodeMessage::removeCallback(m_attributeChanged); }
+  {
+    MNodeMessage::removeCallback(m_attributeChanged);
+    TfNotice::Revoke(m_objectsChangedNoticeKey);
+  }
 
   //--------------------------------------------------------------------------------------------------------------------
   /// Type Info & Registration
@@ -63,7 +83,38 @@ public:
   AL_DECL_ATTRIBUTE(inMesh);
   AL_DECL_ATTRIBUTE(outMesh);
 
+  /// \brief  Enable parallel evaluation
+  /// \return MPxNode::kParallel
+  MPxNode::SchedulingType schedulingType() const override
+    { return kParallel; }
+
 private:
+  /// \brief  Caches the time samples of an animated GfVec3f array attribute either side of the last time evaluated.
+  struct AnimatedAttributeCache
+  {
+    /// \brief  resolves the query for the attribute, and discards any cached samples
+    void reset(const UsdAttribute& attribute);
+
+    /// \brief  writes the value of the attribute at the specified time into the output buffer. If the time lies
+    ///         between two samples, the result is linearly interpolated, or the lower sample is held if the stage uses
+    ///         held interpolation.
+    /// \param  time the time to evaluate the attribute at
+    /// \param  output the buffer to write the (x, y, z) float triples to
+    /// \param  count the number of floats the output buffer can hold
+    /// \return false if the attribute is not animated (in which case nothing is written), true otherwise
+    bool evaluate(UsdTimeCode time, float* output, size_t count);
+
+    UsdAttributeQuery query;
+    bool animated = false;
+    double lowerTime = std::numeric_limits<double>::quiet_NaN();
+    double upperTime = std::numeric_limits<double>::quiet_NaN();
+    VtArray<GfVec3f> lower;
+    VtArray<GfVec3f> upper;
+  };
+
+  void onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdStageWeakPtr const& sender);
+  void resolveQueries(const UsdStageRefPtr& stage, const SdfPath& primPath);
+
   void postConstructor() override;
   MStatus connectionMade(const MPlug& plug, const MPlug& otherPlug, bool asSrc) override;
   MStatus connectionBroken(const MPlug& plug, const MPlug& otherPlug, bool asSrc) override;
@@ -74,6 +125,16 @@ private:
   SdfPath m_cachePath;
   MObjectHandle proxyShapeHandle;
   MCallbackId m_attributeChanged = 0;
+
+  // the stage and prim path the queries were resolved against. The path is read by the change notices, which may be
+  // sent while the node is being computed, so it is written under the mutex.
+  UsdStageWeakPtr m_resolvedStage;
+  SdfPath m_resolvedPath;
+  std::mutex m_resolvedPathMutex;
+  AnimatedAttributeCache m_points;
+  AnimatedAttributeCache m_normals;
+  TfNotice::Key m_objectsChangedNoticeKey;
+  std::atomic<bool> m_queriesDirty{true};
 };
 
 //----------------------------------------------------------------------------------------------------------------------
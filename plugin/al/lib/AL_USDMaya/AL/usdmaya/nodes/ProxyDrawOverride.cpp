@@ -20,6 +20,7 @@
 #include "AL/usdmaya/DebugCodes.h"
 
 
+#include "pxr/base/gf/vec4d.h"
 #include "pxr/base/tf/envSetting.h"
 
 #include "maya/MFnDagNode.h"
@@ -30,6 +31,8 @@
 #include "maya/M3dView.h"
 #include "maya/MSelectionContext.h"
 
+#include <algorithm>
+
 #if defined(WANT_UFE_BUILD)
 #include "AL/usdmaya/TypeIDs.h"
 #include "pxr/base/arch/env.h"
@@ -538,43 +541,112 @@ bool ProxyDrawOverride::userSelect(
     projectionMatrix *= pickMatrix;
   }
 
-  // Get world to local matrix
-  MMatrix invMatrix = objPath.inclusiveMatrixInverse();
-  GfMatrix4d worldToLocalSpace(invMatrix.matrix);
-
-  UsdImagingGLRenderParams params;
-
   auto* proxyShape = static_cast<ProxyShape*>(getShape(objPath));
   auto engine = proxyShape->engine();
   proxyShape->m_pleaseIgnoreSelection = true;
 
-  UsdPrim root = proxyShape->getUsdStage()->GetPseudoRoot();
-
   Engine::HitBatch hitBatch;
-  SdfPathVector rootPath;
-  rootPath.push_back(root.GetPath());
+  bool hitSelected = false;
 
-  int resolution = 10;
-  MGlobal::getOptionVarValue("AL_usdmaya_selectResolution", resolution);
-  if (resolution < 10) { resolution = 10; }
-  if (resolution > 1024) { resolution = 1024; }
+  // By default the intersections are computed on the CPU. Setting the optionVar to 1 will render the selection
+  // through the GL engine instead.
+  const bool useGLEngine = MGlobal::optionVarIntValue("AL_usdmaya_selectEngine") == 1 && engine;
+  if(!useGLEngine)
+  {
+    MMatrix viewMatrix = context.getMatrix(MHWRender::MFrameContext::kViewMtx, &status);
+    if (status != MStatus::kSuccess) return false;
 
+    const GfMatrix4d localToWorld(objPath.inclusiveMatrix().matrix);
+    const GfMatrix4d localToClip = localToWorld * GfMatrix4d(viewMatrix.matrix) * GfMatrix4d(projectionMatrix.matrix);
+    const proxy::IntersectionEngine& intersector = proxyShape->intersectionEngine();
 
-  bool hitSelected = engine->TestIntersectionBatch(
-          GfMatrix4d(worldViewMatrix.matrix),
-          GfMatrix4d(projectionMatrix.matrix),
-          worldToLocalSpace,
-          rootPath,
-          params,
-          resolution,
-          ProxyDrawOverrideSelectionHelper::path_ting,
-          &hitBatch);
+    auto addHit = [&hitBatch, &localToWorld](const proxy::IntersectionEngine::Hit& hit)
+    {
+      Engine::HitInfo& info = hitBatch[hit.path];
+      info.worldSpaceHitPoint = localToWorld.Transform(hit.point);
+      info.hitInstanceIndex = -1;
+    };
+
+    // for a single selection, cast a ray through the centre of the pick region (which the pick matrix maps to the
+    // centre of clip space). If that misses, fall back to the prim found within the pick region that is closest to
+    // the camera.
+    proxy::IntersectionEngine::Hit rayHit;
+    const GfMatrix4d clipToLocal = localToClip.GetInverse();
+    const GfVec3d nearPoint = clipToLocal.Transform(GfVec3d(0.0, 0.0, -1.0));
+    const GfVec3d farPoint = clipToLocal.Transform(GfVec3d(0.0, 0.0, 1.0));
+    if(selectInfo.singleSelection() && intersector.intersectRay(GfRay(nearPoint, farPoint - nearPoint), &rayHit))
+    {
+      addHit(rayHit);
+    }
+    else
+    {
+      std::vector<proxy::IntersectionEngine::Hit> volumeHits;
+      intersector.intersectVolume(localToClip, volumeHits);
+      if(selectInfo.singleSelection())
+      {
+        // the depth of each hit in clip space (the points lie within the volume, so w is positive)
+        auto depth = [&localToClip](const proxy::IntersectionEngine::Hit& hit)
+        {
+          const GfVec4d p = GfVec4d(hit.point[0], hit.point[1], hit.point[2], 1.0) * localToClip;
+          return p[2] / p[3];
+        };
+        auto nearest = std::min_element(volumeHits.begin(), volumeHits.end(),
+            [&depth](const proxy::IntersectionEngine::Hit& a, const proxy::IntersectionEngine::Hit& b)
+            { return depth(a) < depth(b); });
+        if(nearest != volumeHits.end())
+        {
+          addHit(*nearest);
+        }
+      }
+      else
+      {
+        for(const auto& hit : volumeHits)
+        {
+          addHit(hit);
+        }
+      }
+    }
+    hitSelected = !hitBatch.empty();
+  }
+  else
+  {
+    // Get world to local matrix
+    MMatrix invMatrix = objPath.inclusiveMatrixInverse();
+    GfMatrix4d worldToLocalSpace(invMatrix.matrix);
+
+    UsdImagingGLRenderParams params;
+
+    UsdPrim root = proxyShape->getUsdStage()->GetPseudoRoot();
+
+    SdfPathVector rootPath;
+    rootPath.push_back(root.GetPath());
+
+    int resolution = 10;
+    MGlobal::getOptionVarValue("AL_usdmaya_selectResolution", resolution);
+    if (resolution < 10) { resolution = 10; }
+    if (resolution > 1024) { resolution = 1024; }
+
+    hitSelected = engine->TestIntersectionBatch(
+            GfMatrix4d(worldViewMatrix.matrix),
+            GfMatrix4d(projectionMatrix.matrix),
+            worldToLocalSpace,
+            rootPath,
+            params,
+            resolution,
+            ProxyDrawOverrideSelectionHelper::path_ting,
+            &hitBatch);
+  }
 
   auto selected = false;
 
-  auto getHitPath = [&engine] (Engine::HitBatch::const_reference& it) -> SdfPath
+  auto getHitPath = [&engine, useGLEngine] (Engine::HitBatch::const_reference& it) -> SdfPath
   {
     const Engine::HitInfo& hit = it.second;
+    if (!useGLEngine)
+    {
+      // the CPU engine returns the paths of the prims (or instance proxies) directly
+      return it.first;
+    }
     auto path = engine->GetPrimPathFromInstanceIndex(it.first, hit.hitInstanceIndex);
     if (!path.IsEmpty())
     {
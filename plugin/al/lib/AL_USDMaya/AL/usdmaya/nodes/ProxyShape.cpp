@@ -70,6 +70,7 @@ typedef boost::filesystem::path path;
 #include "pxr/base/arch/systemInfo.h"
 #include "pxr/base/tf/fileUtils.h"
 #include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/usd/primRange.h"
 #include "pxr/usd/usd/stageCacheContext.h"
 #include "pxr/usdImaging/usdImaging/primAdapter.h"
 #include "pxr/usdImaging/usdImaging/meshAdapter.h"
@@ -612,100 +613,117 @@ ProxyShape::ProxyShape()
 
   registerEvents();
 
-  m_findExcludedPrims.preIteration = [this]() {
-    m_excludedTaggedGeometry.clear();
+  m_findExcludedPrims.preIteration = [this](const SdfPath& rootPath) {
+    m_findExcludedPrims.rootPath = rootPath;
+    m_excludedTaggedGeometry.erase(
+        std::remove_if(m_excludedTaggedGeometry.begin(), m_excludedTaggedGeometry.end(),
+                       [&rootPath](const SdfPath& path) { return path.HasPrefix(rootPath); }),
+        m_excludedTaggedGeometry.end());
   };
-  m_findExcludedPrims.iteration = [this]( const fileio::TransformIterator& transformIterator,
-                                          const UsdPrim& prim) {
-
+  m_findExcludedPrims.iteration = [this](const UsdPrim& prim) {
     bool excludeGeo = false;
-    if(prim.GetMetadata(Metadata::excludeFromProxyShape, &excludeGeo))
+    if(prim.GetMetadata(Metadata::excludeFromProxyShape, &excludeGeo) && excludeGeo)
+    {
+      m_findExcludedPrims.excludedPrims.local().push_back(prim.GetPrimPath());
+    }
+  };
+  m_findExcludedPrims.postIteration = [this]() {
+    SdfPathVector excludedPrims;
+    for(auto& found : m_findExcludedPrims.excludedPrims)
+    {
+      excludedPrims.insert(excludedPrims.end(), found.begin(), found.end());
+      found.clear();
+    }
+    std::sort(excludedPrims.begin(), excludedPrims.end());
+
+    // If the root of the search is itself a descendant of a previously excluded prim, everything beneath it needs
+    // tagging. Otherwise only the subtrees of the tagged prims we have just found need to be visited.
+    SdfPathVector excludedRoots;
+    UsdPrim root = m_stage->GetPrimAtPath(m_findExcludedPrims.rootPath);
+    if(primHasExcludedParent(root))
     {
-      if (excludeGeo)
+      excludedRoots.push_back(m_findExcludedPrims.rootPath);
+    }
+    else
+    {
+      for(const SdfPath& path : excludedPrims)
       {
-        m_excludedTaggedGeometry.push_back(prim.GetPrimPath());
+        if(excludedRoots.empty() || !path.HasPrefix(excludedRoots.back()))
+        {
+          excludedRoots.push_back(path);
+        }
       }
     }
+    m_excludedTaggedGeometry.insert(m_excludedTaggedGeometry.end(), excludedPrims.begin(), excludedPrims.end());
 
     // If prim has exclusion tag or is a descendent of a prim with it, create as Maya geo
-    if (excludeGeo || primHasExcludedParent(prim))
+    const VtValue schemaName(fileio::ALExcludedPrimSchema.GetString());
+    for(const SdfPath& path : excludedRoots)
     {
-      VtValue schemaName(fileio::ALExcludedPrimSchema.GetString());
-      prim.SetCustomDataByKey(fileio::ALSchemaType, schemaName);
+      UsdPrim excludedRoot = m_stage->GetPrimAtPath(path);
+      if(!excludedRoot)
+        continue;
+      for(UsdPrim prim : UsdPrimRange(excludedRoot))
+      {
+        prim.SetCustomDataByKey(fileio::ALSchemaType, schemaName);
+      }
     }
-  };
-  m_findExcludedPrims.postIteration = [this]() {
     constructExcludedPrims();
   };
 
-  m_findUnselectablePrims.preIteration = [this]() {
-
+  // The selectability and lock logics read the states of the prims from m_inheritedStateCache, which is resolved
+  // (serially, in a single top down pass) before the concurrent iteration begins. Resolving a hierarchy that has
+  // already been resolved does not re-read any metadata, so it does not matter which of the logics does it first.
+  m_findUnselectablePrims.preIteration = [this](const SdfPath& rootPath) {
+    m_selectabilityDB.removeHierarchyAsUnselectable(rootPath);
+    m_inheritedStateCache.resolve(m_stage->GetPrimAtPath(rootPath));
   };
-  m_findUnselectablePrims.iteration = [this]
-                                    (const fileio::TransformIterator& transformIterator, const UsdPrim& prim) {
-
-    TfToken selectabilityPropertyToken;
-    if(prim.GetMetadata<TfToken>(Metadata::selectability, &selectabilityPropertyToken))
+  m_findUnselectablePrims.iteration = [this](const UsdPrim& prim) {
+    if(m_inheritedStateCache.find(prim) & proxy::InheritedStateCache::kAuthoredUnselectable)
     {
-
-      //Check if this prim is unselectable
-      if(selectabilityPropertyToken == Metadata::unselectable)
-      {
-        m_findUnselectablePrims.newUnselectables.push_back(prim.GetPath());
-      }
-      else if(m_selectabilityDB.isPathUnselectable(prim.GetPath()) && selectabilityPropertyToken != Metadata::unselectable)
-      {
-        m_findUnselectablePrims.removeUnselectables.push_back(prim.GetPath());
-      }
+      m_findUnselectablePrims.newUnselectables.local().push_back(prim.GetPath());
     }
   };
   m_findUnselectablePrims.postIteration = [this]() {
-    if(m_findUnselectablePrims.removeUnselectables.size() > 0)
+    SdfPathVector newUnselectables;
+    for(auto& found : m_findUnselectablePrims.newUnselectables)
     {
-      m_selectabilityDB.removePathsAsUnselectable(m_findUnselectablePrims.removeUnselectables);
+      newUnselectables.insert(newUnselectables.end(), found.begin(), found.end());
+      found.clear();
     }
 
-    if(m_findUnselectablePrims.newUnselectables.size() > 0)
+    if(newUnselectables.size() > 0)
     {
-      m_selectabilityDB.addPathsAsUnselectable(m_findUnselectablePrims.newUnselectables);
+      m_selectabilityDB.addPathsAsUnselectable(newUnselectables);
     }
-
-    m_findUnselectablePrims.newUnselectables.clear();
-    m_findUnselectablePrims.removeUnselectables.clear();
   };
 
-  m_findLockedPrims.preIteration = [this]() {
-    this->m_lockTransformPrims.clear();
-    this->m_lockInheritedPrims.clear();
+  m_findLockedPrims.preIteration = [this](const SdfPath& rootPath) {
+    auto range = SdfPathFindPrefixedRange(m_lockTransformPrims.begin(), m_lockTransformPrims.end(), rootPath);
+    m_lockTransformPrims.erase(range.first, range.second);
+    m_inheritedStateCache.resolve(m_stage->GetPrimAtPath(rootPath));
   };
-  m_findLockedPrims.iteration = [this] ( const fileio::TransformIterator& transformIterator,
-                                         const UsdPrim& prim)
+  m_findLockedPrims.iteration = [this](const UsdPrim& prim)
   {
-    TfToken lockPropertyToken;
-    if (prim.GetMetadata<TfToken>(Metadata::locked, & lockPropertyToken))
-    {
-      if (lockPropertyToken == Metadata::lockTransform)
-      {
-        this->m_lockTransformPrims.insert(prim.GetPath());
-      }
-      else if (lockPropertyToken == Metadata::lockInherited)
-      {
-        this->m_lockInheritedPrims.insert(prim.GetPath());
-      }
-    }
-    else
+    if(m_inheritedStateCache.find(prim) & proxy::InheritedStateCache::kTransformLocked)
     {
-      this->m_lockInheritedPrims.insert(prim.GetPath());
+      m_findLockedPrims.lockTransformPrims.local().push_back(prim.GetPath());
     }
-
   };
   m_findLockedPrims.postIteration = [this]() {
+    for(auto& found : m_findLockedPrims.lockTransformPrims)
+    {
+      this->m_lockTransformPrims.insert(found.begin(), found.end());
+      found.clear();
+    }
     constructLockPrims();
   };
 
-  m_hierarchyIterationLogics[0] = &m_findExcludedPrims;
-  m_hierarchyIterationLogics[1] = &m_findUnselectablePrims;
-  m_hierarchyIterationLogics[2] = &m_findLockedPrims;
+  m_hierarchyIterationLogics = {
+    &m_findExcludedPrims,
+    &m_findUnselectablePrims,
+    &m_findLockedPrims
+  };
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1033,6 +1051,13 @@ void ProxyShape::onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdSt
 
   TF_DEBUG(ALUSDMAYA_EVENTS).Msg("ProxyShape::onObjectsChanged called m_compositionHasChanged=%i\n", m_compositionHasChanged);
 
+  m_boundingBoxCache.invalidate(notice);
+  m_intersectionEngine.invalidate(notice);
+  m_transformSampleCache.invalidate();
+
+  SdfPathVector stateChangedPaths;
+  m_inheritedStateCache.invalidate(notice, stateChangedPaths);
+
   // These paths are subtree-roots representing entire subtrees that may have
   // changed. In this case, we must dump all cached data below these points
   // and repopulate those trees.
@@ -1049,94 +1074,7 @@ void ProxyShape::onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdSt
     AL::usdmaya::Profiler::printReport(strstr);
   }
 
-  SdfPathVector newUnselectables;
-  SdfPathVector removeUnselectables;
-  auto recordSelectablePrims = [&newUnselectables, &removeUnselectables, this](const UsdPrim& prim){
-    if(!prim.IsValid())
-    {
-      return;
-    }
-
-    TfToken unselectablePropertyValue;
-    if(prim.GetMetadata(Metadata::selectability, &unselectablePropertyValue))
-    {
-      //Check if this prim is unselectable
-      if(unselectablePropertyValue == Metadata::unselectable)
-      {
-        newUnselectables.push_back(prim.GetPath());
-      }
-      else if(m_selectabilityDB.isPathUnselectable(prim.GetPath()) && unselectablePropertyValue != Metadata::unselectable)
-      {
-        removeUnselectables.push_back(prim.GetPath());
-      }
-    }
-  };
-
-  SdfPathSet lockTransformPrims;
-  SdfPathSet lockInheritedPrims;
-  SdfPathSet unlockedPrims;
-  auto recordPrimsLockStatus = [&lockTransformPrims, &lockInheritedPrims, &unlockedPrims](const UsdPrim& prim) {
-    if (!prim.IsValid())
-    {
-      return;
-    }
-    TfToken lockPropertyValue;
-    if (prim.GetMetadata(Metadata::locked, &lockPropertyValue))
-    {
-      if (lockPropertyValue == Metadata::lockTransform)
-      {
-        lockTransformPrims.insert(prim.GetPath());
-      }
-      else if (lockPropertyValue == Metadata::lockInherited)
-      {
-        lockInheritedPrims.insert(prim.GetPath());
-      }
-      else if (lockPropertyValue == Metadata::lockUnlocked)
-      {
-        unlockedPrims.insert(prim.GetPath());
-      }
-    }
-    else
-    {
-      lockInheritedPrims.insert(prim.GetPath());
-    }
-  };
-
-  const UsdNotice::ObjectsChanged::PathRange resyncedPaths = notice.GetResyncedPaths();
-  for(const SdfPath& path : resyncedPaths)
-  {
-    UsdPrim newPrim = m_stage->GetPrimAtPath(path);
-    recordSelectablePrims(newPrim);
-    recordPrimsLockStatus(newPrim);
-  }
-
-  const UsdNotice::ObjectsChanged::PathRange changedInfoOnlyPaths = notice.GetChangedInfoOnlyPaths();
-  for(const SdfPath& path : changedInfoOnlyPaths)
-  {
-    UsdPrim changedPrim;
-    if(path.IsPropertyPath())
-    {
-      changedPrim = m_stage->GetPrimAtPath(path.GetParentPath());
-    }
-    else
-    {
-      changedPrim = m_stage->GetPrimAtPath(path);
-    }
-    recordSelectablePrims(changedPrim);
-    recordPrimsLockStatus(changedPrim);
-  }
-
-  if(!removeUnselectables.empty())
-  {
-    m_selectabilityDB.removePathsAsUnselectable(removeUnselectables);
-  }
-
-  if(!newUnselectables.empty())
-  {
-    m_selectabilityDB.addPathsAsUnselectable(newUnselectables);
-  }
-
-  bool lockChanged = updateLockPrims(lockTransformPrims, lockInheritedPrims, unlockedPrims);
+  bool lockChanged = updateLockedAndUnselectablePrims(stateChangedPaths);
   if (lockChanged)
   {
     constructLockPrims();
@@ -1208,7 +1146,7 @@ std::vector<UsdPrim> ProxyShape::huntForNativeNodesUnderPrim(
       prims.push_back(prim);
     }
   }
-  findExcludedGeometry();
+  findExcludedGeometry(startPath);
   return prims;
 }
 
@@ -1265,6 +1203,57 @@ void ProxyShape::variantSelectionListener(SdfNotice::LayersDidChange const& noti
   }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+std::string ProxyShape::resolveFilePath(const MString& file)
+{
+  std::string fileString = TfStringTrimRight(file.asChar());
+
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::resolveFilePath original USD file path is %s\n", fileString.c_str());
+
+  AL::filesystem::path filestringPath (fileString);
+  if(filestringPath.is_absolute())
+  {
+    fileString = resolvePath(fileString);
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::resolveFilePath resolved the USD file path to %s\n", fileString.c_str());
+  }
+  else
+  {
+    fileString = resolveRelativePathWithinMayaContext(thisMObject(), fileString);
+    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::resolveFilePath resolved the relative USD file path to %s\n", fileString.c_str());
+  }
+
+  // Fall back on providing the path "as is" to USD
+  if (fileString.empty())
+  {
+    fileString.assign(file.asChar(), file.length());
+  }
+  return fileString;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// the resolver context matching the configuration loadStage gives the asset resolver
+static ArResolverContext resolverContextForStage(const MString& assetResolverConfig, const std::string& fileString)
+{
+  if(assetResolverConfig.length() == 0)
+  {
+    return PXR_NS::ArGetResolver().CreateDefaultContextForAsset(fileString);
+  }
+  return PXR_NS::ArGetResolver().CreateDefaultContextForAsset(assetResolverConfig.asChar());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProxyShape::prefetchStage()
+{
+  MPlug filePathPlug(thisMObject(), m_filePath);
+  MPlug assetResolverConfigPlug(thisMObject(), m_assetResolverConfig);
+  MPlug unloadedPlug(thisMObject(), m_unloaded);
+
+  const std::string fileString = resolveFilePath(filePathPlug.asString());
+  const ArResolverContext context = resolverContextForStage(assetResolverConfigPlug.asString(), fileString);
+  const UsdStage::InitialLoadSet loadOperation = unloadedPlug.asBool() ? UsdStage::LoadNone : UsdStage::LoadAll;
+  m_stagePrefetcher.prefetch(fileString, context, loadOperation);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShape::loadStage()
 {
@@ -1280,6 +1269,7 @@ void ProxyShape::loadStage()
     trackEditTargetLayer();
   }
   m_stage = UsdStageRefPtr();
+  m_inheritedStateCache.clear();
 
   // Get input attr values
   const MString file = inputStringValue(dataBlock, m_filePath);
@@ -1289,32 +1279,22 @@ void ProxyShape::loadStage()
   const MString populationMaskIncludePaths = inputStringValue(dataBlock, m_populationMaskIncludePaths);
   UsdStagePopulationMask mask = constructStagePopulationMask(populationMaskIncludePaths);
 
+  const bool unloadedFlag = inputBoolValue(dataBlock, m_unloaded);
+  const UsdStage::InitialLoadSet loadOperation = unloadedFlag ? UsdStage::LoadNone : UsdStage::LoadAll;
+
   // TODO initialise the context using the serialised attribute
 
   // let the usd stage cache deal with caching the usd stage data
-  std::string fileString = TfStringTrimRight(file.asChar());
+  const std::string fileString = resolveFilePath(file);
 
-  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::reloadStage original USD file path is %s\n", fileString.c_str());
-
-  AL::filesystem::path filestringPath (fileString);
-  if(filestringPath.is_absolute())
-  {
-    fileString = resolvePath(fileString);
-    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::reloadStage resolved the USD file path to %s\n", fileString.c_str());
-  }
-  else
-  {
-    fileString = resolveRelativePathWithinMayaContext(thisMObject(), fileString);
-    TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::reloadStage resolved the relative USD file path to %s\n", fileString.c_str());
-  }
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage called for the usd file: %s\n", fileString.c_str());
 
-  // Fall back on providing the path "as is" to USD
-  if (fileString.empty())
-  {
-    fileString.assign(file.asChar(), file.length());
-  }
+  const MString assetResolverConfig = inputStringValue(dataBlock, m_assetResolverConfig);
 
-  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage called for the usd file: %s\n", fileString.c_str());
+  // If the layers of the stage were prefetched while the file was being read, hold onto them until our own stage has
+  // been opened, so that they are reused rather than read again.
+  const SdfLayerRefPtrVector prefetchedLayers =
+      m_stagePrefetcher.take(fileString, resolverContextForStage(assetResolverConfig, fileString));
 
   // Only try to create a stage for layers that can be opened.
   if (SdfLayerRefPtr rootLayer = SdfLayer::FindOrOpen(fileString))
@@ -1361,8 +1341,6 @@ void ProxyShape::loadStage()
 
       AL_BEGIN_PROFILE_SECTION(OpenRootLayer);
 
-      const MString assetResolverConfig = inputStringValue(dataBlock, m_assetResolverConfig);
-
       if (assetResolverConfig.length()==0)
       {
         // Initialise the asset resolver with the filepath
@@ -1379,9 +1357,6 @@ void ProxyShape::loadStage()
       {
         UsdStageCacheContext ctx(StageCache::Get());
 
-        bool unloadedFlag = inputBoolValue(dataBlock, m_unloaded);
-        UsdStage::InitialLoadSet loadOperation = unloadedFlag ? UsdStage::LoadNone : UsdStage::LoadAll;
-
         if (sessionLayer)
         {
           TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("ProxyShape::loadStage is called with extra session layer.\n");
@@ -1457,30 +1432,40 @@ void ProxyShape::loadStage()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-bool ProxyShape::updateLockPrims(const SdfPathSet& lockTransformPrims, const SdfPathSet& lockInheritedPrims,
-                                 const SdfPathSet& unlockedPrims)
+bool ProxyShape::updateLockedAndUnselectablePrims(const SdfPathVector& changedPaths)
 {
   bool lockChanged = false;
-  for (auto lock : lockTransformPrims)
-  {
-    auto inserted = m_lockTransformPrims.insert(lock);
-    lockChanged = lockChanged || inserted.second;
-    auto erased = m_lockInheritedPrims.erase(lock);
-    lockChanged = lockChanged || erased;
-  }
-  for (auto inherited : lockInheritedPrims)
+  SdfPathVector newUnselectables;
+  for(const SdfPath& path : changedPaths)
   {
-    auto erased = m_lockTransformPrims.erase(inherited);
-    lockChanged = lockChanged || erased;
-    auto inserted = m_lockInheritedPrims.insert(inherited);
-    lockChanged = lockChanged || inserted.second;
+    auto range = SdfPathFindPrefixedRange(m_lockTransformPrims.begin(), m_lockTransformPrims.end(), path);
+    lockChanged = lockChanged || range.first != range.second;
+    m_lockTransformPrims.erase(range.first, range.second);
+    m_selectabilityDB.removeHierarchyAsUnselectable(path);
+
+    UsdPrim prim = m_stage->GetPrimAtPath(path);
+    if(!prim)
+      continue;
+
+    m_inheritedStateCache.resolve(prim);
+    for(const UsdPrim& child : UsdPrimRange(prim))
+    {
+      const uint8_t state = m_inheritedStateCache.find(child);
+      if(state & proxy::InheritedStateCache::kTransformLocked)
+      {
+        m_lockTransformPrims.insert(child.GetPath());
+        lockChanged = true;
+      }
+      if(state & proxy::InheritedStateCache::kAuthoredUnselectable)
+      {
+        newUnselectables.push_back(child.GetPath());
+      }
+    }
   }
-  for (auto unlocked : unlockedPrims)
+
+  if(!newUnselectables.empty())
   {
-    auto erased = m_lockTransformPrims.erase(unlocked);
-    lockChanged = lockChanged || erased;
-    erased = m_lockInheritedPrims.erase(unlocked);
-    lockChanged = lockChanged || erased;
+    m_selectabilityDB.addPathsAsUnselectable(newUnselectables);
   }
   return lockChanged;
 }
@@ -1561,21 +1546,8 @@ bool ProxyShape::lockTransformAttribute(const SdfPath& path, const bool lock)
 void ProxyShape::constructLockPrims()
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::constructLockPrims\n");
-  SdfPathSet primsNeedLock = m_lockTransformPrims;
-
-  // add inherited lock prims if their parents are already in.
-  for (auto inherited : m_lockInheritedPrims)
-  {
-    const SdfPath parentPath = inherited.GetParentPath();
-    if (parentPath.IsEmpty())
-      continue;
-    auto parentIter = primsNeedLock.find(parentPath);
-    if (parentIter != primsNeedLock.end())
-    {
-      auto lowerIter = std::lower_bound(parentIter, primsNeedLock.end(), inherited);
-      primsNeedLock.insert(lowerIter, inherited);
-    }
-  }
+  // the lock states have already been resolved through the hierarchy by m_inheritedStateCache
+  const SdfPathSet& primsNeedLock = m_lockTransformPrims;
 
   SdfPathVector primsToLock;
   primsToLock.reserve(primsNeedLock.size());
@@ -1744,77 +1716,42 @@ void ProxyShape::findTaggedPrims()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void ProxyShape::findTaggedPrims(const HierarchyIterationLogics& iterationLogics)
+void ProxyShape::findTaggedPrims(const HierarchyIterationLogics& iterationLogics, const SdfPath& rootPath)
 {
-  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::iteratePrimHierarchy\n");
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::findTaggedPrims %s\n", rootPath.GetText());
   if(!m_stage)
     return;
 
-  for(auto hl : iterationLogics)
-  {
-    hl->preIteration();
-  }
-
-  MDagPath m_parentPath;
-  for(fileio::TransformIterator it(m_stage, m_parentPath); !it.done(); it.next())
-  {
-    const UsdPrim& prim = it.prim();
-    if(!prim.IsValid())
-      continue;
-
-    for(auto hl : iterationLogics)
-    {
-      hl->iteration(it, prim);
-    }
-  }
+  UsdPrim rootPrim = m_stage->GetPrimAtPath(rootPath);
+  if(!rootPrim)
+    return;
 
-  for(auto hl : iterationLogics)
-  {
-    hl->postIteration();
-  }
+  proxy::iterateHierarchy(rootPrim, iterationLogics);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void ProxyShape::findExcludedGeometry()
+void ProxyShape::findExcludedGeometry(const SdfPath& rootPath)
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::findExcludedGeometry\n");
-  if(!m_stage)
-    return;
-
-  m_findExcludedPrims.preIteration();
-  MDagPath m_parentPath;
-
-  for(fileio::TransformIterator it(m_stage, m_parentPath); !it.done(); it.next())
-  {
-    const UsdPrim& prim = it.prim();
-    if(!prim.IsValid())
-      continue;
-    m_findExcludedPrims.iteration(it, prim);
-  }
-
-  m_findExcludedPrims.postIteration();
+  findTaggedPrims({ &m_findExcludedPrims }, rootPath);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void ProxyShape::findSelectablePrims()
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::findSelectablePrims\n");
-  if(!m_stage)
-    return;
-
-  m_findUnselectablePrims.preIteration();
+  findTaggedPrims({ &m_findUnselectablePrims });
+}
 
-  MDagPath m_parentPath;
-  for(fileio::TransformIterator it(m_stage, m_parentPath); !it.done(); it.next())
+//----------------------------------------------------------------------------------------------------------------------
+bool ProxyShape::isPathUnselectable(const SdfPath& path)
+{
+  UsdPrim prim = m_stage ? m_stage->GetPrimAtPath(path) : UsdPrim();
+  if(!prim)
   {
-    const UsdPrim& prim = it.prim();
-    if(!prim.IsValid())
-      continue;
-
-    m_findUnselectablePrims.iteration(it, prim);
+    return m_selectabilityDB.isPathUnselectable(path);
   }
-
-  m_findUnselectablePrims.postIteration();
+  return m_inheritedStateCache.isUnselectable(prim);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1883,6 +1820,12 @@ MStatus ProxyShape::computeOutputTime(const MPlug& plug, MDataBlock& dataBlock,
   MTime inTimeOffset = inputTimeValue(dataBlock, m_timeOffset);
   double inTimeScalar = inputDoubleValue(dataBlock, m_timeScalar);
   currentTime.setValue((inTime.as(MTime::uiUnit()) - inTimeOffset.as(MTime::uiUnit())) * inTimeScalar);
+
+  // the transforms driven by outTime are evaluated after this, so read all of their samples up front
+  if(m_stage)
+  {
+    m_transformSampleCache.fill(UsdTimeCode(currentTime.as(MTime::uiUnit())));
+  }
   return outputTimeValue(dataBlock, m_outTime, currentTime);
 }
 
@@ -1928,86 +1871,76 @@ MBoundingBox ProxyShape::boundingBox() const
   (void)outDataHandle;
   CHECK_MSTATUS_AND_RETURN(status, MBoundingBox() );
 
-  // XXX:aluk
-  // If we could cheaply determine whether a stage only has static geometry,
-  // we could make this value a constant one for that case, avoiding the
-  // memory overhead of a cache entry per frame
-  UsdTimeCode currTime = UsdTimeCode(inputDoubleValue(dataBlock, m_outTime));
-
-  // RB: There must be a nicer way of doing this that avoids the map?
-  // The time codes are likely to be ranged, so an ordered array + binary search would surely work?
-  std::map<UsdTimeCode, MBoundingBox>::const_iterator cacheLookup = m_boundingBoxCache.find(currTime);
-  if (cacheLookup != m_boundingBoxCache.end())
+  UsdPrim prim = getUsdPrim(dataBlock);
+  if (!prim)
   {
-    return cacheLookup->second;
+    return MBoundingBox();
   }
 
-  GfBBox3d allBox;
-  UsdPrim prim = getUsdPrim(dataBlock);
-  if (prim)
+  UsdTimeCode currTime = UsdTimeCode(inputDoubleValue(dataBlock, m_outTime));
+  return m_boundingBoxCache.boundingBox(prim, currTime, displayPurposes(dataBlock));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TfTokenVector ProxyShape::displayPurposes(MDataBlock& dataBlock) const
+{
+  TfTokenVector purposes = { UsdGeomTokens->default_, UsdGeomTokens->proxy };
+  if (inputBoolValue(dataBlock, m_displayGuides))
   {
-    UsdGeomImageable imageablePrim(prim);
-    bool showGuides = inputBoolValue(dataBlock, m_displayGuides);
-    bool showRenderGuides = inputBoolValue(dataBlock, m_displayRenderGuides);
-    if (showGuides && showRenderGuides)
-    {
-      allBox = imageablePrim.ComputeUntransformedBound(
-            currTime,
-            UsdGeomTokens->default_,
-            UsdGeomTokens->proxy,
-            UsdGeomTokens->guide,
-            UsdGeomTokens->render);
-    }
-    else
-    if (showGuides && !showRenderGuides)
-    {
-      allBox = imageablePrim.ComputeUntransformedBound(
-            currTime,
-            UsdGeomTokens->default_,
-            UsdGeomTokens->proxy,
-            UsdGeomTokens->guide);
-    }
-    else if (!showGuides && showRenderGuides)
-    {
-      allBox = imageablePrim.ComputeUntransformedBound(
-            currTime,
-            UsdGeomTokens->default_,
-            UsdGeomTokens->proxy,
-            UsdGeomTokens->render);
-    }
-    else
-    {
-      allBox = imageablePrim.ComputeUntransformedBound(
-            currTime,
-            UsdGeomTokens->default_,
-            UsdGeomTokens->proxy);
-    }
+    purposes.push_back(UsdGeomTokens->guide);
   }
-  else
+  if (inputBoolValue(dataBlock, m_displayRenderGuides))
   {
-    return MBoundingBox();
+    purposes.push_back(UsdGeomTokens->render);
   }
+  return purposes;
+}
 
-  // insert new cache entry
-  MBoundingBox& retval = m_boundingBoxCache[currTime];
+//----------------------------------------------------------------------------------------------------------------------
+const proxy::IntersectionEngine& ProxyShape::intersectionEngine() const
+{
+  MDataBlock dataBlock = const_cast<ProxyShape*>(this)->forceCache();
+  UsdPrim prim = getUsdPrim(dataBlock);
+  if (!prim)
+  {
+    m_intersectionEngine.clear();
+    return m_intersectionEngine;
+  }
 
-  // Convert to GfRange3d to MBoundingBox
-  GfRange3d boxRange = allBox.ComputeAlignedBox();
-  if (!boxRange.IsEmpty())
+  const TfTokenVector purposes = displayPurposes(dataBlock);
+  const SdfPathVector excludedPaths = getExcludePrimPaths();
+  const UsdTimeCode currTime = UsdTimeCode(inputDoubleValue(dataBlock, m_outTime));
+  if(!m_intersectionEngine.isBuilt() || m_intersectionEngine.root() != prim ||
+     m_intersectionEngine.purposes() != purposes || m_intersectionEngine.excludedPaths() != excludedPaths)
   {
-    retval = MBoundingBox(MPoint(boxRange.GetMin()[0],
-                                 boxRange.GetMin()[1],
-                                 boxRange.GetMin()[2]),
-                          MPoint(boxRange.GetMax()[0],
-                                 boxRange.GetMax()[1],
-                                 boxRange.GetMax()[2]));
+    m_intersectionEngine.build(prim, currTime, purposes, excludedPaths);
   }
   else
   {
-    retval = MBoundingBox(MPoint(-100000.0f, -100000.0f, -100000.0f), MPoint(100000.0f, 100000.0f, 100000.0f));
+    m_intersectionEngine.update(currTime);
   }
+  return m_intersectionEngine;
+}
 
-  return retval;
+//----------------------------------------------------------------------------------------------------------------------
+bool ProxyShape::closestPoint(const MPoint& raySource, const MVector& rayDirection, MPoint& theClosestPoint,
+                              MVector& theClosestNormal, bool findClosestOnMiss, double tolerance)
+{
+  TF_DEBUG(ALUSDMAYA_SELECTION).Msg("ProxyShape::closestPoint\n");
+  const GfRay ray(GfVec3d(raySource.x, raySource.y, raySource.z), GfVec3d(rayDirection.x, rayDirection.y, rayDirection.z));
+  proxy::IntersectionEngine::Hit hit;
+  const proxy::IntersectionEngine& intersector = intersectionEngine();
+  if(!intersector.intersectRay(ray, &hit))
+  {
+    // when requested, snap to the geometry closest to the ray, as long as it lies within the tolerance
+    if(!findClosestOnMiss || !intersector.closestPointToRay(ray, tolerance, &hit))
+    {
+      return false;
+    }
+  }
+  theClosestPoint = MPoint(hit.point[0], hit.point[1], hit.point[2]);
+  theClosestNormal = MVector(hit.normal[0], hit.normal[1], hit.normal[2]);
+  return true;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
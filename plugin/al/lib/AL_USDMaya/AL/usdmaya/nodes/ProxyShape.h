@@ -28,7 +28,13 @@
 #include "AL/usdmaya/fileio/translators/TranslatorBase.h"
 #include "AL/usdmaya/fileio/translators/TranslatorContext.h"
 #include "AL/usdmaya/fileio/translators/TransformTranslator.h"
+#include "AL/usdmaya/nodes/proxy/BoundingBoxCache.h"
+#include "AL/usdmaya/nodes/proxy/InheritedStateCache.h"
+#include "AL/usdmaya/nodes/proxy/IntersectionEngine.h"
+#include "AL/usdmaya/nodes/proxy/TransformSampleCache.h"
+#include "AL/usdmaya/nodes/proxy/HierarchyIteration.h"
 #include "AL/usdmaya/nodes/proxy/PrimFilter.h"
+#include "AL/usdmaya/nodes/proxy/StagePrefetcher.h"
 #include "maya/MPxSurfaceShape.h"
 #include "maya/MEventMessage.h"
 #include "maya/MNodeMessage.h"
@@ -47,6 +53,7 @@
 #include "pxr/usdImaging/usdImagingGL/renderParams.h"
 #include <stack>
 #include <functional>
+#include <tbb/enumerable_thread_specific.h>
 #include "AL/usd/utils/ForwardDeclares.h"
 
 #if defined(WANT_UFE_BUILD)
@@ -197,28 +204,6 @@ private:
   SdfPathHashSet m_selected;
 };
 
-//----------------------------------------------------------------------------------------------------------------------
-/// \brief  A class that provides the logic behind a hierarchy traversal through a UsdStage
-//----------------------------------------------------------------------------------------------------------------------
-struct  HierarchyIterationLogic
-{
-  /// \brief  ctor
-  HierarchyIterationLogic():
-      preIteration(nullptr),
-      iteration(nullptr),
-      postIteration(nullptr)
-  {}
-
-  /// \brief  provide a method to be called prior to iteration of the UsdStage hierarchy
-  std::function<void()> preIteration;
-
-  /// \brief  a visitor method that is called on each of the UsdPrims in the stage hierarchy
-  std::function<void(const fileio::TransformIterator& transformIterator,const UsdPrim& prim)> iteration;
-
-  /// \brief  provide a method to be called after iteration of the UsdStage hierarchy
-  std::function<void()> postIteration;
-};
-
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  implements the logic that constructs a list of objects that need to be added or removed from the selectable
 ///         list of prims within a UsdStage
@@ -226,8 +211,7 @@ struct  HierarchyIterationLogic
 struct FindUnselectablePrimsLogic
   : public HierarchyIterationLogic
 {
-  SdfPathVector newUnselectables; ///< items that need to be made unselectable
-  SdfPathVector removeUnselectables; ///< items that are unselectable, but need to be made selectable
+  tbb::enumerable_thread_specific<SdfPathVector> newUnselectables; ///< items that need to be made unselectable
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -236,9 +220,19 @@ struct FindUnselectablePrimsLogic
 struct FindLockedPrimsLogic
   : public HierarchyIterationLogic
 {
+  tbb::enumerable_thread_specific<SdfPathVector> lockTransformPrims; ///< prims whose lock resolves to 'transform'
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  implements the logic required when searching for prims that have been excluded from the proxy shape
+//----------------------------------------------------------------------------------------------------------------------
+struct FindExcludedPrimsLogic
+  : public HierarchyIterationLogic
+{
+  tbb::enumerable_thread_specific<SdfPathVector> excludedPrims; ///< prims found with the exclusion tag
+  SdfPath rootPath; ///< the root of the hierarchy being searched
 };
 
-typedef const HierarchyIterationLogic*  HierarchyIterationLogics[3];
 typedef std::unordered_map<SdfPath, MString, SdfPath::Hash > PrimPathToDagPath;
 
 extern AL::event::EventId kPreClearStageCache;
@@ -418,6 +412,22 @@ public:
   AL_USDMAYA_PUBLIC
   MBoundingBox boundingBox() const override;
 
+  /// \brief  Returns the CPU intersection engine for the geometry of the shape, which is built on first use and then
+  ///         updated to the current time of the shape.
+  AL_USDMAYA_PUBLIC
+  const proxy::IntersectionEngine& intersectionEngine() const;
+
+  /// \brief  Intersects a ray (in the local space of the shape) with the geometry of the shape using the CPU
+  ///         intersection engine. This allows the shape to be made live. If the ray misses and findClosestOnMiss is
+  ///         set, the point on the geometry closest to the ray is returned, provided it lies within the tolerance.
+  AL_USDMAYA_PUBLIC
+  bool closestPoint(const MPoint& raySource, const MVector& rayDirection, MPoint& theClosestPoint,
+                    MVector& theClosestNormal, bool findClosestOnMiss, double tolerance) override;
+
+  /// \brief  the shape can always be made live, since the intersections are computed on the CPU
+  bool canMakeLive() const override
+    { return true; }
+
   //--------------------------------------------------------------------------------------------------------------------
   /// \name   AL_usdmaya_Transform utils
   /// \brief  A set of commands to manipulate the chains of transforms that map to the usd prims found in a stage.
@@ -640,12 +650,17 @@ public:
   AL_USDMAYA_PUBLIC
   void findTaggedPrims();
 
+  /// \brief runs all of the iteration logics over the prims found under the specified path in a single (multi-threaded)
+  ///        traversal of the stage.
+  /// \param iterationLogics the logics to run
+  /// \param rootPath the root of the hierarchy to search. By default the entire stage is searched.
   AL_USDMAYA_PUBLIC
-  void findTaggedPrims(const HierarchyIterationLogics& iterationLogics);
+  void findTaggedPrims(const HierarchyIterationLogics& iterationLogics, const SdfPath& rootPath = SdfPath::AbsoluteRootPath());
 
   /// \brief  searches for the excluded geometry
+  /// \param  rootPath the root of the hierarchy to search. By default the entire stage is searched.
   AL_USDMAYA_PUBLIC
-  void findExcludedGeometry();
+  void findExcludedGeometry(const SdfPath& rootPath = SdfPath::AbsoluteRootPath());
 
   /// \brief searches for paths which are selectable
   AL_USDMAYA_PUBLIC
@@ -771,6 +786,12 @@ public:
     return m_unloadedProxyShapes;
   }
 
+  /// \brief Starts opening the layers of the stage on a worker thread, so that they are ready by the time loadStage is
+  ///        called. Called for each of the unloaded proxy shapes once a file has been read, when all of the attributes
+  ///        affecting the stage are known.
+  AL_USDMAYA_PUBLIC
+  void prefetchStage();
+
   /// \brief This function starts the prim changed process within the proxyshape
   /// \param[in] changePath is point at which the scene is going to be modified.
   inline void primChangedAtPath(const SdfPath& changePath)
@@ -812,6 +833,17 @@ public:
   const AL::usdmaya::SelectabilityDB& selectabilityDB() const
     { return const_cast<ProxyShape*>(this)->selectabilityDB(); }
 
+  /// \brief  Determines whether a prim is unselectable, either because it is tagged as unselectable itself, or it is
+  ///         beneath a prim that is.
+  /// \param  path the path of the prim
+  /// \return true if the prim should not be selected
+  AL_USDMAYA_PUBLIC
+  bool isPathUnselectable(const SdfPath& path);
+
+  /// \brief  Returns the cache of the inherited selectability and lock states of the prims on the stage
+  inline proxy::InheritedStateCache& inheritedStateCache()
+    { return m_inheritedStateCache; }
+
   /// \brief  used to reload the stage after file open
   AL_USDMAYA_PUBLIC
   void loadStage();
@@ -870,6 +902,10 @@ public:
   inline void clearBoundingBoxCache()
     { m_boundingBoxCache.clear(); }
 
+  /// \brief  Returns the cache of animated transform values shared by the transform nodes driven by this shape
+  inline proxy::TransformSampleCache& transformSampleCache()
+    { return m_transformSampleCache; }
+
 private:
 
   static void onSelectionChanged(void* ptr);
@@ -878,8 +914,7 @@ private:
   void insertTransformRefs(const std::vector<std::pair<SdfPath, MObject>>& removedRefs, TransformReason reason);
 
   void constructExcludedPrims();
-  bool updateLockPrims(const SdfPathSet& lockTransformPrims, const SdfPathSet& lockInheritedPrims,
-                       const SdfPathSet& unlockedPrims);
+  bool updateLockedAndUnselectablePrims(const SdfPathVector& changedPaths);
   bool lockTransformAttribute(const SdfPath& path, bool lock);
 
   MObject makeUsdTransformChain_internal(
@@ -983,6 +1018,7 @@ private:
   MStatus compute(const MPlug& plug, MDataBlock& dataBlock) override;
   MStatus setDependentsDirty(const MPlug& plugBeingDirtied, MPlugArray& plugs) override;
   bool isBounded() const override;
+  TfTokenVector displayPurposes(MDataBlock& dataBlock) const;
   #if MAYA_API_VERSION < 201700
   MPxNode::SchedulingType schedulingType() const override { return kSerialize; }
   #else
@@ -1007,6 +1043,7 @@ private:
   UsdPrim getUsdPrim(MDataBlock& dataBlock) const;
   SdfPathVector getExcludePrimPaths() const;
   UsdStagePopulationMask constructStagePopulationMask(const MString &paths) const;
+  std::string resolveFilePath(const MString& file);
 
   bool isStageValid() const;
   bool primHasExcludedParent(UsdPrim prim);
@@ -1041,7 +1078,7 @@ private:
 
   AL::usdmaya::SelectabilityDB m_selectabilityDB;
   HierarchyIterationLogics m_hierarchyIterationLogics;
-  HierarchyIterationLogic m_findExcludedPrims;
+  FindExcludedPrimsLogic m_findExcludedPrims;
   SelectionList m_selectionList;
   FindUnselectablePrimsLogic m_findUnselectablePrims;
   SdfPathHashSet m_selectedPaths;
@@ -1053,14 +1090,17 @@ private:
   TfNotice::Key m_variantChangedNoticeKey;
   TfNotice::Key m_editTargetChanged;
 
-  mutable std::map<UsdTimeCode, MBoundingBox> m_boundingBoxCache;
+  mutable proxy::BoundingBoxCache m_boundingBoxCache;
+  mutable proxy::IntersectionEngine m_intersectionEngine;
+  proxy::TransformSampleCache m_transformSampleCache;
+  proxy::InheritedStateCache m_inheritedStateCache;
+  proxy::StagePrefetcher m_stagePrefetcher;
   AL::event::CallbackId m_beforeSaveSceneId = -1;
   MCallbackId m_attributeChanged = 0;
   MCallbackId m_onSelectionChanged = 0;
   SdfPathVector m_excludedGeometry;
   SdfPathVector m_excludedTaggedGeometry;
   SdfPathSet m_lockTransformPrims;
-  SdfPathSet m_lockInheritedPrims;
   SdfPathSet m_currentLockedPrims;
   static MObject m_transformTranslate;
   static MObject m_transformRotate;
@@ -89,6 +89,22 @@ Transform::Transform()
 //----------------------------------------------------------------------------------------------------------------------
 Transform::~Transform()
 {
+  ProxyShape* proxyShape = getProxyShapePtr();
+  if(proxyShape)
+  {
+    proxyShape->transformSampleCache().unregisterMatrix(transform());
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+ProxyShape* Transform::getProxyShapePtr() const
+{
+  if(proxyShapeHandle.isValid() && proxyShapeHandle.isAlive())
+  {
+    MFnDependencyNode fn(proxyShapeHandle.object());
+    return static_cast<ProxyShape*>(fn.userNode());
+  }
+  return nullptr;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -242,14 +258,32 @@ void Transform::updateTransform(MDataBlock& dataBlock)
   TempBoolLock updateTransformLock(updateTransformInProgress);
 
   // compute updated time value
-  MTime theTime = (inputTimeValue(dataBlock, m_time) - inputTimeValue(dataBlock, m_timeOffset)) * inputDoubleValue(dataBlock, m_timeScalar);
+  const MTime timeOffset = inputTimeValue(dataBlock, m_timeOffset);
+  const double timeScalar = inputDoubleValue(dataBlock, m_timeScalar);
+  MTime theTime = (inputTimeValue(dataBlock, m_time) - timeOffset) * timeScalar;
   outputTimeValue(dataBlock, m_outTime, theTime);
 
   UsdTimeCode usdTime(theTime.as(MTime::uiUnit()));
 
   // update the transformation matrix to the values at the specified time
   TransformationMatrix* m = transform();
-  m->updateToTime(usdTime);
+  if(!m->hasAnimation())
+  {
+    m->updateToTime(usdTime);
+    dataBlock.setClean(MPxTransform::translate);
+    dataBlock.setClean(MPxTransform::rotate);
+    dataBlock.setClean(MPxTransform::scale);
+    return;
+  }
+
+  // transforms that are evaluated at the same time share the samples read by the proxy shape. If an offset or scale
+  // has been applied to the time, it's unlikely to match the time of the other transforms, so read from the prim.
+  ProxyShape* proxyShape = nullptr;
+  if(timeOffset == MTime(0.0) && timeScalar == 1.0)
+  {
+    proxyShape = getProxyShapePtr();
+  }
+  m->updateToTime(usdTime, proxyShape ? &proxyShape->transformSampleCache() : nullptr);
 
   // if translation animation is present, update the translate attribute (or just flag it as clean if no animation exists)
   if(m->hasAnimatedTranslation())
@@ -345,6 +379,11 @@ MStatus Transform::connectionBroken(const MPlug& plug, const MPlug& otherPlug, b
     MFnDependencyNode otherNode(otherPlug.node());
     if (otherNode.typeId() == ProxyShape::kTypeId)
     {
+      ProxyShape* proxyShape = getProxyShapePtr();
+      if(proxyShape)
+      {
+        proxyShape->transformSampleCache().unregisterMatrix(transform());
+      }
       proxyShapeHandle = MObject();
     }
   }
@@ -128,6 +128,9 @@ public:
   inline const MObject getProxyShape() const
     { return proxyShapeHandle.object(); }
 
+  /// \brief  returns the proxy shape that is driving this transform, or null if not connected to one
+  ProxyShape* getProxyShapePtr() const;
+
 private:
 
   //--------------------------------------------------------------------------------------------------------------------
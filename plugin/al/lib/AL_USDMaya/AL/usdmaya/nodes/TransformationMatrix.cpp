@@ -19,6 +19,7 @@
 #include "AL/usdmaya/nodes/ProxyShape.h"
 #include "AL/usdmaya/nodes/Transform.h"
 #include "AL/usdmaya/nodes/TransformationMatrix.h"
+#include "AL/usdmaya/nodes/proxy/TransformSampleCache.h"
 
 #include "maya/MFileIO.h"
 #include "maya/MViewport2Renderer.h"
@@ -1083,7 +1084,96 @@ void TransformationMatrix::initialiseToPrim(bool readFromPrim, Transform* transf
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void TransformationMatrix::updateToTime(const UsdTimeCode& time)
+void TransformationMatrix::readSample(const UsdTimeCode& time, TransformSample& sample) const
+{
+  sample.flags = 0;
+  auto opIt = m_orderedOps.begin();
+  for(std::vector<UsdGeomXformOp>::const_iterator it = m_xformops.begin(), e = m_xformops.end(); it != e; ++it, ++opIt)
+  {
+    const UsdGeomXformOp& op = *it;
+    switch(*opIt)
+    {
+    case kTranslate:
+      {
+        if(hasAnimatedTranslation() && readVector(sample.translation, op, time))
+          sample.flags |= kAnimatedTranslation;
+      }
+      break;
+
+    case kRotate:
+      {
+        if(hasAnimatedRotation() && readRotation(sample.rotation, op, time))
+          sample.flags |= kAnimatedRotation;
+      }
+      break;
+
+    case kScale:
+      {
+        if(hasAnimatedScale() && readVector(sample.scale, op, time))
+          sample.flags |= kAnimatedScale;
+      }
+      break;
+
+    case kShear:
+      {
+        if(hasAnimatedShear() && readShear(sample.shear, op, time))
+          sample.flags |= kAnimatedShear;
+      }
+      break;
+
+    case kTransform:
+      {
+        GfMatrix4d matrix;
+        if(hasAnimatedMatrix() && op.Get<GfMatrix4d>(&matrix, time))
+        {
+          double T[3], S[3];
+          AL::usdmaya::utils::matrixToSRT(matrix, S, sample.rotation, T);
+          sample.scale = MVector(S[0], S[1], S[2]);
+          sample.translation = MVector(T[0], T[1], T[2]);
+          sample.flags |= kAnimatedMatrix;
+        }
+      }
+      break;
+
+    default:
+      break;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformationMatrix::applySample(const TransformSample& sample)
+{
+  if(sample.flags & (kAnimatedTranslation | kAnimatedMatrix))
+  {
+    m_translationFromUsd = sample.translation;
+    MPxTransformationMatrix::translationValue = m_translationFromUsd + m_translationTweak;
+  }
+
+  if(sample.flags & (kAnimatedRotation | kAnimatedMatrix))
+  {
+    m_rotationFromUsd = sample.rotation;
+    MPxTransformationMatrix::rotationValue = m_rotationFromUsd;
+    MPxTransformationMatrix::rotationValue.x += m_rotationTweak.x;
+    MPxTransformationMatrix::rotationValue.y += m_rotationTweak.y;
+    MPxTransformationMatrix::rotationValue.z += m_rotationTweak.z;
+  }
+
+  if(sample.flags & (kAnimatedScale | kAnimatedMatrix))
+  {
+    m_scaleFromUsd = sample.scale;
+    MPxTransformationMatrix::scaleValue = m_scaleFromUsd + m_scaleTweak;
+  }
+
+  if(sample.flags & kAnimatedShear)
+  {
+    m_shearFromUsd = sample.shear;
+    MPxTransformationMatrix::shearValue = m_shearFromUsd + m_shearTweak;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformationMatrix::updateToTime(const UsdTimeCode& time, proxy::TransformSampleCache* sampleCache)
 {
   TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformationMatrix::updateToTime %f\n", time.GetValue());
   // if not yet initialized, do not execute this code! (It will crash!).
@@ -1097,82 +1187,12 @@ void TransformationMatrix::updateToTime(const UsdTimeCode& time)
     m_time = time;
     if(hasAnimation())
     {
-      auto opIt = m_orderedOps.begin();
-      for(std::vector<UsdGeomXformOp>::const_iterator it = m_xformops.begin(), e = m_xformops.end(); it != e; ++it, ++opIt)
+      TransformSample sample;
+      if(!sampleCache || !sampleCache->sample(this, time, sample))
       {
-        const UsdGeomXformOp& op = *it;
-        switch(*opIt)
-        {
-        case kTranslate:
-          {
-            if(hasAnimatedTranslation())
-            {
-              internal_readVector(m_translationFromUsd, op);
-              MPxTransformationMatrix::translationValue = m_translationFromUsd + m_translationTweak;
-            }
-          }
-          break;
-
-        case kRotate:
-          {
-            if(hasAnimatedRotation())
-            {
-              internal_readRotation(m_rotationFromUsd, op);
-              MPxTransformationMatrix::rotationValue = m_rotationFromUsd;
-              MPxTransformationMatrix::rotationValue.x += m_rotationTweak.x;
-              MPxTransformationMatrix::rotationValue.y += m_rotationTweak.y;
-              MPxTransformationMatrix::rotationValue.z += m_rotationTweak.z;
-            }
-          }
-          break;
-
-        case kScale:
-          {
-            if(hasAnimatedScale())
-            {
-              internal_readVector(m_scaleFromUsd, op);
-              MPxTransformationMatrix::scaleValue = m_scaleFromUsd + m_scaleTweak;
-            }
-          }
-          break;
-
-        case kShear:
-          {
-            if(hasAnimatedShear())
-            {
-              internal_readShear(m_shearFromUsd, op);
-              MPxTransformationMatrix::shearValue = m_shearFromUsd + m_shearTweak;
-            }
-          }
-          break;
-
-        case kTransform:
-          {
-            if(hasAnimatedMatrix())
-            {
-              GfMatrix4d matrix;
-              op.Get<GfMatrix4d>(&matrix, getTimeCode());
-              double T[3], S[3];
-              AL::usdmaya::utils::matrixToSRT(matrix, S, m_rotationFromUsd, T);
-              m_scaleFromUsd.x = S[0];
-              m_scaleFromUsd.y = S[1];
-              m_scaleFromUsd.z = S[2];
-              m_translationFromUsd.x = T[0];
-              m_translationFromUsd.y = T[1];
-              m_translationFromUsd.z = T[2];
-              MPxTransformationMatrix::rotationValue.x = m_rotationFromUsd.x + m_rotationTweak.x;
-              MPxTransformationMatrix::rotationValue.y = m_rotationFromUsd.y + m_rotationTweak.y;
-              MPxTransformationMatrix::rotationValue.z = m_rotationFromUsd.z + m_rotationTweak.z;
-              MPxTransformationMatrix::translationValue = m_translationFromUsd + m_translationTweak;
-              MPxTransformationMatrix::scaleValue = m_scaleFromUsd + m_scaleTweak;
-            }
-          }
-          break;
-
-        default:
-          break;
-        }
+        readSample(time, sample);
       }
+      applySample(sample);
     }
   }
 }
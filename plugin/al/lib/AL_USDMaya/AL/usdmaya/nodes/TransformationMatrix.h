@@ -31,6 +31,23 @@ PXR_NAMESPACE_USING_DIRECTIVE
 namespace AL {
 namespace usdmaya {
 namespace nodes {
+namespace proxy {
+class TransformSampleCache;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The transform components read from the animated xform ops of a prim at a given time, prior to any of the
+///         tweaks being applied.
+/// \ingroup nodes
+//----------------------------------------------------------------------------------------------------------------------
+struct TransformSample
+{
+  MVector scale;
+  MEulerRotation rotation;
+  MVector translation;
+  MVector shear;
+  uint32_t flags = 0; ///< the TransformationMatrix::kAnimated* flags of the components that were successfully read
+};
 
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  This class provides a transformation matrix that allows you to apply tweaks over some read only
@@ -131,6 +148,7 @@ class TransformationMatrix
   bool internal_readRotation(MEulerRotation& result, const UsdGeomXformOp& op) { return readRotation(result, op, getTimeCode()); }
   double internal_readDouble(const UsdGeomXformOp& op) { return readDouble(op, getTimeCode()); }
   bool internal_readMatrix(MMatrix& result, const UsdGeomXformOp& op) { return readMatrix(result, op, getTimeCode()); }
+  void applySample(const TransformSample& sample);
 
   bool internal_pushVector(const MVector& result, UsdGeomXformOp& op) { return pushVector(result, op, getTimeCode()); }
   bool internal_pushPoint(const MPoint& result, UsdGeomXformOp& op) { return pushPoint(result, op, getTimeCode()); }
@@ -415,7 +433,16 @@ public:
   /// \brief  this method updates the internal transformation components to the given time. Only the Transform node
   ///         should need to call this method
   /// \param  time the new timecode
-  void updateToTime(const UsdTimeCode& time);
+  /// \param  sampleCache if specified, the animated values will be copied from this cache (which reads the samples
+  ///         of all of the animated transforms of a stage in parallel) rather than being read from the prim.
+  void updateToTime(const UsdTimeCode& time, proxy::TransformSampleCache* sampleCache = nullptr);
+
+  /// \brief  reads the values of the animated transform ops at the given time. This only reads from the prim, and may
+  ///         therefore be called concurrently for different matrices.
+  /// \param  time the time at which to read the ops
+  /// \param  sample the returned transform components
+  AL_USDMAYA_PUBLIC
+  void readSample(const UsdTimeCode& time, TransformSample& sample) const;
 
   /// \brief  pushes any modifications on the matrix back onto the UsdPrim
   void pushToPrim();
@@ -0,0 +1,228 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/nodes/proxy/BoundingBoxCache.h"
+#include "AL/usdmaya/DebugCodes.h"
+
+#include "pxr/usd/usd/primRange.h"
+#include "pxr/usd/usdGeom/boundable.h"
+#include "pxr/usd/usdGeom/pointBased.h"
+#include "pxr/usd/usdGeom/xformable.h"
+
+#include "maya/MPoint.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+constexpr size_t BoundingBoxCache::kMaxCachedTimes;
+
+//----------------------------------------------------------------------------------------------------------------------
+BoundingBoxCache::BoundingBoxCache()
+  : m_bboxCache(), m_times(), m_prim(), m_purposes(), m_staticState(kUnknown)
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool BoundingBoxCache::isHierarchyStatic(const UsdPrim& prim)
+{
+  for(const UsdPrim& child : UsdPrimRange(prim, UsdTraverseInstanceProxies()))
+  {
+    UsdGeomImageable imageable(child);
+    if(!imageable)
+      continue;
+
+    if(imageable.GetVisibilityAttr().ValueMightBeTimeVarying())
+      return false;
+
+    UsdGeomXformable xformable(child);
+    if(xformable && xformable.TransformMightBeTimeVarying())
+      return false;
+
+    UsdGeomBoundable boundable(child);
+    if(boundable && boundable.GetExtentAttr().ValueMightBeTimeVarying())
+      return false;
+
+    // if the extent has not been authored, it will be computed from the points
+    UsdGeomPointBased pointBased(child);
+    if(pointBased && pointBased.GetPointsAttr().ValueMightBeTimeVarying())
+      return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MBoundingBox BoundingBoxCache::boundingBox(const UsdPrim& prim, UsdTimeCode time, const TfTokenVector& purposes)
+{
+  if(prim != m_prim || purposes != m_purposes)
+  {
+    clear();
+    m_prim = prim;
+    m_purposes = purposes;
+  }
+
+  if(m_staticState == kUnknown)
+  {
+    m_staticState = isHierarchyStatic(prim) ? kStatic : kVarying;
+    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("BoundingBoxCache::boundingBox %s is %s\n",
+                                       prim.GetPath().GetText(), m_staticState == kStatic ? "static" : "time varying");
+  }
+
+  const double timeValue = time.GetValue();
+  auto it = m_times.begin();
+  if(m_staticState == kStatic)
+  {
+    if(!m_times.empty())
+      return it->second;
+  }
+  else
+  {
+    it = std::lower_bound(m_times.begin(), m_times.end(), timeValue,
+                          [](const std::pair<double, MBoundingBox>& a, double b) { return a.first < b; });
+    if(it != m_times.end() && it->first == timeValue)
+      return it->second;
+  }
+
+  if(!m_bboxCache)
+  {
+    m_bboxCache.reset(new UsdGeomBBoxCache(time, purposes));
+  }
+  else
+  {
+    m_bboxCache->SetTime(time);
+  }
+
+  MBoundingBox bounds;
+  GfRange3d boxRange = m_bboxCache->ComputeUntransformedBound(prim).ComputeAlignedBox();
+  if(!boxRange.IsEmpty())
+  {
+    bounds = MBoundingBox(MPoint(boxRange.GetMin()[0], boxRange.GetMin()[1], boxRange.GetMin()[2]),
+                          MPoint(boxRange.GetMax()[0], boxRange.GetMax()[1], boxRange.GetMax()[2]));
+  }
+  else
+  {
+    bounds = MBoundingBox(MPoint(-100000.0f, -100000.0f, -100000.0f), MPoint(100000.0f, 100000.0f, 100000.0f));
+  }
+
+  if(m_staticState == kStatic)
+  {
+    m_times.emplace_back(timeValue, bounds);
+    return bounds;
+  }
+
+  if(m_times.size() >= kMaxCachedTimes)
+  {
+    // evict the entry furthest from the time being requested, which keeps the frames around the current time when
+    // scrubbing back and forth.
+    const bool evictFront = std::abs(m_times.front().first - timeValue) > std::abs(m_times.back().first - timeValue);
+    if(evictFront)
+    {
+      m_times.erase(m_times.begin());
+    }
+    else
+    {
+      m_times.pop_back();
+    }
+    it = std::lower_bound(m_times.begin(), m_times.end(), timeValue,
+                          [](const std::pair<double, MBoundingBox>& a, double b) { return a.first < b; });
+  }
+  m_times.emplace(it, timeValue, bounds);
+  return bounds;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool BoundingBoxCache::isRelevantChange(const SdfPath& path) const
+{
+  const SdfPath primPath = path.GetPrimPath();
+  const SdfPath& rootPath = m_prim.GetPath();
+  if(!primPath.HasPrefix(rootPath) && !rootPath.HasPrefix(primPath))
+    return false;
+
+  // metadata changes on prims (selectability, locks, custom data, etc) do not affect the bounds
+  if(!path.IsPropertyPath())
+    return false;
+
+  // neither do primvars
+  static const std::string primvarsPrefix("primvars:");
+  const std::string& name = path.GetName();
+  return name.compare(0, primvarsPrefix.size(), primvarsPrefix) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BoundingBoxCache::invalidate(const UsdNotice::ObjectsChanged& notice)
+{
+  if(!m_prim)
+    return;
+
+  bool dirty = false;
+  const SdfPath& rootPath = m_prim.GetPath();
+  for(const SdfPath& path : notice.GetResyncedPaths())
+  {
+    const SdfPath primPath = path.GetPrimPath();
+    if(primPath.HasPrefix(rootPath) || rootPath.HasPrefix(primPath))
+    {
+      dirty = true;
+      break;
+    }
+  }
+
+  if(!dirty)
+  {
+    for(const SdfPath& path : notice.GetChangedInfoOnlyPaths())
+    {
+      if(isRelevantChange(path))
+      {
+        dirty = true;
+        break;
+      }
+    }
+  }
+
+  if(dirty)
+  {
+    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("BoundingBoxCache::invalidate %s\n", rootPath.GetText());
+    // UsdGeomBBoxCache does not provide a way to invalidate individual entries
+    m_bboxCache.reset();
+    clearTimes();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BoundingBoxCache::clearTimes()
+{
+  m_times.clear();
+  m_staticState = kUnknown;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BoundingBoxCache::clear()
+{
+  m_bboxCache.reset();
+  m_prim = UsdPrim();
+  m_purposes.clear();
+  clearTimes();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
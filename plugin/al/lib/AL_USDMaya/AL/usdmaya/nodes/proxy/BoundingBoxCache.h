@@ -0,0 +1,112 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "../../Api.h"
+
+#include "pxr/usd/usd/notice.h"
+#include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usdGeom/bboxCache.h"
+
+#include "maya/MBoundingBox.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Caches the untransformed bounds of the prim a proxy shape is displaying.
+///
+///         The per-prim bounds are held in a UsdGeomBBoxCache, which retains the bounds of prims that are not time
+///         varying when the time changes. The final bounds of the root prim are stored in a flat array sorted by
+///         time, which is limited in size (the entries furthest from the requested time are evicted first). If none
+///         of the extents, points, transforms or visibility under the root prim are animated, a single bound is
+///         stored and returned for all times.
+///
+///         UsdGeomBBoxCache provides no way to invalidate the bounds of individual prims, so any change that may affect
+///         the bounds (i.e. a resync, or a non-primvar property change under the root prim) discards the whole cache.
+///         While the stage is being edited interactively, the bounds are therefore recomputed after every edit, and
+///         the cache only pays off while the stage is not changing (e.g. during playback).
+//----------------------------------------------------------------------------------------------------------------------
+class BoundingBoxCache
+{
+public:
+
+  /// the maximum number of time samples that will be retained for animated hierarchies
+  static constexpr size_t kMaxCachedTimes = 256;
+
+  /// \brief  ctor
+  AL_USDMAYA_PUBLIC
+  BoundingBoxCache();
+
+  /// \brief  returns the bounds of the prim at the specified time, computing them if not already cached.
+  /// \param  prim the root prim to compute the bounds for
+  /// \param  time the time at which to compute the bounds
+  /// \param  purposes the purposes to include in the bounds
+  /// \return the bounds of the prim. If the prim has no extent, a very large bounding box is returned.
+  AL_USDMAYA_PUBLIC
+  MBoundingBox boundingBox(const UsdPrim& prim, UsdTimeCode time, const TfTokenVector& purposes);
+
+  /// \brief  inspects the changes described in the notice, and discards all of the cached data if any of the
+  ///         changes may affect the bounds
+  /// \param  notice the notice from the stage
+  AL_USDMAYA_PUBLIC
+  void invalidate(const UsdNotice::ObjectsChanged& notice);
+
+  /// \brief  discards all cached data
+  AL_USDMAYA_PUBLIC
+  void clear();
+
+  /// \brief  returns true if the cached hierarchy has been determined to be static
+  inline bool isStatic() const
+    { return m_staticState == kStatic; }
+
+  /// \brief  returns the number of bounding boxes currently cached
+  inline size_t size() const
+    { return m_times.size(); }
+
+private:
+  enum StaticState
+  {
+    kUnknown,
+    kStatic,
+    kVarying
+  };
+
+  bool isRelevantChange(const SdfPath& path) const;
+  void clearTimes();
+  static bool isHierarchyStatic(const UsdPrim& prim);
+
+  std::unique_ptr<UsdGeomBBoxCache> m_bboxCache;
+  std::vector<std::pair<double, MBoundingBox>> m_times;
+  UsdPrim m_prim;
+  TfTokenVector m_purposes;
+  StaticState m_staticState;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
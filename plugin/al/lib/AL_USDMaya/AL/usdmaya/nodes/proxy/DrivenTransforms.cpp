@@ -3,98 +3,325 @@
 #include "AL/usdmaya/nodes/proxy/DrivenTransforms.h"
 #include "AL/usdmaya/DebugCodes.h"
 
+#include "pxr/usd/sdf/attributeSpec.h"
+#include "pxr/usd/sdf/changeBlock.h"
+#include "pxr/usd/sdf/primSpec.h"
+#include "pxr/usd/sdf/schema.h"
+#include "pxr/usd/usd/editContext.h"
+#include "pxr/usd/usdGeom/tokens.h"
+#include "pxr/usd/usdGeom/xform.h"
+#include "pxr/usd/usdGeom/xformOp.h"
+
+#include <algorithm>
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
 namespace proxy {
 
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// the tag given to the anonymous session sublayer into which the driven values are written
+const char* const kDrivenLayerTag = "AL_usdmaya_drivenTransforms";
+
+//----------------------------------------------------------------------------------------------------------------------
+/// ensures that an attribute spec exists in the layer at the given path, so that time samples can be set directly on the
+/// layer without having to go through the Usd API (which cannot safely create specs within an SdfChangeBlock)
+bool createAttributeSpec(const SdfLayerHandle& layer, const UsdAttribute& attr)
+{
+  const SdfPath& attrPath = attr.GetPath();
+  if(layer->GetAttributeAtPath(attrPath))
+    return true;
+
+  SdfPrimSpecHandle primSpec = SdfCreatePrimInLayer(layer, attrPath.GetPrimPath());
+  if(!primSpec)
+    return false;
+
+  return bool(SdfAttributeSpec::New(primSpec, attrPath.GetNameToken(), attr.GetTypeName(), attr.GetVariability()));
+}
+
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+DrivenTransforms::DrivenTransforms(const DrivenTransforms& other)
+  : TfWeakBase(), m_drivenPrimPaths(other.m_drivenPrimPaths), m_drivenMatrix(other.m_drivenMatrix),
+    m_drivenVisibility(other.m_drivenVisibility), m_dirtyMatrices(other.m_dirtyMatrices),
+    m_dirtyVisibilities(other.m_dirtyVisibilities), m_drivenPrims(), m_matrixAttrPaths(), m_visibilityAttrPaths(),
+    m_primIndices(), m_drivenLayer(), m_resolvedStage(), m_objectsChangedKey()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+DrivenTransforms::~DrivenTransforms()
+{
+  TfNotice::Revoke(m_objectsChangedKey);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+DrivenTransforms& DrivenTransforms::operator = (const DrivenTransforms& other)
+{
+  if(this != &other)
+  {
+    m_drivenPrimPaths = other.m_drivenPrimPaths;
+    m_drivenMatrix = other.m_drivenMatrix;
+    m_drivenVisibility = other.m_drivenVisibility;
+    m_dirtyMatrices = other.m_dirtyMatrices;
+    m_dirtyVisibilities = other.m_dirtyVisibilities;
+    clearResolvedAttributes();
+  }
+  return *this;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DrivenTransforms::clearResolvedAttributes()
+{
+  TfNotice::Revoke(m_objectsChangedKey);
+  m_drivenPrims.clear();
+  m_matrixAttrPaths.clear();
+  m_visibilityAttrPaths.clear();
+  m_primIndices.clear();
+  m_resolvedStage = UsdStageWeakPtr();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DrivenTransforms::invalidateTransformOp(const SdfPath& primPath)
+{
+  auto range = m_primIndices.equal_range(primPath);
+  for(auto it = range.first; it != range.second; ++it)
+  {
+    m_matrixAttrPaths[it->second] = SdfPath();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DrivenTransforms::onObjectsChanged(const UsdNotice::ObjectsChanged& notice, const UsdStageWeakPtr& sender)
+{
+  if(m_primIndices.empty() || sender != m_resolvedStage)
+    return;
+
+  // resyncs of the prims themselves invalidate the cached UsdPrims, which is handled in drivenPrim, so only the
+  // properties need checking here (i.e. a transform op that has been added or removed)
+  for(const SdfPath& path : notice.GetResyncedPaths())
+  {
+    if(path.IsPropertyPath() && UsdGeomXformOp::IsXformOp(path.GetNameToken()))
+    {
+      invalidateTransformOp(path.GetPrimPath());
+    }
+  }
+
+  for(const SdfPath& path : notice.GetChangedInfoOnlyPaths())
+  {
+    if(!path.IsPropertyPath())
+      continue;
+
+    const TfToken& name = path.GetNameToken();
+    if(name == UsdGeomTokens->xformOpOrder)
+    {
+      invalidateTransformOp(path.GetPrimPath());
+    }
+    else
+    if(UsdGeomXformOp::IsXformOp(name))
+    {
+      // the time samples written in updateDrivenTransforms do not change which op is driven, and are ignored so that
+      // each update does not discard the ops it has just resolved
+      const TfTokenVector fields = notice.GetChangedFields(path);
+      if(fields.size() != 1 || fields[0] != SdfFieldKeys->TimeSamples)
+      {
+        invalidateTransformOp(path.GetPrimPath());
+      }
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void DrivenTransforms::resizeDrivenTransforms(const size_t primPathCount)
 {
   m_drivenPrimPaths.resize(primPathCount);
   m_drivenMatrix.resize(primPathCount, MMatrix::identity);
   m_drivenVisibility.resize(primPathCount, true);
+  clearResolvedAttributes();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void DrivenTransforms::updateDrivenTransforms(std::vector<UsdPrim>& drivenPrims, const MTime& currentTime)
+SdfLayerRefPtr DrivenTransforms::drivenLayer(UsdStageRefPtr stage)
 {
-  for (uint32_t i = 0, cnt = m_dirtyMatrices.size(); i < cnt; ++i)
+  SdfLayerHandle sessionLayer = stage->GetSessionLayer();
+  if(!sessionLayer)
+    return SdfLayerRefPtr();
+
+  const std::vector<std::string> subLayerPaths = sessionLayer->GetSubLayerPaths();
+  for(size_t i = subLayerPaths.size(); i-- > 0; )
   {
-    uint32_t idx = uint32_t(m_dirtyMatrices[i]);
-    // [RB] This seems redundant? Why not just prevent invalid data from entering the structure?
-    if (idx >= drivenPrims.size())
-    {
+    const std::string& subLayerPath = subLayerPaths[i];
+    if(!SdfLayer::IsAnonymousLayerIdentifier(subLayerPath) ||
+       SdfLayer::GetDisplayNameFromIdentifier(subLayerPath) != kDrivenLayerTag)
       continue;
+
+    SdfLayerRefPtr layer = SdfLayer::Find(subLayerPath);
+    if(layer)
+      return layer;
+
+    // anonymous layers do not survive a save and reload of the session layer, so remove the stale entry
+    sessionLayer->RemoveSubLayerPath(i);
+  }
+
+  SdfLayerRefPtr layer = SdfLayer::CreateAnonymous(kDrivenLayerTag);
+  sessionLayer->InsertSubLayerPath(layer->GetIdentifier(), 0);
+  return layer;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool DrivenTransforms::resolvePrims(UsdStageRefPtr stage)
+{
+  if(m_resolvedStage != stage || m_drivenPrims.size() != m_drivenPrimPaths.size())
+  {
+    clearResolvedAttributes();
+    m_resolvedStage = stage;
+    m_drivenPrims.resize(m_drivenPrimPaths.size());
+    m_matrixAttrPaths.resize(m_drivenPrimPaths.size());
+    m_visibilityAttrPaths.resize(m_drivenPrimPaths.size());
+    for(uint32_t idx = 0, cnt = m_drivenPrimPaths.size(); idx < cnt; ++idx)
+    {
+      m_primIndices.emplace(m_drivenPrimPaths[idx], idx);
     }
-    UsdPrim& usdPrim = drivenPrims[idx];
-    if (!usdPrim.IsValid())
+    TfWeakPtr<DrivenTransforms> me(this);
+    m_objectsChangedKey = TfNotice::Register(me, &DrivenTransforms::onObjectsChanged, m_resolvedStage);
+  }
+
+  // the driven layer may have been removed from the session layer (e.g. if the session layer was cleared)
+  if(!m_drivenLayer || !stage->HasLocalLayer(m_drivenLayer))
+  {
+    m_drivenLayer = drivenLayer(stage);
+    std::fill(m_matrixAttrPaths.begin(), m_matrixAttrPaths.end(), SdfPath());
+    std::fill(m_visibilityAttrPaths.begin(), m_visibilityAttrPaths.end(), SdfPath());
+  }
+
+  bool result = true;
+  for(uint32_t idx = 0, cnt = m_drivenPrimPaths.size(); idx < cnt; ++idx)
+  {
+    if(!drivenPrim(stage, idx).IsValid())
     {
-      continue;
+      MString warningMsg;
+      warningMsg.format("Driven Prim [^1s] is not valid.", MString("") + idx);
+      MGlobal::displayWarning(warningMsg);
+      result = false;
     }
-    UsdGeomXform xform(usdPrim);
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const UsdPrim& DrivenTransforms::drivenPrim(UsdStageRefPtr stage, uint32_t primIndex)
+{
+  UsdPrim& prim = m_drivenPrims[primIndex];
+  if(!prim.IsValid())
+  {
+    // the prim may have been removed by a resync, so the cached attributes can no longer be trusted
+    prim = stage->GetPrimAtPath(m_drivenPrimPaths[primIndex]);
+    m_matrixAttrPaths[primIndex] = SdfPath();
+    m_visibilityAttrPaths[primIndex] = SdfPath();
+  }
+  return prim;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const SdfPath& DrivenTransforms::matrixAttrPath(UsdStageRefPtr stage, uint32_t primIndex)
+{
+  SdfPath& attrPath = m_matrixAttrPaths[primIndex];
+  if(attrPath.IsEmpty())
+  {
+    UsdGeomXform xform(m_drivenPrims[primIndex]);
     bool resetsXformStack = false;
     std::vector<UsdGeomXformOp> xformops = xform.GetOrderedXformOps(&resetsXformStack);
-    bool pushed = false;
-    for (auto& it : xformops)
+    UsdGeomXformOp transformOp;
+    for(auto& it : xformops)
     {
-      if (it.GetOpType() == UsdGeomXformOp::TypeTransform)
+      if(it.GetOpType() == UsdGeomXformOp::TypeTransform)
       {
-        nodes::TransformationMatrix::pushMatrix(m_drivenMatrix[idx], it, currentTime.as(MTime::uiUnit()));
-        pushed = true;
+        transformOp = it;
         break;
       }
     }
-    if (!pushed)
+    if(!transformOp)
+    {
+      UsdEditContext editContext(stage, UsdEditTarget(m_drivenLayer));
+      transformOp = xform.AddTransformOp();
+    }
+    if(transformOp && createAttributeSpec(m_drivenLayer, transformOp.GetAttr()))
     {
-      UsdGeomXformOp xformop = xform.AddTransformOp();
-      nodes::TransformationMatrix::pushMatrix(m_drivenMatrix[idx], xformop, currentTime.as(MTime::uiUnit()));
+      attrPath = transformOp.GetAttr().GetPath();
     }
+  }
+  return attrPath;
+}
 
-    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("ProxyShape::updateDrivenTransforms %lf %lf %lf %lf  %lf %lf %lf %lf  %lf %lf %lf %lf  %lf %lf %lf %lf\n",
-        m_drivenMatrix[idx][0][0],
-        m_drivenMatrix[idx][0][1],
-        m_drivenMatrix[idx][0][2],
-        m_drivenMatrix[idx][0][3],
-        m_drivenMatrix[idx][1][0],
-        m_drivenMatrix[idx][1][1],
-        m_drivenMatrix[idx][1][2],
-        m_drivenMatrix[idx][1][3],
-        m_drivenMatrix[idx][2][0],
-        m_drivenMatrix[idx][2][1],
-        m_drivenMatrix[idx][2][2],
-        m_drivenMatrix[idx][2][3],
-        m_drivenMatrix[idx][3][0],
-        m_drivenMatrix[idx][3][1],
-        m_drivenMatrix[idx][3][2],
-        m_drivenMatrix[idx][3][3]);
+//----------------------------------------------------------------------------------------------------------------------
+const SdfPath& DrivenTransforms::visibilityAttrPath(UsdStageRefPtr stage, uint32_t primIndex)
+{
+  SdfPath& attrPath = m_visibilityAttrPaths[primIndex];
+  if(attrPath.IsEmpty())
+  {
+    UsdGeomXform xform(m_drivenPrims[primIndex]);
+    UsdAttribute attr = xform.GetVisibilityAttr();
+    if(attr && createAttributeSpec(m_drivenLayer, attr))
+    {
+      attrPath = attr.GetPath();
+    }
   }
-  m_dirtyMatrices.clear();
+  return attrPath;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void DrivenTransforms::updateDrivenVisibility(std::vector<UsdPrim>& drivenPrims, const MTime& currentTime)
+void DrivenTransforms::updateDrivenTransforms(UsdStageRefPtr stage, const MTime& currentTime)
 {
-  for (uint32_t i = 0, cnt = m_dirtyVisibilities.size(); i < cnt; ++i)
+  // resolve (and if needed, create) the transform ops prior to opening the change block
+  for(int32_t idx : m_dirtyMatrices)
   {
-    uint32_t idx = uint32_t(m_dirtyVisibilities[i]);
-    // [RB] This seems redundant? Why not just prevent invalid data from entering the structure?
-    if (idx >= drivenPrims.size())
+    if(uint32_t(idx) < m_drivenPrims.size() && drivenPrim(stage, idx).IsValid())
     {
-      continue;
+      matrixAttrPath(stage, idx);
     }
-    UsdPrim& usdPrim = drivenPrims[idx];
-    if (!usdPrim)
+  }
+
+  const double time = currentTime.as(MTime::uiUnit());
+  {
+    SdfChangeBlock changeBlock;
+    for(int32_t idx : m_dirtyMatrices)
     {
-      continue;
+      if(uint32_t(idx) >= m_matrixAttrPaths.size() || m_matrixAttrPaths[idx].IsEmpty())
+        continue;
+      const GfMatrix4d& value = *(const GfMatrix4d*)(&m_drivenMatrix[idx]);
+      m_drivenLayer->SetTimeSample(m_matrixAttrPaths[idx], time, value);
     }
-    UsdGeomXform xform(usdPrim);
-    UsdAttribute attr = xform.GetVisibilityAttr();
-    if(!attr)
+  }
+
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("DrivenTransforms::updateDrivenTransforms %zu matrices at time %lf\n",
+      m_dirtyMatrices.size(), time);
+  m_dirtyMatrices.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void DrivenTransforms::updateDrivenVisibility(UsdStageRefPtr stage, const MTime& currentTime)
+{
+  for(int32_t idx : m_dirtyVisibilities)
+  {
+    if(uint32_t(idx) < m_drivenPrims.size() && drivenPrim(stage, idx).IsValid())
+    {
+      visibilityAttrPath(stage, idx);
+    }
+  }
+
+  const double time = currentTime.as(MTime::uiUnit());
+  {
+    SdfChangeBlock changeBlock;
+    for(int32_t idx : m_dirtyVisibilities)
     {
-      attr = xform.CreateVisibilityAttr();
+      if(uint32_t(idx) >= m_visibilityAttrPaths.size() || m_visibilityAttrPaths[idx].IsEmpty())
+        continue;
+      m_drivenLayer->SetTimeSample(m_visibilityAttrPaths[idx], time,
+                                   m_drivenVisibility[idx] ? UsdGeomTokens->inherited : UsdGeomTokens->invisible);
     }
-    attr.Set(m_drivenVisibility[idx] ? UsdGeomTokens->inherited : UsdGeomTokens->invisible, currentTime.as(MTime::uiUnit()));
   }
   m_dirtyVisibilities.clear();
 }
@@ -102,30 +329,19 @@ void DrivenTransforms::updateDrivenVisibility(std::vector<UsdPrim>& drivenPrims,
 //----------------------------------------------------------------------------------------------------------------------
 bool DrivenTransforms::update(UsdStageRefPtr stage, const MTime& currentTime)
 {
-  std::vector<UsdPrim> drivenPrims;
-  drivenPrims.resize(transformCount());
-  bool result = true;
-  uint32_t cnt = m_drivenPrimPaths.size();
-  for (uint32_t idx = 0; idx < cnt; ++idx)
+  const bool result = resolvePrims(stage);
+  if(!m_drivenLayer)
   {
-    auto path = m_drivenPrimPaths[idx];
-    drivenPrims[idx] = stage->GetPrimAtPath(path);
-    if (!drivenPrims[idx].IsValid())
-    {
-      MString warningMsg;
-      warningMsg.format("Driven Prim [^1s] is not valid.", MString("") + idx);
-      MGlobal::displayWarning(warningMsg);
-      result = false;
-    }
+    return false;
   }
 
   if (!dirtyMatrices().empty())
   {
-    updateDrivenTransforms(drivenPrims, currentTime);
+    updateDrivenTransforms(stage, currentTime);
   }
   if (!dirtyVisibilities().empty())
   {
-    updateDrivenVisibility(drivenPrims, currentTime);
+    updateDrivenVisibility(stage, currentTime);
   }
   return result;
 }
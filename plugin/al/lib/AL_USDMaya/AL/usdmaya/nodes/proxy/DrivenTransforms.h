@@ -17,8 +17,12 @@
 
 #include "../../Api.h"
 
+#include "pxr/base/tf/weakBase.h"
+#include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/sdf/path.h"
+#include "pxr/usd/usd/notice.h"
 #include "pxr/usd/usd/prim.h"
+#include "pxr/usd/usd/stage.h"
 
 #include "maya/MPxData.h"
 #include "maya/MVector.h"
@@ -26,6 +30,7 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "AL/maya/utils/ForwardDeclares.h"
 #include "AL/usd/utils/ForwardDeclares.h"
 
@@ -43,17 +48,37 @@ namespace proxy {
 ///         memory storage. setDrivenPrimPaths should be called to specify the prim paths. Whenever you need to specify
 ///         a change to the matrix or visibility values, call either dirtyVisibility or dirtyMatrix, and specify the
 ///         index of the prim to modify.
-///         Within the compute method of the node, constructDrivenPrimsArray should be called to construct the array
-///         of prims to update, which can then be passed to the update method to set the dirty values on the prim
-///         attributes.
+///         Within the compute method of the node, the update method should be called to set the dirty values on the
+///         prim attributes.
+///
+///         The values are authored into an anonymous sublayer of the stage's session layer (see drivenLayer), and all
+///         of the values dirtied within a single update are written within one SdfChangeBlock, so that a single change
+///         notice is emitted per update. The attributes driven for each prim index are resolved on the first update
+///         that dirties them, and are then reused until the stage or the prim paths change. The transform op of a prim
+///         is also resolved again when its xformOpOrder, or one of its xformOp: attributes, is changed on the stage.
 //----------------------------------------------------------------------------------------------------------------------
 class DrivenTransforms
+  : public TfWeakBase
 {
 public:
 
   /// \brief  ctor
   inline DrivenTransforms()
-    : m_drivenPrimPaths(), m_drivenMatrix(), m_drivenVisibility(), m_dirtyMatrices(), m_dirtyVisibilities() {}
+    : m_drivenPrimPaths(), m_drivenMatrix(), m_drivenVisibility(), m_dirtyMatrices(), m_dirtyVisibilities(),
+      m_drivenPrims(), m_matrixAttrPaths(), m_visibilityAttrPaths(), m_primIndices(), m_drivenLayer(),
+      m_resolvedStage(), m_objectsChangedKey() {}
+
+  /// \brief  copy ctor. The resolved attributes are not copied, they are resolved again on the next update.
+  AL_USDMAYA_PUBLIC
+  DrivenTransforms(const DrivenTransforms& other);
+
+  /// \brief  dtor
+  AL_USDMAYA_PUBLIC
+  ~DrivenTransforms();
+
+  /// \brief  assignment. The resolved attributes are not copied, they are resolved again on the next update.
+  AL_USDMAYA_PUBLIC
+  DrivenTransforms& operator = (const DrivenTransforms& other);
 
   /// \brief  returns the number of transforms
   inline size_t transformCount() const
@@ -67,7 +92,7 @@ public:
   /// \brief  set the driven prim paths on the host driven transforms
   /// \param  primPaths the prim paths to set on the proxy
   inline void setDrivenPrimPaths(const SdfPathVector& primPaths)
-    { m_drivenPrimPaths = primPaths; }
+    { m_drivenPrimPaths = primPaths; clearResolvedAttributes(); }
 
   /// \brief  update the driven transforms
   /// \param  stage the stage to extract the prims from
@@ -119,15 +144,36 @@ public:
   inline const std::vector<bool>& drivenVisibilities() const
     { return m_drivenVisibility; }
 
+  /// \brief  returns the sublayer of the stage's session layer that driven values are authored into, creating it if
+  ///         it does not yet exist.
+  /// \param  stage the stage being driven
+  /// \return the layer into which the driven values are written
+  AL_USDMAYA_PUBLIC
+  static SdfLayerRefPtr drivenLayer(UsdStageRefPtr stage);
+
 private:
-  void updateDrivenVisibility(std::vector<UsdPrim>& drivenPrims, const MTime& currentTime);
-  void updateDrivenTransforms(std::vector<UsdPrim>& drivenPrims, const MTime& currentTime);
+  bool resolvePrims(UsdStageRefPtr stage);
+  const UsdPrim& drivenPrim(UsdStageRefPtr stage, uint32_t primIndex);
+  const SdfPath& matrixAttrPath(UsdStageRefPtr stage, uint32_t primIndex);
+  const SdfPath& visibilityAttrPath(UsdStageRefPtr stage, uint32_t primIndex);
+  void updateDrivenVisibility(UsdStageRefPtr stage, const MTime& currentTime);
+  void updateDrivenTransforms(UsdStageRefPtr stage, const MTime& currentTime);
+  void onObjectsChanged(const UsdNotice::ObjectsChanged& notice, const UsdStageWeakPtr& sender);
+  void invalidateTransformOp(const SdfPath& primPath);
+  void clearResolvedAttributes();
 private:
   SdfPathVector m_drivenPrimPaths;
   std::vector<MMatrix> m_drivenMatrix;
   std::vector<bool> m_drivenVisibility;
   std::vector<int32_t> m_dirtyMatrices;
   std::vector<int32_t> m_dirtyVisibilities;
+  std::vector<UsdPrim> m_drivenPrims;
+  SdfPathVector m_matrixAttrPaths;
+  SdfPathVector m_visibilityAttrPaths;
+  std::unordered_multimap<SdfPath, uint32_t, SdfPath::Hash> m_primIndices;
+  SdfLayerRefPtr m_drivenLayer;
+  UsdStageWeakPtr m_resolvedStage;
+  TfNotice::Key m_objectsChangedKey;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,121 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/nodes/proxy/HierarchyIteration.h"
+#include "AL/usdmaya/DebugCodes.h"
+
+#include "pxr/base/work/dispatcher.h"
+
+#include <tbb/concurrent_unordered_set.h>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// Subtrees found above this depth are handed to the dispatcher as separate tasks. Anything deeper is walked serially
+/// by the task that owns it, which keeps the task overhead low for deep but narrow hierarchies.
+//----------------------------------------------------------------------------------------------------------------------
+const uint32_t kMaxTaskDepth = 6;
+
+//----------------------------------------------------------------------------------------------------------------------
+struct HierarchyVisitor
+{
+  HierarchyVisitor(const HierarchyIterationLogics& logics)
+    : m_logics(logics) {}
+
+  void visit(const UsdPrim& prim, uint32_t depth)
+  {
+    if(!prim.IsValid())
+      return;
+
+    for(auto hl : m_logics)
+    {
+      hl->iteration(prim);
+    }
+    visitChildren(prim, depth);
+  }
+
+  void visitChildren(const UsdPrim& prim, uint32_t depth)
+  {
+    UsdPrim parent = prim;
+    if(prim.IsInstance())
+    {
+      parent = prim.GetMaster();
+      if(!parent || !m_visitedMasters.insert(parent.GetPath()).second)
+        return;
+    }
+
+    for(const UsdPrim& child : parent.GetChildren())
+    {
+      if(depth < kMaxTaskDepth)
+      {
+        m_dispatcher.Run([this, child, depth]() { visit(child, depth + 1); });
+      }
+      else
+      {
+        visit(child, depth + 1);
+      }
+    }
+  }
+
+  const HierarchyIterationLogics& m_logics;
+  tbb::concurrent_unordered_set<SdfPath, SdfPath::Hash> m_visitedMasters;
+  WorkDispatcher m_dispatcher;
+};
+
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void iterateHierarchy(const UsdPrim& rootPrim, const HierarchyIterationLogics& logics)
+{
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("proxy::iterateHierarchy %s\n", rootPrim.GetPath().GetText());
+  if(!rootPrim.IsValid())
+    return;
+
+  const SdfPath rootPath = rootPrim.GetPath();
+  for(auto hl : logics)
+  {
+    hl->preIteration(rootPath);
+  }
+
+  {
+    HierarchyVisitor visitor(logics);
+    if(rootPrim.IsPseudoRoot())
+    {
+      visitor.visitChildren(rootPrim, 0);
+    }
+    else
+    {
+      visitor.visit(rootPrim, 0);
+    }
+    visitor.m_dispatcher.Wait();
+  }
+
+  for(auto hl : logics)
+  {
+    hl->postIteration();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "../../Api.h"
+
+#include "pxr/usd/sdf/path.h"
+#include "pxr/usd/usd/prim.h"
+
+#include <functional>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A class that provides the logic behind a hierarchy traversal through a UsdStage. The pre and post iteration
+///         methods are always called from the main thread. The iteration method is called concurrently from worker
+///         threads, so it must only read from the stage, and should record its results in thread local storage which
+///         can then be merged in postIteration.
+//----------------------------------------------------------------------------------------------------------------------
+struct  HierarchyIterationLogic
+{
+  /// \brief  ctor
+  HierarchyIterationLogic():
+      preIteration(nullptr),
+      iteration(nullptr),
+      postIteration(nullptr)
+  {}
+
+  /// \brief  provide a method to be called prior to iteration of the UsdStage hierarchy. The path passed in is the
+  ///         root of the hierarchy about to be iterated (the absolute root path if the entire stage will be visited),
+  ///         so that any previous results that lie within that subtree can be discarded.
+  std::function<void(const SdfPath& rootPath)> preIteration;
+
+  /// \brief  a visitor method that is called on each of the UsdPrims in the stage hierarchy. This will be called
+  ///         concurrently from multiple threads.
+  std::function<void(const UsdPrim& prim)> iteration;
+
+  /// \brief  provide a method to be called after iteration of the UsdStage hierarchy
+  std::function<void()> postIteration;
+};
+
+typedef std::vector<const HierarchyIterationLogic*> HierarchyIterationLogics;
+
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Performs a single traversal of the prim hierarchy found under rootPrim, running all of the iteration logics
+///         on every prim visited. Subtrees are distributed across worker threads. The traversal visits the same prims
+///         as fileio::TransformIterator (i.e. the default prim predicate, and the children of instance masters), with
+///         the exception that each instance master is only visited once.
+/// \param  rootPrim the root of the hierarchy to visit. If this is the pseudo root, only its descendants are visited,
+///         otherwise rootPrim itself is also passed to the iteration logics.
+/// \param  logics the iteration logics to run. preIteration is called on each of them prior to the traversal, and
+///         postIteration is called once the traversal has completed.
+//----------------------------------------------------------------------------------------------------------------------
+AL_USDMAYA_PUBLIC
+void iterateHierarchy(const UsdPrim& rootPrim, const HierarchyIterationLogics& logics);
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,184 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/nodes/proxy/InheritedStateCache.h"
+#include "AL/usdmaya/DebugCodes.h"
+#include "AL/usdmaya/Metadata.h"
+
+#include "pxr/usd/usd/primRange.h"
+#include "pxr/usd/usd/stage.h"
+
+#include <algorithm>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+InheritedStateCache::InheritedStateCache()
+  : m_states()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint8_t InheritedStateCache::computeState(const UsdPrim& prim, uint8_t parentState)
+{
+  uint8_t state = kResolved;
+  TfToken value;
+  if(prim.GetMetadata(Metadata::selectability, &value) && value == Metadata::unselectable)
+  {
+    state |= kAuthoredUnselectable;
+  }
+  if(prim.GetMetadata(Metadata::locked, &value))
+  {
+    if(value == Metadata::lockTransform)
+    {
+      state |= kAuthoredLockTransform;
+    }
+    else
+    if(value == Metadata::lockUnlocked)
+    {
+      state |= kAuthoredLockUnlocked;
+    }
+  }
+
+  // an unselectable ancestor can not be overridden, whereas an explicit lock value stops the lock being inherited
+  if((state & kAuthoredUnselectable) || (parentState & kUnselectable))
+  {
+    state |= kUnselectable;
+  }
+  if((state & kAuthoredLockTransform) || ((parentState & kTransformLocked) && !(state & kAuthoredLockUnlocked)))
+  {
+    state |= kTransformLocked;
+  }
+  return state;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint8_t InheritedStateCache::state(const UsdPrim& prim)
+{
+  if(!prim)
+    return 0;
+
+  auto it = m_states.find(prim.GetPath());
+  if(it != m_states.end() && (it->second & kResolved))
+    return it->second;
+
+  const UsdPrim parent = prim.GetParent();
+  const uint8_t result = computeState(prim, parent ? state(parent) : 0);
+  m_states[prim.GetPath()] = result;
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint8_t InheritedStateCache::find(const UsdPrim& prim) const
+{
+  if(!prim)
+    return 0;
+
+  auto it = m_states.find(prim.GetPath());
+  if(it != m_states.end() && (it->second & kResolved))
+    return it->second;
+
+  const UsdPrim parent = prim.GetParent();
+  return computeState(prim, parent ? find(parent) : 0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void InheritedStateCache::resolve(const UsdPrim& root)
+{
+  if(!root)
+    return;
+
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("InheritedStateCache::resolve %s\n", root.GetPath().GetText());
+
+  // the range is visited parents first, so every prim other than the root can inherit from a resolved entry
+  const UsdPrim rootParent = root.GetParent();
+  uint8_t rootParentState = rootParent ? state(rootParent) : 0;
+  for(const UsdPrim& prim : UsdPrimRange(root))
+  {
+    const SdfPath& path = prim.GetPath();
+    auto it = m_states.find(path);
+    if(it != m_states.end() && (it->second & kResolved))
+      continue;
+
+    uint8_t parentState = rootParentState;
+    if(path != root.GetPath())
+    {
+      auto parentIt = m_states.find(path.GetParentPath());
+      parentState = parentIt != m_states.end() ? parentIt->second : 0;
+    }
+    m_states[path] = computeState(prim, parentState);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void InheritedStateCache::invalidate(const UsdNotice::ObjectsChanged& notice, SdfPathVector& changedPaths)
+{
+  changedPaths.clear();
+
+  for(const SdfPath& path : notice.GetResyncedPaths())
+  {
+    // the metadata of a prim is not affected by its properties being resynced
+    if(!path.IsAbsoluteRootOrPrimPath())
+      continue;
+    m_states.erase(path);
+    changedPaths.push_back(path);
+  }
+
+  const UsdStageWeakPtr stage = notice.GetStage();
+  for(const SdfPath& path : notice.GetChangedInfoOnlyPaths())
+  {
+    if(!path.IsAbsoluteRootOrPrimPath())
+      continue;
+
+    // if the prim's own selectability and lock are unchanged, the states of its descendants are still valid
+    auto it = m_states.find(path);
+    if(it != m_states.end() && (it->second & kResolved))
+    {
+      const UsdPrim prim = stage ? stage->GetPrimAtPath(path) : UsdPrim();
+      if(prim && (computeState(prim, 0) & kAuthoredMask) == (it->second & kAuthoredMask))
+        continue;
+      m_states.erase(path);
+    }
+    changedPaths.push_back(path);
+  }
+
+  if(changedPaths.empty())
+    return;
+
+  // strip any paths that lie within the hierarchy of another changed path. Once sorted, an ancestor always precedes
+  // its descendants, so a path only needs to be compared against the last path that was kept.
+  std::sort(changedPaths.begin(), changedPaths.end());
+  auto last = changedPaths.begin();
+  for(auto it = changedPaths.begin() + 1, end = changedPaths.end(); it != end; ++it)
+  {
+    if(!it->HasPrefix(*last))
+    {
+      *(++last) = *it;
+    }
+  }
+  changedPaths.erase(last + 1, changedPaths.end());
+
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("InheritedStateCache::invalidate %zu hierarchies\n", changedPaths.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
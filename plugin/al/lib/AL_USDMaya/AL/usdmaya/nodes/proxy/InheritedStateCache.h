@@ -0,0 +1,115 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "../../Api.h"
+
+#include "pxr/usd/sdf/pathTable.h"
+#include "pxr/usd/usd/notice.h"
+#include "pxr/usd/usd/prim.h"
+
+#include <cstdint>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Caches the inherited selectability and lock state of the prims on a stage.
+///
+///         Resolving the selectability or lock of a prim requires the metadata of each of its ancestors to be
+///         inspected. This cache stores the resolved state of each prim in a path table, so that a top down pass over
+///         a hierarchy reads the metadata of each prim once, and inherits the rest from the (already resolved) parent.
+///         The entries for a prim and its descendants are discarded when the prim is resynced, or when its own
+///         selectability or lock metadata changes.
+//----------------------------------------------------------------------------------------------------------------------
+class InheritedStateCache
+{
+public:
+
+  /// the bits stored in the state of each prim
+  enum StateFlags : uint8_t
+  {
+    kUnselectable = 1 << 0,           ///< the prim, or one of its ancestors, is tagged as unselectable
+    kTransformLocked = 1 << 1,        ///< the lock of the prim resolves to 'transform'
+    kAuthoredUnselectable = 1 << 2,   ///< the prim itself is tagged as unselectable
+    kAuthoredLockTransform = 1 << 3,  ///< the prim itself has its lock set to 'transform'
+    kAuthoredLockUnlocked = 1 << 4,   ///< the prim itself has its lock set to 'unlocked'
+    kResolved = 1 << 7,               ///< the state has been computed (entries without this bit are placeholders)
+
+    kAuthoredMask = kAuthoredUnselectable | kAuthoredLockTransform | kAuthoredLockUnlocked
+  };
+
+  /// \brief  ctor
+  AL_USDMAYA_PUBLIC
+  InheritedStateCache();
+
+  /// \brief  resolves the states of the prim and all of its descendants in a single top down pass. Prims that are
+  ///         already resolved are not re-read.
+  /// \param  root the root of the hierarchy to resolve
+  AL_USDMAYA_PUBLIC
+  void resolve(const UsdPrim& root);
+
+  /// \brief  returns the state of the prim, resolving it (and any unresolved ancestors) if required.
+  /// \param  prim the prim to query
+  /// \return the StateFlags of the prim
+  AL_USDMAYA_PUBLIC
+  uint8_t state(const UsdPrim& prim);
+
+  /// \brief  returns the state of the prim without modifying the cache, so this may be called from multiple threads
+  ///         (as long as no other thread is modifying the cache). If the prim has not been resolved, its state is
+  ///         computed from the nearest resolved ancestor.
+  /// \param  prim the prim to query
+  /// \return the StateFlags of the prim
+  AL_USDMAYA_PUBLIC
+  uint8_t find(const UsdPrim& prim) const;
+
+  /// \brief  returns true if the prim, or one of its ancestors, is tagged as unselectable
+  inline bool isUnselectable(const UsdPrim& prim)
+    { return (state(prim) & kUnselectable) != 0; }
+
+  /// \brief  returns true if the lock of the prim resolves to 'transform'
+  inline bool isTransformLocked(const UsdPrim& prim)
+    { return (state(prim) & kTransformLocked) != 0; }
+
+  /// \brief  inspects the changes described in the notice, and discards the states of any prims that may be affected
+  /// \param  notice the notice from the stage
+  /// \param  changedPaths returns the roots of the hierarchies whose states were discarded. The roots do not overlap.
+  AL_USDMAYA_PUBLIC
+  void invalidate(const UsdNotice::ObjectsChanged& notice, SdfPathVector& changedPaths);
+
+  /// \brief  discards all of the cached states
+  inline void clear()
+    { m_states.clear(); }
+
+  /// \brief  returns the number of entries in the cache
+  inline size_t size() const
+    { return m_states.size(); }
+
+private:
+  static uint8_t computeState(const UsdPrim& prim, uint8_t parentState);
+  SdfPathTable<uint8_t> m_states;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
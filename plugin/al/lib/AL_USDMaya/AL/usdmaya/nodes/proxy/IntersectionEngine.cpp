@@ -0,0 +1,1004 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/nodes/proxy/IntersectionEngine.h"
+#include "AL/usdmaya/DebugCodes.h"
+
+#include "pxr/base/gf/lineSeg.h"
+#include "pxr/base/gf/range3d.h"
+#include "pxr/base/gf/vec4d.h"
+#include "pxr/base/work/loops.h"
+#include "pxr/usd/usd/primRange.h"
+#include "pxr/usd/usdGeom/boundable.h"
+#include "pxr/usd/usdGeom/gprim.h"
+#include "pxr/usd/usdGeom/mesh.h"
+#include "pxr/usd/usdGeom/pointBased.h"
+#include "pxr/usd/usdGeom/tokens.h"
+#include "pxr/usd/usdGeom/xformCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+struct IntersectionEngine::PrimGeometry
+{
+  UsdPrim prim;
+  GfMatrix4d localToRoot;
+  std::vector<GfVec3f> points;      ///< the points of the geometry, in the space of the root prim
+  std::vector<uint32_t> triangles;  ///< three point indices per triangle
+  BoundingVolumeHierarchy hierarchy;
+  bool isMesh = false;
+  bool animatedTransform = false;
+  bool animatedPoints = false;
+  bool animatedTopology = false;
+  bool animatedVisibility = false;
+  bool visible = true;
+
+  inline bool isAnimated() const
+    { return animatedTransform || animatedPoints || animatedTopology; }
+
+  inline GfRange3f bounds() const
+    { return hierarchy.nodes.empty() ? GfRange3f() : hierarchy.nodes[0].bounds; }
+
+  inline size_t triangleCount() const
+    { return triangles.size() / 3; }
+
+  inline void triangle(uint32_t index, GfVec3d& p0, GfVec3d& p1, GfVec3d& p2) const
+  {
+    const uint32_t* tri = triangles.data() + 3 * index;
+    p0 = GfVec3d(points[tri[0]]);
+    p1 = GfVec3d(points[tri[1]]);
+    p2 = GfVec3d(points[tri[2]]);
+  }
+};
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// the triangles of the box used to represent gprims that are not meshes (bits 2, 1 and 0 of a corner index select the
+/// min or max x, y and z of the extent)
+const uint32_t g_boxTriangles[36] =
+{
+  0, 2, 1,  1, 2, 3,
+  4, 5, 6,  5, 7, 6,
+  0, 1, 4,  1, 5, 4,
+  2, 6, 3,  3, 6, 7,
+  0, 4, 2,  2, 4, 6,
+  1, 3, 5,  3, 7, 5
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+inline GfRange3d toRange3d(const GfRange3f& range)
+{
+  return GfRange3d(GfVec3d(range.GetMin()), GfVec3d(range.GetMax()));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// reads the points of the prim (in the space of the prim) and, if requested, the triangles that index them
+bool readLocalGeometry(const UsdPrim& prim, bool isMesh, UsdTimeCode time, bool readTopology,
+                       VtArray<GfVec3f>& points, std::vector<uint32_t>& triangles)
+{
+  if(isMesh)
+  {
+    UsdGeomMesh mesh(prim);
+    if(!mesh.GetPointsAttr().Get(&points, time))
+      return false;
+
+    if(readTopology)
+    {
+      VtArray<int> faceVertexCounts, faceVertexIndices;
+      mesh.GetFaceVertexCountsAttr().Get(&faceVertexCounts, time);
+      mesh.GetFaceVertexIndicesAttr().Get(&faceVertexIndices, time);
+
+      triangles.clear();
+      triangles.reserve(3 * (faceVertexIndices.size() - std::min(faceVertexIndices.size(), 2 * faceVertexCounts.size())));
+      size_t offset = 0;
+      for(int count : faceVertexCounts)
+      {
+        if(count < 0 || offset + count > faceVertexIndices.size())
+          break;
+        for(int i = 2; i < count; ++i)
+        {
+          triangles.push_back(uint32_t(faceVertexIndices[offset]));
+          triangles.push_back(uint32_t(faceVertexIndices[offset + i - 1]));
+          triangles.push_back(uint32_t(faceVertexIndices[offset + i]));
+        }
+        offset += count;
+      }
+    }
+    return true;
+  }
+
+  VtArray<GfVec3f> extent;
+  UsdGeomBoundable boundable(prim);
+  if(!boundable.GetExtentAttr().Get(&extent, time) || extent.size() != 2)
+  {
+    // the extent of point based prims can be computed from their points if it has not been authored
+    VtArray<GfVec3f> pointBasedPoints;
+    UsdGeomPointBased pointBased(prim);
+    if(!pointBased || !pointBased.GetPointsAttr().Get(&pointBasedPoints, time) ||
+       !UsdGeomPointBased::ComputeExtent(pointBasedPoints, &extent))
+      return false;
+  }
+
+  points.resize(8);
+  for(uint32_t i = 0; i < 8; ++i)
+  {
+    points[i] = GfVec3f(extent[(i >> 2) & 1][0], extent[(i >> 1) & 1][1], extent[i & 1][2]);
+  }
+  if(readTopology)
+  {
+    triangles.assign(g_boxTriangles, g_boxTriangles + 36);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// returns true if the transform of the prim, or of any of its ancestors below the root, might be animated
+bool transformMightBeTimeVarying(UsdGeomXformCache& xformCache, UsdPrim prim, const UsdPrim& root)
+{
+  for(; prim && prim != root; prim = prim.GetParent())
+  {
+    if(xformCache.TransformMightBeTimeVarying(prim))
+      return true;
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// returns true if the visibility of the prim, or of any of its ancestors up to the root, might be animated
+bool visibilityMightBeTimeVarying(UsdPrim prim, const UsdPrim& root)
+{
+  for(; prim; prim = prim.GetParent())
+  {
+    UsdGeomImageable imageable(prim);
+    if(imageable && imageable.GetVisibilityAttr().ValueMightBeTimeVarying())
+      return true;
+    if(prim == root)
+      break;
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// the six planes bounding the clip space volume -w <= x,y,z <= w, transformed into the space of the root prim
+struct ClipVolume
+{
+  ClipVolume(const GfMatrix4d& localToClip)
+  {
+    for(int axis = 0; axis < 3; ++axis)
+    {
+      for(int i = 0; i < 4; ++i)
+      {
+        planes[2 * axis][i] = localToClip[i][3] + localToClip[i][axis];
+        planes[2 * axis + 1][i] = localToClip[i][3] - localToClip[i][axis];
+      }
+    }
+  }
+
+  static inline double distance(const GfVec4d& plane, const GfVec3d& p)
+    { return plane[0] * p[0] + plane[1] * p[1] + plane[2] * p[2] + plane[3]; }
+
+  /// returns true if the box lies entirely outside of one of the planes. This may fail to reject boxes near the corners
+  /// of the volume, but never rejects a box that overlaps it.
+  bool isOutside(const GfRange3f& box) const
+  {
+    if(box.IsEmpty())
+      return true;
+    for(const GfVec4d& plane : planes)
+    {
+      const GfVec3d p(plane[0] >= 0 ? box.GetMax()[0] : box.GetMin()[0],
+                      plane[1] >= 0 ? box.GetMax()[1] : box.GetMin()[1],
+                      plane[2] >= 0 ? box.GetMax()[2] : box.GetMin()[2]);
+      if(distance(plane, p) < 0)
+        return true;
+    }
+    return false;
+  }
+
+  /// returns true if the triangle overlaps the volume, along with a point on the triangle within the volume
+  bool intersects(const GfVec3d& p0, const GfVec3d& p1, const GfVec3d& p2, GfVec3d& pointInside) const
+  {
+    // clip the triangle against each plane in turn, and see if anything remains
+    GfVec3d polygon[9] = { p0, p1, p2 };
+    GfVec3d clipped[9];
+    uint32_t count = 3;
+    for(const GfVec4d& plane : planes)
+    {
+      uint32_t clippedCount = 0;
+      for(uint32_t i = 0; i < count; ++i)
+      {
+        const GfVec3d& a = polygon[i];
+        const GfVec3d& b = polygon[(i + 1) % count];
+        const double da = distance(plane, a);
+        const double db = distance(plane, b);
+        if(da >= 0)
+          clipped[clippedCount++] = a;
+        if((da >= 0) != (db >= 0))
+          clipped[clippedCount++] = a + (b - a) * (da / (da - db));
+      }
+      if(!clippedCount)
+        return false;
+      std::copy(clipped, clipped + clippedCount, polygon);
+      count = clippedCount;
+    }
+
+    pointInside = GfVec3d(0);
+    for(uint32_t i = 0; i < count; ++i)
+      pointInside += polygon[i];
+    pointInside /= double(count);
+    return true;
+  }
+
+  GfVec4d planes[6];
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// returns the point on the triangle closest to p
+GfVec3d closestPointOnTriangle(const GfVec3d& p, const GfVec3d& a, const GfVec3d& b, const GfVec3d& c)
+{
+  // find the voronoi region of the triangle containing the point
+  const GfVec3d ab = b - a, ac = c - a, ap = p - a;
+  const double d1 = GfDot(ab, ap), d2 = GfDot(ac, ap);
+  if(d1 <= 0 && d2 <= 0)
+    return a;
+
+  const GfVec3d bp = p - b;
+  const double d3 = GfDot(ab, bp), d4 = GfDot(ac, bp);
+  if(d3 >= 0 && d4 <= d3)
+    return b;
+
+  const double vc = d1 * d4 - d3 * d2;
+  if(vc <= 0 && d1 >= 0 && d3 <= 0)
+    return a + ab * (d1 / (d1 - d3));
+
+  const GfVec3d cp = p - c;
+  const double d5 = GfDot(ab, cp), d6 = GfDot(ac, cp);
+  if(d6 >= 0 && d5 <= d6)
+    return c;
+
+  const double vb = d5 * d2 - d1 * d6;
+  if(vb <= 0 && d2 >= 0 && d6 <= 0)
+    return a + ac * (d2 / (d2 - d6));
+
+  const double va = d3 * d6 - d5 * d4;
+  if(va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+    return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+  const double denom = 1.0 / (va + vb + vc);
+  return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// returns the squared distance between the ray and the triangle (which the ray is assumed to miss), along with the
+/// point on the triangle closest to the ray. If the ray misses, the closest points lie either on an edge of the
+/// triangle, or are the ray origin and the point on the triangle closest to it.
+double rayTriangleDistanceSquared(const GfRay& ray, const GfVec3d& p0, const GfVec3d& p1, const GfVec3d& p2,
+                                  GfVec3d& closest)
+{
+  closest = closestPointOnTriangle(ray.GetStartPoint(), p0, p1, p2);
+  double best = (closest - ray.GetStartPoint()).GetLengthSq();
+
+  const GfVec3d* corners[3] = { &p0, &p1, &p2 };
+  for(int i = 0; i < 3; ++i)
+  {
+    const GfVec3d& a = *corners[i];
+    const GfVec3d& b = *corners[(i + 1) % 3];
+
+    // FindClosestPoints fails for edges parallel to the ray, in which case one of the corners is closest. The point
+    // on the ray is recomputed from the point on the edge, so that it never lies behind the ray origin.
+    GfVec3d segPoint;
+    if(GfFindClosestPoints(ray, GfLineSeg(a, b), nullptr, &segPoint))
+    {
+      const double d = (ray.FindClosestPoint(segPoint) - segPoint).GetLengthSq();
+      if(d < best)
+      {
+        best = d;
+        closest = segPoint;
+      }
+    }
+
+    const double d = (ray.FindClosestPoint(a) - a).GetLengthSq();
+    if(d < best)
+    {
+      best = d;
+      closest = a;
+    }
+  }
+  return best;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// returns the box grown by the distance in each direction
+inline GfRange3d expanded(const GfRange3f& range, double distance)
+{
+  const GfVec3d offset(distance);
+  return GfRange3d(GfVec3d(range.GetMin()) - offset, GfVec3d(range.GetMax()) + offset);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+inline GfVec3d triangleNormal(const GfVec3d& p0, const GfVec3d& p1, const GfVec3d& p2)
+{
+  GfVec3d normal = GfCross(p1 - p0, p2 - p0);
+  normal.Normalize();
+  return normal;
+}
+
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// BoundingVolumeHierarchy
+//----------------------------------------------------------------------------------------------------------------------
+constexpr uint32_t BoundingVolumeHierarchy::kMaxLeafSize;
+
+//----------------------------------------------------------------------------------------------------------------------
+void BoundingVolumeHierarchy::build(const std::vector<GfRange3f>& bounds)
+{
+  clear();
+  if(bounds.empty())
+    return;
+
+  std::vector<GfVec3f> centroids(bounds.size());
+  items.resize(bounds.size());
+  for(uint32_t i = 0, n = bounds.size(); i < n; ++i)
+  {
+    centroids[i] = bounds[i].IsEmpty() ? GfVec3f(0.0f) : bounds[i].GetMidpoint();
+    items[i] = i;
+  }
+  nodes.reserve(2 * (bounds.size() / kMaxLeafSize + 1));
+  buildNode(bounds, centroids, 0, items.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t BoundingVolumeHierarchy::buildNode(const std::vector<GfRange3f>& bounds, const std::vector<GfVec3f>& centroids,
+                                            uint32_t begin, uint32_t end)
+{
+  const uint32_t index = nodes.size();
+  nodes.emplace_back();
+
+  GfRange3f range, centroidRange;
+  for(uint32_t i = begin; i < end; ++i)
+  {
+    range.UnionWith(bounds[items[i]]);
+    centroidRange.UnionWith(centroids[items[i]]);
+  }
+  nodes[index].bounds = range;
+
+  if(end - begin <= kMaxLeafSize)
+  {
+    nodes[index].first = begin;
+    nodes[index].count = end - begin;
+    return index;
+  }
+
+  // split at the median of the longest axis of the centroids
+  const GfVec3f size = centroidRange.GetSize();
+  const int axis = (size[0] >= size[1] && size[0] >= size[2]) ? 0 : (size[1] >= size[2] ? 1 : 2);
+  const uint32_t middle = begin + (end - begin) / 2;
+  std::nth_element(items.begin() + begin, items.begin() + middle, items.begin() + end,
+                   [&centroids, axis](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+
+  buildNode(bounds, centroids, begin, middle);
+  const uint32_t right = buildNode(bounds, centroids, middle, end);
+  nodes[index].first = right;
+  nodes[index].count = 0;
+  return index;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void BoundingVolumeHierarchy::refit(const std::vector<GfRange3f>& bounds)
+{
+  // children are always stored after their parents, so visiting the nodes in reverse updates the children first
+  for(size_t i = nodes.size(); i-- > 0; )
+  {
+    Node& node = nodes[i];
+    GfRange3f range;
+    if(node.count)
+    {
+      for(uint32_t j = node.first, e = node.first + node.count; j < e; ++j)
+        range.UnionWith(bounds[items[j]]);
+    }
+    else
+    {
+      range = GfRange3f::GetUnion(nodes[i + 1].bounds, nodes[node.first].bounds);
+    }
+    node.bounds = range;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// IntersectionEngine
+//----------------------------------------------------------------------------------------------------------------------
+IntersectionEngine::IntersectionEngine()
+  : m_prims(), m_animatedPrims(), m_animatedVisibilityPrims(), m_primHierarchy(), m_root(), m_purposes(), m_excludedPaths(),
+    m_time(UsdTimeCode::Default()), m_built(false)
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+IntersectionEngine::~IntersectionEngine()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IntersectionEngine::clear()
+{
+  m_prims.clear();
+  m_animatedPrims.clear();
+  m_animatedVisibilityPrims.clear();
+  m_primHierarchy.clear();
+  m_root = UsdPrim();
+  m_purposes.clear();
+  m_excludedPaths.clear();
+  m_time = UsdTimeCode::Default();
+  m_built = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+size_t IntersectionEngine::triangleCount() const
+{
+  size_t count = 0;
+  for(const auto& prim : m_prims)
+    count += prim->triangleCount();
+  return count;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IntersectionEngine::build(const UsdPrim& root, UsdTimeCode time, const TfTokenVector& purposes,
+                               const SdfPathVector& excludedPaths)
+{
+  clear();
+  m_root = root;
+  m_purposes = purposes;
+  m_excludedPaths = excludedPaths;
+  m_time = time;
+  m_built = true;
+  if(!root)
+    return;
+
+  SdfPathVector sortedExcludedPaths = excludedPaths;
+  std::sort(sortedExcludedPaths.begin(), sortedExcludedPaths.end());
+
+  // gather the prims, and their transforms. The xform cache is not thread safe, so this is done up front.
+  UsdGeomXformCache xformCache(time);
+  const GfMatrix4d rootInverse = xformCache.GetLocalToWorldTransform(root).GetInverse();
+  UsdPrimRange range(root, UsdTraverseInstanceProxies());
+  for(auto it = range.begin(); it != range.end(); ++it)
+  {
+    const UsdPrim& prim = *it;
+    if(std::binary_search(sortedExcludedPaths.begin(), sortedExcludedPaths.end(), prim.GetPath()))
+    {
+      it.PruneChildren();
+      continue;
+    }
+
+    UsdGeomImageable imageable(prim);
+    if(!imageable)
+      continue;
+
+    // visibility and purpose are both inherited, so skip the descendants too. Prims with animated visibility are
+    // kept, since they may become visible when the time changes.
+    TfToken visibility, purpose;
+    const UsdAttribute visibilityAttr = imageable.GetVisibilityAttr();
+    visibilityAttr.Get(&visibility, time);
+    imageable.GetPurposeAttr().Get(&purpose);
+    if((visibility == UsdGeomTokens->invisible && !visibilityAttr.ValueMightBeTimeVarying()) ||
+       (purpose != UsdGeomTokens->default_ && std::find(purposes.begin(), purposes.end(), purpose) == purposes.end()))
+    {
+      it.PruneChildren();
+      continue;
+    }
+
+    if(!prim.IsA<UsdGeomGprim>())
+      continue;
+
+    std::unique_ptr<PrimGeometry> geom(new PrimGeometry);
+    geom->prim = prim;
+    geom->isMesh = prim.IsA<UsdGeomMesh>();
+    geom->localToRoot = xformCache.GetLocalToWorldTransform(prim) * rootInverse;
+    geom->animatedTransform = transformMightBeTimeVarying(xformCache, prim, root);
+    if(geom->isMesh)
+    {
+      UsdGeomMesh mesh(prim);
+      geom->animatedPoints = mesh.GetPointsAttr().ValueMightBeTimeVarying();
+      geom->animatedTopology = mesh.GetFaceVertexCountsAttr().ValueMightBeTimeVarying() ||
+                               mesh.GetFaceVertexIndicesAttr().ValueMightBeTimeVarying();
+    }
+    else
+    {
+      UsdGeomPointBased pointBased(prim);
+      geom->animatedPoints = UsdGeomBoundable(prim).GetExtentAttr().ValueMightBeTimeVarying() ||
+                             (pointBased && pointBased.GetPointsAttr().ValueMightBeTimeVarying());
+    }
+
+    if(visibilityMightBeTimeVarying(prim, root))
+    {
+      geom->animatedVisibility = true;
+      geom->visible = imageable.ComputeVisibility(time) != UsdGeomTokens->invisible;
+      m_animatedVisibilityPrims.push_back(m_prims.size());
+    }
+
+    if(geom->isAnimated())
+    {
+      m_animatedPrims.push_back(m_prims.size());
+    }
+    m_prims.push_back(std::move(geom));
+  }
+
+  std::vector<uint32_t> allPrims(m_prims.size());
+  for(uint32_t i = 0, n = allPrims.size(); i < n; ++i)
+    allPrims[i] = i;
+  updatePrims(allPrims, true);
+  buildPrimHierarchy();
+
+  TF_DEBUG(ALUSDMAYA_SELECTION).Msg("IntersectionEngine::build %s %zu prims, %zu triangles, %zu animated, %zu with animated visibility\n",
+                                    root.GetPath().GetText(), m_prims.size(), triangleCount(), m_animatedPrims.size(),
+                                    m_animatedVisibilityPrims.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IntersectionEngine::update(UsdTimeCode time)
+{
+  if(!m_built || time == m_time)
+    return;
+
+  m_time = time;
+  if(!m_root)
+    return;
+
+  WorkParallelForN(m_animatedVisibilityPrims.size(), [this, time](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      PrimGeometry& geom = *m_prims[m_animatedVisibilityPrims[i]];
+      geom.visible = UsdGeomImageable(geom.prim).ComputeVisibility(time) != UsdGeomTokens->invisible;
+    }
+  });
+
+  if(m_animatedPrims.empty())
+    return;
+
+  UsdGeomXformCache xformCache(time);
+  const GfMatrix4d rootInverse = xformCache.GetLocalToWorldTransform(m_root).GetInverse();
+  for(uint32_t index : m_animatedPrims)
+  {
+    PrimGeometry& geom = *m_prims[index];
+    if(geom.animatedTransform)
+    {
+      geom.localToRoot = xformCache.GetLocalToWorldTransform(geom.prim) * rootInverse;
+    }
+  }
+
+  updatePrims(m_animatedPrims, false);
+  buildPrimHierarchy();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IntersectionEngine::updatePrims(const std::vector<uint32_t>& primIndices, bool rebuild)
+{
+  const UsdTimeCode time = m_time;
+  WorkParallelForN(primIndices.size(), [this, &primIndices, rebuild, time](size_t begin, size_t end)
+  {
+    VtArray<GfVec3f> localPoints;
+    std::vector<GfRange3f> triangleBounds;
+    for(size_t i = begin; i < end; ++i)
+    {
+      PrimGeometry& geom = *m_prims[primIndices[i]];
+      const bool readTopology = rebuild || geom.animatedTopology;
+      if(!readLocalGeometry(geom.prim, geom.isMesh, time, readTopology, localPoints, geom.triangles))
+      {
+        localPoints.clear();
+        geom.triangles.clear();
+      }
+
+      // discard the triangles if the topology does not match the points
+      const uint32_t numPoints = localPoints.size();
+      if(std::any_of(geom.triangles.begin(), geom.triangles.end(), [numPoints](uint32_t index) { return index >= numPoints; }))
+      {
+        geom.triangles.clear();
+      }
+
+      geom.points.resize(numPoints);
+      for(uint32_t j = 0; j < numPoints; ++j)
+      {
+        geom.points[j] = GfVec3f(geom.localToRoot.TransformAffine(GfVec3d(localPoints[j])));
+      }
+
+      const uint32_t numTriangles = geom.triangleCount();
+      triangleBounds.resize(numTriangles);
+      const uint32_t* tri = geom.triangles.data();
+      for(uint32_t j = 0; j < numTriangles; ++j, tri += 3)
+      {
+        GfRange3f& range = triangleBounds[j];
+        range = GfRange3f(geom.points[tri[0]], geom.points[tri[0]]);
+        range.UnionWith(geom.points[tri[1]]);
+        range.UnionWith(geom.points[tri[2]]);
+      }
+
+      if(readTopology || geom.hierarchy.items.size() != numTriangles)
+      {
+        geom.hierarchy.build(triangleBounds);
+      }
+      else
+      {
+        geom.hierarchy.refit(triangleBounds);
+      }
+    }
+  });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IntersectionEngine::buildPrimHierarchy()
+{
+  std::vector<GfRange3f> primBounds(m_prims.size());
+  for(size_t i = 0, n = m_prims.size(); i < n; ++i)
+  {
+    primBounds[i] = m_prims[i]->bounds();
+  }
+  m_primHierarchy.build(primBounds);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool IntersectionEngine::intersectRay(const GfRay& ray, Hit* hit) const
+{
+  if(m_primHierarchy.nodes.empty())
+    return false;
+
+  // find the prims whose bounds are hit, and visit them in order of distance so that most can be skipped
+  std::vector<std::pair<double, uint32_t>> candidates;
+  std::vector<uint32_t> stack(1, 0);
+  while(!stack.empty())
+  {
+    const BoundingVolumeHierarchy::Node& node = m_primHierarchy.nodes[stack.back()];
+    const uint32_t nodeIndex = stack.back();
+    stack.pop_back();
+
+    double enter, exit;
+    if(!ray.Intersect(toRange3d(node.bounds), &enter, &exit) || exit < 0)
+      continue;
+
+    if(node.count)
+    {
+      for(uint32_t i = node.first, e = node.first + node.count; i < e; ++i)
+      {
+        const uint32_t primIndex = m_primHierarchy.items[i];
+        if(!m_prims[primIndex]->visible)
+          continue;
+        double primEnter, primExit;
+        if(ray.Intersect(toRange3d(m_prims[primIndex]->bounds()), &primEnter, &primExit) && primExit >= 0)
+          candidates.emplace_back(primEnter, primIndex);
+      }
+    }
+    else
+    {
+      stack.push_back(node.first);
+      stack.push_back(nodeIndex + 1);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  double closestDistance = std::numeric_limits<double>::infinity();
+  const PrimGeometry* closestPrim = nullptr;
+  uint32_t closestTriangle = 0;
+  for(const auto& candidate : candidates)
+  {
+    if(candidate.first > closestDistance)
+      break;
+
+    const PrimGeometry& geom = *m_prims[candidate.second];
+    stack.assign(1, 0);
+    while(!stack.empty())
+    {
+      const uint32_t nodeIndex = stack.back();
+      const BoundingVolumeHierarchy::Node& node = geom.hierarchy.nodes[nodeIndex];
+      stack.pop_back();
+
+      double enter, exit;
+      if(!ray.Intersect(toRange3d(node.bounds), &enter, &exit) || exit < 0 || enter > closestDistance)
+        continue;
+
+      if(node.count)
+      {
+        for(uint32_t i = node.first, e = node.first + node.count; i < e; ++i)
+        {
+          const uint32_t triangle = geom.hierarchy.items[i];
+          GfVec3d p0, p1, p2;
+          geom.triangle(triangle, p0, p1, p2);
+          double distance;
+          if(ray.Intersect(p0, p1, p2, &distance, nullptr, nullptr, closestDistance))
+          {
+            closestDistance = distance;
+            closestPrim = &geom;
+            closestTriangle = triangle;
+          }
+        }
+      }
+      else
+      {
+        stack.push_back(node.first);
+        stack.push_back(nodeIndex + 1);
+      }
+    }
+  }
+
+  if(!closestPrim)
+    return false;
+
+  if(hit)
+  {
+    GfVec3d p0, p1, p2;
+    closestPrim->triangle(closestTriangle, p0, p1, p2);
+    GfVec3d normal = triangleNormal(p0, p1, p2);
+    if(GfDot(normal, ray.GetDirection()) > 0)
+      normal = -normal;
+    hit->path = closestPrim->prim.GetPath();
+    hit->point = ray.GetPoint(closestDistance);
+    hit->normal = normal;
+    hit->distance = closestDistance;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool IntersectionEngine::closestPointToRay(const GfRay& ray, double maxDistance, Hit* hit) const
+{
+  if(m_primHierarchy.nodes.empty() || maxDistance < 0)
+    return false;
+
+  // a ray within the current best distance of a box must hit the box grown by that distance, which allows nodes to be
+  // skipped in the same way as for intersectRay
+  double bestDistance = maxDistance;
+  double bestDistanceSq = maxDistance * maxDistance;
+  const PrimGeometry* closestPrim = nullptr;
+  uint32_t closestTriangle = 0;
+  GfVec3d closestPoint(0);
+
+  std::vector<uint32_t> stack(1, 0);
+  std::vector<uint32_t> primStack;
+  while(!stack.empty())
+  {
+    const uint32_t nodeIndex = stack.back();
+    const BoundingVolumeHierarchy::Node& node = m_primHierarchy.nodes[nodeIndex];
+    stack.pop_back();
+
+    double enter, exit;
+    if(!ray.Intersect(expanded(node.bounds, bestDistance), &enter, &exit) || exit < 0)
+      continue;
+
+    if(!node.count)
+    {
+      stack.push_back(node.first);
+      stack.push_back(nodeIndex + 1);
+      continue;
+    }
+
+    for(uint32_t p = node.first, pe = node.first + node.count; p < pe; ++p)
+    {
+      const PrimGeometry& geom = *m_prims[m_primHierarchy.items[p]];
+      if(!geom.visible || geom.hierarchy.nodes.empty())
+        continue;
+
+      primStack.assign(1, 0);
+      while(!primStack.empty())
+      {
+        const uint32_t primNodeIndex = primStack.back();
+        const BoundingVolumeHierarchy::Node& primNode = geom.hierarchy.nodes[primNodeIndex];
+        primStack.pop_back();
+
+        if(!ray.Intersect(expanded(primNode.bounds, bestDistance), &enter, &exit) || exit < 0)
+          continue;
+
+        if(!primNode.count)
+        {
+          primStack.push_back(primNode.first);
+          primStack.push_back(primNodeIndex + 1);
+          continue;
+        }
+
+        for(uint32_t i = primNode.first, e = primNode.first + primNode.count; i < e; ++i)
+        {
+          const uint32_t triangle = geom.hierarchy.items[i];
+          GfVec3d p0, p1, p2, point;
+          geom.triangle(triangle, p0, p1, p2);
+          const double distanceSq = rayTriangleDistanceSquared(ray, p0, p1, p2, point);
+          if(distanceSq <= bestDistanceSq)
+          {
+            bestDistanceSq = distanceSq;
+            bestDistance = std::sqrt(distanceSq);
+            closestPrim = &geom;
+            closestTriangle = triangle;
+            closestPoint = point;
+          }
+        }
+      }
+    }
+  }
+
+  if(!closestPrim)
+    return false;
+
+  if(hit)
+  {
+    GfVec3d p0, p1, p2;
+    closestPrim->triangle(closestTriangle, p0, p1, p2);
+    GfVec3d normal = triangleNormal(p0, p1, p2);
+    if(GfDot(normal, ray.GetDirection()) > 0)
+      normal = -normal;
+    hit->path = closestPrim->prim.GetPath();
+    hit->point = closestPoint;
+    hit->normal = normal;
+    hit->distance = bestDistance;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IntersectionEngine::intersectVolume(const GfMatrix4d& localToClip, std::vector<Hit>& hits) const
+{
+  hits.clear();
+  if(m_primHierarchy.nodes.empty())
+    return;
+
+  const ClipVolume volume(localToClip);
+
+  // find the prims whose bounds overlap the volume
+  std::vector<uint32_t> candidates;
+  std::vector<uint32_t> stack(1, 0);
+  while(!stack.empty())
+  {
+    const uint32_t nodeIndex = stack.back();
+    const BoundingVolumeHierarchy::Node& node = m_primHierarchy.nodes[nodeIndex];
+    stack.pop_back();
+    if(volume.isOutside(node.bounds))
+      continue;
+
+    if(node.count)
+    {
+      for(uint32_t i = node.first, e = node.first + node.count; i < e; ++i)
+      {
+        const uint32_t primIndex = m_primHierarchy.items[i];
+        if(m_prims[primIndex]->visible && !volume.isOutside(m_prims[primIndex]->bounds()))
+          candidates.push_back(primIndex);
+      }
+    }
+    else
+    {
+      stack.push_back(node.first);
+      stack.push_back(nodeIndex + 1);
+    }
+  }
+
+  // then search the triangles of each of those prims for one that lies within the volume
+  std::vector<Hit> candidateHits(candidates.size());
+  std::vector<uint8_t> candidateWasHit(candidates.size(), 0);
+  WorkParallelForN(candidates.size(), [this, &volume, &candidates, &candidateHits, &candidateWasHit](size_t begin, size_t end)
+  {
+    std::vector<uint32_t> primStack;
+    for(size_t c = begin; c < end; ++c)
+    {
+      const PrimGeometry& geom = *m_prims[candidates[c]];
+      primStack.assign(1, 0);
+      while(!primStack.empty() && !candidateWasHit[c])
+      {
+        const uint32_t nodeIndex = primStack.back();
+        const BoundingVolumeHierarchy::Node& node = geom.hierarchy.nodes[nodeIndex];
+        primStack.pop_back();
+        if(volume.isOutside(node.bounds))
+          continue;
+
+        if(node.count)
+        {
+          for(uint32_t i = node.first, e = node.first + node.count; i < e; ++i)
+          {
+            GfVec3d p0, p1, p2, pointInside;
+            geom.triangle(geom.hierarchy.items[i], p0, p1, p2);
+            if(volume.intersects(p0, p1, p2, pointInside))
+            {
+              Hit& hit = candidateHits[c];
+              hit.path = geom.prim.GetPath();
+              hit.point = pointInside;
+              hit.normal = triangleNormal(p0, p1, p2);
+              hit.distance = 0;
+              candidateWasHit[c] = 1;
+              break;
+            }
+          }
+        }
+        else
+        {
+          primStack.push_back(node.first);
+          primStack.push_back(nodeIndex + 1);
+        }
+      }
+    }
+  });
+
+  for(size_t c = 0, n = candidates.size(); c < n; ++c)
+  {
+    if(candidateWasHit[c])
+      hits.push_back(std::move(candidateHits[c]));
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool IntersectionEngine::isRelevantChange(const SdfPath& path) const
+{
+  const SdfPath primPath = path.GetPrimPath();
+  const SdfPath& rootPath = m_root.GetPath();
+  if(!primPath.HasPrefix(rootPath) && !rootPath.HasPrefix(primPath))
+    return false;
+
+  // metadata changes on prims (selectability, locks, custom data, etc) do not affect the geometry
+  if(!path.IsPropertyPath())
+    return false;
+
+  // neither do primvars
+  static const std::string primvarsPrefix("primvars:");
+  const std::string& name = path.GetName();
+  return name.compare(0, primvarsPrefix.size(), primvarsPrefix) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void IntersectionEngine::invalidate(const UsdNotice::ObjectsChanged& notice)
+{
+  if(!m_built)
+    return;
+
+  bool dirty = !m_root.IsValid();
+  if(!dirty)
+  {
+    const SdfPath& rootPath = m_root.GetPath();
+    for(const SdfPath& path : notice.GetResyncedPaths())
+    {
+      const SdfPath primPath = path.GetPrimPath();
+      if(primPath.HasPrefix(rootPath) || rootPath.HasPrefix(primPath))
+      {
+        dirty = true;
+        break;
+      }
+    }
+  }
+
+  if(!dirty)
+  {
+    for(const SdfPath& path : notice.GetChangedInfoOnlyPaths())
+    {
+      if(isRelevantChange(path))
+      {
+        dirty = true;
+        break;
+      }
+    }
+  }
+
+  if(dirty)
+  {
+    TF_DEBUG(ALUSDMAYA_SELECTION).Msg("IntersectionEngine::invalidate\n");
+    clear();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
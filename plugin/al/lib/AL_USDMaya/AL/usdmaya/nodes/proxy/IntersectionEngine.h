@@ -0,0 +1,211 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "../../Api.h"
+
+#include "pxr/base/gf/matrix4d.h"
+#include "pxr/base/gf/range3f.h"
+#include "pxr/base/gf/ray.h"
+#include "pxr/base/gf/vec3f.h"
+#include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/notice.h"
+#include "pxr/usd/usd/prim.h"
+
+#include <memory>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A bounding volume hierarchy, stored as a flat array of nodes in depth first order. The left child of an
+///         internal node immediately follows it in the array, so the nodes can be refitted by visiting them in reverse.
+//----------------------------------------------------------------------------------------------------------------------
+struct BoundingVolumeHierarchy
+{
+  /// the maximum number of items stored in a leaf node
+  static constexpr uint32_t kMaxLeafSize = 4;
+
+  struct Node
+  {
+    GfRange3f bounds;
+    uint32_t first;  ///< for leaves, the index of the first item in the items array. For internal nodes, the index of the right child
+    uint32_t count;  ///< the number of items in a leaf, or zero for internal nodes
+  };
+
+  /// \brief  builds the hierarchy over the items with the specified bounds
+  /// \param  bounds the bounds of each item
+  AL_USDMAYA_PUBLIC
+  void build(const std::vector<GfRange3f>& bounds);
+
+  /// \brief  recomputes the bounds of the nodes without modifying the structure of the hierarchy
+  /// \param  bounds the new bounds of each item. This must be the same size as the array the hierarchy was built with
+  AL_USDMAYA_PUBLIC
+  void refit(const std::vector<GfRange3f>& bounds);
+
+  /// \brief  discards the hierarchy
+  inline void clear()
+    { nodes.clear(); items.clear(); }
+
+  std::vector<Node> nodes;
+  std::vector<uint32_t> items;
+
+private:
+  uint32_t buildNode(const std::vector<GfRange3f>& bounds, const std::vector<GfVec3f>& centroids, uint32_t begin, uint32_t end);
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A CPU intersection engine for the geometry of a proxy shape, which answers ray picking and selection
+///         volume queries without requiring an OpenGL context.
+///
+///         The geometry of the UsdGeomMesh prims below the root prim is triangulated and stored in the space of the
+///         root prim, along with a bounding volume hierarchy over the triangles of each mesh. Other gprims (e.g.
+///         curves and points) are represented by the box of their extent. A second hierarchy over the bounds of all of
+///         the prims is used to find the candidate prims for each query. When the time changes, only the prims with
+///         animated points or transforms are re-read, and their hierarchies are refitted rather than rebuilt.
+///
+///         Prims that are invisible are skipped when building, unless their visibility (or that of one of their
+///         ancestors) is animated. Those prims are kept, along with their visibility at the current time, and queries
+///         ignore them while they are invisible.
+///
+///         Building, updating, and volume queries are distributed across worker threads. The engine must be rebuilt
+///         if the stage is modified (see invalidate).
+//----------------------------------------------------------------------------------------------------------------------
+class IntersectionEngine
+{
+public:
+
+  /// \brief  describes an intersection with the geometry of a prim
+  struct Hit
+  {
+    SdfPath path;       ///< the path of the prim that was hit
+    GfVec3d point;      ///< the intersection point, in the space of the root prim
+    GfVec3d normal;     ///< the normal of the surface at the intersection point (facing the ray origin for ray hits)
+    double distance;    ///< the distance along the ray to the intersection (zero for volume hits, and the distance
+                        ///< between the ray and the point for closest point queries)
+  };
+
+  /// \brief  ctor
+  AL_USDMAYA_PUBLIC
+  IntersectionEngine();
+
+  /// \brief  dtor
+  AL_USDMAYA_PUBLIC
+  ~IntersectionEngine();
+
+  /// \brief  reads the geometry under the root prim, and builds the hierarchies used to query it
+  /// \param  root the root prim of the geometry to intersect
+  /// \param  time the time at which to read the geometry
+  /// \param  purposes the purposes of the prims to include
+  /// \param  excludedPaths the paths of any prims (and their descendants) that should not be included
+  AL_USDMAYA_PUBLIC
+  void build(const UsdPrim& root, UsdTimeCode time, const TfTokenVector& purposes, const SdfPathVector& excludedPaths);
+
+  /// \brief  updates the animated prims to the specified time, refitting their hierarchies, and updates the visibility
+  ///         of the prims with animated visibility
+  /// \param  time the new time
+  AL_USDMAYA_PUBLIC
+  void update(UsdTimeCode time);
+
+  /// \brief  discards all of the geometry
+  AL_USDMAYA_PUBLIC
+  void clear();
+
+  /// \brief  inspects the changes described in the notice, and discards the geometry if it may be affected
+  /// \param  notice the notice from the stage
+  AL_USDMAYA_PUBLIC
+  void invalidate(const UsdNotice::ObjectsChanged& notice);
+
+  /// \brief  finds the closest intersection of the ray with the geometry
+  /// \param  ray the ray, in the space of the root prim
+  /// \param  hit the returned hit
+  /// \return true if the ray hit any geometry
+  AL_USDMAYA_PUBLIC
+  bool intersectRay(const GfRay& ray, Hit* hit) const;
+
+  /// \brief  finds the point on the geometry that is closest to the ray, for rays that miss the geometry
+  /// \param  ray the ray, in the space of the root prim
+  /// \param  maxDistance only geometry within this distance of the ray is considered
+  /// \param  hit the returned hit. The normal faces the ray origin.
+  /// \return true if any geometry lies within maxDistance of the ray
+  AL_USDMAYA_PUBLIC
+  bool closestPointToRay(const GfRay& ray, double maxDistance, Hit* hit) const;
+
+  /// \brief  finds the prims that have geometry within a selection volume. The volume is specified as a matrix that
+  ///         transforms points from the space of the root prim into clip space (e.g. the product of the root to world,
+  ///         view, and projection matrices). Points within the volume are those where -w <= x,y,z <= w.
+  /// \param  localToClip the matrix that transforms root space into the clip space of the volume
+  /// \param  hits the returned hits, one per prim found. The point of each hit lies within the volume.
+  AL_USDMAYA_PUBLIC
+  void intersectVolume(const GfMatrix4d& localToClip, std::vector<Hit>& hits) const;
+
+  /// \brief  returns true if the geometry has been built
+  inline bool isBuilt() const
+    { return m_built; }
+
+  /// \brief  returns the root prim the engine was built for
+  inline const UsdPrim& root() const
+    { return m_root; }
+
+  /// \brief  returns the purposes the engine was built for
+  inline const TfTokenVector& purposes() const
+    { return m_purposes; }
+
+  /// \brief  returns the paths that were excluded when the engine was built
+  inline const SdfPathVector& excludedPaths() const
+    { return m_excludedPaths; }
+
+  /// \brief  returns the time the geometry was last read at
+  inline UsdTimeCode time() const
+    { return m_time; }
+
+  /// \brief  returns the number of prims stored
+  inline size_t primCount() const
+    { return m_prims.size(); }
+
+  /// \brief  returns the total number of triangles stored
+  AL_USDMAYA_PUBLIC
+  size_t triangleCount() const;
+
+private:
+  struct PrimGeometry;
+
+  void updatePrims(const std::vector<uint32_t>& primIndices, bool rebuild);
+  void buildPrimHierarchy();
+  bool isRelevantChange(const SdfPath& path) const;
+
+  std::vector<std::unique_ptr<PrimGeometry>> m_prims;
+  std::vector<uint32_t> m_animatedPrims;
+  std::vector<uint32_t> m_animatedVisibilityPrims;
+  BoundingVolumeHierarchy m_primHierarchy;
+  UsdPrim m_root;
+  TfTokenVector m_purposes;
+  SdfPathVector m_excludedPaths;
+  UsdTimeCode m_time;
+  bool m_built;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
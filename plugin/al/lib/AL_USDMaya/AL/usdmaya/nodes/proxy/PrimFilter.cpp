@@ -2,6 +2,10 @@
 #include "AL/usdmaya/nodes/proxy/PrimFilter.h"
 #include "AL/usdmaya/fileio/SchemaPrims.h"
 
+#include "pxr/base/tf/hashmap.h"
+#include "pxr/base/tf/hashset.h"
+#include "pxr/base/work/loops.h"
+
 namespace AL {
 namespace usdmaya {
 namespace nodes {
@@ -9,56 +13,92 @@ namespace proxy {
 
 //----------------------------------------------------------------------------------------------------------------------
 PrimFilter::PrimFilter(const SdfPathVector& previousPrims, const std::vector<UsdPrim>& newPrimSet, PrimFilterInterface* proxy)
-        : m_newPrimSet(newPrimSet), m_transformsToCreate(), m_updatablePrimSet(), m_removedPrimSet()
+        : m_newPrimSet(), m_transformsToCreate(), m_updatablePrimSet(), m_removedPrimSet()
 {
-  // copy over original prims
-  m_removedPrimSet.assign(previousPrims.begin(), previousPrims.end());
-  std::sort(m_removedPrimSet.begin(), m_removedPrimSet.end(),  [](const SdfPath& a, const SdfPath& b){ return b < a; } );
+  const size_t numPrims = newPrimSet.size();
 
-  for(auto it = m_newPrimSet.begin(); it != m_newPrimSet.end(); )
+  // look up the previous & current type of each prim up front, since these are independent of each other
+  std::vector<TfToken> previousTypes(numPrims);
+  std::vector<TfToken> newTypes(numPrims);
+  WorkParallelForN(numPrims, [&](size_t begin, size_t end)
   {
-    UsdPrim prim = *it;
-    auto lastIt = it;
-    ++it;
-
-    SdfPath path = prim.GetPath();
-
-    // check previous prim type (if it exists at all?)
-    TfToken type = proxy->getTypeForPath(path);
-    TfToken newType = prim.GetTypeName();
+    for(size_t i = begin; i < end; ++i)
+    {
+      previousTypes[i] = proxy->getTypeForPath(newPrimSet[i].GetPath());
+      newTypes[i] = newPrimSet[i].GetTypeName();
+    }
+  });
 
+  // the translator info only depends on the type, of which there will only be a handful
+  struct TypeInfo
+  {
     bool supportsUpdate = false;
     bool requiresParent = false;
-    proxy->getTypeInfo(newType, supportsUpdate, requiresParent);
+  };
+  TfHashMap<TfToken, TypeInfo, TfToken::HashFunctor> typeInfos;
+
+  // the previous prims that have not (yet) been found in the new prim set
+  TfHashSet<SdfPath, SdfPath::Hash> removedPaths(previousPrims.begin(), previousPrims.end());
+
+  m_newPrimSet.reserve(numPrims);
+  for(size_t i = 0; i < numPrims; ++i)
+  {
+    const UsdPrim& prim = newPrimSet[i];
+    const TfToken& type = previousTypes[i];
+    const TfToken& newType = newTypes[i];
+
+    auto typeIt = typeInfos.find(newType);
+    if(typeIt == typeInfos.end())
+    {
+      TypeInfo info;
+      proxy->getTypeInfo(newType, info.supportsUpdate, info.requiresParent);
+      typeIt = typeInfos.insert(std::make_pair(newType, info)).first;
+    }
+    bool requiresParent = typeIt->second.requiresParent;
 
     // if the type remains the same, and the type supports update
     if(type == newType)
     {
-      if(supportsUpdate)
+      if(typeIt->second.supportsUpdate)
       {
         TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg(
-                  "PrimFilter::PrimFilter %s prim has not changed type and supports updates or inactive.\n", path.GetText());
-        // locate the path and delete from the removed set (we do not want to delete this prim!
-        // Note that m_removedPrimSet is reverse sorted
-        auto iter = std::lower_bound(m_removedPrimSet.begin(), m_removedPrimSet.end(), path, [](const SdfPath& a, const SdfPath& b){ return b < a; } );
-        if(iter != removedPrimSet().end() && *iter == path)
+                  "PrimFilter::PrimFilter %s prim has not changed type and supports updates or inactive.\n", prim.GetPath().GetText());
+        // remove the path from the removed set (we do not want to delete this prim!)
+        if(removedPaths.erase(prim.GetPath()))
         {
-          m_removedPrimSet.erase(iter);
           m_updatablePrimSet.push_back(prim);
           // skip creating transforms in this case.
           requiresParent = false;
         }
       }
-
       //If the prim is still already there with the same type, it isn't new.
-      it = m_newPrimSet.erase(lastIt);
     }
+    else
+    {
+      m_newPrimSet.push_back(prim);
+    }
+
     // if we need a transform, make a note of it now
     if(requiresParent)
     {
       m_transformsToCreate.push_back(prim);
     }
   }
+
+  // gather the previous prims that are no longer needed. These are reverse sorted so that children are removed before
+  // their parents.
+  if(!removedPaths.empty())
+  {
+    m_removedPrimSet.reserve(removedPaths.size());
+    for(const SdfPath& path : previousPrims)
+    {
+      if(removedPaths.count(path))
+      {
+        m_removedPrimSet.push_back(path);
+      }
+    }
+    std::sort(m_removedPrimSet.begin(), m_removedPrimSet.end(),  [](const SdfPath& a, const SdfPath& b){ return b < a; } );
+  }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
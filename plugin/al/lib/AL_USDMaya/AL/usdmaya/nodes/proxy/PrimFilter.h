@@ -40,6 +40,7 @@ struct PrimFilterInterface
   ///         which the proxy shape has previously cached (i.e. the old state of the prim prior to a variant switch).
   ///         If the proxy shape is aware of the prim, and the returned info is valid, true will be returned. If the
   ///         proxy shape is unaware of the prim (i.e. a variant switch has created it), then false will be returned.
+  ///         The PrimFilter calls this method from multiple threads, so it must not modify any state.
   /// \param  path the path to the prim we are querying
   /// \return true if the prim is known about, and the info structure contains valid information. False if the prim is
   ///         an unknown type
@@ -55,7 +56,10 @@ struct PrimFilterInterface
 };
 
 //----------------------------------------------------------------------------------------------------------------------
-/// \brief  A class to filter the prims during a variant switch
+/// \brief  A class to filter the prims during a variant switch. The prims are classified in a single pass using hashed
+///         lookups (so the cost is linear in the number of prims), and the relative order of the new, updatable, and
+///         transform prims is the same as in the newPrimSet passed in. Since the filter only reads from the stage and
+///         the PrimFilterInterface, it may be constructed away from the main thread.
 //----------------------------------------------------------------------------------------------------------------------
 class PrimFilter
 {
@@ -80,7 +84,8 @@ public:
   inline const std::vector<UsdPrim>& updatablePrimSet() const
     { return m_updatablePrimSet; }
 
-  /// \brief  returns the list of prims that have been removed from the stage
+  /// \brief  returns the list of prims that have been removed from the stage (reverse sorted, so that children are
+  ///         listed before their parents)
   inline const SdfPathVector& removedPrimSet() const
     { return m_removedPrimSet; }
 
@@ -0,0 +1,189 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/nodes/proxy/StagePrefetcher.h"
+#include "AL/usdmaya/DebugCodes.h"
+
+#include "pxr/base/work/detachedTask.h"
+#include "pxr/usd/ar/resolverContextBinder.h"
+#include "pxr/usd/sdf/layerUtils.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <unordered_set>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+struct StagePrefetcher::Request
+{
+  Request(const std::string& filePath, const ArResolverContext& context, UsdStage::InitialLoadSet loadSet)
+    : m_filePath(filePath), m_context(context), m_loadSet(loadSet), m_cancelled(false), m_finished(false)
+  {
+  }
+
+  void run()
+  {
+    SdfLayerRefPtrVector layers;
+    if(!m_cancelled)
+    {
+      TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("StagePrefetcher prefetching %s\n", m_filePath.c_str());
+      ArResolverContextBinder binder(m_context);
+      if(SdfLayerRefPtr rootLayer = SdfLayer::FindOrOpen(m_filePath))
+      {
+        layers.push_back(rootLayer);
+      }
+
+      // walk the layers breadth first, opening each of the layers they refer to
+      std::unordered_set<std::string> visited;
+      for(size_t i = 0; i < layers.size() && !m_cancelled; ++i)
+      {
+        const SdfLayerRefPtr layer = layers[i];
+        std::set<std::string> assetPaths;
+        if(m_loadSet == UsdStage::LoadNone)
+        {
+          const std::vector<std::string> subLayerPaths = layer->GetSubLayerPaths();
+          assetPaths.insert(subLayerPaths.begin(), subLayerPaths.end());
+        }
+        else
+        {
+          assetPaths = layer->GetExternalReferences();
+        }
+        for(const std::string& assetPath : assetPaths)
+        {
+          if(assetPath.empty())
+            continue;
+          const std::string path = SdfComputeAssetPathRelativeToLayer(layer, assetPath);
+          if(!visited.insert(path).second)
+            continue;
+          if(SdfLayerRefPtr child = SdfLayer::FindOrOpen(path))
+          {
+            layers.push_back(child);
+          }
+        }
+      }
+      TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("StagePrefetcher opened %zu layers for %s\n", layers.size(), m_filePath.c_str());
+    }
+
+    // if nobody is going to take the layers, release them now
+    if(m_cancelled)
+    {
+      layers.clear();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_layers.swap(layers);
+      m_finished = true;
+    }
+    m_finishedCondition.notify_all();
+  }
+
+  bool matches(const std::string& filePath, const ArResolverContext& context) const
+  {
+    return m_filePath == filePath && m_context == context;
+  }
+
+  SdfLayerRefPtrVector wait()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finishedCondition.wait(lock, [this]() { return m_finished; });
+    SdfLayerRefPtrVector layers;
+    layers.swap(m_layers);
+    return layers;
+  }
+
+  const std::string m_filePath;
+  const ArResolverContext m_context;
+  const UsdStage::InitialLoadSet m_loadSet;
+  std::atomic<bool> m_cancelled;
+  std::mutex m_mutex;
+  std::condition_variable m_finishedCondition;
+  SdfLayerRefPtrVector m_layers;
+  bool m_finished;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+StagePrefetcher::StagePrefetcher()
+  : m_request()
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+StagePrefetcher::~StagePrefetcher()
+{
+  cancel();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void StagePrefetcher::prefetch(const std::string& filePath, const ArResolverContext& context, UsdStage::InitialLoadSet loadSet)
+{
+  if(m_request && m_request->matches(filePath, context) && m_request->m_loadSet == loadSet)
+    return;
+
+  cancel();
+  if(filePath.empty())
+    return;
+
+  // the worker holds its own reference to the request, so that the prefetcher may be destroyed before it finishes
+  std::shared_ptr<Request> request = std::make_shared<Request>(filePath, context, loadSet);
+  WorkRunDetachedTask([request]() { request->run(); });
+  m_request = request;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void StagePrefetcher::cancel()
+{
+  if(m_request)
+  {
+    TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("StagePrefetcher cancelled %s\n", m_request->m_filePath.c_str());
+    m_request->m_cancelled = true;
+
+    // the prefetch may have already finished, in which case the layers are released here
+    std::lock_guard<std::mutex> lock(m_request->m_mutex);
+    m_request->m_layers.clear();
+  }
+  m_request.reset();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+SdfLayerRefPtrVector StagePrefetcher::take(const std::string& filePath, const ArResolverContext& context)
+{
+  if(!m_request)
+    return SdfLayerRefPtrVector();
+
+  // layers resolved with a different context may not be the ones the stage would use
+  if(!m_request->matches(filePath, context))
+  {
+    cancel();
+    return SdfLayerRefPtrVector();
+  }
+
+  SdfLayerRefPtrVector layers = m_request->wait();
+  m_request.reset();
+  return layers;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,103 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "../../Api.h"
+
+#include "pxr/usd/ar/resolverContext.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/usd/stage.h"
+
+#include <memory>
+#include <string>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Opens the layers used by a proxy shape's stage on a worker thread, ahead of the proxy shape opening its
+///         stage.
+///
+///         While a maya file is being read, the proxy shapes cannot open their stages until the whole file has been
+///         read (their session layers are held by the LayerManager, which may not have been read yet), at which point
+///         the stages are opened one after another. Instead, once the file has been read, every proxy shape starts a
+///         prefetch before any of them opens its stage. The prefetch opens the root layer on a worker thread, followed
+///         by the layers it depends on, so the layers of all the proxy shapes are read concurrently while the
+///         LayerManager is loaded and the other proxy shapes are set up. The stage itself is not composed, since the
+///         proxy shape composes its own stage with its session layer. Holding onto the prefetched layers keeps them
+///         open, so when the proxy shape opens its stage the layers are found in the layer registry rather than being
+///         read again.
+///
+///         The asset paths are resolved with the resolver context of the proxy shape, which is bound on the worker
+///         thread, so a prefetch is not affected by the resolver being configured for another proxy shape on the main
+///         thread. When the payloads of the stage will not be loaded, only the layer stack of the root layer is opened.
+///
+///         A prefetch can be cancelled (e.g. when the file path changes, or the proxy shape is deleted). A cancelled
+///         prefetch that has not started is skipped, and one that has started releases its layers when it finishes.
+//----------------------------------------------------------------------------------------------------------------------
+class StagePrefetcher
+{
+public:
+
+  /// \brief  ctor
+  AL_USDMAYA_PUBLIC
+  StagePrefetcher();
+
+  /// \brief  dtor. Cancels any pending prefetch.
+  AL_USDMAYA_PUBLIC
+  ~StagePrefetcher();
+
+  /// \brief  starts opening the layers on a worker thread, cancelling any previous prefetch. Does nothing if the same
+  ///         file is already being prefetched with the same resolver context and load set.
+  /// \param  filePath the resolved path of the root layer of the stage
+  /// \param  context the resolver context the proxy shape opens its stage with
+  /// \param  loadSet whether the payloads of the stage will be loaded. If not, only the layer stack of the root layer
+  ///         is opened.
+  AL_USDMAYA_PUBLIC
+  void prefetch(const std::string& filePath, const ArResolverContext& context, UsdStage::InitialLoadSet loadSet);
+
+  /// \brief  cancels any pending prefetch
+  AL_USDMAYA_PUBLIC
+  void cancel();
+
+  /// \brief  waits for the prefetch of the file to finish, and returns the layers it opened. The returned layers
+  ///         should be held until the proxy shape has opened its stage. If a different file or resolver context was
+  ///         being prefetched, that prefetch is cancelled and no layers are returned.
+  /// \param  filePath the resolved path of the root layer of the stage
+  /// \param  context the resolver context the proxy shape opens its stage with
+  /// \return the prefetched layers, or an empty array if there was no matching prefetch
+  AL_USDMAYA_PUBLIC
+  SdfLayerRefPtrVector take(const std::string& filePath, const ArResolverContext& context);
+
+  /// \brief  returns true if a prefetch has been started, and has not been taken or cancelled
+  inline bool isPending() const
+    { return bool(m_request); }
+
+private:
+  struct Request;
+  std::shared_ptr<Request> m_request;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
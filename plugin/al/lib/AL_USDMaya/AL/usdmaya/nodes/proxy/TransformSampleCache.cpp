@@ -0,0 +1,171 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usdmaya/nodes/proxy/TransformSampleCache.h"
+#include "AL/usdmaya/DebugCodes.h"
+
+#include "pxr/base/work/loops.h"
+
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+TransformSampleCache::TransformSampleCache()
+  : m_mutex(), m_matrices(), m_samples(), m_valid(), m_indices(), m_time(UsdTimeCode::Default())
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool TransformSampleCache::sample(const TransformationMatrix* matrix, const UsdTimeCode& time, TransformSample& sample)
+{
+  if(!matrix->hasAnimation())
+    return false;
+
+  {
+    boost::shared_lock_guard<boost::shared_mutex> lock(m_mutex);
+    if(m_time == time)
+    {
+      auto it = m_indices.find(matrix);
+      if(it != m_indices.end() && m_valid[it->second])
+      {
+        sample = m_samples[it->second];
+        return true;
+      }
+    }
+  }
+
+  boost::unique_lock<boost::shared_mutex> lock(m_mutex);
+  size_t index;
+  auto it = m_indices.find(matrix);
+  if(it == m_indices.end())
+  {
+    index = m_matrices.size();
+    m_indices.emplace(matrix, index);
+    m_matrices.push_back(matrix);
+    m_samples.emplace_back();
+    m_valid.push_back(0);
+  }
+  else
+  {
+    index = it->second;
+  }
+
+  // only the proxy shape fills the cache, so a sample for any other time is read directly
+  if(m_time != time)
+  {
+    matrix->readSample(time, sample);
+    return true;
+  }
+
+  if(!m_valid[index])
+  {
+    matrix->readSample(time, m_samples[index]);
+    m_valid[index] = 1;
+  }
+  sample = m_samples[index];
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformSampleCache::fill(const UsdTimeCode& time)
+{
+  boost::unique_lock<boost::shared_mutex> lock(m_mutex);
+  if(m_time == time)
+    return;
+
+  TF_DEBUG(ALUSDMAYA_EVALUATION).Msg("TransformSampleCache::fill %f (%zu transforms)\n", time.GetValue(), m_matrices.size());
+  m_time = time;
+
+  auto readSamples = [this, time](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      const TransformationMatrix* matrix = m_matrices[i];
+      if(matrix->hasAnimation())
+      {
+        matrix->readSample(time, m_samples[i]);
+        m_valid[i] = 1;
+      }
+      else
+      {
+        m_valid[i] = 0;
+      }
+    }
+  };
+
+#if TBB_INTERFACE_VERSION >= 10000
+  // The calling thread holds the writer lock whilst waiting for the loop to complete. Isolating the loop prevents it
+  // from picking up the evaluation of another node that could wait on the same lock.
+  tbb::this_task_arena::isolate([this, &readSamples]() { WorkParallelForN(m_matrices.size(), readSamples); });
+#else
+  readSamples(0, m_matrices.size());
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformSampleCache::unregisterMatrix(const TransformationMatrix* matrix)
+{
+  boost::unique_lock<boost::shared_mutex> lock(m_mutex);
+  auto it = m_indices.find(matrix);
+  if(it == m_indices.end())
+    return;
+
+  // swap the last entry into the slot being removed
+  const size_t index = it->second;
+  const size_t last = m_matrices.size() - 1;
+  if(index != last)
+  {
+    m_matrices[index] = m_matrices[last];
+    m_samples[index] = m_samples[last];
+    m_valid[index] = m_valid[last];
+    m_indices[m_matrices[index]] = index;
+  }
+  m_matrices.pop_back();
+  m_samples.pop_back();
+  m_valid.pop_back();
+  m_indices.erase(matrix);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformSampleCache::invalidate()
+{
+  boost::unique_lock<boost::shared_mutex> lock(m_mutex);
+  m_time = UsdTimeCode::Default();
+  std::fill(m_valid.begin(), m_valid.end(), 0);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void TransformSampleCache::clear()
+{
+  boost::unique_lock<boost::shared_mutex> lock(m_mutex);
+  m_time = UsdTimeCode::Default();
+  m_matrices.clear();
+  m_samples.clear();
+  m_valid.clear();
+  m_indices.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
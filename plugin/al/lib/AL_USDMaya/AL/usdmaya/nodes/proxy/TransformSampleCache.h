@@ -0,0 +1,109 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "../../Api.h"
+#include "AL/usdmaya/nodes/TransformationMatrix.h"
+
+#include "pxr/usd/usd/timeCode.h"
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_lock_guard.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace nodes {
+namespace proxy {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Caches the animated transform values of all of the AL_usdmaya_Transform nodes driven by a proxy shape.
+///
+///         During playback each transform node would otherwise read its own xform ops from USD (including a matrix
+///         decomposition for matrix ops). Instead, the proxy shape calls fill when it computes its output time, which
+///         reads the samples of every animated transform registered with the cache in parallel. The transforms are
+///         evaluated after that (their time is driven by the proxy shape's outTime), so they simply copy their values
+///         out of the cache. Transforms are registered the first time they request a sample, and only transforms that
+///         have animation are ever stored, so static transforms never touch the cache.
+///
+///         The cache is keyed on the output time of the proxy shape. A transform that applies its own time offset or
+///         scale is evaluated at a different time, and so does not use the cache at all (see Transform::updateTransform).
+///         A request for any time other than the filled one is read directly from the prim, and never triggers a fill.
+///
+///         The cache is filled whilst holding a writer lock, and sampled whilst holding a reader lock. A blocking
+///         shared mutex is used, so transforms evaluated in parallel never busy-wait on the fill.
+//----------------------------------------------------------------------------------------------------------------------
+class TransformSampleCache
+{
+public:
+
+  /// \brief  ctor
+  AL_USDMAYA_PUBLIC
+  TransformSampleCache();
+
+  /// \brief  returns the sample of the transformation matrix at the specified time. If the cache does not hold that
+  ///         time, the sample is read from the prim.
+  /// \param  matrix the transformation matrix to return the sample for. It will be registered with the cache if it
+  ///         has not been seen before.
+  /// \param  time the time of the sample
+  /// \param  sample the returned sample
+  /// \return false if the matrix has no animation (in which case it is not cached)
+  AL_USDMAYA_PUBLIC
+  bool sample(const TransformationMatrix* matrix, const UsdTimeCode& time, TransformSample& sample);
+
+  /// \brief  reads the samples of all registered matrices at the specified time in parallel, unless the cache already
+  ///         holds that time. This is called by the proxy shape when its output time is computed.
+  /// \param  time the time to read the samples at
+  AL_USDMAYA_PUBLIC
+  void fill(const UsdTimeCode& time);
+
+  /// \brief  removes a transformation matrix from the cache. This must be called before the matrix is destroyed.
+  /// \param  matrix the transformation matrix to remove
+  AL_USDMAYA_PUBLIC
+  void unregisterMatrix(const TransformationMatrix* matrix);
+
+  /// \brief  discards the cached samples (but retains the registered matrices), e.g. when the stage has been modified
+  AL_USDMAYA_PUBLIC
+  void invalidate();
+
+  /// \brief  discards the cached samples, and all of the registered matrices
+  AL_USDMAYA_PUBLIC
+  void clear();
+
+  /// \brief  returns the number of registered matrices
+  inline size_t size() const
+    { boost::shared_lock_guard<boost::shared_mutex> lock(m_mutex); return m_matrices.size(); }
+
+private:
+  mutable boost::shared_mutex m_mutex;
+  std::vector<const TransformationMatrix*> m_matrices;
+  std::vector<TransformSample> m_samples;
+  std::vector<uint8_t> m_valid;
+  std::unordered_map<const TransformationMatrix*, size_t> m_indices;
+  UsdTimeCode m_time;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // proxy
+} // nodes
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
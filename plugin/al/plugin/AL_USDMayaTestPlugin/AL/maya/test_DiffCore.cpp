@@ -1,6 +1,7 @@
 
 #include "AL/usd/utils/DiffCore.h"
 #include "AL/usd/utils/ALHalf.h"
+#include "AL/usd/utils/CpuFeatures.h"
 #include <gtest/gtest.h>
 
 static inline float randFloat()
@@ -513,3 +514,64 @@ TEST(DataDiff, compareUvArray)
   u[22] -= 1.0f;
 }
 
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Each build of the kernels should detect a difference at any index, for a range of array lengths that
+///         cover the full width & remainder paths of every instruction set.
+//----------------------------------------------------------------------------------------------------------------------
+TEST(DataDiff, compareArraysAtEachSimdLevel)
+{
+  using AL::usd::utils::SimdLevel;
+  const SimdLevel active = AL::usd::utils::activeSimdLevel();
+  const uint32_t supported = uint32_t(AL::usd::utils::supportedSimdLevel());
+  for(uint32_t level = 0; level <= supported; ++level)
+  {
+    ASSERT_TRUE(AL::usd::utils::setActiveSimdLevel(SimdLevel(level)));
+    for(size_t count = 1; count < 70; ++count)
+    {
+      std::vector<float> f0(count * 3), f1;
+      std::vector<double> d0(count), d1;
+      std::vector<GfHalf> h(count);
+      std::vector<int8_t> i80(count), i81;
+      std::vector<int32_t> i320(count), i321;
+      for(size_t i = 0; i < count; ++i)
+      {
+        f0[i * 3] = 1.0f;
+        f0[i * 3 + 1] = 2.0f;
+        f0[i * 3 + 2] = 3.0f;
+        d0[i] = randDouble();
+        h[i] = GfHalf(float(d0[i]));
+        i80[i] = int8_t(rand());
+        i320[i] = rand();
+      }
+      std::vector<float> hf(h.begin(), h.end());
+      EXPECT_TRUE(AL::usd::utils::vec3AreAllTheSame(f0.data(), count));
+      EXPECT_TRUE(AL::usd::utils::compareArray(h.data(), hf.data(), count, count, 1e-5f));
+
+      for(size_t i = 0; i < count; ++i)
+      {
+        f1 = f0;
+        f1[i * 3 + (i % 3)] += 1.0f;
+        EXPECT_EQ(i == 0 && count == 1, AL::usd::utils::vec3AreAllTheSame(f1.data(), count));
+        EXPECT_FALSE(AL::usd::utils::compareArray(f0.data(), f1.data(), count * 3, count * 3, 1e-5f));
+
+        d1 = d0;
+        d1[i] += 1.0;
+        EXPECT_FALSE(AL::usd::utils::compareArray(d0.data(), d1.data(), count, count, 1e-5));
+
+        hf[i] += 1.0f;
+        EXPECT_FALSE(AL::usd::utils::compareArray(h.data(), hf.data(), count, count, 1e-5f));
+        hf[i] -= 1.0f;
+
+        i81 = i80;
+        i81[i] ^= 1;
+        EXPECT_FALSE(AL::usd::utils::compareArray(i80.data(), i81.data(), count, count));
+
+        i321 = i320;
+        i321[i] ^= 1;
+        EXPECT_FALSE(AL::usd::utils::compareArray(i320.data(), i321.data(), count, count));
+      }
+    }
+  }
+  AL::usd::utils::setActiveSimdLevel(active);
+}
@@ -112,4 +112,15 @@ TEST(export_blendshape, animated_mesh)
   UsdAttribute pointsAttr = mesh.GetPointsAttr();
   size_t size = pointsAttr.GetNumTimeSamples();
   EXPECT_EQ(50, size);
+
+  // each frame should be read from the mesh as it is evaluated at that frame
+  VtArray<GfVec3f> firstPoints, midPoints, lastPoints;
+  EXPECT_TRUE(pointsAttr.Get(&firstPoints, UsdTimeCode(1.0)));
+  EXPECT_TRUE(pointsAttr.Get(&midPoints, UsdTimeCode(25.0)));
+  EXPECT_TRUE(pointsAttr.Get(&lastPoints, UsdTimeCode(50.0)));
+  ASSERT_EQ(firstPoints.size(), lastPoints.size());
+  ASSERT_EQ(firstPoints.size(), midPoints.size());
+  EXPECT_NE(firstPoints, midPoints);
+  EXPECT_NE(midPoints, lastPoints);
+  EXPECT_NE(firstPoints, lastPoints);
 }
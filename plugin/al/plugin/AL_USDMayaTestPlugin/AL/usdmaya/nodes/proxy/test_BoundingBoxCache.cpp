@@ -0,0 +1,147 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/nodes/proxy/BoundingBoxCache.h"
+
+#include "pxr/base/tf/notice.h"
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usdGeom/mesh.h"
+#include "pxr/usd/usdGeom/tokens.h"
+#include "pxr/usd/usdGeom/xform.h"
+#include "pxr/usd/usdGeom/xformCommonAPI.h"
+
+using AL::usdmaya::nodes::proxy::BoundingBoxCache;
+
+namespace {
+
+UsdGeomMesh createQuad(UsdStageRefPtr stage, const char* path)
+{
+  UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath(path));
+  VtVec3fArray points = { GfVec3f(0, 0, 0), GfVec3f(1, 0, 0), GfVec3f(1, 1, 0), GfVec3f(0, 1, 0) };
+  mesh.GetPointsAttr().Set(points);
+  mesh.GetFaceVertexCountsAttr().Set(VtIntArray{ 4 });
+  mesh.GetFaceVertexIndicesAttr().Set(VtIntArray{ 0, 1, 2, 3 });
+  VtVec3fArray extent(2);
+  UsdGeomPointBased::ComputeExtent(points, &extent);
+  mesh.GetExtentAttr().Set(extent);
+  return mesh;
+}
+
+struct NoticeListener : public TfWeakBase
+{
+  NoticeListener(BoundingBoxCache& cache, UsdStageRefPtr stage)
+    : m_cache(cache)
+  {
+    TfWeakPtr<NoticeListener> me(this);
+    m_key = TfNotice::Register(me, &NoticeListener::onObjectsChanged, stage);
+  }
+  ~NoticeListener()
+    { TfNotice::Revoke(m_key); }
+
+  void onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdStageWeakPtr const& sender)
+    { m_cache.invalidate(notice); }
+
+  BoundingBoxCache& m_cache;
+  TfNotice::Key m_key;
+};
+
+const TfTokenVector g_purposes = { UsdGeomTokens->default_, UsdGeomTokens->proxy };
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// A hierarchy without any animation should only ever store a single bound
+//----------------------------------------------------------------------------------------------------------------------
+TEST(BoundingBoxCache, staticHierarchy)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform::Define(stage, SdfPath("/root"));
+  createQuad(stage, "/root/quad");
+
+  BoundingBoxCache cache;
+  UsdPrim root = stage->GetPrimAtPath(SdfPath("/root"));
+  for(int i = 0; i < 10; ++i)
+  {
+    MBoundingBox box = cache.boundingBox(root, UsdTimeCode(i), g_purposes);
+    EXPECT_NEAR(0.0, box.min().x, 1e-5);
+    EXPECT_NEAR(1.0, box.max().x, 1e-5);
+    EXPECT_NEAR(1.0, box.max().y, 1e-5);
+  }
+  EXPECT_TRUE(cache.isStatic());
+  EXPECT_EQ(1u, cache.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// An animated transform should produce a bound per time, limited to kMaxCachedTimes entries
+//----------------------------------------------------------------------------------------------------------------------
+TEST(BoundingBoxCache, animatedHierarchy)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform::Define(stage, SdfPath("/root"));
+  UsdGeomXform::Define(stage, SdfPath("/root/moving"));
+  createQuad(stage, "/root/moving/quad");
+
+  const size_t numFrames = BoundingBoxCache::kMaxCachedTimes + 10;
+  UsdGeomXformCommonAPI api(stage->GetPrimAtPath(SdfPath("/root/moving")));
+  for(size_t i = 0; i < numFrames; ++i)
+  {
+    api.SetTranslate(GfVec3d(double(i), 0, 0), UsdTimeCode(double(i)));
+  }
+
+  BoundingBoxCache cache;
+  UsdPrim root = stage->GetPrimAtPath(SdfPath("/root"));
+  for(size_t i = 0; i < numFrames; ++i)
+  {
+    MBoundingBox box = cache.boundingBox(root, UsdTimeCode(double(i)), g_purposes);
+    EXPECT_NEAR(double(i), box.min().x, 1e-5);
+    EXPECT_NEAR(double(i) + 1.0, box.max().x, 1e-5);
+  }
+  EXPECT_FALSE(cache.isStatic());
+  EXPECT_EQ(BoundingBoxCache::kMaxCachedTimes, cache.size());
+
+  // the most recent frames should have been retained
+  MBoundingBox box = cache.boundingBox(root, UsdTimeCode(double(numFrames - 1)), g_purposes);
+  EXPECT_NEAR(double(numFrames - 1), box.min().x, 1e-5);
+  EXPECT_EQ(BoundingBoxCache::kMaxCachedTimes, cache.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Geometric edits should invalidate the cache, metadata edits should not
+//----------------------------------------------------------------------------------------------------------------------
+TEST(BoundingBoxCache, invalidate)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform::Define(stage, SdfPath("/root"));
+  UsdGeomMesh mesh = createQuad(stage, "/root/quad");
+
+  BoundingBoxCache cache;
+  NoticeListener listener(cache, stage);
+  UsdPrim root = stage->GetPrimAtPath(SdfPath("/root"));
+
+  cache.boundingBox(root, UsdTimeCode(1.0), g_purposes);
+  EXPECT_EQ(1u, cache.size());
+
+  mesh.GetPrim().SetCustomDataByKey(TfToken("someKey"), VtValue(1));
+  EXPECT_EQ(1u, cache.size());
+
+  VtVec3fArray extent = { GfVec3f(0, 0, 0), GfVec3f(2, 2, 2) };
+  mesh.GetExtentAttr().Set(extent);
+  EXPECT_EQ(0u, cache.size());
+
+  MBoundingBox box = cache.boundingBox(root, UsdTimeCode(1.0), g_purposes);
+  EXPECT_NEAR(2.0, box.max().x, 1e-5);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
@@ -226,5 +226,54 @@ TEST(ProxyShape, DrivenTransforms)
       }
     }
 
+    // the values should have been authored into the driven session sublayer
+    SdfLayerRefPtr drivenLayer = AL::usdmaya::nodes::proxy::DrivenTransforms::drivenLayer(stage);
+    ASSERT_TRUE(drivenLayer);
+    EXPECT_TRUE(stage->HasLocalLayer(drivenLayer));
+    EXPECT_EQ(1u, stage->GetSessionLayer()->GetSubLayerPaths().size());
+    {
+      UsdGeomXform xform(stage->GetPrimAtPath(drivenPaths[2]));
+      bool resetsXformStack;
+      std::vector<UsdGeomXformOp> ops = xform.GetOrderedXformOps(&resetsXformStack);
+      ASSERT_EQ(1u, ops.size());
+      EXPECT_TRUE(drivenLayer->GetAttributeAtPath(ops[0].GetAttr().GetPath()));
+      EXPECT_TRUE(drivenLayer->GetAttributeAtPath(drivenPaths[3].AppendProperty(UsdGeomTokens->visibility)));
+    }
+
+    // subsequent updates should reuse the transform op resolved previously
+    matrixValue[3][1] = 2.0;
+    dt.dirtyMatrix(2, matrixValue);
+    dt.update(stage, MTime(11.0f, MTime::uiUnit()));
+    {
+      UsdGeomXform xform(stage->GetPrimAtPath(drivenPaths[2]));
+      bool resetsXformStack;
+      std::vector<UsdGeomXformOp> ops = xform.GetOrderedXformOps(&resetsXformStack);
+      ASSERT_EQ(1u, ops.size());
+      MMatrix returnedMatrix;
+      ops[0].Get((GfMatrix4d*)&returnedMatrix, 11.0);
+      EXPECT_EQ(matrixValue, returnedMatrix);
+    }
+    EXPECT_EQ(1u, stage->GetSessionLayer()->GetSubLayerPaths().size());
+
+    // changing the xformOpOrder should cause the transform op to be resolved again
+    {
+      UsdGeomXform xform(stage->GetPrimAtPath(drivenPaths[2]));
+      UsdGeomXformOp customOp = xform.AddTransformOp(UsdGeomXformOp::PrecisionDouble, TfToken("custom"));
+      ASSERT_TRUE(customOp);
+      xform.SetXformOpOrder({ customOp });
+    }
+    matrixValue[3][1] = 3.0;
+    dt.dirtyMatrix(2, matrixValue);
+    dt.update(stage, MTime(12.0f, MTime::uiUnit()));
+    {
+      UsdGeomXform xform(stage->GetPrimAtPath(drivenPaths[2]));
+      bool resetsXformStack;
+      std::vector<UsdGeomXformOp> ops = xform.GetOrderedXformOps(&resetsXformStack);
+      ASSERT_EQ(1u, ops.size());
+      EXPECT_EQ(TfToken("xformOp:transform:custom"), ops[0].GetName());
+      MMatrix returnedMatrix;
+      ops[0].Get((GfMatrix4d*)&returnedMatrix, 12.0);
+      EXPECT_EQ(matrixValue, returnedMatrix);
+    }
   }
 }
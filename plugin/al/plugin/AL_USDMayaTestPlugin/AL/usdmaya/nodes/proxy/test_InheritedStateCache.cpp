@@ -0,0 +1,176 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/Metadata.h"
+#include "AL/usdmaya/nodes/proxy/InheritedStateCache.h"
+
+#include "pxr/usd/sdf/changeBlock.h"
+#include "pxr/usd/usd/stage.h"
+
+using AL::usdmaya::Metadata;
+using AL::usdmaya::nodes::proxy::InheritedStateCache;
+
+namespace {
+
+struct NoticeListener : public TfWeakBase
+{
+  NoticeListener(InheritedStateCache& cache, UsdStageRefPtr stage)
+    : m_cache(cache)
+  {
+    TfWeakPtr<NoticeListener> me(this);
+    m_key = TfNotice::Register(me, &NoticeListener::onObjectsChanged, stage);
+  }
+  ~NoticeListener()
+    { TfNotice::Revoke(m_key); }
+
+  void onObjectsChanged(UsdNotice::ObjectsChanged const& notice, UsdStageWeakPtr const& sender)
+    { m_cache.invalidate(notice, m_changedPaths); }
+
+  InheritedStateCache& m_cache;
+  SdfPathVector m_changedPaths;
+  TfNotice::Key m_key;
+};
+
+//  /root                   lock = transform
+//  /root/a                 selectability = unselectable
+//  /root/a/b               selectability = selectable, lock = unlocked
+//  /root/a/b/c
+//  /root/d                 lock = inherited
+//  /root/d/e
+UsdStageRefPtr createStage()
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  for(const char* path : { "/root/a/b/c", "/root/d/e" })
+  {
+    stage->DefinePrim(SdfPath(path));
+  }
+  stage->GetPrimAtPath(SdfPath("/root")).SetMetadata(Metadata::locked, Metadata::lockTransform);
+  stage->GetPrimAtPath(SdfPath("/root/a")).SetMetadata(Metadata::selectability, Metadata::unselectable);
+  stage->GetPrimAtPath(SdfPath("/root/a/b")).SetMetadata(Metadata::selectability, Metadata::selectable);
+  stage->GetPrimAtPath(SdfPath("/root/a/b")).SetMetadata(Metadata::locked, Metadata::lockUnlocked);
+  stage->GetPrimAtPath(SdfPath("/root/d")).SetMetadata(Metadata::locked, Metadata::lockInherited);
+  return stage;
+}
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Unselectable prims can not be made selectable by their descendants, whereas an explicit lock stops inheritance
+//----------------------------------------------------------------------------------------------------------------------
+TEST(InheritedStateCache, resolve)
+{
+  UsdStageRefPtr stage = createStage();
+  auto prim = [&stage](const char* path) { return stage->GetPrimAtPath(SdfPath(path)); };
+
+  InheritedStateCache cache;
+
+  // querying a prim without resolving its hierarchy should give the same results
+  EXPECT_TRUE(cache.isUnselectable(prim("/root/a/b/c")));
+  EXPECT_FALSE(cache.isTransformLocked(prim("/root/a/b/c")));
+  EXPECT_TRUE(cache.isTransformLocked(prim("/root/a")));
+  cache.clear();
+
+  cache.resolve(stage->GetPseudoRoot());
+  EXPECT_FALSE(cache.isUnselectable(prim("/root")));
+  EXPECT_TRUE(cache.isUnselectable(prim("/root/a")));
+  EXPECT_TRUE(cache.isUnselectable(prim("/root/a/b")));
+  EXPECT_TRUE(cache.isUnselectable(prim("/root/a/b/c")));
+  EXPECT_FALSE(cache.isUnselectable(prim("/root/d/e")));
+
+  EXPECT_TRUE(cache.isTransformLocked(prim("/root")));
+  EXPECT_TRUE(cache.isTransformLocked(prim("/root/a")));
+  EXPECT_FALSE(cache.isTransformLocked(prim("/root/a/b")));
+  EXPECT_FALSE(cache.isTransformLocked(prim("/root/a/b/c")));
+  EXPECT_TRUE(cache.isTransformLocked(prim("/root/d")));
+  EXPECT_TRUE(cache.isTransformLocked(prim("/root/d/e")));
+
+  const uint8_t state = cache.find(prim("/root/a"));
+  EXPECT_TRUE(state & InheritedStateCache::kAuthoredUnselectable);
+  EXPECT_FALSE(state & InheritedStateCache::kAuthoredLockTransform);
+  EXPECT_TRUE(cache.find(prim("/root/a/b")) & InheritedStateCache::kAuthoredLockUnlocked);
+  EXPECT_FALSE(cache.find(prim("/root/a/b")) & InheritedStateCache::kAuthoredUnselectable);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Changing the metadata of a prim should only discard the states within its hierarchy
+//----------------------------------------------------------------------------------------------------------------------
+TEST(InheritedStateCache, invalidate)
+{
+  UsdStageRefPtr stage = createStage();
+  auto prim = [&stage](const char* path) { return stage->GetPrimAtPath(SdfPath(path)); };
+
+  InheritedStateCache cache;
+  NoticeListener listener(cache, stage);
+  cache.resolve(stage->GetPseudoRoot());
+
+  prim("/root/a").SetMetadata(Metadata::selectability, Metadata::selectable);
+  ASSERT_EQ(1u, listener.m_changedPaths.size());
+  EXPECT_EQ(SdfPath("/root/a"), listener.m_changedPaths[0]);
+  EXPECT_FALSE(cache.isUnselectable(prim("/root/a/b/c")));
+  EXPECT_TRUE(cache.isTransformLocked(prim("/root/a")));
+
+  // the state of the prims outside of the changed hierarchy are retained
+  EXPECT_TRUE(cache.find(prim("/root/d/e")) & InheritedStateCache::kResolved);
+
+  // metadata that does not affect the state should not discard anything
+  prim("/root/d").SetDocumentation("not a lock");
+  EXPECT_TRUE(listener.m_changedPaths.empty());
+
+  // nor should attribute edits
+  prim("/root/d").CreateAttribute(TfToken("value"), SdfValueTypeNames->Int).Set(1);
+  EXPECT_TRUE(listener.m_changedPaths.empty());
+
+  prim("/root").SetMetadata(Metadata::locked, Metadata::lockUnlocked);
+  ASSERT_EQ(1u, listener.m_changedPaths.size());
+  EXPECT_EQ(SdfPath("/root"), listener.m_changedPaths[0]);
+  EXPECT_FALSE(cache.isTransformLocked(prim("/root/d/e")));
+
+  stage->DefinePrim(SdfPath("/root/d/f"));
+  EXPECT_FALSE(listener.m_changedPaths.empty());
+  EXPECT_FALSE(cache.isTransformLocked(prim("/root/d/f")));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Overlapping changes within a single notice should be reported as the roots of the changed hierarchies
+//----------------------------------------------------------------------------------------------------------------------
+TEST(InheritedStateCache, invalidateOverlappingPaths)
+{
+  UsdStageRefPtr stage = createStage();
+  auto prim = [&stage](const char* path) { return stage->GetPrimAtPath(SdfPath(path)); };
+
+  InheritedStateCache cache;
+  NoticeListener listener(cache, stage);
+  cache.resolve(stage->GetPseudoRoot());
+
+  {
+    SdfChangeBlock changeBlock;
+    prim("/root/a/b/c").SetMetadata(Metadata::selectability, Metadata::unselectable);
+    prim("/root/a").SetMetadata(Metadata::selectability, Metadata::selectable);
+    prim("/root/a/b").SetMetadata(Metadata::locked, Metadata::lockTransform);
+    prim("/root/d/e").SetMetadata(Metadata::locked, Metadata::lockUnlocked);
+  }
+
+  ASSERT_EQ(2u, listener.m_changedPaths.size());
+  EXPECT_EQ(SdfPath("/root/a"), listener.m_changedPaths[0]);
+  EXPECT_EQ(SdfPath("/root/d/e"), listener.m_changedPaths[1]);
+
+  EXPECT_TRUE(cache.isUnselectable(prim("/root/a/b/c")));
+  EXPECT_FALSE(cache.isUnselectable(prim("/root/a/b")));
+  EXPECT_TRUE(cache.isTransformLocked(prim("/root/a/b/c")));
+  EXPECT_FALSE(cache.isTransformLocked(prim("/root/d/e")));
+  EXPECT_TRUE(cache.find(prim("/root/d")) & InheritedStateCache::kResolved);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,250 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/nodes/proxy/IntersectionEngine.h"
+
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usdGeom/mesh.h"
+#include "pxr/usd/usdGeom/tokens.h"
+#include "pxr/usd/usdGeom/xform.h"
+#include "pxr/usd/usdGeom/xformCommonAPI.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+using AL::usdmaya::nodes::proxy::BoundingVolumeHierarchy;
+using AL::usdmaya::nodes::proxy::IntersectionEngine;
+
+namespace {
+
+// creates a grid of quads in the xy plane, covering [0, size] x [0, size]
+UsdGeomMesh createGrid(UsdStageRefPtr stage, const std::string& path, int size)
+{
+  UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath(path));
+  VtVec3fArray points;
+  VtIntArray counts, indices;
+  for(int y = 0; y <= size; ++y)
+    for(int x = 0; x <= size; ++x)
+      points.push_back(GfVec3f(x, y, 0));
+  for(int y = 0; y < size; ++y)
+  {
+    for(int x = 0; x < size; ++x)
+    {
+      const int i = y * (size + 1) + x;
+      counts.push_back(4);
+      indices.push_back(i);
+      indices.push_back(i + 1);
+      indices.push_back(i + size + 2);
+      indices.push_back(i + size + 1);
+    }
+  }
+  mesh.GetPointsAttr().Set(points);
+  mesh.GetFaceVertexCountsAttr().Set(counts);
+  mesh.GetFaceVertexIndicesAttr().Set(indices);
+  return mesh;
+}
+
+// an orthographic projection of the box [minX, maxX] x [minY, maxY] x [-100, 100]
+GfMatrix4d orthoVolume(double minX, double maxX, double minY, double maxY)
+{
+  GfMatrix4d m(1.0);
+  m[0][0] = 2.0 / (maxX - minX);
+  m[1][1] = 2.0 / (maxY - minY);
+  m[2][2] = 0.01;
+  m[3][0] = -(maxX + minX) / (maxX - minX);
+  m[3][1] = -(maxY + minY) / (maxY - minY);
+  return m;
+}
+
+const TfTokenVector g_purposes = { UsdGeomTokens->default_, UsdGeomTokens->proxy };
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// The hierarchy should contain every item exactly once, and the bounds of each node should contain its items
+//----------------------------------------------------------------------------------------------------------------------
+TEST(IntersectionEngine, boundingVolumeHierarchy)
+{
+  std::vector<GfRange3f> bounds;
+  for(int i = 0; i < 1000; ++i)
+  {
+    const GfVec3f p(float(i % 10), float((i / 10) % 10), float(i / 100));
+    bounds.emplace_back(p, p + GfVec3f(0.5f));
+  }
+
+  BoundingVolumeHierarchy bvh;
+  bvh.build(bounds);
+  ASSERT_EQ(bounds.size(), bvh.items.size());
+  std::vector<uint32_t> sortedItems = bvh.items;
+  std::sort(sortedItems.begin(), sortedItems.end());
+  for(uint32_t i = 0; i < sortedItems.size(); ++i)
+  {
+    EXPECT_EQ(i, sortedItems[i]);
+  }
+
+  auto checkBounds = [&bvh, &bounds]()
+  {
+    for(const auto& node : bvh.nodes)
+    {
+      if(node.count)
+      {
+        EXPECT_LE(node.count, BoundingVolumeHierarchy::kMaxLeafSize);
+        for(uint32_t i = node.first; i < node.first + node.count; ++i)
+        {
+          EXPECT_TRUE(node.bounds.Contains(bounds[bvh.items[i]]));
+        }
+      }
+    }
+  };
+  checkBounds();
+
+  for(auto& b : bounds)
+  {
+    b.SetMax(b.GetMax() + GfVec3f(2.0f));
+  }
+  bvh.refit(bounds);
+  checkBounds();
+  EXPECT_TRUE(GfIsClose(bvh.nodes[0].bounds.GetMax()[0], 11.5f, 1e-5));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Rays should hit the closest mesh, and volumes should find every prim that has a triangle within them
+//----------------------------------------------------------------------------------------------------------------------
+TEST(IntersectionEngine, intersect)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform::Define(stage, SdfPath("/root"));
+  createGrid(stage, "/root/near", 10);
+  UsdGeomMesh far = createGrid(stage, "/root/far", 10);
+  UsdGeomXformCommonAPI(far).SetTranslate(GfVec3d(5.0, 0, -10.0));
+  UsdGeomMesh hidden = createGrid(stage, "/root/hidden", 10);
+  hidden.GetVisibilityAttr().Set(UsdGeomTokens->invisible);
+  createGrid(stage, "/root/excluded", 10);
+
+  IntersectionEngine engine;
+  engine.build(stage->GetPseudoRoot(), UsdTimeCode::Default(), g_purposes, { SdfPath("/root/excluded") });
+  EXPECT_EQ(2u, engine.primCount());
+  EXPECT_EQ(400u, engine.triangleCount());
+
+  IntersectionEngine::Hit hit;
+  ASSERT_TRUE(engine.intersectRay(GfRay(GfVec3d(2.5, 2.5, 10.0), GfVec3d(0, 0, -1.0)), &hit));
+  EXPECT_EQ(SdfPath("/root/near"), hit.path);
+  EXPECT_NEAR(0.0, hit.point[2], 1e-5);
+  EXPECT_NEAR(1.0, hit.normal[2], 1e-5);
+
+  ASSERT_TRUE(engine.intersectRay(GfRay(GfVec3d(12.5, 2.5, 10.0), GfVec3d(0, 0, -1.0)), &hit));
+  EXPECT_EQ(SdfPath("/root/far"), hit.path);
+  EXPECT_NEAR(-10.0, hit.point[2], 1e-5);
+
+  EXPECT_FALSE(engine.intersectRay(GfRay(GfVec3d(20.5, 2.5, 10.0), GfVec3d(0, 0, -1.0)), &hit));
+
+  std::vector<IntersectionEngine::Hit> hits;
+  engine.intersectVolume(orthoVolume(1.0, 2.0, 1.0, 2.0), hits);
+  ASSERT_EQ(1u, hits.size());
+  EXPECT_EQ(SdfPath("/root/near"), hits[0].path);
+
+  engine.intersectVolume(orthoVolume(8.0, 9.0, 1.0, 2.0), hits);
+  EXPECT_EQ(2u, hits.size());
+
+  engine.intersectVolume(orthoVolume(30.0, 40.0, 1.0, 2.0), hits);
+  EXPECT_TRUE(hits.empty());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Rays that miss should find the closest point on the geometry within the maximum distance
+//----------------------------------------------------------------------------------------------------------------------
+TEST(IntersectionEngine, closestPointToRay)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform::Define(stage, SdfPath("/root"));
+  createGrid(stage, "/root/near", 10);
+  UsdGeomMesh far = createGrid(stage, "/root/far", 10);
+  UsdGeomXformCommonAPI(far).SetTranslate(GfVec3d(5.0, 0, -10.0));
+
+  IntersectionEngine engine;
+  engine.build(stage->GetPseudoRoot(), UsdTimeCode::Default(), g_purposes, SdfPathVector());
+
+  // the ray passes 5.5 units from the edge of the far grid, and 10.5 units from the edge of the near grid
+  const GfRay ray(GfVec3d(20.5, 2.5, 10.0), GfVec3d(0, 0, -1.0));
+  IntersectionEngine::Hit hit;
+  ASSERT_TRUE(engine.closestPointToRay(ray, 6.0, &hit));
+  EXPECT_EQ(SdfPath("/root/far"), hit.path);
+  EXPECT_NEAR(5.5, hit.distance, 1e-5);
+  EXPECT_NEAR(15.0, hit.point[0], 1e-5);
+  EXPECT_NEAR(2.5, hit.point[1], 1e-5);
+  EXPECT_NEAR(-10.0, hit.point[2], 1e-5);
+  EXPECT_FALSE(engine.closestPointToRay(ray, 5.0, &hit));
+
+  // geometry behind the ray origin is measured from the origin
+  const GfRay awayRay(GfVec3d(12.0, 5.0, 5.0), GfVec3d(0, 0, 1.0));
+  ASSERT_TRUE(engine.closestPointToRay(awayRay, 10.0, &hit));
+  EXPECT_EQ(SdfPath("/root/near"), hit.path);
+  EXPECT_NEAR(std::sqrt(29.0), hit.distance, 1e-5);
+  EXPECT_NEAR(10.0, hit.point[0], 1e-5);
+  EXPECT_NEAR(0.0, hit.point[2], 1e-5);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Animated transforms should be refitted when the time changes
+//----------------------------------------------------------------------------------------------------------------------
+TEST(IntersectionEngine, update)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform xform = UsdGeomXform::Define(stage, SdfPath("/root"));
+  createGrid(stage, "/root/grid", 4);
+  UsdGeomXformCommonAPI api(xform);
+  api.SetTranslate(GfVec3d(0, 0, 0), UsdTimeCode(1.0));
+  api.SetTranslate(GfVec3d(100.0, 0, 0), UsdTimeCode(2.0));
+
+  IntersectionEngine engine;
+  engine.build(stage->GetPseudoRoot(), UsdTimeCode(1.0), g_purposes, SdfPathVector());
+  const GfRay ray(GfVec3d(101.0, 1.0, 10.0), GfVec3d(0, 0, -1.0));
+  EXPECT_FALSE(engine.intersectRay(ray, nullptr));
+
+  engine.update(UsdTimeCode(2.0));
+  EXPECT_TRUE(engine.intersectRay(ray, nullptr));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+// Prims with animated visibility should only be hit while they are visible
+//----------------------------------------------------------------------------------------------------------------------
+TEST(IntersectionEngine, animatedVisibility)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform xform = UsdGeomXform::Define(stage, SdfPath("/root"));
+  createGrid(stage, "/root/grid", 4);
+  xform.GetVisibilityAttr().Set(UsdGeomTokens->invisible, UsdTimeCode(1.0));
+  xform.GetVisibilityAttr().Set(UsdGeomTokens->inherited, UsdTimeCode(2.0));
+
+  IntersectionEngine engine;
+  engine.build(stage->GetPseudoRoot(), UsdTimeCode(1.0), g_purposes, SdfPathVector());
+  EXPECT_EQ(1u, engine.primCount());
+  const GfRay ray(GfVec3d(1.0, 1.0, 10.0), GfVec3d(0, 0, -1.0));
+  EXPECT_FALSE(engine.intersectRay(ray, nullptr));
+  std::vector<IntersectionEngine::Hit> hits;
+  engine.intersectVolume(orthoVolume(1.0, 2.0, 1.0, 2.0), hits);
+  EXPECT_TRUE(hits.empty());
+
+  engine.update(UsdTimeCode(2.0));
+  EXPECT_TRUE(engine.intersectRay(ray, nullptr));
+  engine.intersectVolume(orthoVolume(1.0, 2.0, 1.0, 2.0), hits);
+  EXPECT_EQ(1u, hits.size());
+
+  engine.update(UsdTimeCode(1.0));
+  EXPECT_FALSE(engine.intersectRay(ray, nullptr));
+}
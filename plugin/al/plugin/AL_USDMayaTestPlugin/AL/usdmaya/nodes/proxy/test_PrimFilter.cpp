@@ -27,6 +27,7 @@
 #include "maya/MFileIO.h"
 #include "maya/MStringArray.h"
 
+#include "pxr/base/tf/stringUtils.h"
 #include "pxr/usd/usd/stage.h"
 #include "pxr/usd/sdf/types.h"
 #include "pxr/usd/usd/attribute.h"
@@ -267,3 +268,50 @@ TEST(PrimFilter, removedPaths)
   }
 }
 
+
+/// The prims should keep their relative order within each of the filtered sets, and the removed prims should be
+/// reverse sorted, regardless of how the previous & new prim sets interleave.
+TEST(PrimFilter, largePrimSets)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  const uint32_t numPrims = 2000;
+
+  SdfPathVector previous;
+  std::vector<UsdPrim> prims;
+  for(uint32_t i = 0; i < numPrims; ++i)
+  {
+    const SdfPath path(TfStringPrintf("/root/group%u/prim%u", i % 10, i));
+    prims.push_back(UsdGeomXform::Define(stage, path).GetPrim());
+
+    // every third prim is newly created, the rest existed previously
+    if(i % 3)
+    {
+      previous.push_back(path);
+    }
+  }
+  // some prims that no longer exist in the stage
+  for(uint32_t i = 0; i < 100; ++i)
+  {
+    previous.push_back(SdfPath(TfStringPrintf("/root/removed/prim%u", i)));
+  }
+
+  MockPrimFilterInterface mockInterface;
+  mockInterface.refPaths = previous;
+
+  AL::usdmaya::nodes::proxy::PrimFilter filter(previous, prims, &mockInterface);
+
+  ASSERT_EQ(size_t(100), filter.removedPrimSet().size());
+  for(size_t i = 1; i < filter.removedPrimSet().size(); ++i)
+  {
+    EXPECT_TRUE(filter.removedPrimSet()[i] < filter.removedPrimSet()[i - 1]);
+  }
+
+  std::vector<UsdPrim> expectedNew, expectedUpdatable;
+  for(uint32_t i = 0; i < numPrims; ++i)
+  {
+    (i % 3 ? expectedUpdatable : expectedNew).push_back(prims[i]);
+  }
+  EXPECT_TRUE(filter.newPrimSet() == expectedNew);
+  EXPECT_TRUE(filter.updatablePrimSet() == expectedUpdatable);
+  EXPECT_TRUE(filter.transformsToCreate() == expectedNew);
+}
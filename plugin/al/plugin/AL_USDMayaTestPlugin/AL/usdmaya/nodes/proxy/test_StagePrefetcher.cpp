@@ -0,0 +1,155 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/nodes/proxy/StagePrefetcher.h"
+
+#include "pxr/base/tf/pathUtils.h"
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/usd/stage.h"
+
+using AL::usdmaya::nodes::proxy::StagePrefetcher;
+
+namespace {
+
+// creates a layer that sublayers one layer, and references another
+std::string createLayer(const char* const name)
+{
+  const std::string path = buildTempPath((std::string(name) + ".usda").c_str());
+  const std::string subLayerPath = buildTempPath((std::string(name) + "_sub.usda").c_str());
+  const std::string referencePath = buildTempPath((std::string(name) + "_ref.usda").c_str());
+
+  UsdStageRefPtr referenced = UsdStage::CreateNew(referencePath);
+  referenced->SetDefaultPrim(referenced->DefinePrim(SdfPath("/ref")));
+  referenced->GetRootLayer()->Save();
+
+  UsdStageRefPtr sub = UsdStage::CreateNew(subLayerPath);
+  sub->DefinePrim(SdfPath("/root/sub"));
+  sub->GetRootLayer()->Save();
+
+  UsdStageRefPtr stage = UsdStage::CreateNew(path);
+  stage->GetRootLayer()->GetSubLayerPaths().push_back(subLayerPath);
+  stage->DefinePrim(SdfPath("/root/a")).GetReferences().AddReference(referencePath);
+  stage->GetRootLayer()->Save();
+  return path;
+}
+
+ArResolverContext createContext(const std::string& path)
+{
+  return ArGetResolver().CreateDefaultContextForAsset(path);
+}
+
+bool containsLayer(const SdfLayerRefPtrVector& layers, const std::string& path)
+{
+  for(const SdfLayerRefPtr& layer : layers)
+  {
+    if(layer->GetRealPath() == TfRealPath(path))
+      return true;
+  }
+  return false;
+}
+
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(StagePrefetcher, take)
+{
+  const std::string path = createLayer("AL_USDMayaTests_StagePrefetcher_take");
+  const ArResolverContext context = createContext(path);
+
+  StagePrefetcher prefetcher;
+  EXPECT_FALSE(prefetcher.isPending());
+  EXPECT_TRUE(prefetcher.take(path, context).empty());
+
+  prefetcher.prefetch(path, context, UsdStage::LoadAll);
+  EXPECT_TRUE(prefetcher.isPending());
+
+  const SdfLayerRefPtrVector layers = prefetcher.take(path, context);
+  EXPECT_FALSE(prefetcher.isPending());
+  ASSERT_EQ(3u, layers.size());
+  EXPECT_TRUE(containsLayer(layers, path));
+  EXPECT_TRUE(containsLayer(layers, buildTempPath("AL_USDMayaTests_StagePrefetcher_take_sub.usda")));
+  EXPECT_TRUE(containsLayer(layers, buildTempPath("AL_USDMayaTests_StagePrefetcher_take_ref.usda")));
+
+  // the layers stay open while the prefetched layers are held
+  EXPECT_TRUE(SdfLayer::Find(path));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(StagePrefetcher, unloaded)
+{
+  const std::string path = createLayer("AL_USDMayaTests_StagePrefetcher_unloaded");
+  const ArResolverContext context = createContext(path);
+
+  // only the layer stack of the root layer is opened when the payloads will not be loaded
+  StagePrefetcher prefetcher;
+  prefetcher.prefetch(path, context, UsdStage::LoadNone);
+  const SdfLayerRefPtrVector layers = prefetcher.take(path, context);
+  ASSERT_EQ(2u, layers.size());
+  EXPECT_TRUE(containsLayer(layers, path));
+  EXPECT_TRUE(containsLayer(layers, buildTempPath("AL_USDMayaTests_StagePrefetcher_unloaded_sub.usda")));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(StagePrefetcher, mismatch)
+{
+  const std::string path = createLayer("AL_USDMayaTests_StagePrefetcher_mismatch");
+  const std::string otherPath = createLayer("AL_USDMayaTests_StagePrefetcher_mismatch_other");
+  const ArResolverContext context = createContext(path);
+
+  StagePrefetcher prefetcher;
+  prefetcher.prefetch(path, context, UsdStage::LoadAll);
+
+  // a different file cancels the prefetch
+  EXPECT_TRUE(prefetcher.take(otherPath, context).empty());
+  EXPECT_FALSE(prefetcher.isPending());
+  EXPECT_TRUE(prefetcher.take(path, context).empty());
+
+  // as does a different resolver context
+  const ArResolverContext otherContext = createContext(otherPath);
+  if(!(otherContext == context))
+  {
+    prefetcher.prefetch(path, context, UsdStage::LoadAll);
+    EXPECT_TRUE(prefetcher.take(path, otherContext).empty());
+    EXPECT_FALSE(prefetcher.isPending());
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TEST(StagePrefetcher, cancel)
+{
+  const std::string path = createLayer("AL_USDMayaTests_StagePrefetcher_cancel");
+  const std::string otherPath = createLayer("AL_USDMayaTests_StagePrefetcher_cancel_other");
+  const ArResolverContext context = createContext(path);
+
+  StagePrefetcher prefetcher;
+  prefetcher.prefetch(path, context, UsdStage::LoadAll);
+  prefetcher.cancel();
+  EXPECT_FALSE(prefetcher.isPending());
+  EXPECT_TRUE(prefetcher.take(path, context).empty());
+
+  // prefetching a new file replaces the previous prefetch
+  prefetcher.prefetch(path, context, UsdStage::LoadAll);
+  prefetcher.prefetch(otherPath, context, UsdStage::LoadAll);
+  EXPECT_TRUE(prefetcher.take(path, context).empty());
+
+  prefetcher.prefetch(otherPath, context, UsdStage::LoadAll);
+  EXPECT_FALSE(prefetcher.take(otherPath, context).empty());
+
+  // an empty path does not start a prefetch
+  prefetcher.prefetch(std::string(), context, UsdStage::LoadAll);
+  EXPECT_FALSE(prefetcher.isPending());
+}
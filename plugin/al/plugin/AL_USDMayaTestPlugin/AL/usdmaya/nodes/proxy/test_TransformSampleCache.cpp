@@ -0,0 +1,137 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "test_usdmaya.h"
+#include "AL/usdmaya/nodes/TransformationMatrix.h"
+#include "AL/usdmaya/nodes/proxy/TransformSampleCache.h"
+
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usdGeom/xform.h"
+#include "pxr/usd/usdGeom/xformCommonAPI.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using AL::usdmaya::nodes::TransformationMatrix;
+using AL::usdmaya::nodes::TransformSample;
+using AL::usdmaya::nodes::proxy::TransformSampleCache;
+
+//----------------------------------------------------------------------------------------------------------------------
+// Only animated matrices should be stored, and the cached samples should match the values read from the prim
+//----------------------------------------------------------------------------------------------------------------------
+TEST(TransformSampleCache, sample)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  const size_t numAnimated = 100;
+  std::vector<std::unique_ptr<TransformationMatrix>> matrices;
+  for(size_t i = 0; i < numAnimated; ++i)
+  {
+    UsdGeomXform xform = UsdGeomXform::Define(stage, SdfPath("/animated" + std::to_string(i)));
+    UsdGeomXformCommonAPI api(xform);
+    for(int frame = 0; frame < 10; ++frame)
+    {
+      api.SetTranslate(GfVec3d(double(i), double(frame), 0), UsdTimeCode(frame));
+      api.SetScale(GfVec3f(1.0f, 1.0f, 1.0f + frame), UsdTimeCode(frame));
+    }
+    matrices.emplace_back(new TransformationMatrix(xform.GetPrim()));
+  }
+
+  UsdGeomXform staticXform = UsdGeomXform::Define(stage, SdfPath("/static"));
+  UsdGeomXformCommonAPI(staticXform).SetTranslate(GfVec3d(1.0, 2.0, 3.0));
+  TransformationMatrix staticMatrix(staticXform.GetPrim());
+
+  TransformSampleCache cache;
+  TransformSample sample;
+  EXPECT_FALSE(cache.sample(&staticMatrix, UsdTimeCode(1.0), sample));
+  EXPECT_EQ(0u, cache.size());
+
+  // register the matrices, then have them read from the filled cache on each frame
+  for(size_t i = 0; i < numAnimated; ++i)
+  {
+    ASSERT_TRUE(cache.sample(matrices[i].get(), UsdTimeCode::Default(), sample));
+  }
+  for(int frame = 0; frame < 10; ++frame)
+  {
+    cache.fill(UsdTimeCode(frame));
+    for(size_t i = 0; i < numAnimated; ++i)
+    {
+      ASSERT_TRUE(cache.sample(matrices[i].get(), UsdTimeCode(frame), sample));
+      EXPECT_NEAR(double(i), sample.translation.x, 1e-5);
+      EXPECT_NEAR(double(frame), sample.translation.y, 1e-5);
+      EXPECT_NEAR(1.0 + frame, sample.scale.z, 1e-5);
+
+      TransformSample expected;
+      matrices[i]->readSample(UsdTimeCode(frame), expected);
+      EXPECT_EQ(expected.flags, sample.flags);
+      EXPECT_TRUE(expected.translation.isEquivalent(sample.translation));
+      EXPECT_TRUE(expected.scale.isEquivalent(sample.scale));
+    }
+  }
+  EXPECT_EQ(numAnimated, cache.size());
+
+  for(size_t i = 0; i < numAnimated; i += 2)
+  {
+    cache.unregisterMatrix(matrices[i].get());
+  }
+  EXPECT_EQ(numAnimated / 2, cache.size());
+
+  // the remaining matrices should still map to their own samples
+  for(size_t i = 1; i < numAnimated; i += 2)
+  {
+    ASSERT_TRUE(cache.sample(matrices[i].get(), UsdTimeCode(3.0), sample));
+    EXPECT_NEAR(double(i), sample.translation.x, 1e-5);
+    EXPECT_NEAR(3.0, sample.translation.y, 1e-5);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Modifying the stage and invalidating the cache should re-read the current time
+//----------------------------------------------------------------------------------------------------------------------
+TEST(TransformSampleCache, invalidate)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomXform xform = UsdGeomXform::Define(stage, SdfPath("/animated"));
+  UsdGeomXformCommonAPI api(xform);
+  api.SetTranslate(GfVec3d(0, 0, 0), UsdTimeCode(0.0));
+  api.SetTranslate(GfVec3d(1, 0, 0), UsdTimeCode(1.0));
+  TransformationMatrix matrix(xform.GetPrim());
+
+  TransformSampleCache cache;
+  TransformSample sample;
+  cache.fill(UsdTimeCode(1.0));
+  ASSERT_TRUE(cache.sample(&matrix, UsdTimeCode(1.0), sample));
+  EXPECT_NEAR(1.0, sample.translation.x, 1e-5);
+
+  api.SetTranslate(GfVec3d(5, 0, 0), UsdTimeCode(1.0));
+  ASSERT_TRUE(cache.sample(&matrix, UsdTimeCode(1.0), sample));
+  EXPECT_NEAR(1.0, sample.translation.x, 1e-5);
+
+  // a sample at another time is read from the prim, and does not replace the filled time
+  ASSERT_TRUE(cache.sample(&matrix, UsdTimeCode(0.0), sample));
+  EXPECT_NEAR(0.0, sample.translation.x, 1e-5);
+  ASSERT_TRUE(cache.sample(&matrix, UsdTimeCode(1.0), sample));
+  EXPECT_NEAR(1.0, sample.translation.x, 1e-5);
+
+  cache.invalidate();
+  ASSERT_TRUE(cache.sample(&matrix, UsdTimeCode(1.0), sample));
+  EXPECT_NEAR(5.0, sample.translation.x, 1e-5);
+  EXPECT_EQ(1u, cache.size());
+
+  cache.clear();
+  EXPECT_EQ(0u, cache.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
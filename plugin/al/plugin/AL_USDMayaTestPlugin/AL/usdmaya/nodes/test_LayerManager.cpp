@@ -24,8 +24,10 @@
 #include "maya/MGlobal.h"
 #include "maya/MItDependencyNodes.h"
 #include "maya/MSelectionList.h"
+#include "pxr/base/tf/stringUtils.h"
 #include "pxr/usd/sdf/attributeSpec.h"
 #include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/sdf/primSpec.h"
 #include "pxr/usd/usd/usdaFileFormat.h"
 #include "pxr/usd/usdGeom/tokens.h"
 
@@ -362,8 +364,17 @@ def Scope "blabla"
 
     ASSERT_EQ(MString(realLayer->GetIdentifier().c_str()), idPlug.asString(MDGContext::fsNormal, &status));
     ASSERT_TRUE(status);
-    ASSERT_EQ(MString(LAYER_CONTENTS), serializedPlug.asString(MDGContext::fsNormal, &status));
+    const std::string serializedVal = serializedPlug.asString(MDGContext::fsNormal, &status).asChar();
     ASSERT_TRUE(status);
+    ASSERT_TRUE(TfStringStartsWith(serializedVal, AL::usdmaya::nodes::LayerSerialiser::kBinaryHeader));
+
+    // decode the layer into a new layer, and make sure the contents match
+    AL::usdmaya::nodes::LayerSerialiser serialiser;
+    auto decodedLayer = SdfLayer::CreateAnonymous("decoded.usda");
+    ASSERT_EQ(std::vector<bool>(1, true), serialiser.decode({ decodedLayer }, { serializedVal }));
+    std::string decodedContents;
+    decodedLayer->ExportToString(&decodedContents);
+    ASSERT_EQ(std::string(LAYER_CONTENTS), decodedContents);
     ASSERT_FALSE(anonymousPlug.asBool(MDGContext::fsNormal, &status));
     ASSERT_TRUE(status);
   };
@@ -394,6 +405,47 @@ def Scope "blabla"
   ASSERT_EQ(2, manager->layersPlug().evaluateNumElements());
   manager->populateSerialisationAttributes();
   { SCOPED_TRACE(""); assertLayersPopulated(); }
+
+  // the layer has not changed, so the previous encoding should have been reused
+  EXPECT_EQ(0u, manager->serialiser().lastEncodeCount());
+  EXPECT_EQ(1u, manager->serialiser().size());
+
+  // editing the layer should cause it to be re-encoded
+  realLayer->GetPrimAtPath(SdfPath("/blabla"))->SetDocumentation("edited");
+  EXPECT_EQ(0u, manager->serialiser().size());
+  manager->clearSerialisationAttributes();
+  manager->populateSerialisationAttributes();
+  EXPECT_EQ(1u, manager->serialiser().lastEncodeCount());
+}
+
+// Layers serialized as text (by older versions of the plugin) should still be decoded
+TEST(LayerManager, serialiserTextFallback)
+{
+  constexpr auto LAYER_CONTENTS = R"ESC(#usda 1.0
+
+def Xform "text"
+{
+}
+
+)ESC";
+
+  AL::usdmaya::nodes::LayerSerialiser serialiser;
+  auto layer = SdfLayer::CreateAnonymous("text.usda");
+  ASSERT_EQ(std::vector<bool>(1, true), serialiser.decode({ layer }, { LAYER_CONTENTS }));
+  EXPECT_TRUE(layer->GetPrimAtPath(SdfPath("/text")));
+
+  // text layers are not retained, as they have to be re-encoded in the binary format
+  EXPECT_EQ(0u, serialiser.size());
+  const std::vector<std::shared_ptr<const std::string>> encoded = serialiser.encode({ layer });
+  ASSERT_EQ(1u, encoded.size());
+  EXPECT_TRUE(TfStringStartsWith(*encoded[0], AL::usdmaya::nodes::LayerSerialiser::kBinaryHeader));
+  EXPECT_EQ(1u, serialiser.lastEncodeCount());
+
+  // the returned data outlives the retained encoding
+  const std::string copy = *encoded[0];
+  layer->GetPrimAtPath(SdfPath("/text"))->SetDocumentation("edited");
+  EXPECT_EQ(0u, serialiser.size());
+  EXPECT_EQ(copy, *encoded[0]);
 }
 
 TEST(LayerManager, simpleSaveRestore)
@@ -85,6 +85,10 @@ TEST(ProxyShapeSelectabilityDB, selectablesOnModification)
 
   //Check that the path is selectable directly using the selectableDB object
   EXPECT_TRUE(proxyShape->selectabilityDB().isPathUnselectable(expectedSelectable));
+
+  //Check that the child inherits the selectability from the cached states
+  EXPECT_TRUE(proxyShape->isPathUnselectable(SdfPath("/A/B/C")));
+  EXPECT_FALSE(proxyShape->isPathUnselectable(SdfPath("/A")));
 }
 
 /*
@@ -263,6 +263,135 @@ TEST(TranslatorContext, TranslatorContext)
 }
 
 
+namespace {
+const char* const g_scopeHierarchy =
+  "#usda 1.0\n"
+  "\n"
+  "def Scope \"root\"\n"
+  "{\n"
+  "    def Scope \"a\"\n"
+  "    {\n"
+  "        def Scope \"b\"\n"
+  "        {\n"
+  "            def Scope \"c\"\n"
+  "            {\n"
+  "            }\n"
+  "        }\n"
+  "    }\n"
+  "    def Scope \"d\"\n"
+  "    {\n"
+  "    }\n"
+  "}\n";
+
+AL::usdmaya::nodes::ProxyShape* createScopeHierarchyProxy(const std::string& temp_path)
+{
+  {
+    std::ofstream os(temp_path);
+    os << g_scopeHierarchy;
+  }
+
+  MFnDagNode fn;
+  MObject xform = fn.create("transform");
+  fn.create("AL_usdmaya_ProxyShape", xform);
+  AL::usdmaya::nodes::ProxyShape* proxy = (AL::usdmaya::nodes::ProxyShape*)fn.userNode();
+  proxy->filePathPlug().setString(temp_path.c_str());
+  proxy->context()->clearPrimMappings();
+  return proxy;
+}
+}
+
+// void TranslatorContext::preRemoveEntry(const SdfPath& primPath, SdfPathVector& itemsToRemove, bool callPreUnload=true);
+// void TranslatorContext::removeEntries(const SdfPathVector& itemsToRemove);
+TEST(TranslatorContext, removeSubtree)
+{
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_removeSubtree.usda");
+  AL::usdmaya::nodes::ProxyShape* proxy = createScopeHierarchyProxy(temp_path);
+  auto stage = proxy->getUsdStage();
+  AL::usdmaya::fileio::translators::TranslatorContextPtr context = proxy->context();
+
+  const char* const paths[] = { "/root/a", "/root/a/b", "/root/a/b/c", "/root/d" };
+  for(const char* path : paths)
+  {
+    context->registerItem(stage->GetPrimAtPath(SdfPath(path)), MObject::kNullObj);
+  }
+
+  SdfPathVector itemsToRemove;
+  context->preRemoveEntry(SdfPath("/root/a"), itemsToRemove, false);
+  ASSERT_EQ(3, itemsToRemove.size());
+
+  // children must be ordered before their parents
+  EXPECT_EQ(SdfPath("/root/a/b/c"), itemsToRemove[0]);
+  EXPECT_EQ(SdfPath("/root/a/b"), itemsToRemove[1]);
+  EXPECT_EQ(SdfPath("/root/a"), itemsToRemove[2]);
+
+  context->removeEntries(itemsToRemove);
+
+  EXPECT_TRUE(TfToken() == context->getTypeForPath(SdfPath("/root/a")));
+  EXPECT_TRUE(TfToken() == context->getTypeForPath(SdfPath("/root/a/b")));
+  EXPECT_TRUE(TfToken() == context->getTypeForPath(SdfPath("/root/a/b/c")));
+  EXPECT_TRUE(TfToken("Scope") == context->getTypeForPath(SdfPath("/root/d")));
+
+  // nothing left to remove beneath the removed prim, and the sibling is unaffected
+  itemsToRemove.clear();
+  context->preRemoveEntry(SdfPath("/root/a"), itemsToRemove, false);
+  EXPECT_TRUE(itemsToRemove.empty());
+  context->preRemoveEntry(SdfPath("/root"), itemsToRemove, false);
+  ASSERT_EQ(1, itemsToRemove.size());
+  EXPECT_EQ(SdfPath("/root/d"), itemsToRemove[0]);
+}
+
+// void TranslatorContext::removeItems(const SdfPath& path);
+// void TranslatorContext::insertItem(const UsdPrim& prim, MObjectHandle object);
+TEST(TranslatorContext, reuseRemovedSlots)
+{
+  MFileIO::newFile(true);
+  const std::string temp_path = buildTempPath("AL_USDMayaTests_reuseRemovedSlots.usda");
+  AL::usdmaya::nodes::ProxyShape* proxy = createScopeHierarchyProxy(temp_path);
+  auto stage = proxy->getUsdStage();
+  AL::usdmaya::fileio::translators::TranslatorContextPtr context = proxy->context();
+
+  UsdPrim primA = stage->GetPrimAtPath(SdfPath("/root/a"));
+  UsdPrim primB = stage->GetPrimAtPath(SdfPath("/root/a/b"));
+  UsdPrim primD = stage->GetPrimAtPath(SdfPath("/root/d"));
+
+  MFnDependencyNode fnd;
+  MObject cubeA = fnd.create("polyCube");
+  MObject cubeD = fnd.create("polyCube");
+  context->registerItem(primA, MObject::kNullObj);
+  context->insertItem(primA, cubeA);
+  context->registerItem(primD, MObject::kNullObj);
+  context->insertItem(primD, cubeD);
+
+  // frees the slot used by /root/a
+  context->removeItems(SdfPath("/root/a"));
+  EXPECT_TRUE(TfToken() == context->getTypeForPath(SdfPath("/root/a")));
+
+  // the freed slot is re-used, and must not carry over the nodes of the previous entry
+  context->registerItem(primB, MObject::kNullObj);
+  {
+    AL::usdmaya::fileio::translators::MObjectHandleArray handles;
+    EXPECT_TRUE(context->getMObjects(SdfPath("/root/a/b"), handles));
+    EXPECT_TRUE(handles.empty());
+  }
+  MObject cubeB = fnd.create("polyCube");
+  context->insertItem(primB, cubeB);
+  {
+    AL::usdmaya::fileio::translators::MObjectHandleArray handles;
+    context->getMObjects(SdfPath("/root/a/b"), handles);
+    ASSERT_EQ(1, handles.size());
+    EXPECT_TRUE(handles[0].object() == cubeB);
+  }
+  {
+    AL::usdmaya::fileio::translators::MObjectHandleArray handles;
+    context->getMObjects(SdfPath("/root/d"), handles);
+    ASSERT_EQ(1, handles.size());
+    EXPECT_TRUE(handles[0].object() == cubeD);
+  }
+  EXPECT_TRUE(TfToken() == context->getTypeForPath(SdfPath("/root/a")));
+}
+
+
 // TranslatorContext::~TranslatorContext();
 // void TranslatorContext::updatePrimTypes();
 // void TranslatorContext::registerItem(const UsdPrim& prim, MObjectHandle object);
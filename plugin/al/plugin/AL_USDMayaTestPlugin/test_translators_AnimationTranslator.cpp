@@ -28,6 +28,9 @@
 #include "maya/MPointArray.h"
 #include "maya/MSelectionList.h"
 
+#include "pxr/usd/usd/stage.h"
+
+using AL::usdmaya::fileio::AnimationSampleFilter;
 using AL::usdmaya::fileio::AnimationTranslator;
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -475,3 +478,71 @@ TEST(translators_AnimationTranslator, isAnimatedTransform)
 
 
 
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Test that runs of identical samples are reduced to their first and last samples as they are written
+//----------------------------------------------------------------------------------------------------------------------
+TEST(translators_AnimationTranslator, sampleFilterRemovesDuplicates)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdPrim prim = stage->DefinePrim(SdfPath("/root"));
+  UsdAttribute a = prim.CreateAttribute(TfToken("a"), SdfValueTypeNames->Float);
+  UsdAttribute b = prim.CreateAttribute(TfToken("b"), SdfValueTypeNames->Float3);
+  UsdAttribute c = prim.CreateAttribute(TfToken("c"), SdfValueTypeNames->Double);
+
+  const float values[] = { 1.0f, 1.0f, 1.0f, 1.0f, 2.0f, 3.0f, 3.0f, 4.0f, 4.0f, 4.0f };
+  AnimationSampleFilter filter({ a, b });
+  for(int i = 0; i < 10; ++i)
+  {
+    a.Set(values[i], UsdTimeCode(i));
+    b.Set(GfVec3f(0.0f, 1.0f, 2.0f), UsdTimeCode(i));
+    c.Set(1.0, UsdTimeCode(i));
+    filter.samplesWritten(i);
+  }
+  filter.finish();
+
+  std::vector<double> times;
+  a.GetTimeSamples(&times);
+  EXPECT_EQ(std::vector<double>({ 0.0, 3.0, 4.0, 5.0, 6.0, 7.0 }), times);
+  b.GetTimeSamples(&times);
+  EXPECT_EQ(std::vector<double>({ 0.0 }), times);
+  EXPECT_EQ(13u, filter.numRemoved());
+
+  // attributes that were not filtered as they were written can be filtered afterwards
+  EXPECT_EQ(9u, AnimationSampleFilter::removeDuplicateSamples({ c }));
+  c.GetTimeSamples(&times);
+  EXPECT_EQ(std::vector<double>({ 0.0 }), times);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Test that samples which can be interpolated from their neighbours within the tolerance are removed
+//----------------------------------------------------------------------------------------------------------------------
+TEST(translators_AnimationTranslator, sampleFilterReducesCurves)
+{
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdPrim prim = stage->DefinePrim(SdfPath("/root"));
+  UsdAttribute linear = prim.CreateAttribute(TfToken("linear"), SdfValueTypeNames->Double3);
+  UsdAttribute peak = prim.CreateAttribute(TfToken("peak"), SdfValueTypeNames->Float);
+  UsdAttribute text = prim.CreateAttribute(TfToken("text"), SdfValueTypeNames->String);
+
+  for(int i = 0; i <= 10; ++i)
+  {
+    linear.Set(GfVec3d(i, 2.0 * i, 1.0 + 0.0001 * (i % 2)), UsdTimeCode(i));
+    peak.Set(float(i <= 5 ? i : 10 - i), UsdTimeCode(i));
+    text.Set(std::string("constant"), UsdTimeCode(i));
+  }
+
+  EXPECT_EQ(9u + 8u, AnimationSampleFilter::reduceSamples({ linear, peak, text }, 0.001));
+
+  std::vector<double> times;
+  linear.GetTimeSamples(&times);
+  EXPECT_EQ(std::vector<double>({ 0.0, 10.0 }), times);
+  peak.GetTimeSamples(&times);
+  EXPECT_EQ(std::vector<double>({ 0.0, 5.0, 10.0 }), times);
+  EXPECT_EQ(11u, text.GetNumTimeSamples());
+
+  // the interpolated values should be unchanged
+  float value;
+  peak.Get(&value, UsdTimeCode(3.0));
+  EXPECT_NEAR(3.0f, value, 1e-5f);
+}
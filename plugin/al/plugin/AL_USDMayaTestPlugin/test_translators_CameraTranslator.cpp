@@ -94,6 +94,65 @@ TEST(translators_CameraTranslator, io)
   }
 }
 
+TEST(translators_CameraTranslator, batch_io)
+{
+  for(int i = 0; i < 10; ++i)
+  {
+    MDagModifier mod, mod2;
+    MObject xform = mod.createNode("transform");
+    MObject node = mod.createNode("camera", xform);
+    MObject xformB = mod.createNode("transform");
+    EXPECT_EQ(MStatus(MS::kSuccess), mod.doIt());
+
+    const char* const attributeNames[] = {
+        "orthographic",
+        "horizontalFilmAperture",
+        "verticalFilmAperture",
+        "horizontalFilmOffset",
+        "verticalFilmOffset",
+        "focalLength",
+        "focusDistance",
+        "nearClipPlane",
+        "farClipPlane",
+        "fStop",
+    };
+    const uint32_t numAttributes = sizeof(attributeNames) / sizeof(const char* const);
+
+    randomNode(node, attributeNames, numAttributes);
+
+    UsdStageRefPtr stage = UsdStage::CreateInMemory();
+    ExporterParams eparams;
+    SdfPath cameraPath("/hello");
+    MDagPath nodeDagPath;
+    MDagPath::getAPathTo(node, nodeDagPath);
+
+    AL::usdmaya::fileio::translators::TranslatorManufacture manufacture(nullptr);
+    AL::usdmaya::fileio::translators::TranslatorRefPtr xtrans = manufacture.get(TfToken("Camera"));
+    ASSERT_TRUE(xtrans->supportsBatchImport());
+    UsdPrim cameraPrim = xtrans->exportObject(stage, nodeDagPath, cameraPath, eparams);
+    EXPECT_TRUE(cameraPrim.IsValid());
+
+    // the node is only created once the modifier is executed, and its attributes are set from the prefetched data
+    MDagModifier batchModifier;
+    MObject nodeB;
+    EXPECT_EQ(MStatus(MS::kSuccess), xtrans->queueNodeCreation(cameraPrim, xformB, batchModifier, nodeB));
+    EXPECT_EQ(MStatus(MS::kSuccess), batchModifier.doIt());
+    EXPECT_TRUE(nodeB.hasFn(MFn::kCamera));
+
+    AL::usdmaya::fileio::translators::TranslatorPrefetchDataPtr data = xtrans->prefetch(cameraPrim);
+    ASSERT_TRUE(data.get() != nullptr);
+    EXPECT_EQ(MStatus(MS::kSuccess), xtrans->importAttributes(cameraPrim, nodeB, data.get()));
+
+    compareNodes(node, nodeB, attributeNames, numAttributes, true);
+
+    mod2.deleteNode(nodeB);
+    mod2.deleteNode(xformB);
+    mod2.deleteNode(node);
+    mod2.deleteNode(xform);
+    mod2.doIt();
+  }
+}
+
 TEST(translators_CameraTranslator, animated_io)
 {
   const double startFrame = 1.0;
@@ -15,12 +15,17 @@
 //
 #include "test_usdmaya.h"
 
+#include "maya/MDagModifier.h"
 #include "maya/MFileIO.h"
+#include "maya/MFnDagNode.h"
+#include "maya/MPointArray.h"
 
 #include "AL/maya/utils/NodeHelper.h"
 #include "AL/usdmaya/fileio/ImportParams.h"
 #include "AL/usdmaya/fileio/translators/DagNodeTranslator.h"
+#include "AL/usdmaya/fileio/translators/TranslatorBase.h"
 #include "AL/usdmaya/utils/MeshUtils.h"
+#include "AL/usd/utils/CpuFeatures.h"
 
 using namespace AL::usdmaya::fileio::translators;
 using AL::maya::test::buildTempPath;
@@ -121,6 +126,73 @@ TEST(translators_MeshTranslator, interleaveIndexedUvData)
   }
 }
 
+TEST(translators_MeshTranslator, arrayConversionsAtEachSimdLevel)
+{
+  using AL::usd::utils::SimdLevel;
+  const SimdLevel active = AL::usd::utils::activeSimdLevel();
+  const uint32_t supported = uint32_t(AL::usd::utils::supportedSimdLevel());
+  for(uint32_t level = 0; level <= supported; ++level)
+  {
+    ASSERT_TRUE(AL::usd::utils::setActiveSimdLevel(SimdLevel(level)));
+
+    // cover the full width & remainder paths of each instruction set, and check nothing is written past the end
+    for(uint32_t count = 0; count < 70; ++count)
+    {
+      std::vector<float> points(count * 3), u(count), v(count);
+      std::vector<int32_t> indices(count);
+      for(uint32_t i = 0; i < count; ++i)
+      {
+        points[i * 3] = float(i);
+        points[i * 3 + 1] = float(i) + 0.25f;
+        points[i * 3 + 2] = float(i) + 0.5f;
+        u[i] = float(i);
+        v[i] = -float(i);
+        indices[i] = count - i - 1;
+      }
+
+      std::vector<float> points4(count * 4 + 1, -1.0f);
+      AL::usdmaya::utils::convert3DArrayTo4DArray(points.data(), points4.data(), count);
+      for(uint32_t i = 0; i < count; ++i)
+      {
+        EXPECT_EQ(points[i * 3], points4[i * 4]);
+        EXPECT_EQ(points[i * 3 + 1], points4[i * 4 + 1]);
+        EXPECT_EQ(points[i * 3 + 2], points4[i * 4 + 2]);
+        EXPECT_EQ(1.0f, points4[i * 4 + 3]);
+      }
+      EXPECT_EQ(-1.0f, points4[count * 4]);
+
+      std::vector<float> uv(count * 2 + 1, -1.0f);
+      AL::usdmaya::utils::zipUVs(u.data(), v.data(), uv.data(), count);
+      for(uint32_t i = 0; i < count; ++i)
+      {
+        EXPECT_EQ(u[i], uv[i * 2]);
+        EXPECT_EQ(v[i], uv[i * 2 + 1]);
+      }
+      EXPECT_EQ(-1.0f, uv[count * 2]);
+
+      std::vector<float> u2(count + 1, -1.0f), v2(count + 1, -1.0f);
+      AL::usdmaya::utils::unzipUVs(uv.data(), u2.data(), v2.data(), count);
+      for(uint32_t i = 0; i < count; ++i)
+      {
+        EXPECT_EQ(u[i], u2[i]);
+        EXPECT_EQ(v[i], v2[i]);
+      }
+      EXPECT_EQ(-1.0f, u2[count]);
+      EXPECT_EQ(-1.0f, v2[count]);
+
+      std::vector<float> interleaved(count * 2 + 1, -1.0f);
+      AL::usdmaya::utils::interleaveIndexedUvData(interleaved.data(), u.data(), v.data(), indices.data(), count);
+      for(uint32_t i = 0; i < count; ++i)
+      {
+        EXPECT_EQ(u[indices[i]], interleaved[i * 2]);
+        EXPECT_EQ(v[indices[i]], interleaved[i * 2 + 1]);
+      }
+      EXPECT_EQ(-1.0f, interleaved[count * 2]);
+    }
+  }
+  AL::usd::utils::setActiveSimdLevel(active);
+}
+
 TEST(translators_MeshTranslator, isUvSetDataSparse)
 {
   std::vector<int32_t> uvCounts;
@@ -148,6 +220,141 @@ TEST(translators_MeshTranslator, generateIncrementingIndices)
   }
 }
 
+TEST(translators_MeshTranslator, edgeLookup)
+{
+  MFileIO::newFile(true);
+  MGlobal::executeCommand("polyCube -w 1 -h 1 -d 1 -sx 2 -sy 2 -sz 2 -ax 0 1 0 -cuv 2 -ch 0;");
+
+  MSelectionList sl;
+  sl.add("pCubeShape1");
+  MObject obj;
+  sl.getDependNode(0, obj);
+  MFnMesh fn(obj);
+
+  AL::usdmaya::utils::EdgeLookup lookup(fn);
+  ASSERT_EQ(size_t(fn.numEdges()), lookup.size());
+  for(int32_t i = 0; i < fn.numEdges(); ++i)
+  {
+    int2 edgeVerts;
+    fn.getEdgeVertices(i, edgeVerts);
+    EXPECT_EQ(i, lookup.find(edgeVerts[0], edgeVerts[1]));
+    EXPECT_EQ(i, lookup.find(edgeVerts[1], edgeVerts[0]));
+  }
+
+  // opposite corners of the cube do not share an edge
+  EXPECT_EQ(-1, lookup.find(0, fn.numVertices() - 1));
+}
+
+TEST(translators_MeshTranslator, edgeCreaseImport)
+{
+  MFileIO::newFile(true);
+
+  // a single quad, with a crease running along two of its edges, and an edge that is not in the mesh
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath("/quad"));
+  VtArray<GfVec3f> points(4);
+  points[0] = GfVec3f(0, 0, 0);
+  points[1] = GfVec3f(1, 0, 0);
+  points[2] = GfVec3f(1, 0, 1);
+  points[3] = GfVec3f(0, 0, 1);
+  VtArray<int> counts(1, 4);
+  VtArray<int> connects(4);
+  for(int i = 0; i < 4; ++i)
+    connects[i] = i;
+  mesh.GetPointsAttr().Set(points);
+  mesh.GetFaceVertexCountsAttr().Set(counts);
+  mesh.GetFaceVertexIndicesAttr().Set(connects);
+
+  VtArray<int> creaseIndices(5);
+  creaseIndices[0] = 0;
+  creaseIndices[1] = 1;
+  creaseIndices[2] = 2;
+  creaseIndices[3] = 0;
+  creaseIndices[4] = 2;
+  VtArray<int> creaseLengths(2);
+  creaseLengths[0] = 3;
+  creaseLengths[1] = 2;
+  VtArray<float> creaseSharpnesses(2);
+  creaseSharpnesses[0] = 0.5f;
+  creaseSharpnesses[1] = 0.25f;
+  mesh.GetCreaseIndicesAttr().Set(creaseIndices);
+  mesh.GetCreaseLengthsAttr().Set(creaseLengths);
+  mesh.GetCreaseSharpnessesAttr().Set(creaseSharpnesses);
+
+  MFnDagNode fnDag;
+  MObject parent = fnDag.create("transform");
+  AL::usdmaya::utils::MeshImportContext context(mesh, parent, "quadShape", UsdTimeCode::Default());
+  EXPECT_TRUE(context.applyEdgeCreases());
+
+  MFnMesh& fn = context.getFn();
+  MUintArray edgeIds;
+  MDoubleArray creaseData;
+  fn.getCreaseEdges(edgeIds, creaseData);
+  ASSERT_EQ(2u, edgeIds.length());
+  ASSERT_EQ(2u, creaseData.length());
+
+  const AL::usdmaya::utils::EdgeLookup& lookup = context.getEdgeLookup();
+  for(uint32_t i = 0; i < edgeIds.length(); ++i)
+  {
+    EXPECT_NEAR(0.5, creaseData[i], 1e-5);
+    EXPECT_TRUE(int32_t(edgeIds[i]) == lookup.find(0, 1) || int32_t(edgeIds[i]) == lookup.find(1, 2));
+  }
+}
+
+TEST(translators_MeshTranslator, batchImport)
+{
+  MFileIO::newFile(true);
+
+  UsdStageRefPtr stage = UsdStage::CreateInMemory();
+  UsdGeomMesh mesh = UsdGeomMesh::Define(stage, SdfPath("/quad"));
+  VtArray<GfVec3f> points(4);
+  points[0] = GfVec3f(0, 0, 0);
+  points[1] = GfVec3f(1, 0, 0);
+  points[2] = GfVec3f(1, 0, 1);
+  points[3] = GfVec3f(0, 0, 1);
+  VtArray<int> counts(1, 4);
+  VtArray<int> connects(4);
+  for(int i = 0; i < 4; ++i)
+    connects[i] = i;
+  mesh.GetPointsAttr().Set(points);
+  mesh.GetFaceVertexCountsAttr().Set(counts);
+  mesh.GetFaceVertexIndicesAttr().Set(connects);
+  mesh.GetHoleIndicesAttr().Set(VtArray<int>(1, 0));
+
+  AL::usdmaya::fileio::translators::TranslatorManufacture manufacture(nullptr);
+  AL::usdmaya::fileio::translators::TranslatorRefPtr translator = manufacture.get(TfToken("Mesh"));
+  ASSERT_TRUE(translator);
+  ASSERT_TRUE(translator->supportsBatchImport());
+
+  // the node is only created once the modifier is executed, and its geometry is set from the prefetched data
+  MFnDagNode fnDag;
+  MObject parent = fnDag.create("transform");
+  MDagModifier modifier;
+  MObject node;
+  EXPECT_EQ(MStatus(MS::kSuccess), translator->queueNodeCreation(mesh.GetPrim(), parent, modifier, node));
+  EXPECT_EQ(MStatus(MS::kSuccess), modifier.doIt());
+  EXPECT_TRUE(node.hasFn(MFn::kMesh));
+
+  AL::usdmaya::fileio::translators::TranslatorPrefetchDataPtr data = translator->prefetch(mesh.GetPrim());
+  ASSERT_TRUE(data.get() != nullptr);
+  EXPECT_EQ(MStatus(MS::kSuccess), translator->importAttributes(mesh.GetPrim(), node, data.get()));
+
+  MFnMesh fnMesh(node);
+  EXPECT_EQ(4, fnMesh.numVertices());
+  EXPECT_EQ(1, fnMesh.numPolygons());
+  EXPECT_EQ(MString("quadShape"), fnMesh.name());
+  MPointArray mayaPoints;
+  fnMesh.getPoints(mayaPoints);
+  ASSERT_EQ(4u, mayaPoints.length());
+  for(uint32_t i = 0; i < 4; ++i)
+  {
+    EXPECT_NEAR(points[i][0], mayaPoints[i].x, 1e-5);
+    EXPECT_NEAR(points[i][1], mayaPoints[i].y, 1e-5);
+    EXPECT_NEAR(points[i][2], mayaPoints[i].z, 1e-5);
+  }
+  EXPECT_EQ(1u, fnMesh.getInvisibleFaces().length());
+}
+
 UsdGeomPrimvar getDefaultUvSet(UsdGeomMesh mesh)
 {
   const std::vector<UsdGeomPrimvar> primvars = mesh.GetPrimvars();
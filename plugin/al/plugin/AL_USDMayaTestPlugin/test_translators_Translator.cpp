@@ -22,6 +22,8 @@
 #include "AL/usdmaya/nodes/ProxyShape.h"
 
 #include "maya/MDagModifier.h"
+#include "maya/MFileIO.h"
+#include "maya/MFnDagNode.h"
 
 #include "pxr/base/tf/refPtr.h"
 #include "pxr/base/tf/type.h"
@@ -73,3 +75,50 @@ TEST(translators_Translator, translatorContext)
   EXPECT_TRUE(context->getTransform(m_prim, handle));
   EXPECT_TRUE(handle.object() == tm);
 }
+
+// the translator and extra data plugin lookups for a maya node should only query the plugins once per node type
+TEST(translators_Translator, nodeTypeLookupCache)
+{
+  MFileIO::newFile(true);
+
+  TranslatorContextPtr context = TranslatorContext::create(nullptr);
+  TranslatorManufacture manufacture(context);
+
+  MFnDagNode fnDag;
+  MObject tm = fnDag.create("transform");
+  MObject first = fnDag.create("distanceDimShape", tm);
+  MObject second = fnDag.create("distanceDimShape", tm);
+
+  TranslatorRefPtr firstTranslator = manufacture.get(first);
+  EXPECT_TRUE(firstTranslator);
+  EXPECT_EQ(0u, manufacture.lookupStats().translatorHits);
+  EXPECT_EQ(1u, manufacture.lookupStats().translatorMisses);
+
+  TranslatorRefPtr secondTranslator = manufacture.get(second);
+  EXPECT_TRUE(firstTranslator == secondTranslator);
+  EXPECT_EQ(1u, manufacture.lookupStats().translatorHits);
+  EXPECT_EQ(1u, manufacture.lookupStats().translatorMisses);
+
+  // a different node type gets its own entry
+  manufacture.get(tm);
+  EXPECT_EQ(1u, manufacture.lookupStats().translatorHits);
+  EXPECT_EQ(2u, manufacture.lookupStats().translatorMisses);
+
+  auto firstPlugins = manufacture.getExtraDataPlugins(first);
+  auto secondPlugins = manufacture.getExtraDataPlugins(second);
+  EXPECT_TRUE(firstPlugins == secondPlugins);
+  EXPECT_EQ(1u, manufacture.lookupStats().extraDataHits);
+  EXPECT_EQ(1u, manufacture.lookupStats().extraDataMisses);
+
+  // loading or unloading a maya plugin flushes the caches
+  TranslatorManufacture::invalidateLookupCaches();
+  EXPECT_TRUE(manufacture.get(first) == firstTranslator);
+  EXPECT_EQ(1u, manufacture.lookupStats().translatorHits);
+  EXPECT_EQ(3u, manufacture.lookupStats().translatorMisses);
+
+  manufacture.resetLookupStats();
+  EXPECT_EQ(0u, manufacture.lookupStats().translatorHits);
+  EXPECT_EQ(0u, manufacture.lookupStats().translatorMisses);
+  EXPECT_EQ(0u, manufacture.lookupStats().extraDataHits);
+  EXPECT_EQ(0u, manufacture.lookupStats().extraDataMisses);
+}
@@ -98,110 +98,192 @@ void Camera::checkCurrentCameras(MObject cameraNode)
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-MStatus Camera::updateAttributes(MObject to, const UsdPrim& prim)
+/// \brief  The values read from a UsdGeomCamera. Attributes flagged as animated are keyed from the time samples of the
+///         USD attribute instead.
+//----------------------------------------------------------------------------------------------------------------------
+struct Camera::CameraData
+  : public TranslatorPrefetchData
+{
+  TfToken projection;
+  GfVec2f clippingRange = GfVec2f(0.0f);
+  float fstop = 0.0f;
+  float focusDistance = 0.0f;
+  float horizontalAperture = 0.0f;
+  float verticalAperture = 0.0f;
+  float horizontalApertureOffset = 0.0f;
+  float verticalApertureOffset = 0.0f;
+  float focalLength = 0.0f;
+  bool animatedFStop = false;
+  bool animatedFocusDistance = false;
+  bool animatedHorizontalAperture = false;
+  bool animatedVerticalAperture = false;
+  bool animatedHorizontalApertureOffset = false;
+  bool animatedVerticalApertureOffset = false;
+  bool animatedFocalLength = false;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+void Camera::readAttributes(const UsdPrim& prim, CameraData& data) const
 {
   UsdGeomCamera usdCamera(prim);
-  const char* const errorString = "CameraTranslator: error setting maya camera parameters";
-  const float mm_to_inches = 0.0393701f;
   UsdTimeCode timeCode = UsdTimeCode::EarliestTime();
   bool forceDefaultRead = false;
-  if(context() && context()->getForceDefaultRead())
+  TranslatorContextPtr ctx = context();
+  if(ctx && ctx->getForceDefaultRead())
   {
     timeCode = UsdTimeCode::Default();
     forceDefaultRead = true;
   }
 
-  TfToken projection;
-  usdCamera.GetProjectionAttr().Get(&projection, timeCode);
-  bool isOrthographic = (projection == UsdGeomTokens->orthographic);
-  AL_MAYA_CHECK_ERROR(DgNodeTranslator::setBool(to, m_orthographic, isOrthographic), errorString);
+  usdCamera.GetProjectionAttr().Get(&data.projection, timeCode);
+
+  // F-Stop
+  auto fstopAttr = usdCamera.GetFStopAttr();
+  data.animatedFStop = fstopAttr.GetNumTimeSamples() != 0;
+  if(!data.animatedFStop)
+  {
+    fstopAttr.Get(&data.fstop, timeCode);
+  }
+
+  // Focus distance
+  auto focusDistanceAttr = usdCamera.GetFocusDistanceAttr();
+  data.animatedFocusDistance = focusDistanceAttr.GetNumTimeSamples() && !forceDefaultRead;
+  if(!data.animatedFocusDistance)
+  {
+    focusDistanceAttr.Get(&data.focusDistance, timeCode);
+  }
 
   // Horizontal film aperture
   auto horizontalApertureAttr = usdCamera.GetHorizontalApertureAttr();
-  if(!horizontalApertureAttr.GetNumTimeSamples() || forceDefaultRead)
+  data.animatedHorizontalAperture = horizontalApertureAttr.GetNumTimeSamples() && !forceDefaultRead;
+  if(!data.animatedHorizontalAperture)
   {
-    float horizontalAperture;
-    horizontalApertureAttr.Get(&horizontalAperture, timeCode);
-    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_horizontalFilmAperture, mm_to_inches * horizontalAperture), errorString);
+    horizontalApertureAttr.Get(&data.horizontalAperture, timeCode);
+  }
+
+  // Vertical film aperture
+  auto verticalApertureAttr = usdCamera.GetVerticalApertureAttr();
+  data.animatedVerticalAperture = verticalApertureAttr.GetNumTimeSamples() && !forceDefaultRead;
+  if(!data.animatedVerticalAperture)
+  {
+    verticalApertureAttr.Get(&data.verticalAperture, timeCode);
+  }
+
+  // Horizontal film aperture offset
+  auto horizontalApertureOffsetAttr = usdCamera.GetHorizontalApertureOffsetAttr();
+  data.animatedHorizontalApertureOffset = horizontalApertureOffsetAttr.GetNumTimeSamples() && !forceDefaultRead;
+  if(!data.animatedHorizontalApertureOffset)
+  {
+    horizontalApertureOffsetAttr.Get(&data.horizontalApertureOffset, timeCode);
+  }
+
+  // Vertical film aperture offset
+  auto verticalApertureOffsetAttr = usdCamera.GetVerticalApertureOffsetAttr();
+  data.animatedVerticalApertureOffset = verticalApertureOffsetAttr.GetNumTimeSamples() && !forceDefaultRead;
+  if(!data.animatedVerticalApertureOffset)
+  {
+    verticalApertureOffsetAttr.Get(&data.verticalApertureOffset);
+  }
+
+  // Focal length
+  auto focalLengthAttr = usdCamera.GetFocalLengthAttr();
+  data.animatedFocalLength = focalLengthAttr.GetNumTimeSamples() && !forceDefaultRead;
+  if(!data.animatedFocalLength)
+  {
+    focalLengthAttr.Get(&data.focalLength, timeCode);
+  }
+
+  // Near/far clip planes
+  // N.B. Animated clip plane values not supported
+  usdCamera.GetClippingRangeAttr().Get(&data.clippingRange, timeCode);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus Camera::writeAttributes(MObject to, const UsdPrim& prim, const CameraData& data)
+{
+  UsdGeomCamera usdCamera(prim);
+  const char* const errorString = "CameraTranslator: error setting maya camera parameters";
+  const float mm_to_inches = 0.0393701f;
+
+  bool isOrthographic = (data.projection == UsdGeomTokens->orthographic);
+  AL_MAYA_CHECK_ERROR(DgNodeTranslator::setBool(to, m_orthographic, isOrthographic), errorString);
+
+  // Horizontal film aperture
+  if(!data.animatedHorizontalAperture)
+  {
+    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_horizontalFilmAperture, mm_to_inches * data.horizontalAperture), errorString);
   }
   else
   {
     DgNodeTranslator::setFloatAttrAnim(to,
                                        m_horizontalFilmAperture,
-                                       horizontalApertureAttr,
+                                       usdCamera.GetHorizontalApertureAttr(),
                                        mm_to_inches);
   }
 
   // Vertical film aperture
-  auto verticalApertureAttr = usdCamera.GetVerticalApertureAttr();
-  if(!verticalApertureAttr.GetNumTimeSamples() || forceDefaultRead)
+  if(!data.animatedVerticalAperture)
   {
-    float verticalAperture;
-    verticalApertureAttr.Get(&verticalAperture, timeCode);
-    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_verticalFilmAperture, mm_to_inches * verticalAperture), errorString);
+    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_verticalFilmAperture, mm_to_inches * data.verticalAperture), errorString);
   }
   else
   {
     DgNodeTranslator::setFloatAttrAnim(to,
                                        m_verticalFilmAperture,
-                                       verticalApertureAttr,
+                                       usdCamera.GetVerticalApertureAttr(),
                                        mm_to_inches);
   }
 
   // Horizontal film aperture offset
-  auto horizontalApertureOffsetAttr = usdCamera.GetHorizontalApertureOffsetAttr();
-  if(!horizontalApertureOffsetAttr.GetNumTimeSamples() || forceDefaultRead)
+  if(!data.animatedHorizontalApertureOffset)
   {
-    float horizontalApertureOffset;
-    horizontalApertureOffsetAttr.Get(&horizontalApertureOffset, timeCode);
-    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_horizontalFilmApertureOffset, mm_to_inches * horizontalApertureOffset), errorString);
+    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_horizontalFilmApertureOffset, mm_to_inches * data.horizontalApertureOffset), errorString);
   }
   else
   {
     DgNodeTranslator::setFloatAttrAnim(to,
                                        m_horizontalFilmApertureOffset,
-                                       horizontalApertureOffsetAttr,
+                                       usdCamera.GetHorizontalApertureOffsetAttr(),
                                        mm_to_inches);
   }
 
   // Vertical film aperture offset
-  auto verticalApertureOffsetAttr = usdCamera.GetVerticalApertureOffsetAttr();
-  if(!verticalApertureOffsetAttr.GetNumTimeSamples() || forceDefaultRead)
+  if(!data.animatedVerticalApertureOffset)
   {
-    float verticalApertureOffset;
-    verticalApertureOffsetAttr.Get(&verticalApertureOffset);
-    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_verticalFilmApertureOffset, mm_to_inches * verticalApertureOffset), errorString);
+    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_verticalFilmApertureOffset, mm_to_inches * data.verticalApertureOffset), errorString);
   }
   else
   {
     DgNodeTranslator::setFloatAttrAnim(to,
                                        m_verticalFilmApertureOffset,
-                                       verticalApertureOffsetAttr,
+                                       usdCamera.GetVerticalApertureOffsetAttr(),
                                        mm_to_inches);
   }
 
   // Focal length
-  auto focalLengthAttr = usdCamera.GetFocalLengthAttr();
-  if(!focalLengthAttr.GetNumTimeSamples() || forceDefaultRead)
+  if(!data.animatedFocalLength)
   {
-    float focalLength;
-    focalLengthAttr.Get(&focalLength, timeCode);
-    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_focalLength, focalLength), errorString);
+    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_focalLength, data.focalLength), errorString);
   }
   else
   {
-    DgNodeTranslator::setFloatAttrAnim(to, m_focalLength, focalLengthAttr);
+    DgNodeTranslator::setFloatAttrAnim(to, m_focalLength, usdCamera.GetFocalLengthAttr());
   }
 
   // Near/far clip planes
-  // N.B. Animated clip plane values not supported
-  GfVec2f clippingRange;
-  usdCamera.GetClippingRangeAttr().Get(&clippingRange, timeCode);
-  AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDistance(to, m_nearDistance, MDistance(clippingRange[0], MDistance::kCentimeters)), errorString);
-  AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDistance(to, m_farDistance, MDistance(clippingRange[1], MDistance::kCentimeters)), errorString);
+  AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDistance(to, m_nearDistance, MDistance(data.clippingRange[0], MDistance::kCentimeters)), errorString);
+  AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDistance(to, m_farDistance, MDistance(data.clippingRange[1], MDistance::kCentimeters)), errorString);
   return MS::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+MStatus Camera::updateAttributes(MObject to, const UsdPrim& prim)
+{
+  CameraData data;
+  readAttributes(prim, data);
+  return writeAttributes(to, prim, data);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 MStatus Camera::update(const UsdPrim& prim)
 {
@@ -218,37 +300,65 @@ MStatus Camera::update(const UsdPrim& prim)
 //----------------------------------------------------------------------------------------------------------------------
 MStatus Camera::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
 {
-  const char* const errorString = "CameraTranslator: error setting maya camera parameters";
-  UsdGeomCamera usdCamera(prim);
-
   MStatus status;
   MFnDagNode fn;
   MString name(prim.GetName().GetText() + MString("Shape"));
-  MObject to = fn.create("camera", name, parent, &status);
-  createdObj = to;
+  createdObj = fn.create("camera", name, parent, &status);
+  AL_MAYA_CHECK_ERROR(status, "CameraTranslator: unable to create camera node");
+
+  CameraData data;
+  readAttributes(prim, data);
+  return importAttributes(prim, createdObj, &data);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus Camera::queueNodeCreation(const UsdPrim& prim, MObject& parent, MDagModifier& modifier, MObject& createdObj)
+{
+  MStatus status;
+  createdObj = modifier.createNode("camera", parent, &status);
+  AL_MAYA_CHECK_ERROR(status, "CameraTranslator: unable to create camera node");
+  return modifier.renameNode(createdObj, prim.GetName().GetText() + MString("Shape"));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TranslatorPrefetchDataPtr Camera::prefetch(const UsdPrim& prim) const
+{
+  std::unique_ptr<CameraData> data(new CameraData);
+  readAttributes(prim, *data);
+  return std::move(data);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus Camera::importAttributes(const UsdPrim& prim, MObject& createdObj, const TranslatorPrefetchData* prefetched)
+{
+  const char* const errorString = "CameraTranslator: error setting maya camera parameters";
+  const CameraData* data = static_cast<const CameraData*>(prefetched);
+  if(!data)
+  {
+    return MS::kFailure;
+  }
+
+  MObject to = createdObj;
   TranslatorContextPtr ctx = context();
-  UsdTimeCode timeCode = UsdTimeCode::EarliestTime();
-  bool forceDefaultRead = false;
   if(ctx)
   {
     ctx->insertItem(prim, to);
-    if(ctx->getForceDefaultRead())
-    {
-      timeCode = UsdTimeCode::Default();
-      forceDefaultRead = true;
-    }
   }
 
+  UsdGeomCamera usdCamera(prim);
+
   // F-Stop
-  if (!DgNodeTranslator::setFloatAttrAnim(to, m_fstop, usdCamera.GetFStopAttr()))
+  if(data->animatedFStop)
+  {
+    DgNodeTranslator::setFloatAttrAnim(to, m_fstop, usdCamera.GetFStopAttr());
+  }
+  else
   {
-    float fstop;
-    usdCamera.GetFStopAttr().Get(&fstop, timeCode);
-    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_fstop, fstop), errorString);
+    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDouble(to, m_fstop, data->fstop), errorString);
   }
 
   // Focus distance
-  if (usdCamera.GetFocusDistanceAttr().GetNumTimeSamples() && !forceDefaultRead)
+  if(data->animatedFocusDistance)
   {
     // TODO: What unit here?
     MDistance one(1.0, MDistance::kCentimeters);
@@ -257,11 +367,9 @@ MStatus Camera::import(const UsdPrim& prim, MObject& parent, MObject& createdObj
   }
   else
   {
-    float focusDistance;
-    usdCamera.GetFocusDistanceAttr().Get(&focusDistance, timeCode);
-    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDistance(to, m_focusDistance, MDistance(focusDistance, MDistance::kCentimeters)), errorString);
+    AL_MAYA_CHECK_ERROR(DgNodeTranslator::setDistance(to, m_focusDistance, MDistance(data->focusDistance, MDistance::kCentimeters)), errorString);
   }
-  return updateAttributes(to, prim);
+  return writeAttributes(to, prim, *data);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -43,16 +43,28 @@ public:
   MStatus update(const UsdPrim& path) override;
   bool supportsUpdate() const override
     { return true; }
+  bool supportsBatchImport() const override
+    { return true; }
+  MStatus queueNodeCreation(const UsdPrim& prim, MObject& parent, MDagModifier& modifier, MObject& createdObj) override;
+  TranslatorPrefetchDataPtr prefetch(const UsdPrim& prim) const override;
+  MStatus importAttributes(const UsdPrim& prim, MObject& createdObj, const TranslatorPrefetchData* data) override;
 
   void checkCurrentCameras(MObject cameraNode);
 
   ExportFlag canExport(const MObject& obj) override
     { return obj.hasFn(MFn::kCamera) ? ExportFlag::kFallbackSupport : ExportFlag::kNotSupported; }
+  bool canExportDependsOnNodeTypeOnly() const override
+    { return true; }
 
 protected:
   AL_USDMAYA_PUBLIC virtual MStatus updateAttributes(MObject to, const UsdPrim& prim);
   AL_USDMAYA_PUBLIC virtual void writePrim(UsdPrim &prim, MDagPath dagPath, const ExporterParams& params);
 
+private:
+  struct CameraData;
+  void readAttributes(const UsdPrim& prim, CameraData& data) const;
+  MStatus writeAttributes(MObject to, const UsdPrim& prim, const CameraData& data);
+
 private:
   static MObject m_orthographic;
   static MObject m_horizontalFilmAperture;
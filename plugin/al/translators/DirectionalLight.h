@@ -50,6 +50,8 @@ public:
 
   ExportFlag canExport(const MObject &obj) override
   { return obj.hasFn(MFn::kDirectionalLight) ? ExportFlag::kFallbackSupport : ExportFlag::kNotSupported; }
+  bool canExportDependsOnNodeTypeOnly() const override
+  { return true; }
 
 private:
   static MObject m_pointWorld;
@@ -53,15 +53,17 @@ MStatus Mesh::initialize()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
+/// \brief  The mesh values read in the prefetch step of a batched import
+//----------------------------------------------------------------------------------------------------------------------
+struct MeshPrefetchData
+  : public TranslatorPrefetchData
 {
-  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("Mesh::import prim=%s\n", prim.GetPath().GetText());
-
-  const UsdGeomMesh mesh(prim);
-
-  TranslatorContextPtr ctx = context();
-  UsdTimeCode timeCode = (ctx && ctx->getForceDefaultRead()) ? UsdTimeCode::Default() : UsdTimeCode::EarliestTime();
+  AL::usdmaya::utils::MeshImportData mesh;
+};
 
+//----------------------------------------------------------------------------------------------------------------------
+static MString meshShapeName(const UsdPrim& prim)
+{
   bool parentUnmerged = false;
   TfToken val;
   if(prim.GetParent().GetMetadata(AL::usdmaya::Metadata::mergedTransform, &val))
@@ -73,8 +75,19 @@ MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
   {
     dagName += "Shape";
   }
+  return dagName;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+UsdTimeCode Mesh::importTimeCode() const
+{
+  TranslatorContextPtr ctx = context();
+  return (ctx && ctx->getForceDefaultRead()) ? UsdTimeCode::Default() : UsdTimeCode::EarliestTime();
+}
 
-  AL::usdmaya::utils::MeshImportContext importContext(mesh, parent, dagName, timeCode);
+//----------------------------------------------------------------------------------------------------------------------
+MStatus Mesh::applyImportedData(const UsdPrim& prim, AL::usdmaya::utils::MeshImportContext& importContext)
+{
   importContext.applyVertexNormals();
   importContext.applyHoleFaces();
   importContext.applyVertexCreases();
@@ -87,10 +100,11 @@ MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
   MFnSet fn(initialShadingGroup, &status);
   AL_MAYA_CHECK_ERROR(status, "Unable to attach MfnSet to initialShadingGroup");
   
-  createdObj = importContext.getPolyShape();
+  MObject createdObj = importContext.getPolyShape();
   fn.addMember(createdObj);
   importContext.applyPrimVars();
 
+  TranslatorContextPtr ctx = context();
   if (ctx)
   {
     ctx->addExcludedGeometry(prim.GetPath());
@@ -99,6 +113,50 @@ MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
   return MStatus::kSuccess;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+MStatus Mesh::import(const UsdPrim& prim, MObject& parent, MObject& createdObj)
+{
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("Mesh::import prim=%s\n", prim.GetPath().GetText());
+
+  const UsdGeomMesh mesh(prim);
+  AL::usdmaya::utils::MeshImportContext importContext(mesh, parent, meshShapeName(prim), importTimeCode());
+  createdObj = importContext.getPolyShape();
+  return applyImportedData(prim, importContext);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus Mesh::queueNodeCreation(const UsdPrim& prim, MObject& parent, MDagModifier& modifier, MObject& createdObj)
+{
+  MStatus status;
+  createdObj = modifier.createNode("mesh", parent, &status);
+  AL_MAYA_CHECK_ERROR(status, "MeshTranslator: unable to create mesh node");
+  return modifier.renameNode(createdObj, meshShapeName(prim));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+TranslatorPrefetchDataPtr Mesh::prefetch(const UsdPrim& prim) const
+{
+  std::unique_ptr<MeshPrefetchData> data(new MeshPrefetchData);
+  data->mesh.read(UsdGeomMesh(prim), importTimeCode());
+  return std::move(data);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MStatus Mesh::importAttributes(const UsdPrim& prim, MObject& createdObj, const TranslatorPrefetchData* prefetched)
+{
+  TF_DEBUG(ALUSDMAYA_TRANSLATORS).Msg("Mesh::importAttributes prim=%s\n", prim.GetPath().GetText());
+
+  const MeshPrefetchData* data = static_cast<const MeshPrefetchData*>(prefetched);
+  if(!data)
+  {
+    return MS::kFailure;
+  }
+
+  const UsdGeomMesh mesh(prim);
+  AL::usdmaya::utils::MeshImportContext importContext(mesh, createdObj, data->mesh, importTimeCode());
+  return applyImportedData(prim, importContext);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 UsdPrim Mesh::exportObject(UsdStageRefPtr stage, MDagPath dagPath, const SdfPath& usdPath, const ExporterParams& params)
 {
@@ -16,6 +16,7 @@
 
 #pragma once
 #include "AL/usdmaya/fileio/translators/TranslatorBase.h"
+#include "AL/usdmaya/utils/MeshUtils.h"
 
 
 namespace AL{
@@ -43,9 +44,16 @@ private:
     { return false; } // Turned off supportsUpdate to get tearDown working correctly
   bool importableByDefault() const override
     { return false; }
+  bool supportsBatchImport() const override
+    { return true; }
+  MStatus queueNodeCreation(const UsdPrim& prim, MObject& parent, MDagModifier& modifier, MObject& createdObj) override;
+  TranslatorPrefetchDataPtr prefetch(const UsdPrim& prim) const override;
+  MStatus importAttributes(const UsdPrim& prim, MObject& createdObj, const TranslatorPrefetchData* data) override;
 
   ExportFlag canExport(const MObject& obj) override
     { return obj.hasFn(MFn::kMesh) ? ExportFlag::kFallbackSupport : ExportFlag::kNotSupported; }
+  bool canExportDependsOnNodeTypeOnly() const override
+    { return true; }
 
 private:
   enum WriteOptions
@@ -54,6 +62,8 @@ private:
     kDynamicAttributes = 1 << 1
   };
   void writeEdits(MDagPath& dagPath, UsdGeomMesh& geomPrim, uint32_t options = kDynamicAttributes);
+  UsdTimeCode importTimeCode() const;
+  MStatus applyImportedData(const UsdPrim& prim, AL::usdmaya::utils::MeshImportContext& importContext);
 
 };
 
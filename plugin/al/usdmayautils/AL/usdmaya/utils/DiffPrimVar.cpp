@@ -24,6 +24,10 @@
 #include "pxr/usd/usd/timeCode.h"
 #include "pxr/usd/usdGeom/mesh.h"
 #include "pxr/usd/usd/attribute.h"
+#include "pxr/base/work/loops.h"
+
+#include <algorithm>
+#include <vector>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
@@ -270,13 +274,17 @@ struct UsdColourSetDefinition
   {
     MFnMesh::MColorRepresentation representation = mesh.getColorRepresentation(*mayaSetNamePtr);
     isRGB = MFnMesh::kRGB == representation;
-    MIntArray faceCounts, pointIndices;
-    mesh.getVertices(faceCounts, pointIndices);
     mesh.getColors(m_colours, mayaSetNamePtr);
+  }
+
+  /// determines the interpolation of the colour data read from maya (this does not access the maya mesh, so may be
+  /// run in parallel with the other colour sets)
+  void guessInterpolation(const size_t numPoints, MIntArray& pointIndices, MIntArray& faceCounts)
+  {
     m_mayaInterpolation = guessColourSetInterpolationTypeExtensive(
         &m_colours[0].r,
         m_colours.length(),
-        mesh.numVertices(),
+        numPoints,
         pointIndices,
         faceCounts,
         m_indicesToExtract);
@@ -363,10 +371,26 @@ void ColourSetBuilder::constructNewlyAddedSets(MStringArray& setNames, const std
 //----------------------------------------------------------------------------------------------------------------------
 void ColourSetBuilder::extractMayaData(const MFnMesh& mesh)
 {
-  for(uint32_t i = 0, n = m_existingSetDefinitions.size(); i < n; ++i)
+  const size_t numSets = m_existingSetDefinitions.size();
+  if(!numSets)
+    return;
+
+  MIntArray faceCounts, pointIndices;
+  mesh.getVertices(faceCounts, pointIndices);
+  const size_t numPoints = mesh.numVertices();
+  for(uint32_t i = 0; i < numSets; ++i)
   {
     m_existingSetDefinitions[i].extractColourDataFromMaya(mesh, &m_existingSetNames[i]);
   }
+
+  // once the data has been read from maya, the sets can be classified in parallel
+  WorkParallelForN(numSets, [&](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      m_existingSetDefinitions[i].guessInterpolation(numPoints, pointIndices, faceCounts);
+    }
+  });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -475,10 +499,14 @@ struct UsdUvSetDefinition
 
   void extractUvDataFromMaya(const MFnMesh& mesh, MString* mayaSetNamePtr)
   {
-    MIntArray pointIndices, faceCounts;
-    mesh.getVertices(faceCounts, pointIndices);
     mesh.getUVs(m_u, m_v, mayaSetNamePtr);
     mesh.getAssignedUVs(m_mayaUvCounts, m_mayaUvIndices, mayaSetNamePtr);
+  }
+
+  /// determines the interpolation of the uv data read from maya (this does not access the maya mesh, so may be run in
+  /// parallel with the other uv sets)
+  void guessInterpolation(MIntArray& pointIndices)
+  {
     m_mayaInterpolation = guessUVInterpolationTypeExtensive(m_u, m_v, m_mayaUvIndices, pointIndices, m_mayaUvCounts, m_indicesToExtract);
   }
 
@@ -551,10 +579,25 @@ void UvSetBuilder::constructNewlyAddedSets(MStringArray& setNames, const std::ve
 //----------------------------------------------------------------------------------------------------------------------
 void UvSetBuilder::extractMayaUvData(const MFnMesh& mesh)
 {
-  for(uint32_t i = 0, n = m_existingSetDefinitions.size(); i < n; ++i)
+  const size_t numSets = m_existingSetDefinitions.size();
+  if(!numSets)
+    return;
+
+  MIntArray pointIndices, faceCounts;
+  mesh.getVertices(faceCounts, pointIndices);
+  for(uint32_t i = 0; i < numSets; ++i)
   {
     m_existingSetDefinitions[i].extractUvDataFromMaya(mesh, &m_existingSetNames[i]);
   }
+
+  // once the data has been read from maya, the sets can be classified in parallel
+  WorkParallelForN(numSets, [&](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      m_existingSetDefinitions[i].guessInterpolation(pointIndices);
+    }
+  });
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -659,6 +702,273 @@ MStringArray hasNewUvSet(UsdGeomMesh& geom, const MFnMesh& mesh, PrimVarDiffRepo
   return setNames;
 }
 
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns true if every face-vertex of each face uses the same index
+/// \param  indices the prim var index of each face-vertex
+/// \param  faceCounts the number of vertices in each face
+//----------------------------------------------------------------------------------------------------------------------
+bool hasUniformIndices(const MIntArray& indices, const MIntArray& faceCounts)
+{
+  const uint32_t numIndices = indices.length();
+  for(uint32_t i = 0, offset = 0, n = faceCounts.length(); i < n; ++i)
+  {
+    const uint32_t numVerts = faceCounts[i];
+    if(offset + numVerts > numIndices)
+      return false;
+
+    const int32_t index = indices[offset];
+    for(uint32_t j = 1; j < numVerts; ++j)
+    {
+      if(index != indices[offset + j])
+        return false;
+    }
+    offset += numVerts;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the number of points referenced by the point indices (i.e. the largest point index + 1)
+//----------------------------------------------------------------------------------------------------------------------
+uint32_t countReferencedPoints(const MIntArray& pointIndices)
+{
+  int32_t maxIndex = -1;
+  for(uint32_t i = 0, n = pointIndices.length(); i < n; ++i)
+  {
+    maxIndex = std::max(maxIndex, pointIndices[i]);
+  }
+  return uint32_t(maxIndex + 1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Determines whether prim var data can be stored as vertex or uniform, rather than face varying. Both tests
+///         are performed together in a single pass over the face-vertices, which stops as soon as both tests have
+///         failed.
+///
+///         The per-vertex test records the value index first assigned to each vertex in a dense array (indexed by the
+///         point index), and the per-face test compares each face-vertex with the first face-vertex of its face. Where
+///         two face-vertices use different value indices, the values themselves are compared, so duplicated values
+///         with different indices do not prevent the data from being compacted.
+/// \param  valueIndices the value index of each face-vertex, or null if there is one value per face-vertex
+/// \param  pointIndices the point index of each face-vertex
+/// \param  numFaceVertices the number of face-vertices
+/// \param  faceCounts the number of vertices in each face
+/// \param  numPoints the number of points in the mesh
+/// \param  valuesEqual a functor that returns true if the values at two value indices are the same
+/// \param  vertexValueIndices returns the value index assigned to each point (or -1 for points that are not used)
+/// \return UsdGeomTokens->vertex, UsdGeomTokens->uniform, or UsdGeomTokens->faceVarying
+//----------------------------------------------------------------------------------------------------------------------
+template<typename ValuesEqual>
+TfToken classifyInterpolation(
+    const int32_t* const valueIndices,
+    const int32_t* const pointIndices,
+    const uint32_t numFaceVertices,
+    const MIntArray& faceCounts,
+    const uint32_t numPoints,
+    const ValuesEqual& valuesEqual,
+    std::vector<int32_t>& vertexValueIndices)
+{
+  vertexValueIndices.assign(numPoints, -1);
+  int32_t* const vertexValues = vertexValueIndices.data();
+
+  bool isVertex = true;
+  bool isUniform = true;
+  for(uint32_t i = 0, offset = 0, n = faceCounts.length(); i < n; ++i)
+  {
+    const uint32_t numVerts = faceCounts[i];
+    if(offset + numVerts > numFaceVertices)
+      return UsdGeomTokens->faceVarying;
+
+    const int32_t faceIndex = valueIndices ? valueIndices[offset] : int32_t(offset);
+    for(uint32_t j = 0; j < numVerts; ++j)
+    {
+      const uint32_t k = offset + j;
+      const int32_t index = valueIndices ? valueIndices[k] : int32_t(k);
+
+      if(isVertex)
+      {
+        const int32_t point = pointIndices[k];
+        if(uint32_t(point) >= numPoints)
+        {
+          isVertex = false;
+        }
+        else
+        if(vertexValues[point] < 0)
+        {
+          vertexValues[point] = index;
+        }
+        else
+        if(vertexValues[point] != index && !valuesEqual(vertexValues[point], index))
+        {
+          isVertex = false;
+        }
+      }
+
+      if(isUniform && index != faceIndex && !valuesEqual(faceIndex, index))
+      {
+        isUniform = false;
+      }
+    }
+
+    if(!isVertex && !isUniform)
+      return UsdGeomTokens->faceVarying;
+
+    offset += numVerts;
+  }
+
+  return isVertex ? UsdGeomTokens->vertex : UsdGeomTokens->uniform;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  classifies indexed prim var data, where each face-vertex has an index into the values
+//----------------------------------------------------------------------------------------------------------------------
+template<typename ValuesEqual>
+TfToken classifyIndexedInterpolation(
+    MIntArray& indices,
+    MIntArray& pointIndices,
+    const MIntArray& faceCounts,
+    const ValuesEqual& valuesEqual,
+    std::vector<int32_t>& vertexValueIndices)
+{
+  // sparse data (where not every face-vertex has a value) can only be stored as face varying
+  if(indices.length() != pointIndices.length() || !indices.length())
+  {
+    return UsdGeomTokens->faceVarying;
+  }
+
+  return classifyInterpolation(
+      &indices[0],
+      &pointIndices[0],
+      indices.length(),
+      faceCounts,
+      countReferencedPoints(pointIndices),
+      valuesEqual,
+      vertexValueIndices);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  compares two UV values
+//----------------------------------------------------------------------------------------------------------------------
+struct UvValuesEqual
+{
+  UvValuesEqual(const float* u, const float* v)
+    : u(u), v(v) {}
+
+  bool operator () (const int32_t a, const int32_t b) const
+    { return u[a] == u[b] && v[a] == v[b]; }
+
+  const float* const u;
+  const float* const v;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  compares two float vec3 values
+//----------------------------------------------------------------------------------------------------------------------
+struct Vec3fValuesEqual
+{
+  // A little dirty. If running the tests via SSE, step back 1 element. We must not go beyond the end of a memory location
+  // in case we hit an non-mapped page (crash). On the assumption that all this data will come in a valid memory allocation,
+  // stepping back 4bytes will lead us into the allocation header (which we will ignore in our test)
+  explicit Vec3fValuesEqual(const float* xyz)
+  #if defined(__SSE__)
+    : xyz(xyz - 1) {}
+  #else
+    : xyz(xyz) {}
+  #endif
+
+  bool operator () (const int32_t a, const int32_t b) const
+  {
+    #if defined(__SSE__)
+    const f128 xyz0 = loadu4f(xyz + 3 * a);
+    const f128 xyz1 = loadu4f(xyz + 3 * b);
+    return !(movemask4f(cmpne4f(xyz0, xyz1)) & 0xE);
+    #else
+    return xyz[3 * a] == xyz[3 * b] &&
+           xyz[3 * a + 1] == xyz[3 * b + 1] &&
+           xyz[3 * a + 2] == xyz[3 * b + 2];
+    #endif
+  }
+
+  const float* const xyz;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  compares two double vec3 values
+//----------------------------------------------------------------------------------------------------------------------
+struct Vec3dValuesEqual
+{
+  explicit Vec3dValuesEqual(const double* xyz)
+    : xyz(xyz) {}
+
+  bool operator () (const int32_t a, const int32_t b) const
+  {
+    return xyz[3 * a] == xyz[3 * b] &&
+           xyz[3 * a + 1] == xyz[3 * b + 1] &&
+           xyz[3 * a + 2] == xyz[3 * b + 2];
+  }
+
+  const double* const xyz;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  compares two float vec4 values
+//----------------------------------------------------------------------------------------------------------------------
+struct Vec4fValuesEqual
+{
+  explicit Vec4fValuesEqual(const float* xyzw)
+    : xyzw(xyzw) {}
+
+  bool operator () (const int32_t a, const int32_t b) const
+  {
+    #if defined(__SSE__)
+    const f128 xyzw0 = loadu4f(xyzw + 4 * a);
+    const f128 xyzw1 = loadu4f(xyzw + 4 * b);
+    return !movemask4f(cmpne4f(xyzw0, xyzw1));
+    #else
+    return xyzw[4 * a] == xyzw[4 * b] &&
+           xyzw[4 * a + 1] == xyzw[4 * b + 1] &&
+           xyzw[4 * a + 2] == xyzw[4 * b + 2] &&
+           xyzw[4 * a + 3] == xyzw[4 * b + 3];
+    #endif
+  }
+
+  const float* const xyzw;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  compares two double vec4 values
+//----------------------------------------------------------------------------------------------------------------------
+struct Vec4dValuesEqual
+{
+  explicit Vec4dValuesEqual(const double* xyzw)
+    : xyzw(xyzw) {}
+
+  bool operator () (const int32_t a, const int32_t b) const
+  {
+    #if defined(__AVX__)
+    const d256 xyzw0 = loadu4d(xyzw + 4 * a);
+    const d256 xyzw1 = loadu4d(xyzw + 4 * b);
+    return !movemask4d(cmpne4d(xyzw0, xyzw1));
+    #elif defined(__SSE__)
+    const d128 xy0 = loadu2d(xyzw + 4 * a);
+    const d128 zw0 = loadu2d(xyzw + 4 * a + 2);
+    const d128 xy1 = loadu2d(xyzw + 4 * b);
+    const d128 zw1 = loadu2d(xyzw + 4 * b + 2);
+    return !movemask2d(or2d(cmpne2d(xy0, xy1), cmpne2d(zw0, zw1)));
+    #else
+    return xyzw[4 * a] == xyzw[4 * b] &&
+           xyzw[4 * a + 1] == xyzw[4 * b + 1] &&
+           xyzw[4 * a + 2] == xyzw[4 * b + 2] &&
+           xyzw[4 * a + 3] == xyzw[4 * b + 3];
+    #endif
+  }
+
+  const double* const xyzw;
+};
+
+} // anonymous namespace
 
 //----------------------------------------------------------------------------------------------------------------------
 TfToken guessUVInterpolationType(
@@ -697,26 +1007,7 @@ TfToken guessUVInterpolationTypeExtended(
   }
 
   // let's see whether we have a uniform UV set (based on the assumption that each face will have unique UV indices)
-  {
-    uint32_t offset = 0;
-    for(uint32_t i = 0, n = faceCounts.length(); i < n; ++i)
-    {
-      const uint32_t numVerts = faceCounts[i];
-      int32_t index = indices[offset];
-      for(uint32_t j = 1; j < numVerts; ++j)
-      {
-        if(index != indices[offset + j])
-        {
-          goto face_varying;
-        }
-      }
-      offset += numVerts;
-    }
-    return UsdGeomTokens->uniform;
-  }
-
-face_varying:
-  return UsdGeomTokens->faceVarying;
+  return hasUniformIndices(indices, faceCounts) ? UsdGeomTokens->uniform : UsdGeomTokens->faceVarying;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -734,89 +1025,24 @@ TfToken guessUVInterpolationTypeExtensive(
     return UsdGeomTokens->constant;
   }
 
-  std::map<int32_t, int32_t> indicesMap;
+  std::vector<int32_t> vertexIndices;
+  const TfToken type = classifyIndexedInterpolation(indices, pointIndices, faceCounts, UvValuesEqual(&u[0], &v[0]), vertexIndices);
 
-  // do an exhaustive test to see if the UV assignments are per-vertex
+  // for per-vertex assignment, extract the UV index of each vertex (skipping any vertices that are not used)
+  if(type == UsdGeomTokens->vertex)
   {
-    indicesMap.emplace(pointIndices[0], indices[0]);
-    for(uint32_t i = 1, n = pointIndices.length(); i < n; ++i)
+    std::vector<uint32_t> tempIndicesToExtract;
+    tempIndicesToExtract.reserve(vertexIndices.size());
+    for(const int32_t index : vertexIndices)
     {
-      auto index = pointIndices[i];
-      auto uvindex = indices[i];
-      auto it = indicesMap.find(index);
-
-      // if not found, insert new entry in map
-      if(it == indicesMap.end())
-      {
-        indicesMap.emplace(index, uvindex);
-      }
-      else
+      if(index >= 0)
       {
-        // if the UV index matches, we have the same assignment
-        if(uvindex != it->second)
-        {
-          // if not, check to see if the indices differ, but the values are the same
-          const float u0 = u[it->second];
-          const float v0 = v[it->second];
-          const float u1 = u[uvindex];
-          const float v1 = v[uvindex];
-          if(u0 != u1 || v0 != v1)
-          {
-            goto uniform_test;
-          }
-        }
+        tempIndicesToExtract.push_back(index);
       }
     }
-
-    std::vector<uint32_t> tempIndicesToExtract(indicesMap.size());
-    auto iter = indicesMap.begin();
-    for(size_t i = 0; i < tempIndicesToExtract.size(); ++i, ++iter)
-    {
-      tempIndicesToExtract[i] = iter->second;
-    }
     std::swap(indicesToExtract, tempIndicesToExtract);
-
-    return UsdGeomTokens->vertex;
   }
-
-uniform_test:
-
-  // An exhaustive test to see if we have per-face assignment of UVs
-  {
-    uint32_t offset = 0;
-    for(uint32_t i = 0, n = faceCounts.length(); i < n; ++i)
-    {
-      const uint32_t numVerts = faceCounts[i];
-      const int32_t index = indices[offset];
-
-      // extract UV for first vertex in face
-      const float u0 = u[index];
-      const float v0 = v[index];
-
-      // process each face
-      for(uint32_t j = 1; j < numVerts; ++j)
-      {
-        const int32_t next_index = indices[offset + j];
-
-        // if the indices don't match
-        if(index != next_index)
-        {
-          // check the UV values directly
-          const float u1 = u[next_index];
-          const float v1 = v[next_index];
-          if(u0 != u1 || v0 != v1)
-          {
-            goto face_varying;
-          }
-        }
-      }
-      offset += numVerts;
-    }
-    return UsdGeomTokens->uniform;
-  }
-
-face_varying:
-  return UsdGeomTokens->faceVarying;
+  return type;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -855,26 +1081,7 @@ TfToken guessVec3InterpolationTypeExtended(
   }
 
   // let's see whether we have a uniform prim var set (based on the assumption that each face will have unique indices)
-  {
-    uint32_t offset = 0;
-    for(uint32_t i = 0, n = faceCounts.length(); i < n; ++i)
-    {
-      const uint32_t numVerts = faceCounts[i];
-      int32_t index = indices[offset];
-      for(uint32_t j = 1; j < numVerts; ++j)
-      {
-        if(index != indices[offset + j])
-        {
-          goto face_varying;
-        }
-      }
-      offset += numVerts;
-    }
-    return UsdGeomTokens->uniform;
-  }
-
-face_varying:
-  return UsdGeomTokens->faceVarying;
+  return hasUniformIndices(indices, faceCounts) ? UsdGeomTokens->uniform : UsdGeomTokens->faceVarying;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -891,118 +1098,8 @@ TfToken guessVec3InterpolationTypeExtensive(
     return UsdGeomTokens->constant;
   }
 
-  // A little dirty. If running the tests via SSE, step back 1 element. We must not go beyond the end of a memory location
-  // in case we hit an non-mapped page (crash). On the assumption that all this data will come in a valid memory allocation,
-  // stepping back 4bytes will lead us into the allocation header (which we will ignore in our test)
-  #if defined(__SSE__)
-  --xyz;
-  #endif
-
-  std::unordered_map<int32_t, int32_t> indicesMap;
-
-  // do an exhaustive test to see if the prim var assignments are per-vertex
-  {
-    indicesMap.emplace(pointIndices[0], indices[0]);
-    for(uint32_t i = 1, n = pointIndices.length(); i < n; ++i)
-    {
-      auto index = pointIndices[i];
-      auto xyzindex = indices[i];
-      auto it = indicesMap.find(index);
-
-      // if not found, insert new entry in map
-      if(it == indicesMap.end())
-      {
-        indicesMap.emplace(index, xyzindex);
-      }
-      else
-      {
-        // if the index matches, we have the same assignment
-        if(xyzindex != it->second)
-        {
-          #if defined(__SSE__)
-
-          const f128 xyz0 = loadu4f(xyz + 3 * it->second);
-          const f128 xyz1 = loadu4f(xyz + 3 * xyzindex);
-          const f128 cmp = cmpne4f(xyz0, xyz1);
-          if(movemask4f(cmp) & 0xE)
-            goto uniform_test;
-
-          #else
-
-          // if not, check to see if the indices differ, but the values are the same
-          const float x0 = xyz[3 * it->second];
-          const float y0 = xyz[3 * it->second + 1];
-          const float z0 = xyz[3 * it->second + 2];
-          const float x1 = xyz[3 * xyzindex];
-          const float y1 = xyz[3 * xyzindex + 1];
-          const float z1 = xyz[3 * xyzindex + 2];
-          if(x0 != x1 || y0 != y1 || z0 != z1)
-            goto uniform_test;
-
-          #endif
-        }
-      }
-    }
-    return UsdGeomTokens->vertex;
-  }
-
-uniform_test:
-
-  // An exhaustive test to see if we have per-face assignment of prim vars
-  {
-    uint32_t offset = 0;
-    for(uint32_t i = 0, n = faceCounts.length(); i < n; ++i)
-    {
-      const uint32_t numVerts = faceCounts[i];
-      const int32_t index = indices[offset];
-
-      #if defined(__SSE__)
-
-      const f128 xyz0 = loadu4f(xyz + 3 * index);
-
-      #else
-
-      // extract prim var for first vertex in face
-      const float x0 = xyz[3 * index];
-      const float y0 = xyz[3 * index + 1];
-      const float z0 = xyz[3 * index + 2];
-
-      #endif
-
-      // process each face
-      for(uint32_t j = 1; j < numVerts; ++j)
-      {
-        const int32_t next_index = indices[offset + j];
-
-        // if the indices don't match
-        if(index != next_index)
-        {
-          #if defined(__SSE__)
-
-          const f128 xyz1 = loadu4f(xyz + 3 * next_index);
-          const f128 cmp = cmpne4f(xyz0, xyz1);
-          if(movemask4f(cmp) & 0xE)
-            goto face_varying;
-
-          #else
-
-          // check the values directly
-          const float x1 = xyz[3 * next_index];
-          const float y1 = xyz[3 * next_index + 1];
-          const float z1 = xyz[3 * next_index + 2];
-          if(x0 != x1 || y0 != y1 || z0 != z1)
-            goto face_varying;
-
-          #endif
-        }
-      }
-      offset += numVerts;
-    }
-    return UsdGeomTokens->uniform;
-  }
-
-face_varying:
-  return UsdGeomTokens->faceVarying;
+  std::vector<int32_t> vertexIndices;
+  return classifyIndexedInterpolation(indices, pointIndices, faceCounts, Vec3fValuesEqual(xyz), vertexIndices);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1040,27 +1137,8 @@ TfToken guessVec3InterpolationTypeExtended(
     return type;
   }
 
-  // let's see whether we have a uniform UV set (based on the assumption that each face will have unique UV indices)
-  {
-    uint32_t offset = 0;
-    for(uint32_t i = 0, n = faceCounts.length(); i < n; ++i)
-    {
-      const uint32_t numVerts = faceCounts[i];
-      int32_t index = indices[offset];
-      for(uint32_t j = 1; j < numVerts; ++j)
-      {
-        if(index != indices[offset + j])
-        {
-          goto face_varying;
-        }
-      }
-      offset += numVerts;
-    }
-    return UsdGeomTokens->uniform;
-  }
-
-face_varying:
-  return UsdGeomTokens->faceVarying;
+  // let's see whether we have a uniform prim var set (based on the assumption that each face will have unique indices)
+  return hasUniformIndices(indices, faceCounts) ? UsdGeomTokens->uniform : UsdGeomTokens->faceVarying;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1071,86 +1149,14 @@ TfToken guessVec3InterpolationTypeExtensive(
     MIntArray& pointIndices,
     MIntArray& faceCounts)
 {
-  // if UV coords are all identical, we have a constant value
+  // if prim vars are all identical, we have a constant value
   if(usd::utils::vec3AreAllTheSame(xyz, numElements))
   {
     return UsdGeomTokens->constant;
   }
 
-  std::unordered_map<int32_t, int32_t> indicesMap;
-
-  // do an exhaustive test to see if the UV assignments are per-vertex
-  {
-    indicesMap.emplace(pointIndices[0], indices[0]);
-    for(uint32_t i = 1, n = pointIndices.length(); i < n; ++i)
-    {
-      auto index = pointIndices[i];
-      auto xyzindex = indices[i];
-      auto it = indicesMap.find(index);
-
-      // if not found, insert new entry in map
-      if(it == indicesMap.end())
-      {
-        indicesMap.emplace(index, xyzindex);
-      }
-      else
-      {
-        // if the UV index matches, we have the same assignment
-        if(xyzindex != it->second)
-        {
-          // if not, check to see if the indices differ, but the values are the same
-          const double x0 = xyz[3 * it->second];
-          const double y0 = xyz[3 * it->second + 1];
-          const double z0 = xyz[3 * it->second + 2];
-          const double x1 = xyz[3 * xyzindex];
-          const double y1 = xyz[3 * xyzindex + 1];
-          const double z1 = xyz[3 * xyzindex + 2];
-          if(x0 != x1 || y0 != y1 || z0 != z1)
-            goto uniform_test;
-        }
-      }
-    }
-    return UsdGeomTokens->vertex;
-  }
-
-uniform_test:
-
-  // An exhaustive test to see if we have per-face assignment of UVs
-  {
-    uint32_t offset = 0;
-    for(uint32_t i = 0, n = faceCounts.length(); i < n; ++i)
-    {
-      const uint32_t numVerts = faceCounts[i];
-      const int32_t index = indices[offset];
-
-      // extract UV for first vertex in face
-      const double x0 = xyz[3 * index];
-      const double y0 = xyz[3 * index + 1];
-      const double z0 = xyz[3 * index + 2];
-
-      // process each face
-      for(uint32_t j = 1; j < numVerts; ++j)
-      {
-        const int32_t next_index = indices[offset + j];
-
-        // if the indices don't match
-        if(index != next_index)
-        {
-          // check the UV values directly
-          const double x1 = xyz[3 * next_index];
-          const double y1 = xyz[3 * next_index + 1];
-          const double z1 = xyz[3 * next_index + 2];
-          if(x0 != x1 || y0 != y1 || z0 != z1)
-            goto face_varying;
-        }
-      }
-      offset += numVerts;
-    }
-    return UsdGeomTokens->uniform;
-  }
-
-face_varying:
-  return UsdGeomTokens->faceVarying;
+  std::vector<int32_t> vertexIndices;
+  return classifyIndexedInterpolation(indices, pointIndices, faceCounts, Vec3dValuesEqual(xyz), vertexIndices);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1188,28 +1194,10 @@ TfToken guessVec4InterpolationTypeExtended(
     return type;
   }
 
-  // let's see whether we have a uniform UV set (based on the assumption that each face will have unique indices)
-  {
-    uint32_t offset = 0;
-    for(uint32_t i = 0, n = faceCounts.length(); i < n; ++i)
-    {
-      const uint32_t numVerts = faceCounts[i];
-      int32_t index = indices[offset];
-      for(uint32_t j = 1; j < numVerts; ++j)
-      {
-        if(index != indices[offset + j])
-        {
-          goto face_varying;
-        }
-      }
-      offset += numVerts;
-    }
-    return UsdGeomTokens->uniform;
-  }
-
-face_varying:
-  return UsdGeomTokens->faceVarying;
+  // let's see whether we have a uniform prim var set (based on the assumption that each face will have unique indices)
+  return hasUniformIndices(indices, faceCounts) ? UsdGeomTokens->uniform : UsdGeomTokens->faceVarying;
 }
+
 //----------------------------------------------------------------------------------------------------------------------
 TfToken guessVec4InterpolationTypeExtensive(
     const float* xyzw,
@@ -1224,114 +1212,8 @@ TfToken guessVec4InterpolationTypeExtensive(
     return UsdGeomTokens->constant;
   }
 
-  std::unordered_map<int32_t, int32_t> indicesMap;
-
-  // do an exhaustive test to see if the UV assignments are per-vertex
-  {
-    indicesMap.emplace(pointIndices[0], indices[0]);
-    for(uint32_t i = 1, n = pointIndices.length(); i < n; ++i)
-    {
-      auto index = pointIndices[i];
-      auto xyzwindex = indices[i];
-      auto it = indicesMap.find(index);
-
-      // if not found, insert new entry in map
-      if(it == indicesMap.end())
-      {
-        indicesMap.emplace(index, xyzwindex);
-      }
-      else
-      {
-        // if the index matches, we have the same assignment
-        if(xyzwindex != it->second)
-        {
-          #if defined(__SSE__)
-
-          const f128 xyzw0 = loadu4f(xyzw + 4 * it->second);
-          const f128 xyzw1 = loadu4f(xyzw + 4 * xyzwindex);
-          const f128 cmp = cmpne4f(xyzw0, xyzw1);
-          if(movemask4f(cmp))
-            goto uniform_test;
-
-          #else
-
-          // if not, check to see if the indices differ, but the values are the same
-          const float x0 = xyzw[4 * it->second];
-          const float y0 = xyzw[4 * it->second + 1];
-          const float z0 = xyzw[4 * it->second + 2];
-          const float w0 = xyzw[4 * it->second + 3];
-          const float x1 = xyzw[4 * xyzwindex];
-          const float y1 = xyzw[4 * xyzwindex + 1];
-          const float z1 = xyzw[4 * xyzwindex + 2];
-          const float w1 = xyzw[4 * xyzwindex + 3];
-          if(x0 != x1 || y0 != y1 || z0 != z1 || w0 != w1)
-            goto uniform_test;
-
-          #endif
-        }
-      }
-    }
-    return UsdGeomTokens->vertex;
-  }
-
-uniform_test:
-
-  // An exhaustive test to see if we have per-face assignment of UVs
-  {
-    uint32_t offset = 0;
-    for(uint32_t i = 0, n = faceCounts.length(); i < n; ++i)
-    {
-      const uint32_t numVerts = faceCounts[i];
-      const int32_t index = indices[offset];
-
-      // extract UV for first vertex in face
-      #if defined(__SSE__)
-
-      const f128 xyzw0 = loadu4f(xyzw + 4 * index);
-
-      #else
-
-      const float x0 = xyzw[4 * index];
-      const float y0 = xyzw[4 * index + 1];
-      const float z0 = xyzw[4 * index + 2];
-      const float w0 = xyzw[4 * index + 3];
-
-      #endif
-
-      // process each face
-      for(uint32_t j = 1; j < numVerts; ++j)
-      {
-        const int32_t next_index = indices[offset + j];
-
-        // if the indices don't match
-        if(index != next_index)
-        {
-          #if defined(__SSE__)
-
-          const f128 xyzw1 = loadu4f(xyzw + 4 * next_index);
-          const f128 cmp = cmpne4f(xyzw0, xyzw1);
-          if(movemask4f(cmp))
-            goto face_varying;
-
-          #else
-          // check the UV values directly
-          const float x1 = xyzw[4 * next_index];
-          const float y1 = xyzw[4 * next_index + 1];
-          const float z1 = xyzw[4 * next_index + 2];
-          const float w1 = xyzw[4 * next_index + 3];
-          if(x0 != x1 || y0 != y1 || z0 != z1 || w0 != w1)
-            goto face_varying;
-
-          #endif
-        }
-      }
-      offset += numVerts;
-    }
-    return UsdGeomTokens->uniform;
-  }
-
-face_varying:
-  return UsdGeomTokens->faceVarying;
+  std::vector<int32_t> vertexIndices;
+  return classifyIndexedInterpolation(indices, pointIndices, faceCounts, Vec4fValuesEqual(xyzw), vertexIndices);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1369,27 +1251,8 @@ TfToken guessVec4InterpolationTypeExtended(
     return type;
   }
 
-  // let's see whether we have a uniform UV set (based on the assumption that each face will have unique UV indices)
-  {
-    uint32_t offset = 0;
-    for(uint32_t i = 0, n = faceCounts.length(); i < n; ++i)
-    {
-      const uint32_t numVerts = faceCounts[i];
-      int32_t index = indices[offset];
-      for(uint32_t j = 1; j < numVerts; ++j)
-      {
-        if(index != indices[offset + j])
-        {
-          goto face_varying;
-        }
-      }
-      offset += numVerts;
-    }
-    return UsdGeomTokens->uniform;
-  }
-
-face_varying:
-  return UsdGeomTokens->faceVarying;
+  // let's see whether we have a uniform prim var set (based on the assumption that each face will have unique indices)
+  return hasUniformIndices(indices, faceCounts) ? UsdGeomTokens->uniform : UsdGeomTokens->faceVarying;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1406,141 +1269,10 @@ TfToken guessVec4InterpolationTypeExtensive(
     return UsdGeomTokens->constant;
   }
 
-  std::unordered_map<int32_t, int32_t> indicesMap;
-
-  // do an exhaustive test to see if the assignments are per-vertex
-  {
-    indicesMap.emplace(pointIndices[0], indices[0]);
-    for(uint32_t i = 1, n = pointIndices.length(); i < n; ++i)
-    {
-      auto index = pointIndices[i];
-      auto xyzindex = indices[i];
-      auto it = indicesMap.find(index);
-
-      // if not found, insert new entry in map
-      if(it == indicesMap.end())
-      {
-        indicesMap.emplace(index, xyzindex);
-      }
-      else
-      {
-        // if the index matches, we have the same assignment
-        if(xyzindex != it->second)
-        {
-          #if defined(__AVX__)
-
-          const d256 xyzw0 = loadu4d(xyzw + 4 * it->second);
-          const d256 xyzw1 = loadu4d(xyzw + 4 * xyzindex);
-          const d256 cmp = cmpne4d(xyzw0, xyzw1);
-          if(movemask4d(cmp))
-            goto uniform_test;
-
-          #elif defined(__SSE__)
-
-          const d128 xy0 = loadu2d(xyzw + 4 * it->second);
-          const d128 zw0 = loadu2d(xyzw + 4 * it->second + 2);
-          const d128 xy1 = loadu2d(xyzw + 4 * xyzindex);
-          const d128 zw1 = loadu2d(xyzw + 4 * xyzindex + 2);
-          const d128 cmp = or2d(cmpne2d(xy0, xy1), cmpne2d(zw0, zw1));
-          if(movemask2d(cmp))
-            goto uniform_test;
-
-          #else
-
-          // if not, check to see if the indices differ, but the values are the same
-          const double x0 = xyzw[4 * it->second];
-          const double y0 = xyzw[4 * it->second + 1];
-          const double z0 = xyzw[4 * it->second + 2];
-          const double w0 = xyzw[4 * it->second + 3];
-          const double x1 = xyzw[4 * xyzindex];
-          const double y1 = xyzw[4 * xyzindex + 1];
-          const double z1 = xyzw[4 * xyzindex + 2];
-          const double w1 = xyzw[4 * xyzindex + 3];
-          if(x0 != x1 || y0 != y1 || z0 != z1 || w0 != w1)
-            goto uniform_test;
-
-          #endif
-        }
-      }
-    }
-    return UsdGeomTokens->vertex;
-  }
-
-uniform_test:
-
-  // An exhaustive test to see if we have per-face assignment of UVs
-  {
-    uint32_t offset = 0;
-    for(uint32_t i = 0, n = faceCounts.length(); i < n; ++i)
-    {
-      const uint32_t numVerts = faceCounts[i];
-      const int32_t index = indices[offset];
-
-      // extract for first vertex in face
-      #if defined(__AVX__)
-
-      const d256 xyzw0 = loadu4d(xyzw + 4 * index);
-
-      #elif defined(__SSE__)
-
-      const d128 xy0 = loadu2d(xyzw + 4 * index);
-      const d128 zw0 = loadu2d(xyzw + 4 * index + 2);
-
-      #else
-
-      const double x0 = xyzw[4 * index];
-      const double y0 = xyzw[4 * index + 1];
-      const double z0 = xyzw[4 * index + 2];
-      const double w0 = xyzw[4 * index + 3];
-
-      #endif
-
-      // process each face
-      for(uint32_t j = 1; j < numVerts; ++j)
-      {
-        const int32_t next_index = indices[offset + j];
-
-        // if the indices don't match
-        if(index != next_index)
-        {
-          #if defined(__AVX__)
-
-          const d256 xyzw1 = loadu4d(xyzw + 4 * next_index);
-          const d256 cmp = cmpne4d(xyzw0, xyzw1);
-          if(movemask4d(cmp))
-            goto face_varying;
-
-          #elif defined(__SSE__)
-
-          const d128 xy1 = loadu2d(xyzw + 4 * next_index);
-          const d128 zw1 = loadu2d(xyzw + 4 * next_index + 2);
-          const d128 cmp = or2d(cmpne2d(xy0, xy1), cmpne2d(zw0, zw1));
-          if(movemask2d(cmp))
-            goto face_varying;
-
-          #else
-
-          // check the values directly
-          const double x1 = xyzw[4 * next_index];
-          const double y1 = xyzw[4 * next_index + 1];
-          const double z1 = xyzw[4 * next_index + 2];
-          const double w1 = xyzw[4 * next_index + 3];
-          if(x0 != x1 || y0 != y1 || z0 != z1 || w0 != w1)
-            goto face_varying;
-
-          #endif
-        }
-      }
-      offset += numVerts;
-    }
-    return UsdGeomTokens->uniform;
-  }
-
-face_varying:
-  return UsdGeomTokens->faceVarying;
+  std::vector<int32_t> vertexIndices;
+  return classifyIndexedInterpolation(indices, pointIndices, faceCounts, Vec4dValuesEqual(xyzw), vertexIndices);
 }
 
-
 //----------------------------------------------------------------------------------------------------------------------
 TfToken guessColourSetInterpolationType(
     const float* rgba,
@@ -1555,7 +1287,6 @@ TfToken guessColourSetInterpolationType(
   return UsdGeomTokens->faceVarying;
 }
 
-
 //----------------------------------------------------------------------------------------------------------------------
 TfToken guessColourSetInterpolationTypeExtensive(
     const float* rgba,
@@ -1571,96 +1302,43 @@ TfToken guessColourSetInterpolationTypeExtensive(
     return UsdGeomTokens->constant;
   }
 
-  // check for per-vertex assignment
-  std::vector<uint32_t> indicesMap;
-  indicesMap.resize(numPoints, -1);
-
+  // the colours are stored per face-vertex, so there are no value indices
+  std::vector<int32_t> vertexIndices;
+  const TfToken type = classifyInterpolation(
+      nullptr,
+      &pointIndices[0],
+      std::min(uint32_t(numElements), pointIndices.length()),
+      faceCounts,
+      numPoints,
+      Vec4fValuesEqual(rgba),
+      vertexIndices);
+
+  if(type == UsdGeomTokens->vertex)
   {
-    for(uint32_t i = 0, n = pointIndices.length(); i < n; ++i)
+    // extract the colour of the first face-vertex of each vertex (or the first colour for any unused vertices)
+    std::vector<uint32_t> tempIndicesToExtract(vertexIndices.size());
+    for(size_t i = 0, n = vertexIndices.size(); i < n; ++i)
     {
-      auto index = pointIndices[i];
-      auto lastIndex = indicesMap[index];
-      if(lastIndex == 0xFFFFFFFF)
-      {
-        indicesMap[index] = i;
-      }
-      else
-      {
-        #if defined(__SSE__)
-
-        const f128 rgba0 = loadu4f(rgba + 4 * lastIndex);
-        const f128 rgba1 = loadu4f(rgba + 4 * i);
-        const f128 cmp = cmpne4f(rgba0, rgba1);
-        if(movemask4f(cmp))
-          goto uniform_test;
-
-        #else
-
-        // if not, check to see if the indices differ, but the values are the same
-        const float x0 = rgba[4 * lastIndex + 0];
-        const float y0 = rgba[4 * lastIndex + 1];
-        const float z0 = rgba[4 * lastIndex + 2];
-        const float w0 = rgba[4 * lastIndex + 3];
-        const float x1 = rgba[4 * i + 0];
-        const float y1 = rgba[4 * i + 1];
-        const float z1 = rgba[4 * i + 2];
-        const float w1 = rgba[4 * i + 3];
-        if(x0 != x1 || y0 != y1 || z0 != z1 || w0 != w1)
-          goto uniform_test;
-
-        #endif
-      }
+      tempIndicesToExtract[i] = vertexIndices[i] < 0 ? 0 : vertexIndices[i];
     }
-    std::swap(indicesToExtract, indicesMap);
-    return UsdGeomTokens->vertex;
+    std::swap(indicesToExtract, tempIndicesToExtract);
   }
-
-uniform_test:
-
-  const uint32_t numFaces = faceCounts.length();
-  indicesMap.resize(numFaces);
-  uint32_t offset = 0;
-  for(uint32_t i = 0; i < numFaces; ++i)
+  else
+  if(type == UsdGeomTokens->uniform)
   {
-    indicesMap[i] = offset;
-
-    int numPointsInFace = faceCounts[i];
-    #if defined(__SSE__)
-
-    const f128 rgba0 = loadu4f(rgba + 4 * offset);
-    for(int32_t j = 1; j < numPointsInFace; ++j)
+    // extract the colour of the first face-vertex of each face
+    const uint32_t numFaces = faceCounts.length();
+    std::vector<uint32_t> tempIndicesToExtract(numFaces);
+    for(uint32_t i = 0, offset = 0; i < numFaces; ++i)
     {
-      const f128 rgba1 = loadu4f(rgba + 4 * (offset + j));
-      const f128 cmp = cmpne4f(rgba0, rgba1);
-      if(movemask4f(cmp))
-        goto faceVarying;
+      tempIndicesToExtract[i] = offset;
+      offset += faceCounts[i];
     }
-
-    #else
-
-    const float* rgba0 = rgba + 4 * offset;
-    for(int32_t j = 1; j < numPointsInFace; ++j)
-    {
-      const float* rgba1 = rgba + 4 * (offset + j);
-      if(rgba0[0] != rgba1[0] ||
-         rgba0[1] != rgba1[1] ||
-         rgba0[2] != rgba1[2] ||
-         rgba0[3] != rgba1[3])
-        goto faceVarying;
-    }
-
-    #endif
-
-    offset += numPointsInFace;
+    std::swap(indicesToExtract, tempIndicesToExtract);
   }
-  std::swap(indicesToExtract, indicesMap);
-  return UsdGeomTokens->uniform;
-
-faceVarying:
-  return UsdGeomTokens->faceVarying;
+  return type;
 }
 
-
 //----------------------------------------------------------------------------------------------------------------------
 } // utils
 } // usdmaya
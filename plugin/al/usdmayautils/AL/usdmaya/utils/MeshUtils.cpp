@@ -17,10 +17,13 @@
 #include "AL/usdmaya/utils/MeshUtils.h"
 #include "AL/usdmaya/utils/DiffPrimVar.h"
 #include "AL/usdmaya/utils/Utils.h"
+#include "AL/usd/utils/CpuFeatures.h"
 #include "AL/usd/utils/DebugCodes.h"
+#include "AL/usdmaya/utils/MeshUtilsKernels.h"
 #include "pxr/usd/usdGeom/tokens.h"
 #include "pxr/usd/usdUtils/pipeline.h"
 
+#include "maya/MFnMeshData.h"
 #include "maya/MItMeshPolygon.h"
 #include "maya/MGlobal.h"
 
@@ -49,170 +52,83 @@ void doubleToFloat(float* output, const double* const input, size_t count)
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-#if AL_UTILS_ENABLE_SIMD
-#if defined(__AVX2__)
-static void convert3Dto4d_avx(f256 a, f256 b, f256 c, float* const output)
+/// the builds of the array conversions, indexed by AL::usd::utils::SimdLevel
+static const MeshUtilsKernels* const g_meshUtilsKernels[] =
 {
-  static const f256 wvalues = set8f(0, 0, 0, 1.0f, 0, 0, 0, 1.0f);
-  static const f256 wmask = set8f(0, 0, 0, -0.0f, 0, 0, 0, -0.0f);
-  const f256 v23 = permute2f128(a, b, 0x12);
-  const f256 v45 = permute2f128(b, c, 0x12);
-  static const i256 mask01 = set8i(0, 1, 2, 0, 3, 4, 5, 0);
-  static const i256 mask23 = set8i(2, 3, 4, 0, 5, 6, 7, 0);
-  f256 o01 = permutevar8x32f(a, mask01);
-  f256 o23 = permutevar8x32f(v23, mask23);
-  f256 o45 = permutevar8x32f(v45, mask01);
-  f256 o67 = permutevar8x32f(c, mask23);
-  o01 = select8f(wvalues, o01, wmask);
-  o23 = select8f(wvalues, o01, wmask);
-  o45 = select8f(wvalues, o01, wmask);
-  o67 = select8f(wvalues, o01, wmask);
-  storeu8f(output, o01);
-  storeu8f(output + 8, o23);
-  storeu8f(output + 16, o45);
-  storeu8f(output + 24, o67);
-}
+  &sse::meshUtilsKernels,
+  &avx2::meshUtilsKernels,
+#if AL_SIMD_HAS_AVX512
+  &avx512::meshUtilsKernels
+#else
+  &avx2::meshUtilsKernels
 #endif
+};
 
-
-//----------------------------------------------------------------------------------------------------------------------
-/// \brief  assuming a, b, & c are 8 packed 3D vectors of the form:
-///
-///         { v0x, v0y, v0z, v1x, v1y, v1z,   *snip*, v7x, v7y, v7z }
-///
-///         This method will convert that to 4D vectors with a 'w' value of 1.
-///
-///         { v0x, v0y, v0z, 1.0, v1x, v1y, v1z, 1.0, *snip*, v7x, v7y, v7z, 1.0 }
-///
-///         The output array must contain 32 floating poing values
 //----------------------------------------------------------------------------------------------------------------------
-static void convert3Dto4d_sse(const f128 a, const f128 b, const f128 c, float* output)
+static inline const MeshUtilsKernels& kernels()
 {
-  static const f128 wvalues = set4f(0, 0, 0, 1.0f);
-  static const f128 wmask = cast4f(set4i(0, 0, 0, 0xFFFFFFFF));
-
-  const f128 o0 = select4f(a, wvalues, wmask);
-  const f128 o3 = or4f(cast4f(shiftBytesRight(cast4i(c), 4)), wvalues);
-  f128 o1 = shuffle4f(a, b, 1, 0, 3, 3);
-  o1 = select4f(shuffle4f(o1, o1, 1, 3, 2, 0), wvalues, wmask);
-  f128 o2 = select4f(shuffle4f(b, c, 1, 0, 3, 2), wvalues, wmask);
-
-  storeu4f(output, o0);
-  storeu4f(output + 4, o1);
-  storeu4f(output + 8, o2);
-  storeu4f(output + 12, o3);
+  return *g_meshUtilsKernels[uint32_t(AL::usd::utils::activeSimdLevel())];
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-static void convert3Dto4d(const float* const c, float* const output, uint32_t count)
+void convert3DArrayTo4DArray(const float* const input, float* const output, size_t count)
 {
-  switch(count)
-  {
-  case 3:
-    output[8] = c[6];
-    output[9] = c[7];
-    output[10] = c[8];
-    output[11] = 1.0f;
-  case 2:
-    output[4] = c[3];
-    output[5] = c[4];
-    output[6] = c[5];
-    output[7] = 1.0f;
-  case 1:
-    output[0] = c[0];
-    output[1] = c[1];
-    output[2] = c[2];
-    output[3] = 1.0f;
-    default: break;
-  }
+  kernels().convert3DArrayTo4DArray(input, output, count);
 }
-#endif
 
 //----------------------------------------------------------------------------------------------------------------------
-void convert3DArrayTo4DArray(const float* const input, float* const output, size_t count)
+void MeshImportData::read(const UsdGeomMesh& mesh, UsdTimeCode timeCode)
 {
-#if AL_UTILS_ENABLE_SIMD
-# if defined(__AVX2__) && ENABLE_SOME_AVX_ROUTINES
-  size_t count8 = count >> 3;
-  bool count4 = (count & 0x4) != 0;
-  uint32_t remainder = count & 0x3;
-  size_t i = 0, j = 0;
-  for(size_t n = 24 * count8; i != n; i += 24, j += 32)
-  {
-    const float* const ptr = input + i;
-    const f256 a = loadu8f(ptr);
-    const f256 b = loadu8f(ptr + 8);
-    const f256 c = loadu8f(ptr + 16);
-    convert3Dto4d_avx(a, b, c, output + j);
-  }
-  if(count4)
-  {
-    const float* const ptr = input + i;
-    const f128 a = loadu4f(ptr);
-    const f128 b = loadu4f(ptr + 4);
-    const f128 c = loadu4f(ptr + 8);
-    convert3Dto4d_sse(a, b, c, output + j);
-    i += 12;
-    j += 16;
-  }
-  convert3Dto4d(input + i, output + j, remainder);
-# elif defined(__SSE3__)
-  const size_t count4 = count >> 2;
-  const uint32_t remainder = count & 0x3;
-  size_t i = 0, j = 0;
-  for(size_t n = 12 * count4; i != n; i += 12, j += 16)
-  {
-    const float* const ptr = input + i;
-    const f128 a = loadu4f(ptr);
-    const f128 b = loadu4f(ptr + 4);
-    const f128 c = loadu4f(ptr + 8);
-    convert3Dto4d_sse(a, b, c, output + j);
-  }
-  convert3Dto4d(input + i, output + j, remainder);
-# endif
-#else
-  for(size_t i = 0, j = 0, n = count * 3; i != n; i += 3, j += 4)
+  mesh.GetFaceVertexCountsAttr().Get(&faceVertexCounts, timeCode);
+  mesh.GetFaceVertexIndicesAttr().Get(&faceVertexIndices, timeCode);
+  mesh.GetPointsAttr().Get(&points, timeCode);
+  hasNormals = mesh.GetNormalsAttr().HasAuthoredValueOpinion();
+  if(hasNormals)
   {
-    output[j ] = input[i ];
-    output[j + 1] = input[i + 1];
-    output[j + 2] = input[i + 2];
-    output[j + 3] = 1.0f;
+    mesh.GetNormalsAttr().Get(&normals, timeCode);
+    normalsInterpolation = mesh.GetNormalsInterpolation();
   }
-#endif
+  TfToken orientation;
+  leftHanded = (mesh.GetOrientationAttr().Get(&orientation, timeCode) && orientation == UsdGeomTokens->leftHanded);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void MeshImportContext::gatherFaceConnectsAndVertices()
+MeshImportContext::MeshImportContext(const UsdGeomMesh& mesh, MObject shape, const MeshImportData& data,
+                                     UsdTimeCode timeCode)
+  : mesh(mesh), polyShape(shape), m_timeCode(timeCode)
 {
-  VtArray<GfVec3f> pointData;
-  VtArray<GfVec3f> normalsData;
-  VtArray<int> faceVertexCounts;
-  VtArray<int> faceVertexIndices;
+  gatherFaceConnectsAndVertices(data);
+
+  // the geometry is built in a data object, and then copied onto the shape
+  MFnMeshData fnData;
+  MObject meshData = fnData.create();
+  fnMesh.create(points.length(), counts.length(), points, counts, connects, meshData);
+  fnMesh.setObject(polyShape);
+  AL_MAYA_CHECK_ERROR2(fnMesh.copyInPlace(meshData), MString("Unable to set the geometry of mesh ") + fnMesh.name());
+  fnMesh.findPlug("op", true).setBool(data.leftHanded);
+}
 
-  UsdAttribute fvc = mesh.GetFaceVertexCountsAttr();
-  UsdAttribute fvi = mesh.GetFaceVertexIndicesAttr();
+//----------------------------------------------------------------------------------------------------------------------
+void MeshImportContext::gatherFaceConnectsAndVertices(const MeshImportData& data)
+{
+  const VtArray<GfVec3f>& pointData = data.points;
+  const VtArray<GfVec3f>& normalsData = data.normals;
+  const VtArray<int>& faceVertexCounts = data.faceVertexCounts;
+  const VtArray<int>& faceVertexIndices = data.faceVertexIndices;
 
-  fvc.Get(&faceVertexCounts, m_timeCode);
   counts.setLength(faceVertexCounts.size());
-  fvi.Get(&faceVertexIndices, m_timeCode);
   connects.setLength(faceVertexIndices.size());
 
-  mesh.GetPointsAttr().Get(&pointData, m_timeCode);
-  if(mesh.GetNormalsAttr().HasAuthoredValueOpinion())
-  {
-    mesh.GetNormalsAttr().Get(&normalsData, m_timeCode);
-  }
-
   points.setLength(pointData.size());
   convert3DArrayTo4DArray((const float*)pointData.cdata(), &points[0].x, pointData.size());
 
   memcpy(&counts[0], (const int32_t*)faceVertexCounts.cdata(), sizeof(int32_t) * faceVertexCounts.size());
   memcpy(&connects[0], (const int32_t*)faceVertexIndices.cdata(), sizeof(int32_t) * faceVertexIndices.size());
 
-  if(mesh.GetNormalsAttr().HasAuthoredValueOpinion())
+  if(data.hasNormals)
   {
-    if(mesh.GetNormalsInterpolation() == UsdGeomTokens->faceVarying ||
-       mesh.GetNormalsInterpolation() == UsdGeomTokens->varying)
+    if(data.normalsInterpolation == UsdGeomTokens->faceVarying ||
+       data.normalsInterpolation == UsdGeomTokens->varying)
     {
       normals.setLength(normalsData.size());
       double* const optr = &normals[0].x;
@@ -225,7 +141,7 @@ void MeshImportContext::gatherFaceConnectsAndVertices()
       }
     }
     else
-    if(mesh.GetNormalsInterpolation() == UsdGeomTokens->uniform)
+    if(data.normalsInterpolation == UsdGeomTokens->uniform)
     {
       const float* const iptr = (const float*)normalsData.cdata();
       normals.setLength(connects.length());
@@ -240,7 +156,7 @@ void MeshImportContext::gatherFaceConnectsAndVertices()
       }
     }
     else
-    if(mesh.GetNormalsInterpolation() == UsdGeomTokens->vertex)
+    if(data.normalsInterpolation == UsdGeomTokens->vertex)
     {
       const float* const iptr = (const float*)normalsData.cdata();
       normals.setLength(connects.length());
@@ -255,9 +171,7 @@ void MeshImportContext::gatherFaceConnectsAndVertices()
   {
     // check for cases where data is left handed.
     // Maya fails
-    TfToken orientation;
-    bool leftHanded = (mesh.GetOrientationAttr().Get(&orientation, m_timeCode) && orientation == UsdGeomTokens->leftHanded);
-    if(leftHanded)
+    if(data.leftHanded)
     {
       size_t numPoints = pointData.size();
       size_t numFaces = faceVertexCounts.size();
@@ -420,6 +334,29 @@ void generateIncrementingIndices(MIntArray& indices, const size_t count)
 #endif
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+EdgeLookup::EdgeLookup(const MFnMesh& fnMesh)
+{
+  const int32_t numEdges = fnMesh.numEdges();
+  m_edges.reserve(numEdges);
+  for(int32_t i = 0; i < numEdges; ++i)
+  {
+    int2 edgeVerts;
+    fnMesh.getEdgeVertices(i, edgeVerts);
+    m_edges.emplace(key(edgeVerts[0], edgeVerts[1]), i);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const EdgeLookup& MeshImportContext::getEdgeLookup()
+{
+  if(!m_edgeLookup)
+  {
+    m_edgeLookup.reset(new EdgeLookup(fnMesh));
+  }
+  return *m_edgeLookup;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 void MeshImportContext::applyHoleFaces()
 {
@@ -436,72 +373,7 @@ void MeshImportContext::applyHoleFaces()
 //----------------------------------------------------------------------------------------------------------------------
 void unzipUVs(const float* const uv, float* const u, float* const v, const size_t count)
 {
-#if AL_UTILS_ENABLE_SIMD
-
-#ifdef __AVX2__
-  const size_t count8 = count & ~7ULL;
-  size_t i = 0, j = 0;
-  for(; i < count8; i += 8, j += 16)
-  {
-    const f256 uva = loadu8f(uv + j);
-    const f256 uvb = loadu8f(uv + j + 8);
-    const f256 uva1 = permute2f128(uva, uvb, 0x20);
-    const f256 uvb1 = permute2f128(uva, uvb, 0x31);
-    const f256 uvals = shuffle8f(uva1, uvb1, 2, 0, 2, 0);
-    const f256 vvals = shuffle8f(uva1, uvb1, 3, 1, 3, 1);
-    storeu8f(u + i, uvals);
-    storeu8f(v + i, vvals);
-  }
-
-  if(count & 0x4)
-  {
-    const f128 uva = loadu4f(uv + j);
-    const f128 uvb = loadu4f(uv + j + 4);
-    const f128 uvals = shuffle4f(uva, uvb, 2, 0, 2, 0);
-    const f128 vvals = shuffle4f(uva, uvb, 3, 1, 3, 1);
-    storeu4f(u + i, uvals);
-    storeu4f(v + i, vvals);
-    i += 4;
-    j += 8;
-  }
-#else
-
-  const size_t count4 = count & ~3ULL;
-  size_t i = 0, j = 0;
-  for(; i < count4; i += 4, j += 8)
-  {
-    const f128 uva = loadu4f(uv + j);
-    const f128 uvb = loadu4f(uv + j + 4);
-    const f128 uvals = shuffle4f(uva, uvb, 2, 0, 2, 0);
-    const f128 vvals = shuffle4f(uva, uvb, 3, 1, 3, 1);
-    storeu4f(u + i, uvals);
-    storeu4f(v + i, vvals);
-  }
-
-#endif
-
-  switch(count & 3)
-  {
-  case 3:
-    u[i + 2] = uv[j + 4];
-    v[i + 2] = uv[j + 5];
-  case 2:
-    u[i + 1] = uv[j + 2];
-    v[i + 1] = uv[j + 3];
-  case 1:
-    u[i] = uv[j];
-    v[i] = uv[j + 1];
-  default:
-    break;
-  }
-
-#else
-  for(size_t i = 0, j = 0; i < count; ++i, j += 2)
-  {
-    u[i] = uv[j];
-    v[i] = uv[j + 1];
-  }
-#endif
+  kernels().unzipUVs(uv, u, v, count);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -572,9 +444,21 @@ bool MeshImportContext::applyEdgeCreases()
     creaseLengths.Get(&lengths, m_timeCode);
     creaseSharpness.Get(&sharpness, m_timeCode);
 
-    // expand data into vertex pair + single sharpness value
-    MUintArray edgesIdValues;
+    // count the edges, so that the output arrays can be sized up front
+    uint32_t numEdges = 0;
+    for(uint32_t i = 0; i < lengths.size(); ++i)
+    {
+      if(lengths[i] > 1)
+        numEdges += lengths[i] - 1;
+    }
+
+    // expand data into an edge id + single sharpness value per edge
+    const EdgeLookup& edgeLookup = getEdgeLookup();
+    MUintArray creaseEdgeIds;
     MDoubleArray creaseValues;
+    creaseEdgeIds.setLength(numEdges);
+    creaseValues.setLength(numEdges);
+    uint32_t numFound = 0;
     for(uint32_t i = 0, k = 0; i < lengths.size(); ++i)
     {
       const int32_t len = lengths[i];
@@ -584,55 +468,23 @@ bool MeshImportContext::applyEdgeCreases()
       int32_t firstVertex = indices[k++];
       for(int32_t j = 1; j < len; ++j)
       {
-        int32_t nextVertex = indices[k++];
-        edgesIdValues.append(firstVertex);
-        edgesIdValues.append(nextVertex);
-        firstVertex = nextVertex;
-        creaseValues.append(sharpness[i]);
-      }
-    }
-
-    //
-    MObject temp = fnMesh.object();
-    MItMeshVertex iter(temp);
-    MIntArray edgeIds;
-    MUintArray creaseEdgeIds;
-    for(size_t i = 0, k = 0; i < edgesIdValues.length(); i += 2, ++k)
-    {
-      const int32_t vertexIndex0 = edgesIdValues[i];
-      const int32_t vertexIndex1 = edgesIdValues[i + 1];
-      int prev;
-      if(!iter.setIndex(vertexIndex0, prev))
-      {
-        std::cout << "could not set index on vertex iterator" << std::endl;
-      }
-
-      if(iter.getConnectedEdges(edgeIds))
-      {
-        bool found = false;
-        for(uint32_t j = 0; j < edgeIds.length(); ++j)
+        const int32_t nextVertex = indices[k++];
+        const int32_t edgeId = edgeLookup.find(firstVertex, nextVertex);
+        if(edgeId < 0)
         {
-          int2 edgeVerts;
-          fnMesh.getEdgeVertices(edgeIds[j], edgeVerts);
-
-          if((vertexIndex0 == edgeVerts[0] && vertexIndex1 == edgeVerts[1]) ||
-             (vertexIndex1 == edgeVerts[0] && vertexIndex0 == edgeVerts[1]))
-          {
-            found = true;
-            creaseEdgeIds.append(edgeIds[j]);
-            break;
-          }
+          std::cout << "could not find matching edge" << std::endl;
         }
-        if(!found)
+        else
         {
-          std::cout << "could not find matching edge" << std::endl;
+          creaseEdgeIds[numFound] = edgeId;
+          creaseValues[numFound] = sharpness[i];
+          ++numFound;
         }
-      }
-      else
-      {
-        std::cout << "could not access connected edges" << std::endl;
+        firstVertex = nextVertex;
       }
     }
+    creaseEdgeIds.setLength(numFound);
+    creaseValues.setLength(numFound);
 
     if(!fnMesh.setCreaseEdges(creaseEdgeIds, creaseValues))
     {
@@ -998,81 +850,7 @@ bool isUvSetDataSparse(const int32_t* uvCounts, const uint32_t count)
 //----------------------------------------------------------------------------------------------------------------------
 void zipUVs(const float* u, const float* v, float* uv, const size_t count)
 {
-#if AL_UTILS_ENABLE_SIMD
-# ifdef __AVX2__
-
-  uint32_t uvCount8 = count & ~7U;
-
-  for(uint32_t i = 0; i < uvCount8; i += 8, uv += 16)
-  {
-    const f256 U = loadu8f(u + i);
-    const f256 V = loadu8f(v + i);
-    const f256 uv0 = unpacklo8f(U, V);
-    const f256 uv1 = unpackhi8f(U, V);
-    storeu8f(uv, permute2f128(uv0, uv1, 0x20));
-    storeu8f(uv + 8, permute2f128(uv0, uv1, 0x31));
-  }
-
-  if(count & 0x4)
-  {
-    const f128 U = loadu4f(u + uvCount8);
-    const f128 V = loadu4f(v + uvCount8);
-    storeu4f(uv, unpacklo4f(U, V));
-    storeu4f(uv + 4, unpackhi4f(U, V));
-    uv += 8;
-    uvCount8 += 4;
-  }
-
-  switch(count & 3)
-  {
-  case 3:
-    uv[4] = u[uvCount8 + 2];
-    uv[5] = v[uvCount8 + 2];
-  case 2:
-    uv[2] = u[uvCount8 + 1];
-    uv[3] = v[uvCount8 + 1];
-  case 1:
-    uv[0] = u[uvCount8 + 0];
-    uv[1] = v[uvCount8 + 0];
-  default:
-    break;
-  }
-
-# else
-
-  const uint32_t uvCount4 = count & ~3U;
-
-  for(uint32_t i = 0; i < uvCount4; i += 4, uv += 8)
-  {
-    const f128 U = loadu4f(u + i);
-    const f128 V = loadu4f(v + i);
-    storeu4f(uv, unpacklo4f(U, V));
-    storeu4f(uv + 4, unpackhi4f(U, V));
-  }
-
-  switch(count & 3)
-  {
-  case 3:
-    uv[4] = u[uvCount4 + 2];
-    uv[5] = v[uvCount4 + 2];
-  case 2:
-    uv[2] = u[uvCount4 + 1];
-    uv[3] = v[uvCount4 + 1];
-  case 1:
-    uv[0] = u[uvCount4 + 0];
-    uv[1] = v[uvCount4 + 0];
-  default:
-    break;
-  }
-
-# endif
-#else
-  for(uint32_t i = 0, j = 0; i < count; i++, j += 2)
-  {
-    uv[j] = u[i];
-    uv[j + 1] = v[i];
-  }
-#endif
+  kernels().zipUVs(u, v, uv, count);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1312,118 +1090,7 @@ void MeshExportContext::copyUvSetData()
 //----------------------------------------------------------------------------------------------------------------------
 void interleaveIndexedUvData(float* output, const float* u, const float* v, const int32_t* indices, const uint32_t numIndices)
 {
-#if AL_UTILS_ENABLE_SIMD
-
-#if defined(__AVX2__) && ENABLE_SOME_AVX_ROUTINES
-
-  const uint32_t numIndices8 = numIndices & ~7;
-  uint32_t i = 0;
-  for(; i < numIndices8; i += 8, output += 16)
-  {
-    const i256 I = loadu8i(indices + i);
-    const f256 U = i32gather8f(u, I);
-    const f256 V = i32gather8f(v, I);
-    const f256 uv0 = unpacklo8f(U, V);
-    const f256 uv1 = unpackhi8f(U, V);
-    storeu8f(output, permute2f128(uv0, uv1, 0x20));
-    storeu8f(output + 8, permute2f128(uv0, uv1, 0x31));
-  }
-
-  if(numIndices & 0x4)
-  {
-    const i128 I = loadu4i(indices + i);
-    const f128 U = i32gather4f(u, I);
-    const f128 V = i32gather4f(v, I);
-    const f128 uv0 = unpacklo4f(U, V);
-    const f128 uv1 = unpackhi4f(U, V);
-    storeu4f(output, uv0);
-    storeu4f(output + 4, uv1);
-    output += 8;
-    i += 4;
-  }
-
-#else
-
-  const i128 uptr = splat2i64(intptr_t(u));
-  const i128 vptr = splat2i64(intptr_t(v));
-  const i128 mask = set4i(0xFFFFFFFF, 0, 0xFFFFFFFF, 0);
-
-  const uint32_t numIndices4 = numIndices & ~3;
-  uint32_t i = 0;
-  for(; i < numIndices4; i += 4, output += 8)
-  {
-    // load 4 indices
-    const i128 I = loadu4i(indices + i);
-
-    // mask out into 2 pairs of 64 bit indices, and scale values by 4 (using shift)
-    const i128 I02 = lshift64(and4i(mask, I), 2);
-    const i128 I13 = lshift64(and4i(mask, shiftBytesRight(I, 4)), 2);
-
-    // get addresses by adding the base offset
-    const i128 U02 = add2i64(I02, uptr);
-    const i128 U13 = add2i64(I13, uptr);
-    const i128 V02 = add2i64(I02, vptr);
-    const i128 V13 = add2i64(I13, vptr);
-
-    #ifndef __SSE4_1__
-    ALIGN16(float* ptrs[8]);
-    store4i(ptrs    , U02);
-    store4i(ptrs + 2, U13);
-    store4i(ptrs + 4, V02);
-    store4i(ptrs + 6, V13);
-
-    const f128 u0 = load1f(ptrs[0]);
-    const f128 u2 = load1f(ptrs[1]);
-    const f128 u1 = load1f(ptrs[2]);
-    const f128 u3 = load1f(ptrs[3]);
-    const f128 v0 = load1f(ptrs[4]);
-    const f128 v2 = load1f(ptrs[5]);
-    const f128 v1 = load1f(ptrs[6]);
-    const f128 v3 = load1f(ptrs[7]);
-    #else
-    #define extract_float_ptr(reg, index) reinterpret_cast<const float*>(_mm_extract_epi64(reg, index))
-    const f128 u0 = load1f(extract_float_ptr(U02, 0));
-    const f128 u2 = load1f(extract_float_ptr(U02, 1));
-    const f128 u1 = load1f(extract_float_ptr(U13, 0));
-    const f128 u3 = load1f(extract_float_ptr(U13, 1));
-    const f128 v0 = load1f(extract_float_ptr(V02, 0));
-    const f128 v2 = load1f(extract_float_ptr(V02, 1));
-    const f128 v1 = load1f(extract_float_ptr(V13, 0));
-    const f128 v3 = load1f(extract_float_ptr(V13, 1));
-    #undef extract_ptr
-    #endif
-
-    const f128 uv0 = unpacklo4f(u0, v0);
-    const f128 uv1 = unpacklo4f(u1, v1);
-    storeu4f(output, movelh4f(uv0, uv1));
-
-    const f128 uv2 = unpacklo4f(u2, v2);
-    const f128 uv3 = unpacklo4f(u3, v3);
-    storeu4f(output + 4, movelh4f(uv2, uv3));
-  }
-
-#endif
-
-  switch(numIndices & 0x3)
-  {
-  case 3: output[4] = u[indices[i + 2]];
-          output[5] = v[indices[i + 2]];
-  case 2: output[2] = u[indices[i + 1]];
-          output[3] = v[indices[i + 1]];
-  case 1: output[0] = u[indices[i]];
-          output[1] = v[indices[i]];
-  default: break;
-  }
-
-#else
-
-  for(uint32_t i = 0, j = 0; i < numIndices; ++i, j += 2)
-  {
-    output[j] = u[indices[i]];
-    output[j + 1] = v[indices[i]];
-  }
-
-#endif
+  kernels().interleaveIndexedUvData(output, u, v, indices, numIndices);
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1758,26 +1425,42 @@ void MeshExportContext::copyAnimalFaceColours()
 
 //----------------------------------------------------------------------------------------------------------------------
 void MeshExportContext::copyVertexData(UsdTimeCode time)
+{
+  VtArray<GfVec3f> points;
+  if(copyVertexData(points))
+  {
+    writeVertexData(points, time);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool MeshExportContext::copyVertexData(VtArray<GfVec3f>& points)
 {
   if(diffGeom & kPoints)
   {
-    if(UsdAttribute pointsAttr = mesh.GetPointsAttr())
+    // the context may be re-used after the time has changed (e.g. when exporting animation), so make sure the
+    // function set refers to the mesh data as it is now evaluated.
+    MStatus status = fnMesh.syncObject();
+    AL_MAYA_CHECK_ERROR2(status, MString("unable to sync function set to mesh") + fnMesh.fullPathName());
+    const uint32_t numVertices = fnMesh.numVertices();
+    const float* pointsData = fnMesh.getRawPoints(&status);
+    if(status)
     {
-      MStatus status;
-      const uint32_t numVertices = fnMesh.numVertices();
-      VtArray<GfVec3f> points(numVertices);
-      const float* pointsData = fnMesh.getRawPoints(&status);
-      if(status)
-      {
-        memcpy((GfVec3f*)points.data(), pointsData, sizeof(float) * 3 * numVertices);
-
-        pointsAttr.Set(points, time);
-      }
-      else
-      {
-        MGlobal::displayError(MString("Unable to access mesh vertices on mesh: ") + fnMesh.fullPathName());
-      }
+      points.resize(numVertices);
+      memcpy((GfVec3f*)points.data(), pointsData, sizeof(float) * 3 * numVertices);
+      return true;
     }
+    MGlobal::displayError(MString("Unable to access mesh vertices on mesh: ") + fnMesh.fullPathName());
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshExportContext::writeVertexData(const VtArray<GfVec3f>& points, UsdTimeCode time)
+{
+  if(UsdAttribute pointsAttr = mesh.GetPointsAttr())
+  {
+    pointsAttr.Set(points, time);
   }
 }
 
@@ -38,6 +38,9 @@
 
 #include "AL/maya/utils/MayaHelperMacros.h"
 
+#include <memory>
+#include <unordered_map>
+
 PXR_NAMESPACE_USING_DIRECTIVE
 
 constexpr auto _alusd_colour = "alusd_colour_";
@@ -123,6 +126,65 @@ AL_USDMAYA_UTILS_PUBLIC
 void interleaveIndexedUvData(float* output, const float* u, const float* v, const int32_t* indices, const uint32_t numIndices);
 
 
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  A lookup table from a pair of vertex indices to the index of the Maya edge between them. The table is built
+///         in one pass over the edges of the mesh, so that finding the edge for a pair of vertices does not require
+///         walking the edges connected to a vertex.
+//----------------------------------------------------------------------------------------------------------------------
+class EdgeLookup
+{
+public:
+
+  /// \brief  builds the lookup table from the edges of the mesh
+  /// \param  fnMesh the mesh whose edges should be looked up
+  AL_USDMAYA_UTILS_PUBLIC
+  explicit EdgeLookup(const MFnMesh& fnMesh);
+
+  /// \brief  returns the index of the edge between two vertices, in either order
+  /// \param  vertex0 the index of the first vertex
+  /// \param  vertex1 the index of the second vertex
+  /// \return the index of the edge, or -1 if there is no edge between the vertices
+  int32_t find(const int32_t vertex0, const int32_t vertex1) const
+  {
+    auto it = m_edges.find(key(vertex0, vertex1));
+    return it != m_edges.end() ? it->second : -1;
+  }
+
+  /// \brief  returns the number of edges in the table
+  size_t size() const
+    { return m_edges.size(); }
+
+private:
+  static uint64_t key(const int32_t vertex0, const int32_t vertex1)
+  {
+    const uint32_t a = uint32_t(vertex0 < vertex1 ? vertex0 : vertex1);
+    const uint32_t b = uint32_t(vertex0 < vertex1 ? vertex1 : vertex0);
+    return (uint64_t(a) << 32) | b;
+  }
+  std::unordered_map<uint64_t, int32_t> m_edges;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The values a MeshImportContext reads from the UsdGeomMesh in order to create the Maya geometry. These only
+///         require USD, so can be read on a worker thread ahead of creating the mesh (e.g. for a batched import).
+//----------------------------------------------------------------------------------------------------------------------
+struct MeshImportData
+{
+  VtArray<GfVec3f> points; ///< the vertex positions
+  VtArray<GfVec3f> normals; ///< the normals, if they have been authored
+  VtArray<int> faceVertexCounts; ///< the number of vertices in each face
+  VtArray<int> faceVertexIndices; ///< the vertex indices for each face-vertex
+  TfToken normalsInterpolation; ///< the interpolation of the normals
+  bool hasNormals = false; ///< true if the mesh has authored normals
+  bool leftHanded = false; ///< true if the mesh has a left handed orientation
+
+  /// \brief  reads the values from the mesh
+  /// \param  mesh the usd geometry to read
+  /// \param  timeCode the time code at which to read the data
+  AL_USDMAYA_UTILS_PUBLIC
+  void read(const UsdGeomMesh& mesh, UsdTimeCode timeCode);
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 /// \brief  A class used to import mesh data from Usd into Maya
 //----------------------------------------------------------------------------------------------------------------------
@@ -137,8 +199,9 @@ private:
   const UsdGeomMesh& mesh; ///< the USD geometry being imported
   MObject polyShape; ///< the handle to the created mesh shape
   UsdTimeCode m_timeCode; ///< the time at which to import the mesh
+  std::unique_ptr<EdgeLookup> m_edgeLookup; ///< the vertex pair to edge lookup table, built on first use
   AL_USDMAYA_UTILS_PUBLIC
-  void gatherFaceConnectsAndVertices();
+  void gatherFaceConnectsAndVertices(const MeshImportData& data);
 public:
 
   /// \brief  constructs the import context for the specified mesh
@@ -150,11 +213,11 @@ public:
   MeshImportContext(const UsdGeomMesh& mesh, MObject parentOrOwner, MString dagName, UsdTimeCode timeCode = UsdTimeCode::EarliestTime())
     : mesh(mesh), m_timeCode(timeCode)
   {
-    gatherFaceConnectsAndVertices();
+    MeshImportData data;
+    data.read(mesh, timeCode);
+    gatherFaceConnectsAndVertices(data);
     polyShape = fnMesh.create(points.length(), counts.length(), points, counts, connects, parentOrOwner);
-    TfToken orientation;
-    bool leftHanded = (mesh.GetOrientationAttr().Get(&orientation, timeCode) && orientation == UsdGeomTokens->leftHanded);
-    fnMesh.findPlug("op", true).setBool(leftHanded);
+    fnMesh.findPlug("op", true).setBool(data.leftHanded);
     // 
     if(parentOrOwner.hasFn(MFn::kTransform))
     {
@@ -162,6 +225,16 @@ public:
     }
   }
 
+  /// \brief  constructs the import context for a mesh shape that already exists (e.g. one created with an
+  ///         MDagModifier), replacing its geometry with the previously read mesh data.
+  /// \param  mesh the usd geometry to import
+  /// \param  shape the maya mesh shape to import the geometry into
+  /// \param  data the values read from the usd geometry
+  /// \param  timeCode the time code at which to gather the remaining data from USD
+  AL_USDMAYA_UTILS_PUBLIC
+  MeshImportContext(const UsdGeomMesh& mesh, MObject shape, const MeshImportData& data,
+                    UsdTimeCode timeCode = UsdTimeCode::EarliestTime());
+
   /// \brief  reads the HoleIndices attribute from the usd geometry, and assigns those values as invisible faces on
   ///         the Maya mesh
   AL_USDMAYA_UTILS_PUBLIC
@@ -192,6 +265,11 @@ public:
   /// \brief  returns the mesh function set
   MFnMesh& getFn()
     { return fnMesh; }
+
+  /// \brief  returns the table used to find the edge between a pair of vertices of the poly shape. The table is built
+  ///         the first time it is requested, and is then shared by all of the import steps that need it.
+  AL_USDMAYA_UTILS_PUBLIC
+  const EdgeLookup& getEdgeLookup();
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -236,6 +314,21 @@ public:
   AL_USDMAYA_UTILS_PUBLIC
   void copyVertexData(UsdTimeCode timeCode);
 
+  /// \brief  copies the vertex data from maya into the points array, without modifying the usd prim. This allows the
+  ///         data to be gathered from maya on the main thread, and written into USD later (via writeVertexData).
+  ///         The mesh is re-synced before it is read, so the context may be re-used to read each frame of an animation.
+  /// \param  points the returned vertex positions
+  /// \return true if the vertex data was retrieved from the mesh
+  AL_USDMAYA_UTILS_PUBLIC
+  bool copyVertexData(VtArray<GfVec3f>& points);
+
+  /// \brief  writes vertex data previously extracted via copyVertexData into the usd prim. This does not access the
+  ///         maya mesh, so may be called from a thread other than the main thread.
+  /// \param  points the vertex positions to write
+  /// \param  timeCode the time code at which to write the samples
+  AL_USDMAYA_UTILS_PUBLIC
+  void writeVertexData(const VtArray<GfVec3f>& points, UsdTimeCode timeCode);
+
   /// \brief  copies the normal data from maya into the usd prim.
   /// \param  timeCode the time code at which to extract the samples
   AL_USDMAYA_UTILS_PUBLIC
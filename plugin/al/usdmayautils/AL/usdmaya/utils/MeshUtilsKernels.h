@@ -0,0 +1,48 @@
+//
+// Copyright 2019 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace AL {
+namespace usdmaya {
+namespace utils {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The array conversions from MeshUtils built for a single instruction set (see MeshUtilsKernels.inl). This is
+///         an internal header, the methods should be called via MeshUtils.h, which selects the build for the
+///         AL::usd::utils::activeSimdLevel().
+//----------------------------------------------------------------------------------------------------------------------
+struct MeshUtilsKernels
+{
+  void (*convert3DArrayTo4DArray)(const float*, float*, size_t);
+  void (*unzipUVs)(const float*, float*, float*, size_t);
+  void (*zipUVs)(const float*, const float*, float*, size_t);
+  void (*interleaveIndexedUvData)(float*, const float*, const float*, const int32_t*, uint32_t);
+};
+
+namespace sse { extern const MeshUtilsKernels meshUtilsKernels; }
+namespace avx2 { extern const MeshUtilsKernels meshUtilsKernels; }
+#if AL_SIMD_HAS_AVX512
+namespace avx512 { extern const MeshUtilsKernels meshUtilsKernels; }
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+} // utils
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
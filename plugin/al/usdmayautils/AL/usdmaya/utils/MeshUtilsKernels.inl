@@ -0,0 +1,498 @@
+//
+// Copyright 2017 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \file   MeshUtilsKernels.inl
+/// \brief  The implementation of the array conversions used by the mesh import/export. As with DiffCoreKernels.inl,
+///         this file is compiled once for each instruction set with AL_SIMD_NAMESPACE defined, and MeshUtils.cpp calls
+///         into the build selected by AL::usd::utils::activeSimdLevel().
+//----------------------------------------------------------------------------------------------------------------------
+#include "AL/usd/utils/SIMD.h"
+#include "AL/usdmaya/utils/MeshUtilsKernels.h"
+
+#ifndef AL_SIMD_NAMESPACE
+# error "AL_SIMD_NAMESPACE must be defined when compiling the MeshUtils kernels"
+#endif
+
+namespace AL {
+namespace usdmaya {
+namespace utils {
+namespace AL_SIMD_NAMESPACE {
+namespace {
+
+#if defined(__SSE__)
+
+#if defined(__AVX2__)
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  the 8 element version of convert3Dto4d_sse. The output array must contain 32 floating point values
+//----------------------------------------------------------------------------------------------------------------------
+void convert3Dto4d_avx(const f256 a, const f256 b, const f256 c, float* const output)
+{
+  static const f256 wvalues = set8f(0, 0, 0, 1.0f, 0, 0, 0, 1.0f);
+  static const f256 wmask = set8f(0, 0, 0, -0.0f, 0, 0, 0, -0.0f);
+  const f256 v23 = permute2f128(a, b, 0x21);
+  const f256 v45 = permute2f128(b, c, 0x21);
+  static const i256 mask01 = set8i(0, 1, 2, 0, 3, 4, 5, 0);
+  static const i256 mask23 = set8i(2, 3, 4, 0, 5, 6, 7, 0);
+  f256 o01 = permutevar8x32f(a, mask01);
+  f256 o23 = permutevar8x32f(v23, mask23);
+  f256 o45 = permutevar8x32f(v45, mask01);
+  f256 o67 = permutevar8x32f(c, mask23);
+  o01 = select8f(o01, wvalues, wmask);
+  o23 = select8f(o23, wvalues, wmask);
+  o45 = select8f(o45, wvalues, wmask);
+  o67 = select8f(o67, wvalues, wmask);
+  storeu8f(output, o01);
+  storeu8f(output + 8, o23);
+  storeu8f(output + 16, o45);
+  storeu8f(output + 24, o67);
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  assuming a, b, & c are 4 packed 3D vectors of the form:
+///
+///         { v0x, v0y, v0z, v1x, v1y, v1z, v2x, v2y, v2z, v3x, v3y, v3z }
+///
+///         This method will convert that to 4D vectors with a 'w' value of 1.
+///
+///         { v0x, v0y, v0z, 1.0, v1x, v1y, v1z, 1.0, v2x, v2y, v2z, 1.0, v3x, v3y, v3z, 1.0 }
+///
+///         The output array must contain 16 floating point values
+//----------------------------------------------------------------------------------------------------------------------
+void convert3Dto4d_sse(const f128 a, const f128 b, const f128 c, float* output)
+{
+  static const f128 wvalues = set4f(0, 0, 0, 1.0f);
+  static const f128 wmask = cast4f(set4i(0, 0, 0, 0xFFFFFFFF));
+
+  const f128 o0 = select4f(a, wvalues, wmask);
+  const f128 o3 = or4f(cast4f(shiftBytesRight(cast4i(c), 4)), wvalues);
+  f128 o1 = shuffle4f(a, b, 1, 0, 3, 3);
+  o1 = select4f(shuffle4f(o1, o1, 1, 3, 2, 0), wvalues, wmask);
+  f128 o2 = select4f(shuffle4f(b, c, 1, 0, 3, 2), wvalues, wmask);
+
+  storeu4f(output, o0);
+  storeu4f(output + 4, o1);
+  storeu4f(output + 8, o2);
+  storeu4f(output + 12, o3);
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+void convert3Dto4d(const float* const c, float* const output, uint32_t count)
+{
+  switch(count)
+  {
+  case 3:
+    output[8] = c[6];
+    output[9] = c[7];
+    output[10] = c[8];
+    output[11] = 1.0f;
+  case 2:
+    output[4] = c[3];
+    output[5] = c[4];
+    output[6] = c[5];
+    output[7] = 1.0f;
+  case 1:
+    output[0] = c[0];
+    output[1] = c[1];
+    output[2] = c[2];
+    output[3] = 1.0f;
+    default: break;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void convert3DArrayTo4DArray(const float* const input, float* const output, size_t count)
+{
+#if defined(__SSE__)
+  const size_t n = count * 3;
+  size_t i = 0, j = 0;
+
+# if AL_SIMD_ENABLE_AVX512
+  // each group of 4 output vectors is read from 12 of the 32 floats in 2 adjacent registers
+  static const i512 index0 = set16i(0, 1, 2, 0, 3, 4, 5, 0, 6, 7, 8, 0, 9, 10, 11, 0);
+  static const i512 index1 = set16i(12, 13, 14, 0, 15, 16, 17, 0, 18, 19, 20, 0, 21, 22, 23, 0);
+  static const i512 index2 = set16i(8, 9, 10, 0, 11, 12, 13, 0, 14, 15, 16, 0, 17, 18, 19, 0);
+  static const i512 index3 = set16i(20, 21, 22, 0, 23, 24, 25, 0, 26, 27, 28, 0, 29, 30, 31, 0);
+  const f512 ones = splat16f(1.0f);
+  const uint16_t wmask = 0x8888;
+  for(; i + 48 <= n; i += 48, j += 64)
+  {
+    const float* const ptr = input + i;
+    const f512 a = loadu16f(ptr);
+    const f512 b = loadu16f(ptr + 16);
+    const f512 c = loadu16f(ptr + 32);
+    storeu16f(output + j, select16f(permute2x16f(a, index0, b), ones, wmask));
+    storeu16f(output + j + 16, select16f(permute2x16f(a, index1, b), ones, wmask));
+    storeu16f(output + j + 32, select16f(permute2x16f(b, index2, c), ones, wmask));
+    storeu16f(output + j + 48, select16f(permute2x16f(b, index3, c), ones, wmask));
+  }
+# endif
+
+# if defined(__AVX2__)
+  for(; i + 24 <= n; i += 24, j += 32)
+  {
+    const float* const ptr = input + i;
+    const f256 a = loadu8f(ptr);
+    const f256 b = loadu8f(ptr + 8);
+    const f256 c = loadu8f(ptr + 16);
+    convert3Dto4d_avx(a, b, c, output + j);
+  }
+# endif
+
+  for(; i + 12 <= n; i += 12, j += 16)
+  {
+    const float* const ptr = input + i;
+    const f128 a = loadu4f(ptr);
+    const f128 b = loadu4f(ptr + 4);
+    const f128 c = loadu4f(ptr + 8);
+    convert3Dto4d_sse(a, b, c, output + j);
+  }
+  convert3Dto4d(input + i, output + j, uint32_t((n - i) / 3));
+#else
+  for(size_t i = 0, j = 0, n = count * 3; i != n; i += 3, j += 4)
+  {
+    output[j ] = input[i ];
+    output[j + 1] = input[i + 1];
+    output[j + 2] = input[i + 2];
+    output[j + 3] = 1.0f;
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void unzipUVs(const float* const uv, float* const u, float* const v, const size_t count)
+{
+#if defined(__SSE__)
+  size_t i = 0, j = 0;
+
+# if AL_SIMD_ENABLE_AVX512
+  static const i512 uindices = set16i(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+  static const i512 vindices = set16i(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+  const size_t count16 = count & ~size_t(15);
+  for(; i < count16; i += 16, j += 32)
+  {
+    const f512 uva = loadu16f(uv + j);
+    const f512 uvb = loadu16f(uv + j + 16);
+    storeu16f(u + i, permute2x16f(uva, uindices, uvb));
+    storeu16f(v + i, permute2x16f(uva, vindices, uvb));
+  }
+
+  // the remaining 1 to 15 UVs are handled with masked loads & stores
+  const size_t remainder = count & 15;
+  if(remainder)
+  {
+    const uint16_t maska = remainder >= 8 ? 0xFFFF : tailmask16(remainder * 2);
+    const uint16_t maskb = remainder > 8 ? tailmask16(remainder * 2) : 0;
+    const f512 uva = loadmask16f(uv + j, maska);
+    const f512 uvb = loadmask16f(uv + j + 16, maskb);
+    const uint16_t mask = tailmask16(remainder);
+    storemask16f(u + i, mask, permute2x16f(uva, uindices, uvb));
+    storemask16f(v + i, mask, permute2x16f(uva, vindices, uvb));
+  }
+  return;
+# else
+
+#  if defined(__AVX2__)
+  const size_t count8 = count & ~size_t(7);
+  for(; i < count8; i += 8, j += 16)
+  {
+    const f256 uva = loadu8f(uv + j);
+    const f256 uvb = loadu8f(uv + j + 8);
+    const f256 uva1 = permute2f128(uva, uvb, 0x20);
+    const f256 uvb1 = permute2f128(uva, uvb, 0x31);
+    const f256 uvals = shuffle8f(uva1, uvb1, 2, 0, 2, 0);
+    const f256 vvals = shuffle8f(uva1, uvb1, 3, 1, 3, 1);
+    storeu8f(u + i, uvals);
+    storeu8f(v + i, vvals);
+  }
+#  endif
+
+  const size_t count4 = count & ~size_t(3);
+  for(; i < count4; i += 4, j += 8)
+  {
+    const f128 uva = loadu4f(uv + j);
+    const f128 uvb = loadu4f(uv + j + 4);
+    const f128 uvals = shuffle4f(uva, uvb, 2, 0, 2, 0);
+    const f128 vvals = shuffle4f(uva, uvb, 3, 1, 3, 1);
+    storeu4f(u + i, uvals);
+    storeu4f(v + i, vvals);
+  }
+
+  switch(count & 3)
+  {
+  case 3:
+    u[i + 2] = uv[j + 4];
+    v[i + 2] = uv[j + 5];
+  case 2:
+    u[i + 1] = uv[j + 2];
+    v[i + 1] = uv[j + 3];
+  case 1:
+    u[i] = uv[j];
+    v[i] = uv[j + 1];
+  default:
+    break;
+  }
+# endif
+#else
+  for(size_t i = 0, j = 0; i < count; ++i, j += 2)
+  {
+    u[i] = uv[j];
+    v[i] = uv[j + 1];
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void zipUVs(const float* u, const float* v, float* uv, const size_t count)
+{
+#if defined(__SSE__)
+  size_t i = 0;
+
+# if AL_SIMD_ENABLE_AVX512
+  static const i512 loindices = set16i(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+  static const i512 hiindices = set16i(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+  const size_t count16 = count & ~size_t(15);
+  for(; i < count16; i += 16, uv += 32)
+  {
+    const f512 U = loadu16f(u + i);
+    const f512 V = loadu16f(v + i);
+    storeu16f(uv, permute2x16f(U, loindices, V));
+    storeu16f(uv + 16, permute2x16f(U, hiindices, V));
+  }
+
+  // the remaining 1 to 15 UVs are handled with masked loads & stores
+  const size_t remainder = count & 15;
+  if(remainder)
+  {
+    const uint16_t mask = tailmask16(remainder);
+    const f512 U = loadmask16f(u + i, mask);
+    const f512 V = loadmask16f(v + i, mask);
+    storemask16f(uv, remainder >= 8 ? 0xFFFF : tailmask16(remainder * 2), permute2x16f(U, loindices, V));
+    storemask16f(uv + 16, remainder > 8 ? tailmask16(remainder * 2) : 0, permute2x16f(U, hiindices, V));
+  }
+  return;
+# else
+
+#  if defined(__AVX2__)
+  const size_t count8 = count & ~size_t(7);
+  for(; i < count8; i += 8, uv += 16)
+  {
+    const f256 U = loadu8f(u + i);
+    const f256 V = loadu8f(v + i);
+    const f256 uv0 = unpacklo8f(U, V);
+    const f256 uv1 = unpackhi8f(U, V);
+    storeu8f(uv, permute2f128(uv0, uv1, 0x20));
+    storeu8f(uv + 8, permute2f128(uv0, uv1, 0x31));
+  }
+#  endif
+
+  const size_t count4 = count & ~size_t(3);
+  for(; i < count4; i += 4, uv += 8)
+  {
+    const f128 U = loadu4f(u + i);
+    const f128 V = loadu4f(v + i);
+    storeu4f(uv, unpacklo4f(U, V));
+    storeu4f(uv + 4, unpackhi4f(U, V));
+  }
+
+  switch(count & 3)
+  {
+  case 3:
+    uv[4] = u[i + 2];
+    uv[5] = v[i + 2];
+  case 2:
+    uv[2] = u[i + 1];
+    uv[3] = v[i + 1];
+  case 1:
+    uv[0] = u[i + 0];
+    uv[1] = v[i + 0];
+  default:
+    break;
+  }
+# endif
+#else
+  for(size_t i = 0, j = 0; i < count; i++, j += 2)
+  {
+    uv[j] = u[i];
+    uv[j + 1] = v[i];
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void interleaveIndexedUvData(float* output, const float* u, const float* v, const int32_t* indices, const uint32_t numIndices)
+{
+#if defined(__SSE__)
+
+#if AL_SIMD_ENABLE_AVX512
+
+  static const i512 loindices = set16i(0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+  static const i512 hiindices = set16i(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+  const uint32_t numIndices16 = numIndices & ~15U;
+  uint32_t i = 0;
+  for(; i < numIndices16; i += 16, output += 32)
+  {
+    const i512 I = loadu16i(indices + i);
+    const f512 U = i32gather16f(u, I);
+    const f512 V = i32gather16f(v, I);
+    storeu16f(output, permute2x16f(U, loindices, V));
+    storeu16f(output + 16, permute2x16f(U, hiindices, V));
+  }
+
+  // the remaining 1 to 15 indices are handled with masked loads, gathers & stores
+  const uint32_t remainder = numIndices & 15;
+  if(remainder)
+  {
+    const uint16_t mask = tailmask16(remainder);
+    const i512 I = loadmask16i(indices + i, mask);
+    const f512 U = i32gathermask16f(u, I, mask);
+    const f512 V = i32gathermask16f(v, I, mask);
+    storemask16f(output, remainder >= 8 ? 0xFFFF : tailmask16(remainder * 2), permute2x16f(U, loindices, V));
+    storemask16f(output + 16, remainder > 8 ? tailmask16(remainder * 2) : 0, permute2x16f(U, hiindices, V));
+  }
+  return;
+
+#elif defined(__AVX2__)
+
+  const uint32_t numIndices8 = numIndices & ~7U;
+  uint32_t i = 0;
+  for(; i < numIndices8; i += 8, output += 16)
+  {
+    const i256 I = loadu8i(indices + i);
+    const f256 U = i32gather8f(u, I);
+    const f256 V = i32gather8f(v, I);
+    const f256 uv0 = unpacklo8f(U, V);
+    const f256 uv1 = unpackhi8f(U, V);
+    storeu8f(output, permute2f128(uv0, uv1, 0x20));
+    storeu8f(output + 8, permute2f128(uv0, uv1, 0x31));
+  }
+
+  if(numIndices & 0x4)
+  {
+    const i128 I = loadu4i(indices + i);
+    const f128 U = i32gather4f(u, I);
+    const f128 V = i32gather4f(v, I);
+    const f128 uv0 = unpacklo4f(U, V);
+    const f128 uv1 = unpackhi4f(U, V);
+    storeu4f(output, uv0);
+    storeu4f(output + 4, uv1);
+    output += 8;
+    i += 4;
+  }
+
+#else
+
+  const i128 uptr = splat2i64(intptr_t(u));
+  const i128 vptr = splat2i64(intptr_t(v));
+  const i128 mask = set4i(0xFFFFFFFF, 0, 0xFFFFFFFF, 0);
+
+  const uint32_t numIndices4 = numIndices & ~3U;
+  uint32_t i = 0;
+  for(; i < numIndices4; i += 4, output += 8)
+  {
+    // load 4 indices
+    const i128 I = loadu4i(indices + i);
+
+    // mask out into 2 pairs of 64 bit indices, and scale values by 4 (using shift)
+    const i128 I02 = lshift64(and4i(mask, I), 2);
+    const i128 I13 = lshift64(and4i(mask, shiftBytesRight(I, 4)), 2);
+
+    // get addresses by adding the base offset
+    const i128 U02 = add2i64(I02, uptr);
+    const i128 U13 = add2i64(I13, uptr);
+    const i128 V02 = add2i64(I02, vptr);
+    const i128 V13 = add2i64(I13, vptr);
+
+    #ifndef __SSE4_1__
+    ALIGN16(float* ptrs[8]);
+    store4i(ptrs    , U02);
+    store4i(ptrs + 2, U13);
+    store4i(ptrs + 4, V02);
+    store4i(ptrs + 6, V13);
+
+    const f128 u0 = load1f(ptrs[0]);
+    const f128 u2 = load1f(ptrs[1]);
+    const f128 u1 = load1f(ptrs[2]);
+    const f128 u3 = load1f(ptrs[3]);
+    const f128 v0 = load1f(ptrs[4]);
+    const f128 v2 = load1f(ptrs[5]);
+    const f128 v1 = load1f(ptrs[6]);
+    const f128 v3 = load1f(ptrs[7]);
+    #else
+    #define extract_float_ptr(reg, index) reinterpret_cast<const float*>(_mm_extract_epi64(reg, index))
+    const f128 u0 = load1f(extract_float_ptr(U02, 0));
+    const f128 u2 = load1f(extract_float_ptr(U02, 1));
+    const f128 u1 = load1f(extract_float_ptr(U13, 0));
+    const f128 u3 = load1f(extract_float_ptr(U13, 1));
+    const f128 v0 = load1f(extract_float_ptr(V02, 0));
+    const f128 v2 = load1f(extract_float_ptr(V02, 1));
+    const f128 v1 = load1f(extract_float_ptr(V13, 0));
+    const f128 v3 = load1f(extract_float_ptr(V13, 1));
+    #undef extract_float_ptr
+    #endif
+
+    const f128 uv0 = unpacklo4f(u0, v0);
+    const f128 uv1 = unpacklo4f(u1, v1);
+    storeu4f(output, movelh4f(uv0, uv1));
+
+    const f128 uv2 = unpacklo4f(u2, v2);
+    const f128 uv3 = unpacklo4f(u3, v3);
+    storeu4f(output + 4, movelh4f(uv2, uv3));
+  }
+
+#endif
+
+  switch(numIndices & 0x3)
+  {
+  case 3: output[4] = u[indices[i + 2]];
+          output[5] = v[indices[i + 2]];
+  case 2: output[2] = u[indices[i + 1]];
+          output[3] = v[indices[i + 1]];
+  case 1: output[0] = u[indices[i]];
+          output[1] = v[indices[i]];
+  default: break;
+  }
+
+#else
+
+  for(uint32_t i = 0, j = 0; i < numIndices; ++i, j += 2)
+  {
+    output[j] = u[indices[i]];
+    output[j + 1] = v[indices[i]];
+  }
+
+#endif
+}
+
+} // anon
+
+//----------------------------------------------------------------------------------------------------------------------
+extern const MeshUtilsKernels meshUtilsKernels =
+{
+  convert3DArrayTo4DArray,
+  unzipUVs,
+  zipUVs,
+  interleaveIndexedUvData
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // AL_SIMD_NAMESPACE
+} // utils
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
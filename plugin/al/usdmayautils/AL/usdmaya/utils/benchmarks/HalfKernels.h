@@ -0,0 +1,50 @@
+//
+// Copyright 2019 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "pxr/pxr.h"
+#include "pxr/base/gf/half.h"
+
+#include <cstddef>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace AL {
+namespace usdmaya {
+namespace utils {
+namespace benchmarks {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  Array conversions using the ALHalf.h methods, built for a single instruction set (see HalfKernels.inl)
+//----------------------------------------------------------------------------------------------------------------------
+struct HalfKernels
+{
+  void (*halfToFloat)(const GfHalf*, float*, size_t);
+  void (*halfToDouble)(const GfHalf*, double*, size_t);
+};
+
+namespace sse { extern const HalfKernels halfKernels; }
+namespace avx2 { extern const HalfKernels halfKernels; }
+#if AL_SIMD_HAS_AVX512
+namespace avx512 { extern const HalfKernels halfKernels; }
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+} // benchmarks
+} // utils
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,73 @@
+//
+// Copyright 2019 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usd/utils/ALHalf.h"
+#include "HalfKernels.h"
+
+#ifndef AL_SIMD_NAMESPACE
+# error "AL_SIMD_NAMESPACE must be defined when compiling the half kernels"
+#endif
+
+namespace AL {
+namespace usdmaya {
+namespace utils {
+namespace benchmarks {
+namespace AL_SIMD_NAMESPACE {
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+void halfToFloat(const GfHalf* const input, float* const output, const size_t count)
+{
+  size_t i = 0;
+  for(const size_t count8 = count & ~size_t(7); i < count8; i += 8)
+  {
+    usd::utils::half2float_8f(input + i, output + i);
+  }
+  for(; i < count; ++i)
+  {
+    output[i] = usd::utils::half2float_1f(input[i]);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void halfToDouble(const GfHalf* const input, double* const output, const size_t count)
+{
+  size_t i = 0;
+  for(const size_t count8 = count & ~size_t(7); i < count8; i += 8)
+  {
+    usd::utils::half2double_8f(input + i, output + i);
+  }
+  for(; i < count; ++i)
+  {
+    output[i] = usd::utils::half2double_1f(input[i]);
+  }
+}
+
+} // anon
+
+//----------------------------------------------------------------------------------------------------------------------
+extern const HalfKernels halfKernels =
+{
+  halfToFloat,
+  halfToDouble
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+} // AL_SIMD_NAMESPACE
+} // benchmarks
+} // utils
+} // usdmaya
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
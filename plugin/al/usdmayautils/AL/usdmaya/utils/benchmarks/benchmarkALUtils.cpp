@@ -0,0 +1,567 @@
+//
+// Copyright 2019 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \file   benchmarkALUtils.cpp
+/// \brief  Measures the throughput of the SIMD kernels (DiffCore, the MeshUtils array conversions, and the half float
+///         conversions) on synthetic arrays, for each instruction set the CPU supports. Each kernel is run on aligned
+///         (64 byte) and unaligned (offset by 4 bytes) arrays, and the results are written as JSON, so that they can be
+///         compared across compiler and instruction set changes. No Maya session is required.
+//----------------------------------------------------------------------------------------------------------------------
+#include "AL/usd/utils/CpuFeatures.h"
+#include "AL/usd/utils/DiffCore.h"
+#include "AL/usdmaya/utils/MeshUtils.h"
+#include "HalfKernels.h"
+
+#include "pxr/base/gf/vec2f.h"
+#include "pxr/base/vt/array.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+# include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+#endif
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+using AL::usd::utils::SimdLevel;
+
+namespace {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// the builds of the half conversions, indexed by SimdLevel
+const AL::usdmaya::utils::benchmarks::HalfKernels* const g_halfKernels[] =
+{
+  &AL::usdmaya::utils::benchmarks::sse::halfKernels,
+  &AL::usdmaya::utils::benchmarks::avx2::halfKernels,
+#if AL_SIMD_HAS_AVX512
+  &AL::usdmaya::utils::benchmarks::avx512::halfKernels
+#else
+  &AL::usdmaya::utils::benchmarks::avx2::halfKernels
+#endif
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  the command line options
+//----------------------------------------------------------------------------------------------------------------------
+struct Options
+{
+  std::vector<size_t> sizes = { 1000, 64000, 1000000, 16000000, 50000000 };
+  double minTime = 0.25;
+  std::string filter;
+  std::string output;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  the timings for a single kernel / instruction set / array size / alignment
+//----------------------------------------------------------------------------------------------------------------------
+struct Result
+{
+  std::string name;
+  const char* isa;
+  size_t elements;
+  bool aligned;
+  double bytesPerIteration;
+  uint64_t iterations;
+  double seconds;
+  uint64_t cycles;
+};
+
+/// the results of the boolean kernels are accumulated here so that the calls can't be optimised away
+volatile uint32_t g_sink = 0;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  reads the time stamp counter. Note that this counts at the nominal frequency of the CPU, so cycles/element
+///         will be skewed if the clock is boosted or throttled during the run.
+//----------------------------------------------------------------------------------------------------------------------
+inline uint64_t readCycleCounter()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  an array of count elements, that is either 64 byte aligned, or offset 4 bytes from a 64 byte boundary
+//----------------------------------------------------------------------------------------------------------------------
+template<typename T>
+class TestArray
+{
+public:
+  TestArray(const size_t count, const bool aligned)
+    : m_storage(count * sizeof(T) + 128), m_count(count)
+  {
+    uintptr_t ptr = (uintptr_t(m_storage.data()) + 63) & ~uintptr_t(63);
+    if(!aligned)
+    {
+      ptr += sizeof(float);
+    }
+    m_data = reinterpret_cast<T*>(ptr);
+  }
+
+  T* data() { return m_data; }
+  T& operator [] (const size_t i) { return m_data[i]; }
+  size_t size() const { return m_count; }
+
+private:
+  std::vector<uint8_t> m_storage;
+  T* m_data;
+  size_t m_count;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  a random float in the range [-1, 1]
+//----------------------------------------------------------------------------------------------------------------------
+inline float randFloat()
+{
+  return float(rand()) / RAND_MAX * 2.0f - 1.0f;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  runs the kernel repeatedly until at least minTime seconds have passed
+//----------------------------------------------------------------------------------------------------------------------
+class Benchmarker
+{
+public:
+  explicit Benchmarker(const Options& options)
+    : m_options(options) {}
+
+  /// \brief  the instruction sets that the dispatched kernels are run with
+  std::vector<SimdLevel> levels() const
+  {
+    std::vector<SimdLevel> result;
+    for(uint32_t i = 0; i <= uint32_t(AL::usd::utils::supportedSimdLevel()); ++i)
+    {
+      result.push_back(SimdLevel(i));
+    }
+    return result;
+  }
+
+  /// \brief  returns true if the benchmark with the given name should be run
+  bool enabled(const char* const name) const
+  {
+    return m_options.filter.empty() || std::strstr(name, m_options.filter.c_str());
+  }
+
+  /// \brief  times the kernel, and records the result
+  /// \param  name the name of the kernel
+  /// \param  level the instruction set the kernel was built for
+  /// \param  elements the number of elements processed by each call to the kernel
+  /// \param  aligned true if the arrays passed to the kernel are aligned
+  /// \param  bytesPerIteration the number of bytes read & written by each call to the kernel
+  /// \param  kernel the kernel to time
+  void run(const char* const name, const SimdLevel level, const size_t elements, const bool aligned,
+           const double bytesPerIteration, const std::function<void()>& kernel)
+  {
+    // warm up the caches (for the small sizes), and fault in the pages of the output arrays
+    kernel();
+
+    uint64_t iterations = 0;
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t startCycles = readCycleCounter();
+    double seconds = 0;
+    do
+    {
+      kernel();
+      ++iterations;
+      seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    while(seconds < m_options.minTime);
+    const uint64_t cycles = readCycleCounter() - startCycles;
+
+    Result result = { name, AL::usd::utils::simdLevelName(level), elements, aligned, bytesPerIteration, iterations, seconds, cycles };
+    m_results.push_back(result);
+
+    std::fprintf(stderr, "%-32s %-7s %10zu %-9s %9.3f GB/s %9.3f cycles/element\n",
+                 name, result.isa, elements, aligned ? "aligned" : "unaligned",
+                 gigabytesPerSecond(result), cyclesPerElement(result));
+  }
+
+  /// \brief  writes the results as JSON
+  void writeJson(FILE* const fp) const
+  {
+    std::fprintf(fp, "{\n");
+    std::fprintf(fp, "  \"context\": {\n");
+#if defined(__clang__)
+    std::fprintf(fp, "    \"compiler\": \"clang %s\",\n", __clang_version__);
+#elif defined(__GNUC__)
+    std::fprintf(fp, "    \"compiler\": \"gcc %s\",\n", __VERSION__);
+#elif defined(_MSC_VER)
+    std::fprintf(fp, "    \"compiler\": \"msvc %d\",\n", _MSC_FULL_VER);
+#else
+    std::fprintf(fp, "    \"compiler\": \"unknown\",\n");
+#endif
+    std::fprintf(fp, "    \"supportedSimdLevel\": \"%s\",\n", AL::usd::utils::simdLevelName(AL::usd::utils::supportedSimdLevel()));
+    std::fprintf(fp, "    \"minTime\": %g\n", m_options.minTime);
+    std::fprintf(fp, "  },\n");
+    std::fprintf(fp, "  \"benchmarks\": [");
+    for(size_t i = 0; i < m_results.size(); ++i)
+    {
+      const Result& r = m_results[i];
+      std::fprintf(fp, "%s\n    {\"name\": \"%s\", \"isa\": \"%s\", \"elements\": %zu, \"aligned\": %s, "
+                       "\"iterations\": %llu, \"seconds\": %.6f, \"bytesPerIteration\": %.0f, "
+                       "\"gbPerSecond\": %.4f, \"cyclesPerElement\": %.4f}",
+                   i ? "," : "", r.name.c_str(), r.isa, r.elements, r.aligned ? "true" : "false",
+                   (unsigned long long)r.iterations, r.seconds, r.bytesPerIteration,
+                   gigabytesPerSecond(r), cyclesPerElement(r));
+    }
+    std::fprintf(fp, "\n  ]\n}\n");
+  }
+
+private:
+  static double gigabytesPerSecond(const Result& r)
+  {
+    return r.bytesPerIteration * r.iterations / r.seconds * 1e-9;
+  }
+
+  static double cyclesPerElement(const Result& r)
+  {
+    return r.elements ? double(r.cycles) / (double(r.iterations) * r.elements) : 0.0;
+  }
+
+  const Options& m_options;
+  std::vector<Result> m_results;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+void benchmarkVec3AreAllTheSame(Benchmarker& bench, const size_t count, const bool aligned)
+{
+  if(!bench.enabled("vec3AreAllTheSame"))
+    return;
+
+  // all of the same value, so that the whole array is scanned
+  TestArray<float> points(count * 3, aligned);
+  for(size_t i = 0; i < count * 3; i += 3)
+  {
+    points[i] = 1.0f;
+    points[i + 1] = 2.0f;
+    points[i + 2] = 3.0f;
+  }
+  for(SimdLevel level : bench.levels())
+  {
+    AL::usd::utils::setActiveSimdLevel(level);
+    bench.run("vec3AreAllTheSame", level, count, aligned, count * 3.0 * sizeof(float), [&]() {
+      g_sink += AL::usd::utils::vec3AreAllTheSame(points.data(), count);
+    });
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void benchmarkCompareArray(Benchmarker& bench, const size_t count, const bool aligned)
+{
+  if(bench.enabled("compareArray(float)"))
+  {
+    TestArray<float> a(count, aligned), b(count, aligned);
+    for(size_t i = 0; i < count; ++i)
+    {
+      a[i] = b[i] = randFloat();
+    }
+    for(SimdLevel level : bench.levels())
+    {
+      AL::usd::utils::setActiveSimdLevel(level);
+      bench.run("compareArray(float)", level, count, aligned, count * 2.0 * sizeof(float), [&]() {
+        g_sink += AL::usd::utils::compareArray(a.data(), b.data(), count, count, 1e-5f);
+      });
+    }
+  }
+
+  if(bench.enabled("compareArray(double)"))
+  {
+    TestArray<double> a(count, aligned), b(count, aligned);
+    for(size_t i = 0; i < count; ++i)
+    {
+      a[i] = b[i] = randFloat();
+    }
+    for(SimdLevel level : bench.levels())
+    {
+      AL::usd::utils::setActiveSimdLevel(level);
+      bench.run("compareArray(double)", level, count, aligned, count * 2.0 * sizeof(double), [&]() {
+        g_sink += AL::usd::utils::compareArray(a.data(), b.data(), count, count, 1e-5);
+      });
+    }
+  }
+
+  if(bench.enabled("compareArray(half,float)"))
+  {
+    TestArray<GfHalf> a(count, aligned);
+    TestArray<float> b(count, aligned);
+    for(size_t i = 0; i < count; ++i)
+    {
+      a[i] = GfHalf(randFloat());
+      b[i] = float(a[i]);
+    }
+    for(SimdLevel level : bench.levels())
+    {
+      AL::usd::utils::setActiveSimdLevel(level);
+      bench.run("compareArray(half,float)", level, count, aligned, count * double(sizeof(GfHalf) + sizeof(float)), [&]() {
+        g_sink += AL::usd::utils::compareArray(a.data(), b.data(), count, count, 1e-5f);
+      });
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void benchmarkUvs(Benchmarker& bench, const size_t count, const bool aligned)
+{
+  if(!bench.enabled("compareUvArray") && !bench.enabled("zipUVs") && !bench.enabled("unzipUVs") &&
+     !bench.enabled("interleaveIndexedUvData"))
+    return;
+
+  TestArray<float> u(count, aligned), v(count, aligned), uv(count * 2, aligned), interleaved(count * 2, aligned);
+  TestArray<int32_t> indices(count, aligned);
+  for(size_t i = 0; i < count; ++i)
+  {
+    u[i] = uv[i * 2] = randFloat();
+    v[i] = uv[i * 2 + 1] = randFloat();
+    indices[i] = int32_t(rand() % count);
+  }
+  const double uvBytes = count * 4.0 * sizeof(float);
+
+  for(SimdLevel level : bench.levels())
+  {
+    AL::usd::utils::setActiveSimdLevel(level);
+    if(bench.enabled("compareUvArray"))
+    {
+      bench.run("compareUvArray", level, count, aligned, uvBytes, [&]() {
+        g_sink += AL::usd::utils::compareUvArray(u.data(), v.data(), uv.data(), count, count, 1e-5f);
+      });
+    }
+    if(bench.enabled("zipUVs"))
+    {
+      bench.run("zipUVs", level, count, aligned, uvBytes, [&]() {
+        AL::usdmaya::utils::zipUVs(u.data(), v.data(), uv.data(), count);
+      });
+    }
+    if(bench.enabled("unzipUVs"))
+    {
+      bench.run("unzipUVs", level, count, aligned, uvBytes, [&]() {
+        AL::usdmaya::utils::unzipUVs(uv.data(), u.data(), v.data(), count);
+      });
+    }
+    if(bench.enabled("interleaveIndexedUvData"))
+    {
+      bench.run("interleaveIndexedUvData", level, count, aligned, uvBytes + count * sizeof(int32_t), [&]() {
+        AL::usdmaya::utils::interleaveIndexedUvData(interleaved.data(), u.data(), v.data(), indices.data(), uint32_t(count));
+      });
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void benchmarkConvert3DArrayTo4DArray(Benchmarker& bench, const size_t count, const bool aligned)
+{
+  if(!bench.enabled("convert3DArrayTo4DArray"))
+    return;
+
+  TestArray<float> points3(count * 3, aligned), points4(count * 4, aligned);
+  for(size_t i = 0; i < count * 3; ++i)
+  {
+    points3[i] = randFloat();
+  }
+  for(SimdLevel level : bench.levels())
+  {
+    AL::usd::utils::setActiveSimdLevel(level);
+    bench.run("convert3DArrayTo4DArray", level, count, aligned, count * 7.0 * sizeof(float), [&]() {
+      AL::usdmaya::utils::convert3DArrayTo4DArray(points3.data(), points4.data(), count);
+    });
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void benchmarkHalfConversions(Benchmarker& bench, const size_t count, const bool aligned)
+{
+  if(!bench.enabled("half2float_8f") && !bench.enabled("half2double_8f"))
+    return;
+
+  TestArray<GfHalf> halfs(count, aligned);
+  TestArray<float> floats(count, aligned);
+  TestArray<double> doubles(count, aligned);
+  for(size_t i = 0; i < count; ++i)
+  {
+    halfs[i] = GfHalf(randFloat());
+  }
+  for(SimdLevel level : bench.levels())
+  {
+    const AL::usdmaya::utils::benchmarks::HalfKernels& kernels = *g_halfKernels[uint32_t(level)];
+    if(bench.enabled("half2float_8f"))
+    {
+      bench.run("half2float_8f", level, count, aligned, count * double(sizeof(GfHalf) + sizeof(float)), [&]() {
+        kernels.halfToFloat(halfs.data(), floats.data(), count);
+      });
+    }
+    if(bench.enabled("half2double_8f"))
+    {
+      bench.run("half2double_8f", level, count, aligned, count * double(sizeof(GfHalf) + sizeof(double)), [&]() {
+        kernels.halfToDouble(halfs.data(), doubles.data(), count);
+      });
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The parts of MeshExportContext::copyUvSetData that don't require Maya, for a face varying UV set of quads:
+///         the sparse check on the uv counts, and zipping the Maya u & v arrays into the VtArray written to USD.
+//----------------------------------------------------------------------------------------------------------------------
+void benchmarkCopyUvSetData(Benchmarker& bench, const size_t count, const bool aligned)
+{
+  if(!bench.enabled("copyUvSetData"))
+    return;
+
+  const size_t numFaces = count / 4;
+  TestArray<int32_t> uvCounts(numFaces, aligned);
+  TestArray<float> u(count, aligned), v(count, aligned);
+  for(size_t i = 0; i < numFaces; ++i)
+  {
+    uvCounts[i] = 4;
+  }
+  for(size_t i = 0; i < count; ++i)
+  {
+    u[i] = randFloat();
+    v[i] = randFloat();
+  }
+  const double bytes = numFaces * double(sizeof(int32_t)) + count * 4.0 * sizeof(float);
+
+  for(SimdLevel level : bench.levels())
+  {
+    AL::usd::utils::setActiveSimdLevel(level);
+    bench.run("copyUvSetData", level, count, aligned, bytes, [&]() {
+      if(!AL::usdmaya::utils::isUvSetDataSparse(uvCounts.data(), uint32_t(numFaces)))
+      {
+        VtArray<GfVec2f> uvValues(count);
+        AL::usdmaya::utils::zipUVs(u.data(), v.data(), (float*)uvValues.data(), count);
+        g_sink += uvValues.size() != 0;
+      }
+    });
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void printUsage()
+{
+  std::fprintf(stderr,
+    "usage: benchmarkALUtils [--sizes N,N,...] [--min-time SECONDS] [--filter NAME] [--output FILE.json]\n"
+    "  --sizes     the numbers of elements to run each kernel on (default 1000,64000,1000000,16000000,50000000)\n"
+    "  --min-time  the minimum time to run each kernel for (default 0.25)\n"
+    "  --filter    only run the kernels whose name contains NAME\n"
+    "  --output    the file to write the JSON results to (default stdout)\n");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool parseOptions(int argc, char** argv, Options& options)
+{
+  for(int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if(arg == "--help" || arg == "-h" || i + 1 == argc)
+    {
+      return false;
+    }
+    const char* const value = argv[++i];
+    if(arg == "--sizes")
+    {
+      options.sizes.clear();
+      for(const char* s = value; *s; )
+      {
+        char* end = nullptr;
+        const unsigned long long size = std::strtoull(s, &end, 10);
+        if(end == s || !size)
+        {
+          return false;
+        }
+        options.sizes.push_back(size_t(size));
+        s = *end == ',' ? end + 1 : end;
+      }
+    }
+    else
+    if(arg == "--min-time")
+    {
+      options.minTime = std::atof(value);
+    }
+    else
+    if(arg == "--filter")
+    {
+      options.filter = value;
+    }
+    else
+    if(arg == "--output")
+    {
+      options.output = value;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return !options.sizes.empty();
+}
+
+} // anon
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  Options options;
+  if(!parseOptions(argc, argv, options))
+  {
+    printUsage();
+    return 1;
+  }
+
+  const SimdLevel active = AL::usd::utils::activeSimdLevel();
+  Benchmarker bench(options);
+  srand(1);
+  for(size_t size : options.sizes)
+  {
+    for(bool aligned : { true, false })
+    {
+      benchmarkVec3AreAllTheSame(bench, size, aligned);
+      benchmarkCompareArray(bench, size, aligned);
+      benchmarkUvs(bench, size, aligned);
+      benchmarkConvert3DArrayTo4DArray(bench, size, aligned);
+      benchmarkHalfConversions(bench, size, aligned);
+      benchmarkCopyUvSetData(bench, size, aligned);
+    }
+  }
+  AL::usd::utils::setActiveSimdLevel(active);
+
+  FILE* fp = stdout;
+  if(!options.output.empty())
+  {
+    fp = std::fopen(options.output.c_str(), "w");
+    if(!fp)
+    {
+      std::fprintf(stderr, "unable to write to %s\n", options.output.c_str());
+      return 1;
+    }
+  }
+  bench.writeJson(fp);
+  if(fp != stdout)
+  {
+    std::fclose(fp);
+  }
+  return 0;
+}
@@ -20,7 +20,9 @@
 ///         The Intel Ivy Bridge CPUs actually implemented float <-> conversions in hardware via the vcvtps2ph and
 ///         vcvtph2ps instructions (which convert 8 floats at a time with a latency of 4 or 5 cycles). This header file
 ///         provides some methods to convert between half/float and half/double using the F16C conversion intrinsics.
-///         To enable HW conversions, pass the compiler flag -mf16c to clang or gcc.
+///         To enable HW conversions, pass the compiler flag -mf16c to clang or gcc. The methods are declared within
+///         the instruction set specific namespace from SIMD.h, since the kernels built with al_add_simd_kernels will
+///         have F16C enabled even when the rest of the library does not.
 //----------------------------------------------------------------------------------------------------------------------
 
 #pragma once
@@ -29,12 +31,14 @@
 #endif
 #include "pxr/base/gf/half.h"
 #include "pxr/base/gf/ilmbase_half.h"
+#include "AL/usd/utils/SIMD.h"
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
 namespace AL {
 namespace usd {
 namespace utils {
+inline namespace AL_SIMD_ISA_NAMESPACE {
 
 #ifdef __F16C__
 
@@ -194,7 +198,7 @@ inline void half2double_4f(const GfHalf input[4], double out[4])
 }
 
 /// convert half to float
-inline double half2fdouble_1f(const GfHalf h)
+inline double half2double_1f(const GfHalf h)
 {
   return double(float(h));
 }
@@ -256,6 +260,7 @@ inline GfHalf double2half_1f(const double f)
 }
 #endif
 
+} // AL_SIMD_ISA_NAMESPACE
 } // utils
 } // usd
 } // AL
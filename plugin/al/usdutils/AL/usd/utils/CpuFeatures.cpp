@@ -0,0 +1,186 @@
+//
+// Copyright 2019 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "AL/usd/utils/CpuFeatures.h"
+#include "AL/usd/utils/DebugCodes.h"
+
+#include "pxr/base/tf/envSetting.h"
+
+#include <atomic>
+#include <string>
+
+#if defined(_MSC_VER)
+# include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+# include <cpuid.h>
+#endif
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+TF_DEFINE_ENV_SETTING(AL_USD_UTILS_SIMD_LEVEL, "",
+                      "Limits the SIMD kernels used by AL_USDUtils to the given instruction set (sse, avx2 or avx512)");
+
+namespace AL {
+namespace usd {
+namespace utils {
+
+namespace {
+
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+//----------------------------------------------------------------------------------------------------------------------
+void cpuid(const uint32_t leaf, const uint32_t subleaf, uint32_t info[4])
+{
+#if defined(_MSC_VER)
+  __cpuidex((int*)info, leaf, subleaf);
+#else
+  __cpuid_count(leaf, subleaf, info[0], info[1], info[2], info[3]);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint64_t xgetbv()
+{
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (uint64_t(edx) << 32) | eax;
+#endif
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+SimdLevel detectSimdLevel()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+  uint32_t info[4];
+  cpuid(0, 0, info);
+  if(info[0] < 7)
+  {
+    return SimdLevel::kSSE;
+  }
+
+  // AVX, FMA and F16C, and the OS must be using xsave to preserve the registers
+  cpuid(1, 0, info);
+  const uint32_t avxFeatures = (1U << 12) | (1U << 27) | (1U << 28) | (1U << 29);
+  if((info[2] & avxFeatures) != avxFeatures)
+  {
+    return SimdLevel::kSSE;
+  }
+
+  // the OS must save the XMM and YMM registers on a context switch
+  const uint64_t xcr0 = xgetbv();
+  if((xcr0 & 0x6) != 0x6)
+  {
+    return SimdLevel::kSSE;
+  }
+
+  cpuid(7, 0, info);
+  if(!(info[1] & (1U << 5)))
+  {
+    return SimdLevel::kSSE;
+  }
+
+  // AVX-512 F, DQ, BW and VL, and the OS must also save the opmask and ZMM registers
+  const uint32_t avx512Features = (1U << 16) | (1U << 17) | (1U << 30) | (1U << 31);
+  if((info[1] & avx512Features) == avx512Features && (xcr0 & 0xE6) == 0xE6)
+  {
+    return SimdLevel::kAVX512;
+  }
+  return SimdLevel::kAVX2;
+#else
+  return SimdLevel::kSSE;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+SimdLevel initialSimdLevel()
+{
+  SimdLevel level = supportedSimdLevel();
+  const std::string requested = TfGetEnvSetting(AL_USD_UTILS_SIMD_LEVEL);
+  if(!requested.empty())
+  {
+    for(uint32_t i = 0; i < uint32_t(SimdLevel::kNumLevels); ++i)
+    {
+      if(requested == simdLevelName(SimdLevel(i)))
+      {
+        if(i < uint32_t(level))
+        {
+          level = SimdLevel(i);
+        }
+        break;
+      }
+    }
+  }
+  TF_DEBUG(ALUTILS_INFO).Msg("AL_USDUtils using the %s SIMD kernels\n", simdLevelName(level));
+  return level;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::atomic<uint32_t>& activeLevel()
+{
+  static std::atomic<uint32_t> level(static_cast<uint32_t>(initialSimdLevel()));
+  return level;
+}
+
+} // anon
+
+//----------------------------------------------------------------------------------------------------------------------
+const char* simdLevelName(const SimdLevel level)
+{
+  switch(level)
+  {
+  case SimdLevel::kSSE: return "sse";
+  case SimdLevel::kAVX2: return "avx2";
+  case SimdLevel::kAVX512: return "avx512";
+  default: break;
+  }
+  return "unknown";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+SimdLevel supportedSimdLevel()
+{
+  static const SimdLevel detected = detectSimdLevel();
+#if AL_SIMD_HAS_AVX512
+  return detected;
+#else
+  return detected == SimdLevel::kAVX512 ? SimdLevel::kAVX2 : detected;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+SimdLevel activeSimdLevel()
+{
+  return SimdLevel(activeLevel().load(std::memory_order_relaxed));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool setActiveSimdLevel(const SimdLevel level)
+{
+  if(uint32_t(level) > uint32_t(supportedSimdLevel()))
+  {
+    return false;
+  }
+  activeLevel().store(uint32_t(level), std::memory_order_relaxed);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+} // utils
+} // usd
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
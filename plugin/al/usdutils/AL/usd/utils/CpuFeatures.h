@@ -0,0 +1,77 @@
+//
+// Copyright 2019 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include "./Api.h"
+
+#include <cstdint>
+
+namespace AL {
+namespace usd {
+namespace utils {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The instruction sets that the SIMD kernels (e.g. DiffCore) are compiled for. Each kernel is compiled once
+///         per level, and the build that is used is selected at runtime from the features reported by the CPU, so
+///         that a binary built for the baseline instruction set will still make use of AVX2 or AVX-512 when the
+///         machine supports them.
+//----------------------------------------------------------------------------------------------------------------------
+enum class SimdLevel : uint32_t
+{
+  kSSE, ///< the baseline instruction set the libraries are compiled for
+  kAVX2, ///< AVX2, FMA and F16C (Haswell or later)
+  kAVX512, ///< AVX-512 F, BW, VL and DQ (Skylake-X or later)
+  kNumLevels
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the name of the level, e.g. "avx2"
+/// \param  level the level
+/// \return the name of the level
+//----------------------------------------------------------------------------------------------------------------------
+AL_USD_UTILS_PUBLIC
+const char* simdLevelName(SimdLevel level);
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the highest level that is supported by both the CPU (and OS), and the kernels that were compiled
+///         into the library (the AVX-512 kernels are skipped if the compiler does not support them).
+/// \return the highest usable level
+//----------------------------------------------------------------------------------------------------------------------
+AL_USD_UTILS_PUBLIC
+SimdLevel supportedSimdLevel();
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  returns the level of the kernels that are currently in use. This will be the supportedSimdLevel(), unless
+///         it has been lowered via the AL_USD_UTILS_SIMD_LEVEL environment variable ("sse", "avx2" or "avx512"), or
+///         by setActiveSimdLevel().
+/// \return the level in use
+//----------------------------------------------------------------------------------------------------------------------
+AL_USD_UTILS_PUBLIC
+SimdLevel activeSimdLevel();
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  switches the kernels that are in use (e.g. to compare the results or throughput of each level).
+/// \param  level the level to use
+/// \return false if the level is higher than the supportedSimdLevel(), in which case the active level is unchanged
+//----------------------------------------------------------------------------------------------------------------------
+AL_USD_UTILS_PUBLIC
+bool setActiveSimdLevel(SimdLevel level);
+
+//----------------------------------------------------------------------------------------------------------------------
+} // utils
+} // usd
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,64 @@
+//
+// Copyright 2019 Animal Logic
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace AL {
+namespace usd {
+namespace utils {
+
+//----------------------------------------------------------------------------------------------------------------------
+/// \brief  The DiffCore methods built for a single instruction set (see DiffCoreKernels.inl). This is an internal
+///         header, the methods should be called via DiffCore.h, which selects the build for the activeSimdLevel().
+///         Half values are passed as their raw bits, so that the kernels do not need the (non ISA specific) inline
+///         methods of GfHalf.
+//----------------------------------------------------------------------------------------------------------------------
+struct DiffCoreKernels
+{
+  bool (*vec2AreAllTheSameUV)(const float*, const float*, size_t);
+  bool (*vec2AreAllTheSamef)(const float*, size_t);
+  bool (*vec3AreAllTheSamef)(const float*, size_t);
+  bool (*vec4AreAllTheSamef)(const float*, size_t);
+  bool (*vec2AreAllTheSamed)(const double*, size_t);
+  bool (*vec3AreAllTheSamed)(const double*, size_t);
+  bool (*vec4AreAllTheSamed)(const double*, size_t);
+  bool (*compareArrayHalfFloat)(const uint16_t*, const float*, size_t, size_t, float);
+  bool (*compareArrayHalfDouble)(const uint16_t*, const double*, size_t, size_t, double);
+  bool (*compareArrayDoubleFloat)(const double*, const float*, size_t, size_t, float);
+  bool (*compareArrayDoubleDouble)(const double*, const double*, size_t, size_t, double);
+  bool (*compareArrayFloatFloat)(const float*, const float*, size_t, size_t, float);
+  bool (*compareArrayInt8)(const int8_t*, const int8_t*, size_t, size_t);
+  bool (*compareArrayInt32)(const int32_t*, const int32_t*, size_t, size_t);
+  bool (*compareArray3Dto4D)(const float*, const float*, size_t, size_t, float);
+  bool (*compareArrayFloat3DtoDouble4D)(const float*, const double*, size_t, size_t, float);
+  bool (*compareUvArray)(const float*, const float*, const float*, size_t, size_t, float);
+  bool (*compareUvArrayToConstant)(float, float, const float*, const float*, size_t, float);
+  bool (*compareRGBAArray)(float, float, float, float, const float*, size_t, float);
+};
+
+namespace sse { extern const DiffCoreKernels diffCoreKernels; }
+namespace avx2 { extern const DiffCoreKernels diffCoreKernels; }
+#if AL_SIMD_HAS_AVX512
+namespace avx512 { extern const DiffCoreKernels diffCoreKernels; }
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+} // utils
+} // usd
+} // AL
+//----------------------------------------------------------------------------------------------------------------------
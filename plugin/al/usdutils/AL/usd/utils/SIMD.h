@@ -25,7 +25,7 @@
 
 #include <stdint.h>
 
-#ifdef __AVX2__
+#if defined(__AVX2__) || defined(__AVX512F__)
 # include <immintrin.h>
 #endif
 
@@ -59,7 +59,20 @@
 # define ENABLE_SOME_AVX_ROUTINES 1
 #endif
 
+// Some translation units (the kernels added with al_add_simd_kernels) are compiled for a higher instruction set than
+// the rest of the library, and the appropriate build of those kernels is chosen at runtime (see CpuFeatures.h). Since
+// the inline methods in this file are compiled differently for each instruction set, they live within a namespace
+// specific to the instruction set, so that the linker can never swap the SSE build of a method for the AVX2 build.
+#if defined(__AVX512F__)
+# define AL_SIMD_ISA_NAMESPACE simd_avx512
+#elif defined(__AVX2__)
+# define AL_SIMD_ISA_NAMESPACE simd_avx2
+#else
+# define AL_SIMD_ISA_NAMESPACE simd_sse
+#endif
+
 namespace AL {
+inline namespace AL_SIMD_ISA_NAMESPACE {
 
 #if defined(__SSE__)
 typedef __m128 f128;
@@ -415,4 +428,82 @@ inline f128 loadmask3f(const void* const ptr, size_t count)
 }
 #endif
 
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__)
+# define AL_SIMD_ENABLE_AVX512 1
+typedef __m512 f512;
+typedef __m512i i512;
+typedef __m512d d512;
+
+AL_DLL_HIDDEN inline f512 loadu16f(const void* const ptr) { return _mm512_loadu_ps((const float*)ptr); }
+AL_DLL_HIDDEN inline i512 loadu16i(const void* const ptr) { return _mm512_loadu_si512(ptr); }
+AL_DLL_HIDDEN inline d512 loadu8d(const void* const ptr) { return _mm512_loadu_pd((const double*)ptr); }
+
+AL_DLL_HIDDEN inline void storeu16f(void* const ptr, const f512 reg) { _mm512_storeu_ps((float*)ptr, reg); }
+AL_DLL_HIDDEN inline void storeu16i(void* const ptr, const i512 reg) { _mm512_storeu_si512(ptr, reg); }
+AL_DLL_HIDDEN inline void storeu8d(void* const ptr, const d512 reg) { _mm512_storeu_pd((double*)ptr, reg); }
+
+/// \brief  returns a mask with the lowest (count % 16) bits set, for use with the masked loads & stores
+AL_DLL_HIDDEN inline uint16_t tailmask16(const size_t count) { return uint16_t((1U << (count & 15)) - 1); }
+/// \brief  returns a mask with the lowest (count % 8) bits set, for use with the masked loads & stores
+AL_DLL_HIDDEN inline uint8_t tailmask8(const size_t count) { return uint8_t((1U << (count & 7)) - 1); }
+/// \brief  returns a mask with the lowest (count % 64) bits set, for use with the masked loads & stores
+AL_DLL_HIDDEN inline uint64_t tailmask64(const size_t count) { return (uint64_t(1) << (count & 63)) - 1; }
+
+/// masked loads. The elements not within the mask are set to zero, and are not read from memory.
+AL_DLL_HIDDEN inline f512 loadmask16f(const void* const ptr, const uint16_t mask) { return _mm512_maskz_loadu_ps(mask, ptr); }
+AL_DLL_HIDDEN inline i512 loadmask16i(const void* const ptr, const uint16_t mask) { return _mm512_maskz_loadu_epi32(mask, ptr); }
+AL_DLL_HIDDEN inline d512 loadmask8d(const void* const ptr, const uint8_t mask) { return _mm512_maskz_loadu_pd(mask, ptr); }
+AL_DLL_HIDDEN inline i512 loadmask64i8(const void* const ptr, const uint64_t mask) { return _mm512_maskz_loadu_epi8(mask, ptr); }
+AL_DLL_HIDDEN inline i256 loadmask16i16(const void* const ptr, const uint16_t mask) { return _mm256_maskz_loadu_epi16(mask, ptr); }
+
+/// masked stores. The elements not within the mask are not written to memory.
+AL_DLL_HIDDEN inline void storemask16f(void* const ptr, const uint16_t mask, const f512 reg) { _mm512_mask_storeu_ps(ptr, mask, reg); }
+
+AL_DLL_HIDDEN inline f512 splat16f(const float f) { return _mm512_set1_ps(f); }
+AL_DLL_HIDDEN inline d512 splat8d(const double f) { return _mm512_set1_pd(f); }
+
+AL_DLL_HIDDEN inline f512 sub16f(const f512 a, const f512 b) { return _mm512_sub_ps(a, b); }
+AL_DLL_HIDDEN inline d512 sub8d(const d512 a, const d512 b) { return _mm512_sub_pd(a, b); }
+
+AL_DLL_HIDDEN inline f512 abs16f(const f512 v) { return _mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(v), _mm512_set1_epi32(0x7FFFFFFF))); }
+AL_DLL_HIDDEN inline d512 abs8d(const d512 v) { return _mm512_castsi512_pd(_mm512_and_epi64(_mm512_castpd_si512(v), _mm512_set1_epi64(0x7FFFFFFFFFFFFFFFLL))); }
+
+/// comparisons, which return a bit mask (rather than a vector register) containing the result for each element
+AL_DLL_HIDDEN inline uint16_t cmpgt16f(const f512 a, const f512 b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+AL_DLL_HIDDEN inline uint8_t cmpgt8d(const d512 a, const d512 b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+AL_DLL_HIDDEN inline uint16_t cmpne16f(const f512 a, const f512 b) { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_OQ); }
+AL_DLL_HIDDEN inline uint16_t cmpne16i(const i512 a, const i512 b) { return _mm512_cmpneq_epi32_mask(a, b); }
+AL_DLL_HIDDEN inline uint64_t cmpne64i8(const i512 a, const i512 b) { return _mm512_cmpneq_epi8_mask(a, b); }
+
+AL_DLL_HIDDEN inline f512 cvtph16(const i256 a) { return _mm512_cvtph_ps(a); }
+AL_DLL_HIDDEN inline f256 cvt8d_to_8f(const d512 reg) { return _mm512_cvtpd_ps(reg); }
+AL_DLL_HIDDEN inline f512 set2f256(const f256 lo, const f256 hi)
+{
+  return _mm512_castpd_ps(_mm512_insertf64x4(_mm512_castpd256_pd512(_mm256_castps_pd(lo)), _mm256_castps_pd(hi), 1));
+}
+
+/// \brief  selects elements from the 32 elements in a and b, using the indices in idx (0 -> 15 select from a,
+///         16 -> 31 select from b)
+AL_DLL_HIDDEN inline f512 permute2x16f(const f512 a, const i512 idx, const f512 b) { return _mm512_permutex2var_ps(a, idx, b); }
+/// \brief  returns the elements of b where the bit in mask is set, and the elements of a otherwise
+AL_DLL_HIDDEN inline f512 select16f(const f512 a, const f512 b, const uint16_t mask) { return _mm512_mask_blend_ps(mask, a, b); }
+AL_DLL_HIDDEN inline f512 i32gather16f(const float* const ptr, const i512 indices) { return _mm512_i32gather_ps(indices, ptr, 4); }
+/// \brief  gathers the elements within the mask, the remaining elements are set to zero (and are not read)
+AL_DLL_HIDDEN inline f512 i32gathermask16f(const float* const ptr, const i512 indices, const uint16_t mask)
+  { return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), mask, indices, ptr, 4); }
+AL_DLL_HIDDEN inline i512 set16i(
+    const int32_t a0, const int32_t b0, const int32_t c0, const int32_t d0,
+    const int32_t a1, const int32_t b1, const int32_t c1, const int32_t d1,
+    const int32_t a2, const int32_t b2, const int32_t c2, const int32_t d2,
+    const int32_t a3, const int32_t b3, const int32_t c3, const int32_t d3)
+  { return _mm512_setr_epi32(a0, b0, c0, d0, a1, b1, c1, d1, a2, b2, c2, d2, a3, b3, c3, d3); }
+AL_DLL_HIDDEN inline f512 set16f(
+    const float a0, const float b0, const float c0, const float d0,
+    const float a1, const float b1, const float c1, const float d1,
+    const float a2, const float b2, const float c2, const float d2,
+    const float a3, const float b3, const float c3, const float d3)
+  { return _mm512_setr_ps(a0, b0, c0, d0, a1, b1, c1, d1, a2, b2, c2, d2, a3, b3, c3, d3); }
+#endif
+
+} // AL_SIMD_ISA_NAMESPACE
 } // AL
@@ -24,7 +24,8 @@ PXR_NAMESPACE_OPEN_SCOPE
 
 TF_DEBUG_CODES(
     PXRUSDMAYA_REGISTRY,
-    PXRUSDMAYA_DIAGNOSTICS
+    PXRUSDMAYA_DIAGNOSTICS,
+    PXRUSDMAYA_STAGE_LOADING
 );
 
 
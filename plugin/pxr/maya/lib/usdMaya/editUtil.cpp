@@ -26,6 +26,8 @@
 #include <maya/MGlobal.h>
 #include <maya/MItEdits.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <unordered_map>
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -180,6 +182,28 @@ UsdMayaEditUtil::GetEditsForAssembly(
     }
 }
 
+size_t
+UsdMayaEditUtil::GetEditsHash(const PathEditMap &refEdits)
+{
+    if( refEdits.empty() )
+        return 0;
+
+    size_t hash = 0;
+    TF_FOR_ALL(itr, refEdits)
+    {
+        boost::hash_combine(hash, itr->first.GetHash());
+        TF_FOR_ALL(editItr, itr->second)
+        {
+            boost::hash_combine(hash, static_cast<int>(editItr->op));
+            boost::hash_combine(hash, static_cast<int>(editItr->set));
+            boost::hash_combine(hash, editItr->value.GetHash());
+        }
+    }
+
+    // Reserve 0 for "no edits".
+    return hash ? hash : 1;
+}
+
 void
 UsdMayaEditUtil::ApplyEditsToProxy(
     const PathEditMap &refEdits,
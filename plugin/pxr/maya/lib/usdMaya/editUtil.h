@@ -111,6 +111,13 @@ public:
             PathEditMap *refEdits,
             std::vector< std::string > *invalidEdits );
     
+    /// \brief Returns a hash of \p refEdits. Assemblies whose edits author
+    /// the same opinions on the proxy get the same hash, regardless of their
+    /// namespace (which appears in the edit strings, so those are not hashed).
+    /// Returns 0 if \p refEdits is empty.
+    PXRUSDMAYA_API
+    static size_t GetEditsHash(const PathEditMap &refEdits);
+
     /// \brief Apply \p refEdits to a \p stage for an assembly rooted
     /// at \p proxyRootPrim.
     PXRUSDMAYA_API
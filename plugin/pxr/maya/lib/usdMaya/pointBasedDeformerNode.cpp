@@ -27,14 +27,20 @@
 
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/usd/attribute.h"
+#include "pxr/usd/usd/attributeQuery.h"
+#include "pxr/usd/usd/notice.h"
 #include "pxr/usd/usd/prim.h"
 #include "pxr/usd/usd/stage.h"
 #include "pxr/usd/usd/timeCode.h"
 #include "pxr/usd/usdGeom/pointBased.h"
 
+#include <maya/MArrayDataHandle.h>
 #include <maya/MDataBlock.h>
 #include <maya/MDataHandle.h>
+#include <maya/MFloatPointArray.h>
+#include <maya/MFn.h>
 #include <maya/MFnData.h>
+#include <maya/MFnMesh.h>
 #include <maya/MFnPluginData.h>
 #include <maya/MFnStringData.h>
 #include <maya/MFnTypedAttribute.h>
@@ -50,6 +56,7 @@
 #include <maya/MTime.h>
 #include <maya/MTypeId.h>
 
+#include <algorithm>
 #include <string>
 
 
@@ -168,14 +175,6 @@ UsdMayaPointBasedDeformerNode::deform(
         return MS::kFailure;
     }
 
-    const SdfPath primPath(primPathString);
-
-    const UsdPrim& usdPrim = usdStage->GetPrimAtPath(primPath);
-    const UsdGeomPointBased usdPointBased(usdPrim);
-    if (!usdPointBased) {
-        return MS::kFailure;
-    }
-
     const MDataHandle timeHandle = block.inputValue(timeAttr, &status);
     CHECK_MSTATUS_AND_RETURN_IT(status);
     const UsdTimeCode usdTime(timeHandle.asTime().value());
@@ -185,11 +184,43 @@ UsdMayaPointBasedDeformerNode::deform(
     const float envelope = envelopeHandle.asFloat();
 
     VtVec3fArray usdPoints;
-    if (!usdPointBased.GetPointsAttr().Get(&usdPoints, usdTime) ||
-            usdPoints.empty()) {
+    if (!_GetPoints(usdStage, primPathString, usdTime, &usdPoints)) {
         return MS::kFailure;
     }
 
+    // If no weights have been painted, every point has a weight of 1, and
+    // if every point of a mesh is being deformed, we can blend the points in
+    // a plain loop over the mesh's raw points and set them with a single
+    // call, rather than going through the geometry iterator.
+    bool uniformWeights = true;
+    MArrayDataHandle weightListHandle =
+        block.inputArrayValue(weightList, &status);
+    if (status == MS::kSuccess &&
+            weightListHandle.jumpToElement(multiIndex) == MS::kSuccess) {
+        MArrayDataHandle weightsHandle =
+            weightListHandle.inputValue().child(weights);
+        uniformWeights = (weightsHandle.elementCount() == 0u);
+    }
+
+    if (uniformWeights) {
+        MArrayDataHandle outputGeomHandle =
+            block.outputArrayValue(outputGeom, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+        status = outputGeomHandle.jumpToElement(multiIndex);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        MObject geomObj = outputGeomHandle.outputValue().data();
+        if (geomObj.hasFn(MFn::kMesh)) {
+            MFnMesh meshFn(geomObj);
+            const unsigned int numVertices =
+                static_cast<unsigned int>(meshFn.numVertices());
+            if (numVertices == usdPoints.size() &&
+                    static_cast<unsigned int>(iter.exactCount()) == numVertices) {
+                return _BlendAllPoints(meshFn, usdPoints, envelope);
+            }
+        }
+    }
+
     for ( ; !iter.isDone(); iter.next()) {
         const int index = iter.index();
         if (index < 0 || static_cast<size_t>(index) >= usdPoints.size()) {
@@ -213,9 +244,110 @@ UsdMayaPointBasedDeformerNode::deform(
     return status;
 }
 
+bool
+UsdMayaPointBasedDeformerNode::_GetPoints(
+        const UsdStageRefPtr& usdStage,
+        const std::string& primPathString,
+        const UsdTimeCode& usdTime,
+        VtVec3fArray* points)
+{
+    if (_cachedStage != UsdStageWeakPtr(usdStage) ||
+            _cachedPrimPath != primPathString) {
+        _ClearCache();
+        _cachedStage = usdStage;
+        _cachedPrimPath = primPathString;
+        _stageNoticeListener.SetStage(usdStage);
+
+        const UsdPrim usdPrim = usdStage->GetPrimAtPath(SdfPath(primPathString));
+        const UsdGeomPointBased usdPointBased(usdPrim);
+        if (usdPointBased) {
+            _pointsQuery = UsdAttributeQuery(usdPointBased.GetPointsAttr());
+        }
+    }
+
+    if (!_pointsQuery.IsValid()) {
+        return false;
+    }
+
+    const double timeValue = usdTime.GetValue();
+    for (auto it = _cachedFrames.begin(); it != _cachedFrames.end(); ++it) {
+        if (it->first == timeValue) {
+            // Move the frame to the back, as it's now the most recently used.
+            std::rotate(it, it + 1, _cachedFrames.end());
+            *points = _cachedFrames.back().second;
+            return true;
+        }
+    }
+
+    if (!_pointsQuery.Get(points, usdTime) || points->empty()) {
+        return false;
+    }
+
+    if (_cachedFrames.size() >= _MaxCachedFrames) {
+        _cachedFrames.erase(_cachedFrames.begin());
+    }
+    // VtArray is copy-on-write, so the cache shares the points' storage.
+    _cachedFrames.emplace_back(timeValue, *points);
+
+    return true;
+}
+
+void
+UsdMayaPointBasedDeformerNode::_ClearCache()
+{
+    _cachedStage = UsdStageWeakPtr();
+    _cachedPrimPath.clear();
+    _pointsQuery = UsdAttributeQuery();
+    _cachedFrames.clear();
+}
+
+/* static */
+MStatus
+UsdMayaPointBasedDeformerNode::_BlendAllPoints(
+        MFnMesh& meshFn,
+        const VtVec3fArray& usdPoints,
+        const float envelope)
+{
+    MStatus status;
+
+    const size_t numPoints = usdPoints.size();
+    const GfVec3f* const usdData = usdPoints.cdata();
+
+    MFloatPointArray deformedPoints(static_cast<unsigned int>(numPoints));
+    if (envelope == 1.0f) {
+        for (size_t i = 0u; i < numPoints; ++i) {
+            deformedPoints[i].x = usdData[i][0];
+            deformedPoints[i].y = usdData[i][1];
+            deformedPoints[i].z = usdData[i][2];
+        }
+    }
+    else {
+        const float* const mayaData = meshFn.getRawPoints(&status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
+
+        for (size_t i = 0u; i < numPoints; ++i) {
+            const float* const mayaPoint = mayaData + 3u * i;
+            deformedPoints[i].x =
+                mayaPoint[0] + (usdData[i][0] - mayaPoint[0]) * envelope;
+            deformedPoints[i].y =
+                mayaPoint[1] + (usdData[i][1] - mayaPoint[1]) * envelope;
+            deformedPoints[i].z =
+                mayaPoint[2] + (usdData[i][2] - mayaPoint[2]) * envelope;
+        }
+    }
+
+    return meshFn.setPoints(deformedPoints);
+}
+
 UsdMayaPointBasedDeformerNode::UsdMayaPointBasedDeformerNode() :
     MPxDeformerNode()
 {
+    // Any change to the stage may invalidate the resolved points query or
+    // the cached points.
+    _stageNoticeListener.SetStageContentsChangedCallback(
+        [this](const UsdNotice::StageContentsChanged&) {
+            _ClearCache();
+        });
 }
 
 /* virtual */
@@ -19,12 +19,18 @@
 /// \file usdMaya/pointBasedDeformerNode.h
 
 #include "usdMaya/api.h"
+#include "usdMaya/stageNoticeListener.h"
 
 #include "pxr/pxr.h"
 
 #include "pxr/base/tf/staticTokens.h"
+#include "pxr/base/vt/types.h"
+#include "pxr/usd/usd/attributeQuery.h"
+#include "pxr/usd/usd/stage.h"
+#include "pxr/usd/usd/timeCode.h"
 
 #include <maya/MDataBlock.h>
+#include <maya/MFnMesh.h>
 #include <maya/MItGeometry.h>
 #include <maya/MMatrix.h>
 #include <maya/MObject.h>
@@ -33,6 +39,10 @@
 #include <maya/MString.h>
 #include <maya/MTypeId.h>
 
+#include <string>
+#include <utility>
+#include <vector>
+
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -55,6 +65,11 @@ TF_DECLARE_PUBLIC_TOKENS(UsdMayaPointBasedDeformerNodeTokens,
 /// the deformer runs, it will read the points attribute of the prim at that
 /// time sample and use the positions to modify the positions of the geometry
 /// being deformed.
+///
+/// The points attribute query is resolved once and reused until the stage,
+/// the prim path or the stage's contents change, and the points of the most
+/// recently evaluated times are kept, so that scrubbing back and forth does
+/// not re-read them from USD.
 class UsdMayaPointBasedDeformerNode : public MPxDeformerNode
 {
     public:
@@ -89,6 +104,35 @@ class UsdMayaPointBasedDeformerNode : public MPxDeformerNode
         UsdMayaPointBasedDeformerNode();
         ~UsdMayaPointBasedDeformerNode() override;
 
+        /// Gets the points of the prim at \p primPathString in \p usdStage at
+        /// \p usdTime, from the cache if they have been read before.
+        bool _GetPoints(
+                const UsdStageRefPtr& usdStage,
+                const std::string& primPathString,
+                const UsdTimeCode& usdTime,
+                VtVec3fArray* points);
+
+        void _ClearCache();
+
+        /// Blends all of the points of \p meshFn towards \p usdPoints with a
+        /// uniform weight of \p envelope. This is a scalar loop over the
+        /// mesh's raw points, followed by a single MFnMesh::setPoints().
+        static MStatus _BlendAllPoints(
+                MFnMesh& meshFn,
+                const VtVec3fArray& usdPoints,
+                float envelope);
+
+        /// The maximum number of frames of points held in the cache.
+        static constexpr size_t _MaxCachedFrames = 8u;
+
+        UsdMayaStageNoticeListener _stageNoticeListener;
+        UsdStageWeakPtr _cachedStage;
+        std::string _cachedPrimPath;
+        UsdAttributeQuery _pointsQuery;
+
+        /// The most recently used frames are at the back.
+        std::vector<std::pair<double, VtVec3fArray>> _cachedFrames;
+
         UsdMayaPointBasedDeformerNode(const UsdMayaPointBasedDeformerNode&);
         UsdMayaPointBasedDeformerNode& operator=(
                 const UsdMayaPointBasedDeformerNode&);
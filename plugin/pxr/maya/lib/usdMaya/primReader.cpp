@@ -22,6 +22,11 @@ UsdMayaPrimReader::UsdMayaPrimReader(const UsdMayaPrimReaderArgs& args)
 {
 }
 
+void
+UsdMayaPrimReader::Prefetch()
+{
+}
+
 bool
 UsdMayaPrimReader::HasPostReadSubtree() const
 {
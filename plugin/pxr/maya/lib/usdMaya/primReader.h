@@ -40,6 +40,16 @@ public:
     PXRUSDMAYA_API
     virtual bool Read(UsdMayaPrimReaderContext* context) = 0;
 
+    /// An optional step that queries the data needed by Read() from the USD
+    /// stage ahead of time, so that Read() only has to create Maya nodes.
+    /// The read job calls Prefetch() on batches of prim readers concurrently
+    /// from worker threads before any of them are read, so implementations
+    /// must only read from the USD stage (never from Maya), and must store
+    /// their results in the prim reader itself.
+    /// Read() must still succeed if Prefetch() was never called.
+    PXRUSDMAYA_API
+    virtual void Prefetch();
+
     /// Whether this prim reader specifies a PostReadSubtree step.
     PXRUSDMAYA_API
     virtual bool HasPostReadSubtree() const;
@@ -25,6 +25,7 @@
 #include "usdMaya/util.h"
 
 #include "pxr/base/tf/token.h"
+#include "pxr/base/work/loops.h"
 
 #include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/sdf/path.h"
@@ -50,6 +51,7 @@
 #include <maya/MStatus.h>
 #include <maya/MTime.h>
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -66,6 +68,14 @@ PXR_NAMESPACE_OPEN_SCOPE
 // (usdMaya/referenceAssembly.cpp)
 const static TfToken ASSEMBLY_SHADING_MODE = UsdMayaShadingModeTokens->displayColor;
 
+// The number of prims whose readers are created and prefetched together when
+// importing. Larger batches give the worker threads more to do at once, at the
+// expense of holding more prefetched data in memory.
+static const size_t _PREFETCH_BATCH_SIZE = 1024u;
+
+using _PrimReaderMap =
+    std::unordered_map<SdfPath, UsdMayaPrimReaderSharedPtr, SdfPath::Hash>;
+
 
 UsdMaya_ReadJob::UsdMaya_ReadJob(
         const std::string &iFileName,
@@ -283,6 +293,47 @@ UsdMaya_ReadJob::Read(std::vector<MDagPath>* addedDagPaths)
 }
 
 
+// Creates the prim readers for prims[begin, end) and runs their USD-side
+// Prefetch() step in parallel. Prims without a prim reader are recorded with a
+// null reader so that we don't look them up again.
+static
+void
+_PrefetchPrimReaders(
+        const std::vector<UsdPrim>& prims,
+        const size_t begin,
+        const size_t end,
+        const UsdMayaJobImportArgs& jobArgs,
+        _PrimReaderMap* primReaders)
+{
+    // Finding the factories may load plugins, so the readers are created
+    // serially. It's only Prefetch() that's worth spreading over threads.
+    std::vector<UsdMayaPrimReaderSharedPtr> batch;
+    batch.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        // Note that the args keep a reference to the prim, so prims must
+        // outlive the readers.
+        const UsdPrim& prim = prims[i];
+        UsdMayaPrimReaderSharedPtr primReader;
+        if (UsdMayaPrimReaderRegistry::ReaderFactoryFn factoryFn
+                = UsdMayaPrimReaderRegistry::FindOrFallback(
+                    prim.GetTypeName())) {
+            primReader = factoryFn(UsdMayaPrimReaderArgs(prim, jobArgs));
+            if (primReader) {
+                batch.push_back(primReader);
+            }
+        }
+        (*primReaders)[prim.GetPath()] = primReader;
+    }
+
+    WorkParallelForN(
+        batch.size(),
+        [&batch](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+                batch[i]->Prefetch();
+            }
+        });
+}
+
 bool
 UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootPrim)
 {
@@ -293,8 +344,34 @@ UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootPrim)
         const UsdPrim& rootPrim = *rootIt;
         rootIt.PruneChildren();
 
-        std::unordered_map<SdfPath, UsdMayaPrimReaderSharedPtr,
-                SdfPath::Hash> primReaders;
+        // Gather the prims of the subtree up front, so that their USD data
+        // can be prefetched in parallel batches ahead of the Maya nodes being
+        // created. The descendants of prims that may be imported as
+        // assemblies are left out, since they usually won't be read; if they
+        // are, their readers are simply created when they are reached.
+        std::vector<UsdPrim> subtreePrims;
+        std::unordered_map<SdfPath, size_t, SdfPath::Hash> subtreeIndices;
+        {
+            const UsdPrimRange range(rootPrim);
+            for (auto primIt = range.begin(); primIt != range.end(); ++primIt) {
+                const UsdPrim& prim = *primIt;
+                subtreeIndices[prim.GetPath()] = subtreePrims.size();
+                subtreePrims.push_back(prim);
+
+                std::string assetIdentifier;
+                SdfPath assetPrimPath;
+                if (UsdMayaTranslatorModelAssembly::ShouldImportAsAssembly(
+                        usdRootPrim,
+                        prim,
+                        &assetIdentifier,
+                        &assetPrimPath)) {
+                    primIt.PruneChildren();
+                }
+            }
+        }
+        size_t numPrefetched = 0u;
+
+        _PrimReaderMap primReaders;
         const UsdPrimRange range = UsdPrimRange::PreAndPostVisit(rootPrim);
         for (auto primIt = range.begin(); primIt != range.end(); ++primIt) {
             const UsdPrim& prim = *primIt;
@@ -303,6 +380,23 @@ UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootPrim)
             // this is the pre-visit (Read) step or post-visit (PostReadSubtree)
             // step.
             if (!primIt.IsPostVisit()) {
+                // If we've caught up with the prefetched prims, prefetch the
+                // next batch.
+                const auto indexIt = subtreeIndices.find(prim.GetPath());
+                if (indexIt != subtreeIndices.end() &&
+                        indexIt->second >= numPrefetched) {
+                    const size_t batchEnd = std::min(
+                        indexIt->second + _PREFETCH_BATCH_SIZE,
+                        subtreePrims.size());
+                    _PrefetchPrimReaders(
+                        subtreePrims,
+                        indexIt->second,
+                        batchEnd,
+                        mArgs,
+                        &primReaders);
+                    numPrefetched = batchEnd;
+                }
+
                 // This is the normal Read step (pre-visit).
                 UsdMayaPrimReaderArgs args(prim, mArgs);
                 UsdMayaPrimReaderContext readCtx(&mNewNodeRegistry);
@@ -343,6 +437,8 @@ UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootPrim)
                             args,
                             &readCtx,
                             mArgs.assemblyRep)) {
+                        // The prefetched reader won't be used.
+                        primReaders.erase(prim.GetPath());
                         if (readCtx.GetPruneChildren()) {
                             primIt.PruneChildren();
                         }
@@ -350,18 +446,31 @@ UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootPrim)
                     }
                 }
 
-                TfToken typeName = prim.GetTypeName();
-                if (UsdMayaPrimReaderRegistry::ReaderFactoryFn factoryFn
-                        = UsdMayaPrimReaderRegistry::FindOrFallback(typeName)) {
-                    UsdMayaPrimReaderSharedPtr primReader = factoryFn(args);
-                    if (primReader) {
-                        primReader->Read(&readCtx);
-                        if (primReader->HasPostReadSubtree()) {
-                            primReaders[prim.GetPath()] = primReader;
-                        }
-                        if (readCtx.GetPruneChildren()) {
-                            primIt.PruneChildren();
-                        }
+                UsdMayaPrimReaderSharedPtr primReader;
+                const auto primReaderIt = primReaders.find(prim.GetPath());
+                if (primReaderIt != primReaders.end()) {
+                    primReader = primReaderIt->second;
+                }
+                else {
+                    TfToken typeName = prim.GetTypeName();
+                    if (UsdMayaPrimReaderRegistry::ReaderFactoryFn factoryFn
+                            = UsdMayaPrimReaderRegistry::FindOrFallback(
+                                typeName)) {
+                        primReader = factoryFn(args);
+                    }
+                }
+
+                if (primReader) {
+                    primReader->Read(&readCtx);
+                    if (primReader->HasPostReadSubtree()) {
+                        primReaders[prim.GetPath()] = primReader;
+                    }
+                    else {
+                        // Release any prefetched data held by the reader.
+                        primReaders.erase(prim.GetPath());
+                    }
+                    if (readCtx.GetPruneChildren()) {
+                        primIt.PruneChildren();
                     }
                 }
             }
@@ -370,8 +479,9 @@ UsdMaya_ReadJob::_DoImport(UsdPrimRange& rootRange, const UsdPrim& usdRootPrim)
                 // specified one.
                 UsdMayaPrimReaderContext postReadCtx(&mNewNodeRegistry);
                 auto primReaderIt = primReaders.find(prim.GetPath());
-                if (primReaderIt != primReaders.end()) {
+                if (primReaderIt != primReaders.end() && primReaderIt->second) {
                     primReaderIt->second->PostReadSubtree(&postReadCtx);
+                    primReaders.erase(primReaderIt);
                 }
             }
         }
@@ -61,6 +61,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 
@@ -271,7 +272,8 @@ UsdMayaReferenceAssembly::UsdMayaReferenceAssembly() :
     _updatingRepNamespace(false),
     _activateRepOnFileLoad(false),
     _inSetInternalValue(false),
-    _hasEdits(false)
+    _hasEdits(false),
+    _editsHash(0)
 {
     TfRegistryManager::GetInstance().SubscribeTo<UsdMayaReferenceAssembly>();
 
@@ -598,6 +600,52 @@ _GetEdits(
     return MItEdits(editsOwner, targetNode);
 }
 
+// The number of active proxy representations using each assembly edits
+// sublayer, keyed by the stage and the hash of the edits applied to it.
+// Assemblies with the same edits share one stage, so the sublayer holding
+// those edits must only be removed from the stage once none of them are using
+// it.
+typedef std::map<std::pair<UsdStagePtr, size_t>, size_t> _EditsSublayerUsers;
+
+namespace {
+
+// Stages do not outlive the scene they were loaded in, so the counts are
+// discarded whenever the scene is reset, rather than being left to match a
+// later stage that happens to reuse the same address.
+struct _EditsSublayerUsersResetListener : public TfWeakBase {
+    _EditsSublayerUsersResetListener(_EditsSublayerUsers& users) :
+        _users(users)
+    {
+        TfWeakPtr<_EditsSublayerUsersResetListener> me(this);
+        TfNotice::Register(me, &_EditsSublayerUsersResetListener::OnSceneReset);
+    }
+
+    void OnSceneReset(const UsdMayaSceneResetNotice& notice)
+    {
+        _users.clear();
+    }
+
+    _EditsSublayerUsers& _users;
+};
+
+} // anonymous namespace
+
+static
+_EditsSublayerUsers&
+_GetEditsSublayerUsers()
+{
+    static _EditsSublayerUsers users;
+    static _EditsSublayerUsersResetListener onSceneResetListener(users);
+    return users;
+}
+
+static
+std::string
+_GetEditsSublayerTag(const size_t editsHash)
+{
+    return TfStringPrintf("assemblyEdits_%zx", editsHash);
+}
+
 static
 std::set<std::string> _GetVariantSetNamesForStageCache(
         const MFnDependencyNode& depNodeFn)
@@ -698,27 +746,27 @@ UsdMayaReferenceAssembly::computeInStageDataCached(MDataBlock& dataBlock)
                 drawMode = TfToken(drawModePlug.asString().asChar());
             }
 
-            SdfLayerRefPtr sessionLayer =
-                    UsdMayaStageCache::GetSharedSessionLayer(
-                        SdfPath::AbsoluteRootPath().AppendChild(modelName),
-                        varSels,
-                        drawMode);
-
-            // If we have assembly edits, do not share session layers with
-            // other models that have our same set of variant selections,
-            // since our edits may differ from theirs. Theoretically we
-            // could hash all of our edit strings and share the same usd
-            // stage as other models with the same hash, but it's not
-            // typical to have enough models in a scene that share the same
-            // set of edits in order to make that worthwhile.
+            // If we have assembly edits, only share session layers with
+            // the other models that have the same edits as well as the same
+            // set of variant selections, since the edits are applied to the
+            // stage (see UsdMayaRepresentationProxyBase::_PushEditsToProxy).
+            // Layouts commonly contain many instances of a model carrying
+            // identical edits, which can then all share a single stage.
             MObject assemObj = thisMObject();
             MItEdits assemEdits(_GetEdits(assemObj));
             if (!assemEdits.isDone()) {
                 _hasEdits = true;
-                SdfLayerRefPtr unsharedSessionLayer = SdfLayer::CreateAnonymous();
-                unsharedSessionLayer->TransferContent(sessionLayer);
-                sessionLayer = unsharedSessionLayer;
             }
+            UsdMayaEditUtil::PathEditMap refEdits;
+            UsdMayaEditUtil::GetEditsForAssembly(assemObj, &refEdits, nullptr);
+            _editsHash = UsdMayaEditUtil::GetEditsHash(refEdits);
+
+            SdfLayerRefPtr sessionLayer =
+                    UsdMayaStageCache::GetSharedSessionLayer(
+                        SdfPath::AbsoluteRootPath().AppendChild(modelName),
+                        varSels,
+                        drawMode,
+                        _editsHash);
 
             UsdStageCacheContext ctx(UsdMayaStageCache::Get());
             usdStage = UsdStage::Open(rootLayer,
@@ -1253,13 +1301,20 @@ UsdMayaRepresentationProxyBase::_PushEditsToProxy()
     MFnAssembly assemblyFn(assemObj);
     MString assemblyPathStr = assemblyFn.partialPathName();
     MItEdits assemEdits(_GetEdits(assemObj));
-    bool hasEdits = !assemEdits.isDone();
-    if (usdAssem->HasEdits() != hasEdits) {
-        usdAssem->SetHasEdits(hasEdits);
+    usdAssem->SetHasEdits(!assemEdits.isDone());
+
+    UsdMayaEditUtil::PathEditMap refEdits;
+    std::vector< std::string > invalidEdits, failedEdits;
 
-        // If we now have edits but previous did not, or vice versa, make sure
-        // we invalidate our UsdStage so that we are not sharing with other
-        // model instances that do not have edits.
+    UsdMayaEditUtil::GetEditsForAssembly( assemObj, &refEdits, &invalidEdits );
+
+    const size_t editsHash = UsdMayaEditUtil::GetEditsHash(refEdits);
+    if (usdAssem->GetEditsHash() != editsHash) {
+        usdAssem->SetEditsHash(editsHash);
+
+        // If our edits have changed since our UsdStage was composed, make
+        // sure we invalidate it so that we only share it with the other model
+        // instances that have the same edits.
         MGlobal::executeCommand("dgdirty " + assemblyPathStr);
     }
 
@@ -1269,26 +1324,36 @@ UsdMayaRepresentationProxyBase::_PushEditsToProxy()
     }
     UsdStagePtr stage = proxyRootPrim.GetStage();
 
-    UsdMayaEditUtil::PathEditMap refEdits;
-    std::vector< std::string > invalidEdits, failedEdits;
-
-    UsdMayaEditUtil::GetEditsForAssembly( assemObj, &refEdits, &invalidEdits );
-
     if( !refEdits.empty() )
     {
-        // Create an anonymous layer to hold the assembly edit opinions, and
-        // sublayer it into the stage's session layer.
-        _sessionSublayer = SdfLayer::CreateAnonymous();
-        stage->GetSessionLayer()->GetSubLayerPaths().clear();
-        stage->GetSessionLayer()->GetSubLayerPaths().push_back(
-            _sessionSublayer->GetIdentifier());
-
-        // Make the session sublayer the edit target before applying the Maya
-        // edits to ensure that we don't pollute other assemblies using the
-        // same layer(s).
-        UsdEditContext editContext(stage, _sessionSublayer);
-
-        UsdMayaEditUtil::ApplyEditsToProxy( refEdits, stage, proxyRootPrim, &failedEdits );
+        // The assemblies sharing this stage all have the same edits, so if
+        // one of them has already applied its edits to the stage, just hold
+        // on to the sublayer holding them.
+        const std::string tag = _GetEditsSublayerTag(editsHash);
+        SdfSubLayerProxy subLayerPaths =
+            stage->GetSessionLayer()->GetSubLayerPaths();
+        if (subLayerPaths.size() == 1u &&
+                TfStringEndsWith(subLayerPaths[0], tag)) {
+            _sessionSublayer = SdfLayer::Find(subLayerPaths[0]);
+        }
+
+        if (!_sessionSublayer) {
+            // Create an anonymous layer to hold the assembly edit opinions,
+            // and sublayer it into the stage's session layer.
+            _sessionSublayer = SdfLayer::CreateAnonymous(tag);
+            stage->GetSessionLayer()->GetSubLayerPaths().clear();
+            stage->GetSessionLayer()->GetSubLayerPaths().push_back(
+                _sessionSublayer->GetIdentifier());
+
+            // Make the session sublayer the edit target before applying the
+            // Maya edits to ensure that we don't pollute other assemblies
+            // using the same layer(s).
+            UsdEditContext editContext(stage, _sessionSublayer);
+
+            UsdMayaEditUtil::ApplyEditsToProxy( refEdits, stage, proxyRootPrim, &failedEdits );
+        }
+        _sessionSublayerEditsHash = editsHash;
+        ++_GetEditsSublayerUsers()[std::make_pair(stage, editsHash)];
     }
 
     if( !invalidEdits.empty() )
@@ -1311,11 +1376,29 @@ UsdMayaRepresentationProxyBase::_PushEditsToProxy()
 bool UsdMayaRepresentationProxyBase::inactivate()
 {
     // Clear out session sublayer and remove it from the layer stack, to avoid
-    // polluting other representations of the same stage.
+    // polluting other representations of the same stage. Other assemblies
+    // with the same edits may still be using it though, in which case it is
+    // left in place.
     UsdPrim proxyRootPrim = dynamic_cast<UsdMayaReferenceAssembly*>(getAssembly())->usdPrim();
     if (proxyRootPrim) {
-        proxyRootPrim.GetStage()->GetSessionLayer()->GetSubLayerPaths().clear();
+        bool inUse = false;
+        if (_sessionSublayer) {
+            _EditsSublayerUsers& editsSublayerUsers = _GetEditsSublayerUsers();
+            auto users = editsSublayerUsers.find(std::make_pair(
+                UsdStagePtr(proxyRootPrim.GetStage()),
+                _sessionSublayerEditsHash));
+            if (users != editsSublayerUsers.end() && --users->second == 0u) {
+                editsSublayerUsers.erase(users);
+            }
+            else if (users != editsSublayerUsers.end()) {
+                inUse = true;
+            }
+        }
+        if (!inUse) {
+            proxyRootPrim.GetStage()->GetSessionLayer()->GetSubLayerPaths().clear();
+        }
         _sessionSublayer = SdfLayerRefPtr();
+        _sessionSublayerEditsHash = 0;
     }
 
     return UsdMayaRepresentationBase::inactivate();
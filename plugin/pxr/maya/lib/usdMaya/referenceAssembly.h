@@ -202,6 +202,12 @@ public:
     bool HasEdits() const { return _hasEdits; }
     void SetHasEdits(bool val) { _hasEdits = val; }
 
+    /// Returns the hash of the assembly edits the stage was composed with
+    /// (see UsdMayaEditUtil::GetEditsHash). Assemblies with the same edits
+    /// hash, variant selections and draw mode share the same stage.
+    size_t GetEditsHash() const { return _editsHash; }
+    void SetEditsHash(size_t val) { _editsHash = val; }
+
     /// This method returns a map of variantSet names to variant selections based
     /// on the variant selections specified on the Maya assembly node. The list
     /// of valid variantSets is retrieved from the referenced prim, so only
@@ -270,6 +276,7 @@ public:
     std::shared_ptr<MPxRepresentation> _activeRep;
     bool _inSetInternalValue;
     bool _hasEdits;
+    size_t _editsHash;
 };
 
 
@@ -310,6 +317,7 @@ class UsdMayaRepresentationProxyBase : public UsdMayaRepresentationBase
             const MString &name,
             bool proxyIsSoftSelectable) :
         UsdMayaRepresentationBase(assembly, name),
+        _sessionSublayerEditsHash(0),
         _proxyIsSoftSelectable(proxyIsSoftSelectable) {};
 
     PXRUSDMAYA_API
@@ -328,6 +336,7 @@ class UsdMayaRepresentationProxyBase : public UsdMayaRepresentationBase
 
   private:
     SdfLayerRefPtr _sessionSublayer;
+    size_t _sessionSublayerEditsHash;
     bool _proxyIsSoftSelectable;
 };
 
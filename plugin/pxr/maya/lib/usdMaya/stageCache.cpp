@@ -101,9 +101,12 @@ SdfLayerRefPtr
 UsdMayaStageCache::GetSharedSessionLayer(
     const SdfPath& rootPath,
     const std::map<std::string, std::string>& variantSelections,
-    const TfToken& drawMode)
+    const TfToken& drawMode,
+    const size_t editsHash)
 {
     // Example key: "/Root/Path:modelingVariant=round|shadingVariant=red|:cards"
+    // Models with assembly edits append the hash of their edits, e.g.
+    // "/Root/Path:modelingVariant=round|shadingVariant=red|:cards:edits=1f3a"
     std::ostringstream key;
     key << rootPath;
     key << ":";
@@ -112,6 +115,9 @@ UsdMayaStageCache::GetSharedSessionLayer(
     }
     key << ":";
     key << drawMode;
+    if (editsHash != 0) {
+        key << ":edits=" << std::hex << editsHash;
+    }
 
     std::string keyString = key.str();
     std::lock_guard<std::mutex> lock(_sharedSessionLayersMutex);
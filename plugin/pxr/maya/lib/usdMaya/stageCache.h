@@ -56,10 +56,15 @@ public:
     /// Gets (or creates) a shared session layer tied with the given variant
     /// selections and draw mode on the given root path.
     /// The stage is cached for the lifetime of the current Maya scene.
+    ///
+    /// Models with assembly edits should pass the hash of their edits (see
+    /// UsdMayaEditUtil::GetEditsHash) as \p editsHash, so that they only share
+    /// a session layer with the models that have the same edits.
     static SdfLayerRefPtr GetSharedSessionLayer(
             const SdfPath& rootPath,
             const std::map<std::string, std::string>& variantSelections,
-            const TfToken& drawMode);
+            const TfToken& drawMode,
+            const size_t editsHash = 0);
 };
 
 
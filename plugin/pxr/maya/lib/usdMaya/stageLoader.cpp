@@ -0,0 +1,171 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "usdMaya/stageLoader.h"
+
+#include "usdMaya/debugCodes.h"
+#include "usdMaya/stageCache.h"
+
+#include "pxr/base/tf/envSetting.h"
+#include "pxr/base/work/detachedTask.h"
+
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/sdf/layer.h"
+#include "pxr/usd/usd/stageCache.h"
+
+#include <maya/MGlobal.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+TF_DEFINE_ENV_SETTING(PIXMAYA_ASYNC_STAGE_LOADING, true,
+                      "Open USD stages on worker threads when Maya is "
+                      "running interactively");
+
+
+namespace {
+
+// Guards the check for an existing stage and the insertion of a new one, so
+// that two requests for the same stage do not both add it to the cache.
+static std::mutex _stageCacheMutex;
+
+} // anonymous namespace
+
+
+UsdMayaStageLoader::Request::Request(
+        const std::string& filePath,
+        const ArResolverContext& resolverContext,
+        const FinishedCallback& onFinished) :
+    _filePath(filePath),
+    _resolverContext(resolverContext),
+    _onFinished(onFinished),
+    _finished(false),
+    _cancelled(false)
+{
+}
+
+UsdStageRefPtr
+UsdMayaStageLoader::Request::GetStage() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stage;
+}
+
+void
+UsdMayaStageLoader::Request::Wait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _finishedCondition.wait(lock, [this]() { return _finished.load(); });
+}
+
+void
+UsdMayaStageLoader::Request::_Run()
+{
+    UsdStageRefPtr stage;
+
+    if (!_cancelled) {
+        TF_DEBUG(PXRUSDMAYA_STAGE_LOADING).Msg(
+            "Loading stage '%s'\n", _filePath.c_str());
+
+        if (SdfLayerRefPtr rootLayer = SdfLayer::FindOrOpen(_filePath)) {
+            UsdStageCache& cache = UsdMayaStageCache::Get();
+            {
+                std::lock_guard<std::mutex> lock(_stageCacheMutex);
+                stage = cache.FindOneMatching(rootLayer, _resolverContext);
+            }
+
+            // The stage is composed without holding the lock, so that
+            // multiple stages can be composed at once.
+            if (!stage && !_cancelled) {
+                UsdStageRefPtr newStage =
+                    UsdStage::Open(rootLayer, _resolverContext);
+
+                std::lock_guard<std::mutex> lock(_stageCacheMutex);
+                stage = cache.FindOneMatching(rootLayer, _resolverContext);
+                if (!stage && newStage && !_cancelled) {
+                    cache.Insert(newStage);
+                    stage = newStage;
+                }
+            }
+        }
+    }
+
+    if (_cancelled) {
+        TF_DEBUG(PXRUSDMAYA_STAGE_LOADING).Msg(
+            "Cancelled loading stage '%s'\n", _filePath.c_str());
+        stage = TfNullPtr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stage = stage;
+        _finished = true;
+    }
+    _finishedCondition.notify_all();
+}
+
+/* static */
+UsdMayaStageLoader::RequestSharedPtr
+UsdMayaStageLoader::Load(
+        const std::string& filePath,
+        const FinishedCallback& onFinished)
+{
+    // The resolver context is bound per thread, so capture the one that is
+    // current on the calling thread.
+    RequestSharedPtr request = std::make_shared<Request>(
+        filePath, ArGetResolver().GetCurrentContext(), onFinished);
+
+    if (!IsAsync()) {
+        request->_Run();
+        return request;
+    }
+
+    WorkRunDetachedTask([request]() {
+        request->_Run();
+        if (!request->IsCancelled()) {
+            MGlobal::executeTaskOnIdle(
+                _InvokeFinishedCallback, new RequestSharedPtr(request));
+        }
+    });
+
+    return request;
+}
+
+/* static */
+void
+UsdMayaStageLoader::_InvokeFinishedCallback(void* data)
+{
+    std::unique_ptr<RequestSharedPtr> request(
+        static_cast<RequestSharedPtr*>(data));
+    if (!(*request)->IsCancelled() && (*request)->_onFinished) {
+        (*request)->_onFinished();
+    }
+}
+
+/* static */
+bool
+UsdMayaStageLoader::IsAsync()
+{
+    return MGlobal::mayaState() == MGlobal::kInteractive &&
+        TfGetEnvSetting(PIXMAYA_ASYNC_STAGE_LOADING);
+}
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
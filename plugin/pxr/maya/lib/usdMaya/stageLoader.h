@@ -0,0 +1,135 @@
+//
+// Copyright 2018 Pixar
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef PXRUSDMAYA_STAGE_LOADER_H
+#define PXRUSDMAYA_STAGE_LOADER_H
+
+/// \file usdMaya/stageLoader.h
+
+#include "usdMaya/api.h"
+
+#include "pxr/pxr.h"
+
+#include "pxr/usd/ar/resolverContext.h"
+#include "pxr/usd/usd/stage.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+
+PXR_NAMESPACE_OPEN_SCOPE
+
+
+/// Opens USD stages on worker threads, so that Maya remains responsive while
+/// the stages are being composed.
+///
+/// A load is started with Load(), which returns a request that can be polled
+/// for the stage. The root layer is opened and the stage is composed on a
+/// worker thread, and the stage is then inserted into UsdMayaStageCache (or
+/// the stage already in the cache for the same root layer and resolver context
+/// is used). Once the request has finished, its callback is invoked on Maya's
+/// main thread the next time Maya is idle, where it is safe to dirty the DG so
+/// that the stage is picked up.
+///
+/// Requests can be cancelled, e.g. when the file path that a stage was
+/// requested for changes. A cancelled request that has not started yet is
+/// skipped. A cancelled request that has already started is allowed to
+/// finish, but its stage is discarded rather than added to the cache, and its
+/// callback is not invoked.
+///
+/// Loads are performed synchronously (within Load()) when Maya is not running
+/// interactively, since there is no idle processing to deliver the callbacks,
+/// or when the PIXMAYA_ASYNC_STAGE_LOADING env setting is disabled.
+class UsdMayaStageLoader
+{
+public:
+    /// Callback invoked on the main thread when a request has finished.
+    typedef std::function<void ()> FinishedCallback;
+
+    /// A pending or finished load of a stage.
+    class Request
+    {
+    public:
+        PXRUSDMAYA_API
+        Request(
+                const std::string& filePath,
+                const ArResolverContext& resolverContext,
+                const FinishedCallback& onFinished);
+
+        /// The file path of the root layer of the requested stage.
+        const std::string& GetFilePath() const { return _filePath; }
+
+        /// Returns true once the stage has been loaded (or failed to load).
+        bool IsFinished() const { return _finished; }
+
+        /// Returns the loaded stage, or null if the request has not finished,
+        /// failed, or was cancelled.
+        PXRUSDMAYA_API
+        UsdStageRefPtr GetStage() const;
+
+        /// Cancels the request.
+        void Cancel() { _cancelled = true; }
+
+        /// Returns true if the request was cancelled.
+        bool IsCancelled() const { return _cancelled; }
+
+        /// Blocks until the request has finished.
+        PXRUSDMAYA_API
+        void Wait();
+
+    private:
+        friend class UsdMayaStageLoader;
+
+        void _Run();
+
+        const std::string _filePath;
+        const ArResolverContext _resolverContext;
+        const FinishedCallback _onFinished;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _finishedCondition;
+        UsdStageRefPtr _stage;
+        std::atomic<bool> _finished;
+        std::atomic<bool> _cancelled;
+    };
+
+    typedef std::shared_ptr<Request> RequestSharedPtr;
+
+    /// Starts loading the stage whose root layer is at \p filePath, using the
+    /// current resolver context. \p onFinished is invoked on the main thread
+    /// once the load has finished, unless the request is cancelled first. It
+    /// is not invoked if the load was performed synchronously.
+    PXRUSDMAYA_API
+    static RequestSharedPtr Load(
+            const std::string& filePath,
+            const FinishedCallback& onFinished = FinishedCallback());
+
+    /// Returns true if stages are loaded on worker threads.
+    PXRUSDMAYA_API
+    static bool IsAsync();
+
+private:
+    static void _InvokeFinishedCallback(void* data);
+};
+
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+
+#endif
@@ -15,26 +15,25 @@
 //
 #include "usdMaya/stageNode.h"
 
-#include "usdMaya/stageCache.h"
 #include "usdMaya/stageData.h"
 
 #include "pxr/base/tf/staticTokens.h"
 #include "pxr/base/tf/stringUtils.h"
 #include "pxr/base/tf/token.h"
 
-#include "pxr/usd/ar/resolver.h"
-#include "pxr/usd/sdf/layer.h"
 #include "pxr/usd/sdf/path.h"
 #include "pxr/usd/usd/stage.h"
-#include "pxr/usd/usd/stageCacheContext.h"
 
 #include <maya/MDataBlock.h>
 #include <maya/MDataHandle.h>
 #include <maya/MFnData.h>
+#include <maya/MFnDependencyNode.h>
+#include <maya/MFnNumericAttribute.h>
 #include <maya/MFnPluginData.h>
 #include <maya/MFnStringData.h>
 #include <maya/MFnTypedAttribute.h>
 #include <maya/MObject.h>
+#include <maya/MObjectHandle.h>
 #include <maya/MPlug.h>
 #include <maya/MPxNode.h>
 #include <maya/MStatus.h>
@@ -58,6 +57,7 @@ const MString UsdMayaStageNode::typeName(
 // Attributes
 MObject UsdMayaStageNode::filePathAttr;
 MObject UsdMayaStageNode::outUsdStageAttr;
+MObject UsdMayaStageNode::stageLoadCountAttr;
 
 
 /* static */
@@ -102,12 +102,96 @@ UsdMayaStageNode::initialize()
     status = addAttribute(outUsdStageAttr);
     CHECK_MSTATUS_AND_RETURN_IT(status);
 
+    // Incremented each time a stage finishes loading in the background, so
+    // that the output is recomputed to pick up the loaded stage.
+    MFnNumericAttribute numericAttrFn;
+    stageLoadCountAttr = numericAttrFn.create("stageLoadCount",
+                                              "slc",
+                                              MFnNumericData::kInt,
+                                              0,
+                                              &status);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = numericAttrFn.setHidden(true);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = numericAttrFn.setStorable(false);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = numericAttrFn.setConnectable(false);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = addAttribute(stageLoadCountAttr);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
+
     status = attributeAffects(filePathAttr, outUsdStageAttr);
     CHECK_MSTATUS_AND_RETURN_IT(status);
+    status = attributeAffects(stageLoadCountAttr, outUsdStageAttr);
+    CHECK_MSTATUS_AND_RETURN_IT(status);
 
     return status;
 }
 
+/* virtual */
+void
+UsdMayaStageNode::postConstructor()
+{
+    // Start loading the stage as soon as the file path is set, rather than
+    // waiting for the output to be pulled.
+    MStatus status;
+    MObject thisNode = thisMObject();
+    _attributeChangedCallbackId = MNodeMessage::addAttributeChangedCallback(
+        thisNode, _OnAttributeChanged, this, &status);
+    CHECK_MSTATUS(status);
+}
+
+/* static */
+void
+UsdMayaStageNode::_OnAttributeChanged(
+        MNodeMessage::AttributeMessage msg,
+        MPlug& plug,
+        MPlug& /* otherPlug */,
+        void* clientData)
+{
+    if ((msg & MNodeMessage::kAttributeSet) && plug == filePathAttr) {
+        UsdMayaStageNode* node = static_cast<UsdMayaStageNode*>(clientData);
+        node->_RequestStage(TfStringTrim(plug.asString().asChar()));
+    }
+}
+
+void
+UsdMayaStageNode::_RequestStage(const std::string& usdFile)
+{
+    if (_loadRequest) {
+        if (_loadRequest->GetFilePath() == usdFile) {
+            return;
+        }
+        _loadRequest->Cancel();
+        _loadRequest.reset();
+    }
+
+    if (usdFile.empty()) {
+        return;
+    }
+
+    // Once the stage has loaded, dirty the output so that it is recomputed.
+    // The node may have been deleted (or may have requested a different file)
+    // by the time the callback is invoked.
+    const MObjectHandle nodeHandle(thisMObject());
+    const std::string requestedFile = usdFile;
+    _loadRequest = UsdMayaStageLoader::Load(usdFile,
+        [nodeHandle, requestedFile]() {
+            if (!nodeHandle.isValid() || !nodeHandle.isAlive()) {
+                return;
+            }
+            MFnDependencyNode depNodeFn(nodeHandle.object());
+            UsdMayaStageNode* node =
+                dynamic_cast<UsdMayaStageNode*>(depNodeFn.userNode());
+            if (!node || !node->_loadRequest ||
+                    node->_loadRequest->GetFilePath() != requestedFile) {
+                return;
+            }
+            MPlug loadCountPlug(nodeHandle.object(), stageLoadCountAttr);
+            loadCountPlug.setInt(loadCountPlug.asInt() + 1);
+        });
+}
+
 /* virtual */
 MStatus
 UsdMayaStageNode::compute(const MPlug& plug, MDataBlock& dataBlock)
@@ -118,18 +202,24 @@ UsdMayaStageNode::compute(const MPlug& plug, MDataBlock& dataBlock)
         const MDataHandle filePathHandle = dataBlock.inputValue(filePathAttr,
                                                                 &status);
         CHECK_MSTATUS_AND_RETURN_IT(status);
+        dataBlock.inputValue(stageLoadCountAttr, &status);
+        CHECK_MSTATUS_AND_RETURN_IT(status);
 
         const std::string usdFile =
             TfStringTrim(filePathHandle.asString().asChar());
 
-        UsdStageRefPtr usdStage;
-
-        if (SdfLayerRefPtr rootLayer = SdfLayer::FindOrOpen(usdFile)) {
-            UsdStageCacheContext ctx(UsdMayaStageCache::Get());
-            usdStage = UsdStage::Open(rootLayer,
-                                      ArGetResolver().GetCurrentContext());
+        // The file path may be driven by a connection, in which case the load
+        // will not have been started when the attribute was set.
+        _RequestStage(usdFile);
 
-            usdStage->SetEditTarget(usdStage->GetSessionLayer());
+        // While the stage is loading, a null stage is output as a
+        // placeholder.
+        UsdStageRefPtr usdStage;
+        if (_loadRequest && _loadRequest->IsFinished()) {
+            usdStage = _loadRequest->GetStage();
+            if (usdStage) {
+                usdStage->SetEditTarget(usdStage->GetSessionLayer());
+            }
         }
 
         SdfPath primPath;
@@ -163,13 +253,21 @@ UsdMayaStageNode::compute(const MPlug& plug, MDataBlock& dataBlock)
     return status;
 }
 
-UsdMayaStageNode::UsdMayaStageNode() : MPxNode()
+UsdMayaStageNode::UsdMayaStageNode() :
+    MPxNode(),
+    _attributeChangedCallbackId(0)
 {
 }
 
 /* virtual */
 UsdMayaStageNode::~UsdMayaStageNode()
 {
+    if (_attributeChangedCallbackId) {
+        MMessage::removeCallback(_attributeChangedCallbackId);
+    }
+    if (_loadRequest) {
+        _loadRequest->Cancel();
+    }
 }
 
 
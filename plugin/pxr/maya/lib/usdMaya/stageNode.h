@@ -19,12 +19,15 @@
 /// \file usdMaya/stageNode.h
 
 #include "usdMaya/api.h"
+#include "usdMaya/stageLoader.h"
 
 #include "pxr/pxr.h"
 
 #include "pxr/base/tf/staticTokens.h"
 
 #include <maya/MDataBlock.h>
+#include <maya/MMessage.h>
+#include <maya/MNodeMessage.h>
 #include <maya/MObject.h>
 #include <maya/MPlug.h>
 #include <maya/MPxNode.h>
@@ -54,6 +57,12 @@ TF_DECLARE_PUBLIC_TOKENS(UsdMayaStageNodeTokens,
 /// and it keeps all of the specifics of reading/caching USD stages and layers
 /// in this stage node so that consumers can simply focus on working with the
 /// stage and its contents.
+///
+/// The stage is opened on a worker thread by UsdMayaStageLoader, starting as
+/// soon as the file path is set. Until it has been opened, the output stage
+/// data holds a null stage. Once the stage has been opened, the output is
+/// dirtied so that consumers pick it up. Changing the file path cancels any
+/// load that is still pending.
 class UsdMayaStageNode : public MPxNode
 {
     public:
@@ -67,6 +76,8 @@ class UsdMayaStageNode : public MPxNode
         static MObject filePathAttr;
         PXRUSDMAYA_API
         static MObject outUsdStageAttr;
+        PXRUSDMAYA_API
+        static MObject stageLoadCountAttr;
 
         PXRUSDMAYA_API
         static void* creator();
@@ -75,6 +86,9 @@ class UsdMayaStageNode : public MPxNode
         static MStatus initialize();
 
         // MPxNode overrides
+        PXRUSDMAYA_API
+        void postConstructor() override;
+
         PXRUSDMAYA_API
         MStatus compute(const MPlug& plug, MDataBlock& dataBlock) override;
 
@@ -84,6 +98,19 @@ class UsdMayaStageNode : public MPxNode
 
         UsdMayaStageNode(const UsdMayaStageNode&);
         UsdMayaStageNode& operator=(const UsdMayaStageNode&);
+
+        /// Starts loading the stage for \p usdFile, cancelling the load of
+        /// any other file. Does nothing if that file is already being loaded.
+        void _RequestStage(const std::string& usdFile);
+
+        static void _OnAttributeChanged(
+                MNodeMessage::AttributeMessage msg,
+                MPlug& plug,
+                MPlug& otherPlug,
+                void* clientData);
+
+        UsdMayaStageLoader::RequestSharedPtr _loadRequest;
+        MCallbackId _attributeChangedCallbackId;
 };
 
 
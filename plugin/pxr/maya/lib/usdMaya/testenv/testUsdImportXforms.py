@@ -227,6 +227,32 @@ class testUsdImportXforms(unittest.TestCase):
                 Gf.IsClose(expectedScale, actualScale, self.EPSILON))
 
 
+    def testImportMatrixXformSingleSample(self):
+        """
+        Tests that a transform op with a single time sample and no default
+        value, which is not considered time varying, still imports with the
+        value of that sample.
+        """
+        from pxr import Usd, UsdGeom
+
+        usdFile = os.path.abspath('UsdImportMatrixXformSingleSample.usda')
+        stage = Usd.Stage.CreateNew(usdFile)
+        xform = UsdGeom.Xform.Define(stage, '/SingleSampleXform')
+        xformOp = xform.AddTransformOp()
+        xformOp.Set(Gf.Matrix4d().SetTranslate(Gf.Vec3d(1.0, 2.0, 3.0)), 1.0)
+        stage.Save()
+
+        cmds.usdImport(file=usdFile, shadingMode='none')
+
+        mayaTransform = self._GetMayaTransform('SingleSampleXform')
+        transformationMatrix = mayaTransform.transformation()
+
+        expectedTranslation = [1.0, 2.0, 3.0]
+        actualTranslation = list(
+            transformationMatrix.translation(OM.MSpace.kTransform))
+        self.assertTrue(
+            Gf.IsClose(expectedTranslation, actualTranslation, self.EPSILON))
+
     def testPivot(self):
         """
         Tests that pivotPosition attribute doesn't interfere with the matrix
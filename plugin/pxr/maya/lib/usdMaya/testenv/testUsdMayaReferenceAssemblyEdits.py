@@ -114,6 +114,34 @@ class testUsdMayaReferenceAssemblyEdits(unittest.TestCase):
         expectedEditString = 'setAttr "NS_TestAssemblyNode:Geom|NS_TestAssemblyNode:Cube.translateX" 5'
         self.assertEqual(refEdit.editString, expectedEditString)
 
+    def testStageSharedByAssembliesWithSameEdits(self):
+        """
+        Tests that assemblies with the same assembly edits share a single USD
+        stage, while an assembly without edits uses a stage of its own.
+        """
+        assemblyNodeNames = []
+        for nodeName in ['AssemblyA', 'AssemblyB', 'AssemblyC']:
+            assemblyNodeName = self._CreateAssemblyNode(nodeName)
+            cmds.assembly(assemblyNodeName, edit=True, active='Full')
+            if nodeName != 'AssemblyC':
+                self._MakeAssemblyEdit(assemblyNodeName, 'Cube')
+            cmds.assembly(assemblyNodeName, edit=True, active='Collapsed')
+            assemblyNodeNames.append(assemblyNodeName)
+
+        stages = [UsdMaya.GetPrim(name).GetStage() for name in assemblyNodeNames]
+        self.assertEqual(stages[0], stages[1])
+        self.assertNotEqual(stages[0], stages[2])
+
+        # The edits are applied once, in the sublayer of the shared stage's
+        # session layer.
+        self.assertEqual(len(stages[0].GetSessionLayer().subLayerPaths), 1)
+        self.assertEqual(len(stages[2].GetSessionLayer().subLayerPaths), 0)
+
+        # The sublayer holding the edits stays in place until neither of the
+        # assemblies sharing it is using it any more.
+        cmds.assembly(assemblyNodeNames[0], edit=True, active='')
+        self.assertEqual(len(stages[1].GetSessionLayer().subLayerPaths), 1)
+
     # XXX: Maya's built-in duplicate() command does NOT copy assembly edits.
     #      Hopefully one day it will, and we can enable this test.
     # def testAssemblyEditsAfterDuplicate(self):
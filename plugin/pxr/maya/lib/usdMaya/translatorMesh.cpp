@@ -214,88 +214,74 @@ _SetupPointBasedDeformerForMayaNode(
 }
 
 /* static */
-bool
-UsdMayaTranslatorMesh::Create(
+void
+UsdMayaTranslatorMesh::ReadMeshData(
         const UsdGeomMesh& mesh,
-        MObject parentNode,
         const UsdMayaPrimReaderArgs& args,
-        UsdMayaPrimReaderContext* context)
+        MeshData* meshData)
 {
+    meshData->isRead = true;
     if (!mesh) {
-        return false;
+        return;
     }
 
     const UsdPrim& prim = mesh.GetPrim();
 
-    MStatus status;
-
-    // Create node (transform)
-    MObject mayaNodeTransformObj;
-    if (!UsdMayaTranslatorUtil::CreateTransformNode(prim,
-                                                       parentNode,
-                                                       args,
-                                                       context,
-                                                       &status,
-                                                       &mayaNodeTransformObj)) {
-        return false;
-    }
-
-    VtIntArray faceVertexCounts;
-    VtIntArray faceVertexIndices;
+    UsdMayaTranslatorXformable::ReadSamples(
+            mesh, args, &meshData->xformSamples);
 
     const UsdAttribute fvc = mesh.GetFaceVertexCountsAttr();
     if (fvc.ValueMightBeTimeVarying()){
         // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
         // for the mesh, perhaps?  For now, better to give a more specific error
-        TF_RUNTIME_ERROR(
+        meshData->error = TfStringPrintf(
                 "<%s> is a topologically varying Mesh (has animated "
                 "faceVertexCounts), which isn't currently supported. "
                 "Skipping...",
                 prim.GetPath().GetText());
-        return false;
+        return;
     } else {
-        fvc.Get(&faceVertexCounts, UsdTimeCode::EarliestTime());
+        fvc.Get(&meshData->faceVertexCounts, UsdTimeCode::EarliestTime());
     }
 
     const UsdAttribute fvi = mesh.GetFaceVertexIndicesAttr();
     if (fvi.ValueMightBeTimeVarying()){
         // at some point, it would be great, instead of failing, to create a usd/hydra proxy node
         // for the mesh, perhaps?  For now, better to give a more specific error
-        TF_RUNTIME_ERROR(
+        meshData->error = TfStringPrintf(
                 "<%s> is a topologically varying Mesh (has animated "
                 "faceVertexIndices), which isn't currently supported. "
                 "Skipping...",
                 prim.GetPath().GetText());
-        return false;
+        return;
     } else {
-        fvi.Get(&faceVertexIndices, UsdTimeCode::EarliestTime());
+        fvi.Get(&meshData->faceVertexIndices, UsdTimeCode::EarliestTime());
     }
 
+    const VtIntArray& faceVertexCounts = meshData->faceVertexCounts;
+    const VtIntArray& faceVertexIndices = meshData->faceVertexIndices;
+
     // Sanity Checks. If the vertex arrays are empty, skip this mesh
     if (faceVertexCounts.empty() || faceVertexIndices.empty()) {
-        TF_RUNTIME_ERROR(
+        meshData->error = TfStringPrintf(
                 "faceVertexCounts or faceVertexIndices array is empty "
                 "[count: %zu, indices:%zu] on Mesh <%s>. Skipping...",
                 faceVertexCounts.size(), faceVertexIndices.size(),
                 prim.GetPath().GetText());
-        return false; // invalid mesh, so exit
+        return; // invalid mesh, so exit
     }
 
     // Gather points and normals
     // If timeInterval is non-empty, pick the first available sample in the
     // timeInterval or default.
-    VtVec3fArray points;
-    VtVec3fArray normals;
     UsdTimeCode pointsTimeSample = UsdTimeCode::EarliestTime();
     UsdTimeCode normalsTimeSample = UsdTimeCode::EarliestTime();
-    std::vector<double> pointsTimeSamples;
-    size_t pointsNumTimeSamples = 0u;
     if (!args.GetTimeInterval().IsEmpty()) {
-        mesh.GetPointsAttr().GetTimeSamplesInInterval(args.GetTimeInterval(),
-                                                      &pointsTimeSamples);
-        if (!pointsTimeSamples.empty()) {
-            pointsNumTimeSamples = pointsTimeSamples.size();
-            pointsTimeSample = pointsTimeSamples.front();
+        mesh.GetPointsAttr().GetTimeSamplesInInterval(
+                args.GetTimeInterval(),
+                &meshData->pointsTimeSamples);
+        if (!meshData->pointsTimeSamples.empty()) {
+            pointsTimeSample = meshData->pointsTimeSamples.front();
         }
 
         std::vector<double> normalsTimeSamples;
@@ -306,25 +292,86 @@ UsdMayaTranslatorMesh::Create(
         }
     }
 
-    mesh.GetPointsAttr().Get(&points, pointsTimeSample);
-    mesh.GetNormalsAttr().Get(&normals, normalsTimeSample);
+    mesh.GetPointsAttr().Get(&meshData->points, pointsTimeSample);
+    mesh.GetNormalsAttr().Get(&meshData->normals, normalsTimeSample);
 
-    if (points.empty()) {
-        TF_RUNTIME_ERROR("points array is empty on Mesh <%s>. Skipping...",
-                         prim.GetPath().GetText());
-        return false;
+    if (meshData->points.empty()) {
+        meshData->error = TfStringPrintf(
+                "points array is empty on Mesh <%s>. Skipping...",
+                prim.GetPath().GetText());
+        return;
     }
 
     std::string reason;
     if (!UsdGeomMesh::ValidateTopology(faceVertexIndices,
                                        faceVertexCounts,
-                                       points.size(),
+                                       meshData->points.size(),
                                        &reason)) {
-        TF_RUNTIME_ERROR("Skipping Mesh <%s> with invalid topology: %s",
-                         prim.GetPath().GetText(), reason.c_str());
+        meshData->error = TfStringPrintf(
+                "Skipping Mesh <%s> with invalid topology: %s",
+                prim.GetPath().GetText(), reason.c_str());
+        return;
+    }
+
+    meshData->normalsInterpolation = mesh.GetNormalsInterpolation();
+    mesh.GetSubdivisionSchemeAttr().Get(&meshData->subdivisionScheme);
+    mesh.GetHoleIndicesAttr().Get(&meshData->holeIndices); // not animatable
+    meshData->primvars = mesh.GetPrimvars();
+}
+
+/* static */
+bool
+UsdMayaTranslatorMesh::Create(
+        const UsdGeomMesh& mesh,
+        MObject parentNode,
+        const UsdMayaPrimReaderArgs& args,
+        UsdMayaPrimReaderContext* context)
+{
+    MeshData meshData;
+    ReadMeshData(mesh, args, &meshData);
+    return Create(mesh, meshData, parentNode, args, context);
+}
+
+/* static */
+bool
+UsdMayaTranslatorMesh::Create(
+        const UsdGeomMesh& mesh,
+        const MeshData& meshData,
+        MObject parentNode,
+        const UsdMayaPrimReaderArgs& args,
+        UsdMayaPrimReaderContext* context)
+{
+    if (!mesh || !TF_VERIFY(meshData.isRead)) {
+        return false;
+    }
+
+    const UsdPrim& prim = mesh.GetPrim();
+
+    MStatus status;
+
+    // Create node (transform)
+    MObject mayaNodeTransformObj;
+    if (!UsdMayaTranslatorUtil::CreateTransformNode(prim,
+                                                       meshData.xformSamples,
+                                                       parentNode,
+                                                       args,
+                                                       context,
+                                                       &status,
+                                                       &mayaNodeTransformObj)) {
+        return false;
+    }
+
+    if (!meshData.error.empty()) {
+        TF_RUNTIME_ERROR("%s", meshData.error.c_str());
         return false;
     }
 
+    const VtIntArray& faceVertexCounts = meshData.faceVertexCounts;
+    const VtIntArray& faceVertexIndices = meshData.faceVertexIndices;
+    const std::vector<double>& pointsTimeSamples = meshData.pointsTimeSamples;
+    const size_t pointsNumTimeSamples = pointsTimeSamples.size();
+    VtVec3fArray points = meshData.points;
+    VtVec3fArray normals = meshData.normals;
 
     // == Convert data
     const size_t mayaNumVertices = points.size();
@@ -410,11 +457,9 @@ UsdMayaTranslatorMesh::Create(
     // If we are dealing with polys, check if there are normals and set the
     // internal emit-normals tag so that the normals will round-trip.
     // If we are dealing with a subdiv, read additional subdiv tags.
-    TfToken subdScheme;
-    if (mesh.GetSubdivisionSchemeAttr().Get(&subdScheme) &&
-            subdScheme == UsdGeomTokens->none) {
+    if (meshData.subdivisionScheme == UsdGeomTokens->none) {
         if (normals.size() == static_cast<size_t>(meshFn.numFaceVertices()) &&
-                mesh.GetNormalsInterpolation() == UsdGeomTokens->faceVarying) {
+                meshData.normalsInterpolation == UsdGeomTokens->faceVarying) {
             UsdMayaMeshUtil::SetEmitNormalsTag(meshFn, true);
         }
     } else {
@@ -422,8 +467,7 @@ UsdMayaTranslatorMesh::Create(
     }
 
     // Set Holes
-    VtIntArray holeIndices;
-    mesh.GetHoleIndicesAttr().Get(&holeIndices); // not animatable
+    const VtIntArray& holeIndices = meshData.holeIndices;
     if (!holeIndices.empty()) {
         MUintArray mayaHoleIndices;
         mayaHoleIndices.setLength(holeIndices.size());
@@ -438,8 +482,7 @@ UsdMayaTranslatorMesh::Create(
     }
 
     // GETTING PRIMVARS
-    const std::vector<UsdGeomPrimvar> primvars = mesh.GetPrimvars();
-    TF_FOR_ALL(iter, primvars) {
+    TF_FOR_ALL(iter, meshData.primvars) {
         const UsdGeomPrimvar& primvar = *iter;
         const TfToken name = primvar.GetBaseName();
         const TfToken fullName = primvar.GetPrimvarName();
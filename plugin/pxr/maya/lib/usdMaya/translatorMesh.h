@@ -23,15 +23,21 @@
 
 #include "usdMaya/primReaderArgs.h"
 #include "usdMaya/primReaderContext.h"
+#include "usdMaya/translatorXformable.h"
 
 #include "pxr/pxr.h"
 
+#include "pxr/base/tf/token.h"
+#include "pxr/base/vt/types.h"
 #include "pxr/usd/usdGeom/mesh.h"
 #include "pxr/usd/usdGeom/primvar.h"
 
 #include <maya/MFnMesh.h>
 #include <maya/MObject.h>
 
+#include <string>
+#include <vector>
+
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -41,6 +47,44 @@ PXR_NAMESPACE_OPEN_SCOPE
 class UsdMayaTranslatorMesh
 {
     public:
+        /// The data read from a UsdGeomMesh that is needed to create the
+        /// Maya mesh. It is filled in by ReadMeshData(), which only queries
+        /// the USD stage and may therefore run on a worker thread.
+        struct MeshData
+        {
+            /// Whether ReadMeshData() has been run on this data.
+            bool isRead = false;
+
+            /// If non-empty, the reason the mesh cannot be imported.
+            std::string error;
+
+            VtIntArray faceVertexCounts;
+            VtIntArray faceVertexIndices;
+            VtIntArray holeIndices;
+            VtVec3fArray points;
+            VtVec3fArray normals;
+            TfToken normalsInterpolation;
+            TfToken subdivisionScheme;
+
+            /// The points time samples within the import time interval.
+            std::vector<double> pointsTimeSamples;
+
+            std::vector<UsdGeomPrimvar> primvars;
+
+            /// The samples for the mesh's transform node.
+            UsdMayaTranslatorXformable::XformSamples xformSamples;
+        };
+
+        /// Reads the data needed to create a Maya mesh and its transform from
+        /// \p mesh into \p meshData. This does not touch Maya, and does not
+        /// emit any diagnostics; if the mesh cannot be imported, the reason
+        /// is stored in \p meshData and reported by Create().
+        PXRUSDMAYA_API
+        static void ReadMeshData(
+                const UsdGeomMesh& mesh,
+                const UsdMayaPrimReaderArgs& args,
+                MeshData* meshData);
+
         /// Creates an MFnMesh under \p parentNode from \p mesh.
         PXRUSDMAYA_API
         static bool Create(
@@ -49,6 +93,16 @@ class UsdMayaTranslatorMesh
                 const UsdMayaPrimReaderArgs& args,
                 UsdMayaPrimReaderContext* context);
 
+        /// Creates an MFnMesh under \p parentNode from \p mesh, using the
+        /// USD data previously read into \p meshData by ReadMeshData().
+        PXRUSDMAYA_API
+        static bool Create(
+                const UsdGeomMesh& mesh,
+                const MeshData& meshData,
+                MObject parentNode,
+                const UsdMayaPrimReaderArgs& args,
+                UsdMayaPrimReaderContext* context);
+
     private:
         static bool _AssignSubDivTagsToMesh(
                 const UsdGeomMesh& primSchema,
@@ -21,6 +21,7 @@
 
 #include "pxr/base/tf/staticData.h"
 #include "pxr/base/tf/staticTokens.h"
+#include "pxr/base/work/loops.h"
 
 #include "pxr/usd/usdSkel/skeleton.h"
 #include "pxr/usd/usdSkel/skeletonQuery.h"
@@ -39,11 +40,15 @@
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MFnSingleIndexedComponent.h>
 #include <maya/MFnSkinCluster.h>
+#include <maya/MIntArray.h>
 #include <maya/MMatrix.h>
 #include <maya/MObjectHandle.h>
 #include <maya/MPlug.h>
 #include <maya/MPlugArray.h>
 
+#include <algorithm>
+#include <vector>
+
 
 PXR_NAMESPACE_OPEN_SCOPE
 
@@ -912,6 +917,59 @@ UsdMayaTranslatorSkel::GetBindPose(const UsdSkelSkeletonQuery& skelQuery,
 namespace {
 
 
+/// The maximum number of weights transferred to the skinCluster in a single
+/// MFnSkinCluster::setWeights() call. Points are applied in ranges whose
+/// (points x used joints) weight block fits in this budget, so that the full
+/// points-by-joints weight matrix is never allocated.
+constexpr size_t _MaxWeightsPerRange = 1u << 22;
+
+
+/// Compute the block of weights for points [\p start, \p end) and the
+/// \p numUsedJoints joints influencing them, as expected by
+/// MFnSkinCluster::setWeights(). Weights are stored as:
+///   vert_0_joint_0 ... vert_0_joint_n ... vert_n_joint_0 ... vert_n_joint_n
+/// where \p jointColumns maps a joint index to its column in the block, or
+/// to -1 for joints that only have zero weights in the range.
+void
+_ComputeWeightsBlock(const VtIntArray& indices,
+                     const VtFloatArray& weights,
+                     int numInfluencesPerPoint,
+                     const std::vector<int>& jointColumns,
+                     unsigned int numUsedJoints,
+                     unsigned int start,
+                     unsigned int end,
+                     MDoubleArray* block)
+{
+    block->setLength((end - start)*numUsedJoints);
+
+    // Only touch the raw storage from the worker threads.
+    double* blockData = &(*block)[0];
+    WorkParallelForN(end - start,
+        [&](size_t begin, size_t finish) {
+            for (size_t i = begin; i < finish; ++i) {
+                const unsigned int pt = start + static_cast<unsigned int>(i);
+                double* ptWeights = blockData + i*numUsedJoints;
+                std::fill(ptWeights, ptWeights + numUsedJoints, 0.0);
+
+                for (int c = 0; c < numInfluencesPerPoint; ++c) {
+                    int jointIdx = indices[pt*numInfluencesPerPoint+c];
+                    if (jointIdx >= 0 
+                       && static_cast<size_t>(jointIdx) < jointColumns.size()
+                       && jointColumns[jointIdx] >= 0) {
+                        // There may be multiple influences referencing the
+                        // same joint for this point. eg., 'unweighted' points
+                        // are assigned index 0 and weight 0. Sum the weight
+                        // contributions to ensure that we properly account
+                        // for this.
+                        ptWeights[jointColumns[jointIdx]] +=
+                            weights[pt*numInfluencesPerPoint+c];
+                    }
+                }
+            }
+        });
+}
+
+
 bool
 _SetVaryingJointInfluences(const MFnMesh& meshFn,
                            const MObject& skinCluster,
@@ -935,34 +993,6 @@ _SetVaryingJointInfluences(const MFnMesh& meshFn,
 
     const unsigned int numJoints = static_cast<unsigned int>(joints.size());
 
-    // Compute a vertex-ordered weight arrays. Weights are stored as:
-    //   vert_0_joint_0 ... vert_0_joint_n ... vert_n_joint_0 ... vert_n_joint_n
-    MDoubleArray vertOrderedWeights(numPoints*numJoints, 0.0f); 
-    for (unsigned int pt = 0; pt < numPoints; ++pt) {
-        for (int c = 0; c < numInfluencesPerPoint; ++c) {
-            int jointIdx = indices[pt*numInfluencesPerPoint+c];
-            if (jointIdx >= 0 
-               && static_cast<unsigned int>(jointIdx) < numJoints) {
-                float w = weights[pt*numInfluencesPerPoint+c];
-                // There may be multiple influences referencing the same joint
-                // for this point. eg., 'unweighted' points are assigned
-                // index 0 and weight 0. Sum the weight contributions to ensure
-                // that we properly account for this.
-                vertOrderedWeights[pt*numJoints + jointIdx] += w;
-            }
-        }
-    }
-
-    MIntArray influenceIndices(numJoints);
-    for (unsigned int i = 0; i < numJoints; ++i) {
-        influenceIndices[i] = i;
-    }
-
-    // Set all weights in one batch 
-    MFnSingleIndexedComponent components;
-    components.create(MFn::kMeshVertComponent);
-    components.setCompleteData(numPoints);
-
     // XXX: Note that weights are expected to be pre-normalized in USD.
     // In order to faithfully transfer our source data, we do not perform
     // any normalization on import. Maya's weight normalization also seems
@@ -988,13 +1018,58 @@ _SetVaryingJointInfluences(const MFnMesh& meshFn,
     status = skinClusterFn.setObject(skinCluster);
     CHECK_MSTATUS_AND_RETURN(status, false);
 
-    // Apply the weights. Note that this fails with kInvalidParameter
-    // if the influenceIndices are invalid. Validity is based on the
-    // set of joints wired up to the skinCluster.
-    status = skinClusterFn.setWeights(dagPath, components.object(),
-                                      influenceIndices, vertOrderedWeights,
-                                      /*normalize*/ false);
-    CHECK_MSTATUS_AND_RETURN(status, false);
+    // The skinCluster has just been created, so all of its weights are zero.
+    // Rather than setting all weights in one batch, which requires a dense
+    // (numPoints x numJoints) array, apply the weights a range of points at a
+    // time, and only for the joints that influence points in that range.
+    const unsigned int pointsPerRange = static_cast<unsigned int>(
+        std::max<size_t>(_MaxWeightsPerRange/numJoints, 1u));
+
+    std::vector<int> jointColumns(numJoints);
+    MIntArray influenceIndices;
+    MIntArray pointIndices;
+    MDoubleArray weightsBlock;
+    for (unsigned int start = 0; start < numPoints; start += pointsPerRange) {
+        const unsigned int end = std::min(start + pointsPerRange, numPoints);
+
+        // Find the joints with non-zero weights in this range.
+        std::fill(jointColumns.begin(), jointColumns.end(), -1);
+        influenceIndices.clear();
+        for (unsigned int i = start*numInfluencesPerPoint;
+                i < end*numInfluencesPerPoint; ++i) {
+            int jointIdx = indices[i];
+            if (jointIdx >= 0 
+               && static_cast<unsigned int>(jointIdx) < numJoints
+               && weights[i] != 0.0f
+               && jointColumns[jointIdx] < 0) {
+                jointColumns[jointIdx] = influenceIndices.length();
+                influenceIndices.append(jointIdx);
+            }
+        }
+        if (influenceIndices.length() == 0) {
+            continue;
+        }
+
+        _ComputeWeightsBlock(indices, weights, numInfluencesPerPoint,
+                             jointColumns, influenceIndices.length(),
+                             start, end, &weightsBlock);
+
+        pointIndices.setLength(end - start);
+        for (unsigned int pt = start; pt < end; ++pt) {
+            pointIndices[pt - start] = pt;
+        }
+        MFnSingleIndexedComponent components;
+        components.create(MFn::kMeshVertComponent);
+        components.addElements(pointIndices);
+
+        // Apply the weights. Note that this fails with kInvalidParameter
+        // if the influenceIndices are invalid. Validity is based on the
+        // set of joints wired up to the skinCluster.
+        status = skinClusterFn.setWeights(dagPath, components.object(),
+                                          influenceIndices, weightsBlock,
+                                          /*normalize*/ false);
+        CHECK_MSTATUS_AND_RETURN(status, false);
+    }
 
 
     // Reset the normalization flag to its previous value.
@@ -66,6 +66,39 @@ UsdMayaTranslatorUtil::CreateTransformNode(
     return true;
 }
 
+/* static */
+bool
+UsdMayaTranslatorUtil::CreateTransformNode(
+        const UsdPrim& usdPrim,
+        const UsdMayaTranslatorXformable::XformSamples& xformSamples,
+        MObject& parentNode,
+        const UsdMayaPrimReaderArgs& args,
+        UsdMayaPrimReaderContext* context,
+        MStatus* status,
+        MObject* mayaNodeObj)
+{
+    if (!usdPrim || !usdPrim.IsA<UsdGeomXformable>()) {
+        return false;
+    }
+
+    if (!CreateNode(usdPrim,
+                    _DEFAULT_TRANSFORM_TYPE,
+                    parentNode,
+                    context,
+                    status,
+                    mayaNodeObj)) {
+        return false;
+    }
+
+    // Apply the xformable attributes previously read from the UsdPrim on to
+    // the transform node.
+    UsdGeomXformable xformable(usdPrim);
+    UsdMayaTranslatorXformable::Read(
+        xformable, xformSamples, *mayaNodeObj, args, context);
+
+    return true;
+}
+
 /* static */
 bool
 UsdMayaTranslatorUtil::CreateDummyTransformNode(
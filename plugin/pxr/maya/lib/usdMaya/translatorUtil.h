@@ -20,6 +20,7 @@
 #include "usdMaya/api.h"
 #include "usdMaya/primReaderArgs.h"
 #include "usdMaya/primReaderContext.h"
+#include "usdMaya/translatorXformable.h"
 
 #include "pxr/usd/usd/prim.h"
 
@@ -49,6 +50,20 @@ struct UsdMayaTranslatorUtil
             MStatus* status,
             MObject* mayaNodeObj);
 
+    /// \brief Same as above, except that the transform values are taken from
+    /// \p xformSamples, which must have been read from \p usdPrim with
+    /// UsdMayaTranslatorXformable::ReadSamples().
+    PXRUSDMAYA_API
+    static bool
+    CreateTransformNode(
+            const UsdPrim& usdPrim,
+            const UsdMayaTranslatorXformable::XformSamples& xformSamples,
+            MObject& parentNode,
+            const UsdMayaPrimReaderArgs& args,
+            UsdMayaPrimReaderContext* context,
+            MStatus* status,
+            MObject* mayaNodeObj);
+
     /// \brief Creates a "dummy" transform node for the given prim, where the
     /// dummy transform has all transform properties locked.
     /// A UsdMayaAdaptor-compatible attribute for the typeName metadata will
@@ -20,7 +20,10 @@
 #include "usdMaya/translatorUtil.h"
 #include "usdMaya/xformStack.h"
 
+#include "pxr/base/tf/stringUtils.h"
 #include "pxr/base/tf/token.h"
+#include "pxr/base/vt/value.h"
+#include "pxr/usd/usd/attributeQuery.h"
 #include "pxr/usd/usdGeom/xformable.h"
 #include "pxr/usd/usdGeom/xform.h"
 #include "pxr/usd/usd/stage.h"
@@ -28,27 +31,32 @@
 #include "pxr/usd/usdGeom/xformCommonAPI.h"
 
 #include <maya/MDagModifier.h>
+#include <maya/MDoubleArray.h>
 #include <maya/MFnAnimCurve.h>
 #include <maya/MFnTransform.h>
 #include <maya/MEulerRotation.h>
 #include <maya/MPlug.h>
+#include <maya/MTimeArray.h>
 #include <maya/MTransformationMatrix.h>
 #include <maya/MVector.h>
 #include <maya/MFnDependencyNode.h>
 
 #include <algorithm>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 PXR_NAMESPACE_OPEN_SCOPE
 
 
-// This function retrieves a value for a given xformOp and given time sample. It
-// knows how to deal with different type of ops and angle conversion
+// This function converts the value of a given xformOp to a Vec3d. It knows
+// how to deal with different type of ops and angle conversion
 static bool _getXformOpAsVec3d(
         const UsdGeomXformOp &xformOp,
-        GfVec3d &value,
-        const UsdTimeCode &usdTime)
+        const VtValue &opValue,
+        GfVec3d &value)
 {
     bool retValue = false;
 
@@ -91,25 +99,28 @@ static bool _getXformOpAsVec3d(
     // If we encounter a transform op, we treat it as a shear operation.
     if (opType == UsdGeomXformOp::TypeTransform) {
         // GetOpTransform() handles the inverse op case for us.
-        GfMatrix4d xform = xformOp.GetOpTransform(usdTime);
+        GfMatrix4d xform = UsdGeomXformOp::GetOpTransform(
+                opType, opValue, xformOp.IsInverseOp());
         value[0] = xform[1][0]; //xyVal
         value[1] = xform[2][0]; //xzVal
         value[2] = xform[2][1]; //yzVal
         retValue = true;
     } else if (rotAxis != -1) {
         // Single Axis rotation
-        double valued = 0;
-        retValue = xformOp.GetAs<double>(&valued, usdTime);
+        const VtValue castValue = VtValue::Cast<double>(opValue);
+        retValue = !castValue.IsEmpty();
         if (retValue) {
+            double valued = castValue.UncheckedGet<double>();
             if (xformOp.IsInverseOp()) {
                 valued = -valued;
             }
             value[rotAxis] = valued * angleMult;
         }
     } else {
-        GfVec3d valued;
-        retValue = xformOp.GetAs<GfVec3d>(&valued, usdTime);
+        const VtValue castValue = VtValue::Cast<GfVec3d>(opValue);
+        retValue = !castValue.IsEmpty();
         if (retValue) {
+            GfVec3d valued = castValue.UncheckedGet<GfVec3d>();
             if (xformOp.IsInverseOp()) {
                 valued = -valued;
             }
@@ -122,183 +133,99 @@ static bool _getXformOpAsVec3d(
     return retValue;
 }
 
-// Sets the animation curve (a knot per frame) for a given plug/attribute
-static void _setAnimPlugData(MPlug plg, std::vector<double> &value, MTimeArray &timeArray,
-        const UsdMayaPrimReaderContext* context)
-{
-    MStatus status;
-    MFnAnimCurve animFn;
-    // Make the plug keyable before attaching an anim curve
-    if (!plg.isKeyable()) {
-        plg.setKeyable(true);
-    }
-    MObject animObj = animFn.create(plg, nullptr, &status);
-    if (status == MS::kSuccess ) {
-        MDoubleArray valueArray( &value[0], value.size());
-        animFn.addKeys(&timeArray, &valueArray);
-        if (context) {
-            context->RegisterNewMayaNode(animFn.name().asChar(), animObj );
-        }
-    } else {
-        MString mayaPlgName = plg.partialName(true, true, true, false, true, true, &status);
-        TF_RUNTIME_ERROR(
-                "Failed to create animation object for attribute: %s",
-                mayaPlgName.asChar());
-    }
-}
-
-// Returns true if the array is not constant
-static bool _isArrayVarying(std::vector<double> &value)
-{
-    bool isVarying=false;
-    for (unsigned int i=1;i<value.size();i++) {
-        if (!GfIsClose(value[0], value[i], 1e-9)) { isVarying=true; break; }
-    }
-    return isVarying;
-}
-
-// Sets the Maya Attribute values. Sets the value to the first element of the
-// double arrays and then if the array is varying defines an anym curve for the
-// attribute
-static void _setMayaAttribute(
-        MFnDagNode &depFn,
-        std::vector<double> &xVal, std::vector<double> &yVal, std::vector<double> &zVal,
-        MTimeArray &timeArray,
-        const MString& opName,
-        const MString& x, const MString& y, const MString& z,
-        const UsdMayaPrimReaderContext* context)
+// Works out which of the x, y and z channels of the op actually change over
+// time, so that we only create anim curves for those.
+static void _findVaryingChannels(UsdMayaTranslatorXformable::XformSamples::Op& op)
 {
-    MPlug plg;
-    if (x!="" && !xVal.empty()) {
-        plg = depFn.findPlug(opName+x);
-        if ( !plg.isNull() ) {
-            plg.setDouble(xVal[0]);
-            if (xVal.size()>1 && _isArrayVarying(xVal)) _setAnimPlugData(plg, xVal, timeArray, context);
-        }
-    }
-    if (y!="" && !yVal.empty()) {
-        plg = depFn.findPlug(opName+y);
-        if ( !plg.isNull() ) {
-            plg.setDouble(yVal[0]);
-            if (yVal.size()>1 && _isArrayVarying(yVal)) _setAnimPlugData(plg, yVal, timeArray, context);
-        }
-    }
-    if (z!="" && !zVal.empty()) {
-        plg = depFn.findPlug(opName+z);
-        if ( !plg.isNull() ) {
-            plg.setDouble(zVal[0]);
-            if (zVal.size()>1 && _isArrayVarying(zVal)) _setAnimPlugData(plg, zVal, timeArray, context);
+    for (unsigned int c = 0u; c < 3u; ++c) {
+        op.varying[c] = false;
+        for (size_t i = 1u; i < op.values.size(); ++i) {
+            if (!GfIsClose(op.values[0u][c], op.values[i][c], 1e-9)) {
+                op.varying[c] = true;
+                break;
+            }
         }
     }
 }
 
-// For each xformop, we gather it's data either time sampled or not and we push
-// it to the corresponding Maya xform
-static bool _pushUSDXformOpToMayaXform(
+// For each xformop, we gather its data either time sampled or not. A single
+// attribute query is used for all the samples, so that the value resolution
+// is only done once per op.
+static void _readUSDXformOpSamples(
         const UsdGeomXformOp& xformop,
         const TfToken& opName,
-        MFnDagNode &MdagNode,
         const UsdMayaPrimReaderArgs& args,
-        const UsdMayaPrimReaderContext* context)
+        UsdMayaTranslatorXformable::XformSamples* samples)
 {
-    std::vector<double> xValue;
-    std::vector<double> yValue;
-    std::vector<double> zValue;
-    GfVec3d value;
+    const UsdAttributeQuery query(xformop.GetAttr());
+
+    UsdMayaTranslatorXformable::XformSamples::Op op;
+    op.name = opName;
+    op.type = xformop.GetOpType();
+
     std::vector<double> timeSamples;
-    if (!args.GetTimeInterval().IsEmpty()) {
-        xformop.GetTimeSamplesInInterval(args.GetTimeInterval(), &timeSamples);
+    if (!args.GetTimeInterval().IsEmpty() && query.ValueMightBeTimeVarying()) {
+        query.GetTimeSamplesInInterval(args.GetTimeInterval(), &timeSamples);
     }
-    MTimeArray timeArray;
+
+    VtValue opValue;
+    GfVec3d value;
     if (!timeSamples.empty()) {
-        timeArray.setLength(timeSamples.size());
-        xValue.resize(timeSamples.size());
-        yValue.resize(timeSamples.size());
-        zValue.resize(timeSamples.size());
-        for (unsigned int ti=0; ti < timeSamples.size(); ++ti) {
-            UsdTimeCode time(timeSamples[ti]);
-            if (_getXformOpAsVec3d(xformop, value, time)) {
-                xValue[ti]=value[0]; yValue[ti]=value[1]; zValue[ti]=value[2];
-                timeArray.set(MTime(timeSamples[ti]), ti);
+        op.times.reserve(timeSamples.size());
+        op.values.reserve(timeSamples.size());
+        for (const double timeSample : timeSamples) {
+            if (query.Get(&opValue, UsdTimeCode(timeSample)) &&
+                    _getXformOpAsVec3d(xformop, opValue, value)) {
+                op.times.push_back(timeSample);
+                op.values.push_back(value);
             }
             else {
-                TF_RUNTIME_ERROR(
+                samples->errors.push_back(TfStringPrintf(
                         "Missing sampled data on xformOp: %s",
-                        xformop.GetName().GetText());
+                        xformop.GetName().GetText()));
             }
         }
     }
     else {
         // pick the first available sample or default
-        UsdTimeCode time=UsdTimeCode::EarliestTime();
-        if (_getXformOpAsVec3d(xformop, value, time)) {
-            xValue.resize(1);
-            yValue.resize(1);
-            zValue.resize(1);
-            xValue[0]=value[0]; yValue[0]=value[1]; zValue[0]=value[2];
+        if (query.Get(&opValue, UsdTimeCode::EarliestTime()) &&
+                _getXformOpAsVec3d(xformop, opValue, value)) {
+            op.values.push_back(value);
         }
         else {
-            TF_RUNTIME_ERROR(
+            samples->errors.push_back(TfStringPrintf(
                     "Missing default data on xformOp: %s",
-                    xformop.GetName().GetText());
+                    xformop.GetName().GetText()));
         }
     }
-    if (!xValue.empty()) {
-        if (opName==UsdMayaXformStackTokens->shear) {
-            _setMayaAttribute(MdagNode, xValue, yValue, zValue, timeArray, MString(opName.GetText()), "XY", "XZ", "YZ", context);
-        }
-        else if (opName==UsdMayaXformStackTokens->pivot) {
-            _setMayaAttribute(MdagNode, xValue, yValue, zValue, timeArray, MString("rotatePivot"), "X", "Y", "Z", context);
-            _setMayaAttribute(MdagNode, xValue, yValue, zValue, timeArray, MString("scalePivot"), "X", "Y", "Z", context);
-        }
-        else if (opName==UsdMayaXformStackTokens->pivotTranslate) {
-            _setMayaAttribute(MdagNode, xValue, yValue, zValue, timeArray, MString("rotatePivotTranslate"), "X", "Y", "Z", context);
-            _setMayaAttribute(MdagNode, xValue, yValue, zValue, timeArray, MString("scalePivotTranslate"), "X", "Y", "Z", context);
-        }
-        else {
-            if (opName==UsdMayaXformStackTokens->rotate) {
-                MFnTransform trans;
-                if(trans.setObject(MdagNode.object()))
-                {
-                    auto MrotOrder =
-                            UsdMayaXformStack::RotateOrderFromOpType<MTransformationMatrix::RotationOrder>(
-                                    xformop.GetOpType());
-                    MPlug plg = MdagNode.findPlug("rotateOrder");
-                    if ( !plg.isNull() ) {
-                        trans.setRotationOrder(MrotOrder, /*no need to reorder*/ false);
-                    }
-                }
-            }
-            else if(opName==UsdMayaXformStackTokens->rotateAxis)
-            {
-                // Rotate axis only accepts input in XYZ form
-                // (though it's actually stored as a quaternion),
-                // so we need to convert other rotation orders to XYZ
-                const auto opType = xformop.GetOpType();
-                if (opType != UsdGeomXformOp::TypeRotateXYZ
-                        && opType != UsdGeomXformOp::TypeRotateX
-                        && opType != UsdGeomXformOp::TypeRotateY
-                        && opType != UsdGeomXformOp::TypeRotateZ)
-                {
-                    for (size_t i = 0u; i < xValue.size(); ++i)
-                    {
-                        auto MrotOrder =
-                                UsdMayaXformStack::RotateOrderFromOpType<MEulerRotation::RotationOrder>(
-                                        xformop.GetOpType());
-                        MEulerRotation eulerRot(xValue[i], yValue[i], zValue[i], MrotOrder);
-                        eulerRot.reorderIt(MEulerRotation::kXYZ);
-                        xValue[i] = eulerRot.x;
-                        yValue[i] = eulerRot.y;
-                        zValue[i] = eulerRot.z;
-                    }
-                }
+
+    if (op.values.empty()) {
+        return;
+    }
+
+    if (opName == UsdMayaXformStackTokens->rotateAxis) {
+        // Rotate axis only accepts input in XYZ form
+        // (though it's actually stored as a quaternion),
+        // so we need to convert other rotation orders to XYZ
+        const auto opType = xformop.GetOpType();
+        if (opType != UsdGeomXformOp::TypeRotateXYZ
+                && opType != UsdGeomXformOp::TypeRotateX
+                && opType != UsdGeomXformOp::TypeRotateY
+                && opType != UsdGeomXformOp::TypeRotateZ)
+        {
+            const auto MrotOrder =
+                    UsdMayaXformStack::RotateOrderFromOpType<MEulerRotation::RotationOrder>(
+                            opType);
+            for (GfVec3d& rotation : op.values) {
+                MEulerRotation eulerRot(rotation[0], rotation[1], rotation[2], MrotOrder);
+                eulerRot.reorderIt(MEulerRotation::kXYZ);
+                rotation.Set(eulerRot.x, eulerRot.y, eulerRot.z);
             }
-            _setMayaAttribute(MdagNode, xValue, yValue, zValue, timeArray, MString(opName.GetText()), "X", "Y", "Z", context);
         }
-        return true;
     }
 
-    return false;
+    _findVaryingChannels(op);
+    samples->ops.push_back(std::move(op));
 }
 
 // Simple function that determines if the matrix is identity
@@ -317,96 +244,192 @@ static bool _isIdentityMatrix(GfMatrix4d m)
     return isIdentity;
 }
 
-// For each xformop, we gather it's data either time sampled or not and we push it to the corresponding Maya xform
-static bool _pushUSDXformToMayaXform(
+// When the xform ops don't match a known stack, we decompose the local
+// transformation at each time sample into translate, rotate and scale
+static bool _readUSDXformSamples(
         const UsdGeomXformable &xformSchema,
-        MFnDagNode &MdagNode,
         const UsdMayaPrimReaderArgs& args,
-        const UsdMayaPrimReaderContext* context)
+        UsdMayaTranslatorXformable::XformSamples* samples)
 {
-    std::vector<double> TxVal, TyVal, TzVal;
-    std::vector<double> RxVal, RyVal, RzVal;
-    std::vector<double> SxVal, SyVal, SzVal;
+    // The query caches the ops' attribute queries for all of the samples.
+    const UsdGeomXformable::XformQuery query(xformSchema);
+
+    UsdMayaTranslatorXformable::XformSamples::Op translateOp, rotateOp, scaleOp;
+    translateOp.name = UsdMayaXformStackTokens->translate;
+    rotateOp.name = UsdMayaXformStackTokens->rotate;
+    scaleOp.name = UsdMayaXformStackTokens->scale;
+
     GfVec3d xlate, rotate, scale;
-    bool resetsXformStack;
     GfMatrix4d localXform(1.0);
 
+    auto appendSample = [&](const GfMatrix4d& xform) {
+        xlate=GfVec3d(0); rotate=GfVec3d(0); scale=GfVec3d(1);
+        if (!_isIdentityMatrix(xform)) {
+            // XXX if we want to support the old pivotPosition, we can pass
+            // it into this function..
+            UsdMayaTranslatorXformable::ConvertUsdMatrixToComponents(
+                    xform, &xlate, &rotate, &scale);
+        }
+        translateOp.values.push_back(xlate);
+        rotateOp.values.push_back(rotate);
+        scaleOp.values.push_back(scale);
+    };
+
     std::vector<double> tSamples;
-    xformSchema.GetTimeSamplesInInterval(args.GetTimeInterval(), &tSamples);
-    MTimeArray timeArray;
+    if (query.TransformMightBeTimeVarying()) {
+        query.GetTimeSamplesInInterval(args.GetTimeInterval(), &tSamples);
+    }
     if (!tSamples.empty()) {
-        timeArray.setLength(tSamples.size());
-        TxVal.resize(tSamples.size()); TyVal.resize(tSamples.size()); TzVal.resize(tSamples.size());
-        RxVal.resize(tSamples.size()); RyVal.resize(tSamples.size()); RzVal.resize(tSamples.size());
-        SxVal.resize(tSamples.size()); SyVal.resize(tSamples.size()); SzVal.resize(tSamples.size());
-        for (unsigned int ti=0; ti < tSamples.size(); ++ti) {
-            UsdTimeCode time(tSamples[ti]);
-            if (xformSchema.GetLocalTransformation(&localXform,
-                                                   &resetsXformStack,
-                                                   time)) {
-                xlate=GfVec3d(0); rotate=GfVec3d(0); scale=GfVec3d(1);
-                if (!_isIdentityMatrix(localXform)) {
-                     UsdMayaTranslatorXformable::ConvertUsdMatrixToComponents(
-                             localXform, &xlate, &rotate, &scale);
-                }
-                TxVal[ti]=xlate [0]; TyVal[ti]=xlate [1]; TzVal[ti]=xlate [2];
-                RxVal[ti]=rotate[0]; RyVal[ti]=rotate[1]; RzVal[ti]=rotate[2];
-                SxVal[ti]=scale [0]; SyVal[ti]=scale [1]; SzVal[ti]=scale [2];
-                timeArray.set(MTime(tSamples[ti]), ti);
+        translateOp.values.reserve(tSamples.size());
+        rotateOp.values.reserve(tSamples.size());
+        scaleOp.values.reserve(tSamples.size());
+        for (const double tSample : tSamples) {
+            if (query.GetLocalTransformation(&localXform, UsdTimeCode(tSample))) {
+                appendSample(localXform);
+                translateOp.times.push_back(tSample);
             }
             else {
-                TF_RUNTIME_ERROR(
+                samples->errors.push_back(TfStringPrintf(
                         "Missing sampled xform data on USD prim <%s>",
-                        xformSchema.GetPath().GetText());
+                        xformSchema.GetPath().GetText()));
             }
         }
     }
     else {
-        if (xformSchema.GetLocalTransformation(&localXform, &resetsXformStack)) {
-            xlate=GfVec3d(0); rotate=GfVec3d(0); scale=GfVec3d(1);
-            if (!_isIdentityMatrix(localXform)) {
-                // XXX if we want to support the old pivotPosition, we can pass
-                // it into this function..
-                UsdMayaTranslatorXformable::ConvertUsdMatrixToComponents(
-                        localXform, &xlate, &rotate, &scale);
-            }
-            TxVal.resize(1); TyVal.resize(1); TzVal.resize(1);
-            RxVal.resize(1); RyVal.resize(1); RzVal.resize(1);
-            SxVal.resize(1); SyVal.resize(1); SzVal.resize(1);
-            TxVal[0]=xlate [0]; TyVal[0]=xlate [1]; TzVal[0]=xlate [2];
-            RxVal[0]=rotate[0]; RyVal[0]=rotate[1]; RzVal[0]=rotate[2];
-            SxVal[0]=scale [0]; SyVal[0]=scale [1]; SzVal[0]=scale [2];
+        // pick the first available sample or default. A transform with a
+        // single time sample is not time varying, and its value would not be
+        // found at the default time.
+        if (query.GetLocalTransformation(&localXform, UsdTimeCode::EarliestTime())) {
+            appendSample(localXform);
         }
         else {
-            TF_RUNTIME_ERROR(
+            samples->errors.push_back(TfStringPrintf(
                     "Missing default xform data on USD prim <%s>",
-                    xformSchema.GetPath().GetText());
+                    xformSchema.GetPath().GetText()));
+        }
+    }
+
+    if (translateOp.values.empty()) {
+        return false;
+    }
+
+    rotateOp.times = translateOp.times;
+    scaleOp.times = translateOp.times;
+    for (auto* op : { &translateOp, &rotateOp, &scaleOp }) {
+        _findVaryingChannels(*op);
+        samples->ops.push_back(std::move(*op));
+    }
+    return true;
+}
+
+// Sets the animation curve (a knot per frame) for a given plug/attribute
+static void _setAnimPlugData(MPlug plg, const MDoubleArray& valueArray,
+        const MTimeArray& timeArray,
+        const UsdMayaPrimReaderContext* context)
+{
+    MStatus status;
+    MFnAnimCurve animFn;
+    // Make the plug keyable before attaching an anim curve
+    if (!plg.isKeyable()) {
+        plg.setKeyable(true);
+    }
+    MObject animObj = animFn.create(plg, nullptr, &status);
+    if (status == MS::kSuccess ) {
+        animFn.addKeys(&timeArray, &valueArray);
+        if (context) {
+            context->RegisterNewMayaNode(animFn.name().asChar(), animObj );
+        }
+    } else {
+        MString mayaPlgName = plg.partialName(true, true, true, false, true, true, &status);
+        TF_RUNTIME_ERROR(
+                "Failed to create animation object for attribute: %s",
+                mayaPlgName.asChar());
+    }
+}
+
+// Sets the Maya Attribute values. Sets the value to the first sample of the op
+// and then, for the channels that vary, defines an anim curve for the
+// attribute
+static void _setMayaAttribute(
+        MFnDagNode &depFn,
+        const UsdMayaTranslatorXformable::XformSamples::Op& op,
+        const MTimeArray &timeArray,
+        const MString& opName,
+        const MString& x, const MString& y, const MString& z,
+        const UsdMayaPrimReaderContext* context)
+{
+    const MString* channels[3] = { &x, &y, &z };
+    MDoubleArray valueArray;
+    for (unsigned int c = 0u; c < 3u; ++c) {
+        if (*channels[c] == "") {
+            continue;
+        }
+        MPlug plg = depFn.findPlug(opName + *channels[c]);
+        if (plg.isNull()) {
+            continue;
+        }
+        plg.setDouble(op.values[0u][c]);
+        if (op.varying[c]) {
+            valueArray.setLength(op.values.size());
+            for (unsigned int i = 0u; i < valueArray.length(); ++i) {
+                valueArray[i] = op.values[i][c];
+            }
+            _setAnimPlugData(plg, valueArray, timeArray, context);
         }
     }
+}
 
-    // All of these vectors should have the same size and greater than 0 to set their values
-    if (TxVal.size()==TyVal.size() && TxVal.size()==TzVal.size() && !TxVal.empty()) {
-        _setMayaAttribute(MdagNode, TxVal, TyVal, TzVal, timeArray, MString("translate"), "X", "Y", "Z", context);
-        _setMayaAttribute(MdagNode, RxVal, RyVal, RzVal, timeArray, MString("rotate"), "X", "Y", "Z", context);
-        _setMayaAttribute(MdagNode, SxVal, SyVal, SzVal, timeArray, MString("scale"), "X", "Y", "Z", context);
-        return true;
+// For each op that was read, push its data to the corresponding Maya xform
+static void _pushXformOpSamplesToMayaXform(
+        const UsdMayaTranslatorXformable::XformSamples::Op& op,
+        MFnDagNode &MdagNode,
+        const UsdMayaPrimReaderContext* context)
+{
+    MTimeArray timeArray;
+    timeArray.setLength(op.times.size());
+    for (unsigned int ti = 0u; ti < op.times.size(); ++ti) {
+        timeArray.set(MTime(op.times[ti]), ti);
     }
 
-    return false;
+    const TfToken& opName = op.name;
+    if (opName==UsdMayaXformStackTokens->shear) {
+        _setMayaAttribute(MdagNode, op, timeArray, MString(opName.GetText()), "XY", "XZ", "YZ", context);
+    }
+    else if (opName==UsdMayaXformStackTokens->pivot) {
+        _setMayaAttribute(MdagNode, op, timeArray, MString("rotatePivot"), "X", "Y", "Z", context);
+        _setMayaAttribute(MdagNode, op, timeArray, MString("scalePivot"), "X", "Y", "Z", context);
+    }
+    else if (opName==UsdMayaXformStackTokens->pivotTranslate) {
+        _setMayaAttribute(MdagNode, op, timeArray, MString("rotatePivotTranslate"), "X", "Y", "Z", context);
+        _setMayaAttribute(MdagNode, op, timeArray, MString("scalePivotTranslate"), "X", "Y", "Z", context);
+    }
+    else {
+        // Decomposed matrices have no op type, and are always in XYZ order.
+        if (opName==UsdMayaXformStackTokens->rotate &&
+                op.type != UsdGeomXformOp::TypeInvalid) {
+            MFnTransform trans;
+            if(trans.setObject(MdagNode.object()))
+            {
+                auto MrotOrder =
+                        UsdMayaXformStack::RotateOrderFromOpType<MTransformationMatrix::RotationOrder>(
+                                op.type);
+                MPlug plg = MdagNode.findPlug("rotateOrder");
+                if ( !plg.isNull() ) {
+                    trans.setRotationOrder(MrotOrder, /*no need to reorder*/ false);
+                }
+            }
+        }
+        _setMayaAttribute(MdagNode, op, timeArray, MString(opName.GetText()), "X", "Y", "Z", context);
+    }
 }
 
 void
-UsdMayaTranslatorXformable::Read(
+UsdMayaTranslatorXformable::ReadSamples(
         const UsdGeomXformable& xformSchema,
-        MObject mayaNode,
         const UsdMayaPrimReaderArgs& args,
-        UsdMayaPrimReaderContext* context)
+        XformSamples* samples)
 {
-    MStatus status;
-
-    // == Read attrs ==
-    // Read parent class attrs
-    UsdMayaTranslatorPrim::Read(xformSchema.GetPrim(), mayaNode, args, context);
+    samples->isRead = true;
 
     // Scanning Xformops to see if we have a general Maya xform or an xform
     // that conform to the commonAPI
@@ -416,6 +439,7 @@ UsdMayaTranslatorXformable::Read(
     bool resetsXformStack= false;
     std::vector<UsdGeomXformOp> xformops = xformSchema.GetOrderedXformOps(
         &resetsXformStack);
+    samples->resetsXformStack = resetsXformStack;
 
     // When we find ops, we match the ops by suffix ("" will define the basic
     // translate, rotate, scale) and by order. If we find an op with a
@@ -430,7 +454,6 @@ UsdMayaTranslatorXformable::Read(
                     },
                     xformops);
 
-    MFnDagNode MdagNode(mayaNode);
     if (!stackOps.empty()) {
         // make sure stackIndices.size() == xformops.size()
         for (unsigned int i=0; i < stackOps.size(); i++) {
@@ -442,17 +465,55 @@ UsdMayaTranslatorXformable::Read(
 
             const TfToken& opName(opDef.GetName());
 
-            _pushUSDXformOpToMayaXform(xformop, opName, MdagNode, args, context);
+            _readUSDXformOpSamples(xformop, opName, args, samples);
         }
     } else {
-        if (!_pushUSDXformToMayaXform(xformSchema, MdagNode, args, context)) {
-            TF_RUNTIME_ERROR(
+        if (!_readUSDXformSamples(xformSchema, args, samples)) {
+            samples->errors.push_back(TfStringPrintf(
                     "Unable to successfully decompose matrix at USD prim <%s>",
-                    xformSchema.GetPath().GetText());
+                    xformSchema.GetPath().GetText()));
         }
     }
+}
+
+void
+UsdMayaTranslatorXformable::Read(
+        const UsdGeomXformable& xformSchema,
+        MObject mayaNode,
+        const UsdMayaPrimReaderArgs& args,
+        UsdMayaPrimReaderContext* context)
+{
+    XformSamples samples;
+    ReadSamples(xformSchema, args, &samples);
+    Read(xformSchema, samples, mayaNode, args, context);
+}
+
+void
+UsdMayaTranslatorXformable::Read(
+        const UsdGeomXformable& xformSchema,
+        const XformSamples& samples,
+        MObject mayaNode,
+        const UsdMayaPrimReaderArgs& args,
+        UsdMayaPrimReaderContext* context)
+{
+    if (!TF_VERIFY(samples.isRead)) {
+        return;
+    }
+
+    // == Read attrs ==
+    // Read parent class attrs
+    UsdMayaTranslatorPrim::Read(xformSchema.GetPrim(), mayaNode, args, context);
+
+    for (const std::string& error : samples.errors) {
+        TF_RUNTIME_ERROR("%s", error.c_str());
+    }
+
+    MFnDagNode MdagNode(mayaNode);
+    for (const XformSamples::Op& op : samples.ops) {
+        _pushXformOpSamplesToMayaXform(op, MdagNode, context);
+    }
 
-    if (resetsXformStack) {
+    if (samples.resetsXformStack) {
         MPlug plg = MdagNode.findPlug("inheritsTransform");
         if (!plg.isNull()) plg.setBool(false);
     }
@@ -20,6 +20,7 @@
 #include "usdMaya/api.h"
 #include "pxr/base/gf/matrix4d.h"
 #include "pxr/base/gf/vec3d.h"
+#include "pxr/base/tf/token.h"
 #include "pxr/usd/usdGeom/xformable.h"
 
 #include "usdMaya/primReaderContext.h"
@@ -27,12 +28,52 @@
 
 #include <maya/MObject.h>
 
+#include <string>
+#include <vector>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 
 /// \brief Provides helper functions for reading UsdGeomXformable.  
 struct UsdMayaTranslatorXformable
 {
+    /// \brief The xform data read from a UsdGeomXformable, converted into the
+    /// values of the Maya transform attributes.
+    struct XformSamples
+    {
+        /// \brief The samples of one op on the Maya transform.
+        struct Op
+        {
+            /// The name of the op in the Maya xform stack.
+            TfToken name;
+            /// The type of the USD op, or TypeInvalid if the op was
+            /// decomposed from the local transformation.
+            UsdGeomXformOp::Type type = UsdGeomXformOp::TypeInvalid;
+            /// The sample times, empty if the op is not animated.
+            std::vector<double> times;
+            /// A value per sample time, or a single value if not animated.
+            std::vector<GfVec3d> values;
+            /// Whether each of the x, y and z channels changes over time.
+            bool varying[3] = { false, false, false };
+        };
+
+        /// Whether ReadSamples() has been run on this data.
+        bool isRead = false;
+        bool resetsXformStack = false;
+        std::vector<Op> ops;
+        /// Problems found while reading, reported when the data is applied.
+        std::vector<std::string> errors;
+    };
+
+    /// \brief reads all of the xform samples of \p xformable within the
+    /// import time interval into \p samples. This only reads from USD, so it
+    /// is safe to call from worker threads.
+    PXRUSDMAYA_API
+    static void ReadSamples(
+            const UsdGeomXformable& xformable,
+            const UsdMayaPrimReaderArgs& args,
+            XformSamples* samples);
+
     /// \brief reads xform attributes from \p xformable and converts them into
     /// maya transform values.
     PXRUSDMAYA_API
@@ -42,6 +83,16 @@ struct UsdMayaTranslatorXformable
             const UsdMayaPrimReaderArgs& args,
             UsdMayaPrimReaderContext* context);
 
+    /// \brief sets the maya transform values from \p samples, previously
+    /// read from \p xformable by ReadSamples().
+    PXRUSDMAYA_API
+    static void Read(
+            const UsdGeomXformable& xformable,
+            const XformSamples& samples,
+            MObject mayaNode,
+            const UsdMayaPrimReaderArgs& args,
+            UsdMayaPrimReaderContext* context);
+
     /// \brief Convenince function for decomposing \p usdMatrix.
     PXRUSDMAYA_API
     static bool ConvertUsdMatrixToComponents(
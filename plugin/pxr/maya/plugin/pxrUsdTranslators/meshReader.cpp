@@ -14,25 +14,76 @@
 // limitations under the License.
 //
 #include "pxr/pxr.h"
+#include "usdMaya/primReader.h"
 #include "usdMaya/primReaderRegistry.h"
 #include "usdMaya/translatorMesh.h"
 
 #include "pxr/usd/usdGeom/mesh.h"
 
+#include <maya/MObject.h>
+
 PXR_NAMESPACE_OPEN_SCOPE
 
 
-PXRUSDMAYA_DEFINE_READER(UsdGeomMesh, args, context)
+/// Prim reader for meshes.
+/// The USD side of the import (topology, points, normals, the list of
+/// primvars and the xform samples) is gathered in Prefetch(), so that it can
+/// be done in parallel with the other prims being imported.
+class PxrUsdTranslators_MeshReader : public UsdMayaPrimReader
 {
-    const UsdPrim& usdPrim = args.GetUsdPrim();
+public:
+    PxrUsdTranslators_MeshReader(const UsdMayaPrimReaderArgs& args)
+        : UsdMayaPrimReader(args) {}
+
+    ~PxrUsdTranslators_MeshReader() override {}
+
+    void Prefetch() override;
+
+    bool Read(UsdMayaPrimReaderContext* context) override;
+
+private:
+    UsdMayaTranslatorMesh::MeshData _meshData;
+};
+
+TF_REGISTRY_FUNCTION_WITH_TAG(UsdMayaPrimReaderRegistry, UsdGeomMesh) {
+    UsdMayaPrimReaderRegistry::Register<UsdGeomMesh>(
+        [](const UsdMayaPrimReaderArgs& args)
+        {
+            return UsdMayaPrimReaderSharedPtr(
+                new PxrUsdTranslators_MeshReader(args));
+        });
+}
+
+void
+PxrUsdTranslators_MeshReader::Prefetch()
+{
+    UsdMayaTranslatorMesh::ReadMeshData(
+            UsdGeomMesh(_GetArgs().GetUsdPrim()),
+            _GetArgs(),
+            &_meshData);
+}
+
+bool
+PxrUsdTranslators_MeshReader::Read(UsdMayaPrimReaderContext* context)
+{
+    const UsdPrim& usdPrim = _GetArgs().GetUsdPrim();
+    const UsdGeomMesh mesh(usdPrim);
+    if (!_meshData.isRead) {
+        Prefetch();
+    }
+
     MObject parentNode = context->GetMayaNode(usdPrim.GetPath().GetParentPath(), true);
-    return UsdMayaTranslatorMesh::Create(
-            UsdGeomMesh(usdPrim),
+    const bool success = UsdMayaTranslatorMesh::Create(
+            mesh,
+            _meshData,
             parentNode,
-            args,
+            _GetArgs(),
             context);
+
+    // The Maya mesh now holds the data, so release our copy of it.
+    _meshData = UsdMayaTranslatorMesh::MeshData();
+    return success;
 }
 
 
 PXR_NAMESPACE_CLOSE_SCOPE
-
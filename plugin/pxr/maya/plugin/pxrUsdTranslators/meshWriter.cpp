@@ -24,6 +24,7 @@
 #include "usdMaya/writeUtil.h"
 #include "usdMaya/writeJobContext.h"
 
+#include "pxr/base/arch/hash.h"
 #include "pxr/base/gf/vec2f.h"
 #include "pxr/base/gf/vec3f.h"
 #include "pxr/base/gf/vec4f.h"
@@ -33,7 +34,6 @@
 #include "pxr/usd/sdf/types.h"
 #include "pxr/usd/usd/timeCode.h"
 #include "pxr/usd/usdGeom/mesh.h"
-#include "pxr/usd/usdGeom/pointBased.h"
 #include "pxr/usd/usdGeom/primvar.h"
 #include "pxr/usd/usdUtils/pipeline.h"
 
@@ -46,6 +46,9 @@
 #include <maya/MStringArray.h>
 #include <maya/MUintArray.h>
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <set>
 #include <string>
 #include <vector>
@@ -60,6 +63,96 @@ PXRUSDMAYA_REGISTER_ADAPTOR_SCHEMA(mesh, UsdGeomMesh);
 
 namespace {
 
+static_assert(sizeof(GfVec3f) == 3 * sizeof(float),
+              "GfVec3f must be tightly packed to copy Maya's raw points");
+
+/// Copies the raw points of \p mesh into \p points in a single block.
+void
+_GetRawPoints(const MFnMesh& mesh, VtArray<GfVec3f>* points)
+{
+    MStatus status;
+    const float* mayaRawPoints = mesh.getRawPoints(&status);
+    const unsigned int numVertices = mesh.numVertices();
+    points->resize(numVertices);
+    if (status && mayaRawPoints && numVertices > 0u) {
+        std::memcpy(points->data(),
+                    mayaRawPoints,
+                    numVertices * sizeof(GfVec3f));
+    }
+}
+
+/// Computes the extent of \p points. The minimum and maximum of each
+/// component are accumulated independently of the others, so that the
+/// compiler can vectorize the loop. Matches UsdGeomPointBased::ComputeExtent()
+/// (an empty range) when there are no points.
+void
+_ComputeExtent(const VtArray<GfVec3f>& points, VtArray<GfVec3f>* extent)
+{
+    float minX = std::numeric_limits<float>::max();
+    float minY = minX;
+    float minZ = minX;
+    float maxX = -minX;
+    float maxY = -minX;
+    float maxZ = -minX;
+
+    const float* const data = points.cdata()->data();
+    const size_t numPoints = points.size();
+    for (size_t i = 0u; i < numPoints; ++i) {
+        const float x = data[i * 3u];
+        const float y = data[i * 3u + 1u];
+        const float z = data[i * 3u + 2u];
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        minZ = std::min(minZ, z);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+        maxZ = std::max(maxZ, z);
+    }
+
+    extent->resize(2u);
+    (*extent)[0].Set(minX, minY, minZ);
+    (*extent)[1].Set(maxX, maxY, maxZ);
+}
+
+/// Reads the face vertex counts and indices of \p mesh with the bulk
+/// accessor, rather than querying the vertices of each polygon.
+void
+_GetMeshTopology(
+        const MFnMesh& mesh,
+        VtIntArray* faceVertexCounts,
+        VtIntArray* faceVertexIndices)
+{
+    MIntArray mayaFaceVertexCounts;
+    MIntArray mayaFaceVertexIndices;
+    mesh.getVertices(mayaFaceVertexCounts, mayaFaceVertexIndices);
+
+    faceVertexCounts->resize(mayaFaceVertexCounts.length());
+    if (mayaFaceVertexCounts.length() > 0u) {
+        mayaFaceVertexCounts.get(faceVertexCounts->data());
+    }
+    faceVertexIndices->resize(mayaFaceVertexIndices.length());
+    if (mayaFaceVertexIndices.length() > 0u) {
+        mayaFaceVertexIndices.get(faceVertexIndices->data());
+    }
+}
+
+/// Hashes the face vertex counts and indices of a mesh. The number of face
+/// vertex indices is implied by the counts, so hashing both arrays in turn
+/// identifies the topology.
+uint64_t
+_HashMeshTopology(
+        const VtIntArray& faceVertexCounts,
+        const VtIntArray& faceVertexIndices)
+{
+    const uint64_t hash = ArchHash64(
+        reinterpret_cast<const char*>(faceVertexCounts.cdata()),
+        faceVertexCounts.size() * sizeof(int));
+    return ArchHash64(
+        reinterpret_cast<const char*>(faceVertexIndices.cdata()),
+        faceVertexIndices.size() * sizeof(int),
+        hash);
+}
+
 void
 _exportReferenceMesh(UsdGeomMesh& primSchema, MObject obj)
 {
@@ -90,15 +183,8 @@ _exportReferenceMesh(UsdGeomMesh& primSchema, MObject obj)
         return;
     }
 
-    const float* mayaRawPoints = referenceMesh.getRawPoints(&status);
-    const int numVertices = referenceMesh.numVertices();
-    VtArray<GfVec3f> points(numVertices);
-    for (int i = 0; i < numVertices; ++i) {
-        const int floatIndex = i * 3;
-        points[i].Set(mayaRawPoints[floatIndex],
-                        mayaRawPoints[floatIndex + 1],
-                        mayaRawPoints[floatIndex + 2]);
-    }
+    VtArray<GfVec3f> points;
+    _GetRawPoints(referenceMesh, &points);
 
     UsdGeomPrimvar primVar = primSchema.CreatePrimvar(
         UsdUtilsGetPrefName(),
@@ -132,7 +218,10 @@ PxrUsdTranslators_MeshWriter::PxrUsdTranslators_MeshWriter(
         const MFnDependencyNode& depNodeFn,
         const SdfPath& usdPath,
         UsdMayaWriteJobContext& jobCtx) :
-    UsdMayaPrimWriter(depNodeFn, usdPath, jobCtx)
+    UsdMayaPrimWriter(depNodeFn, usdPath, jobCtx),
+    _topologyHash(0u),
+    _hasTopology(false),
+    _isTopologyAnimated(false)
 {
     if (!TF_VERIFY(GetDagPath().isValid())) {
         return;
@@ -228,44 +317,23 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(
         return true;
     }
 
-    unsigned int numVertices = geomMesh.numVertices();
-    unsigned int numPolygons = geomMesh.numPolygons();
-
     // Set mesh attrs ==========
     // Get points
-    // TODO: Use memcpy()
-    const float* mayaRawPoints = geomMesh.getRawPoints(&status);
-    VtArray<GfVec3f> points(numVertices);
-    for (unsigned int i = 0; i < numVertices; i++) {
-        unsigned int floatIndex = i*3;
-        points[i].Set(mayaRawPoints[floatIndex],
-                      mayaRawPoints[floatIndex+1],
-                      mayaRawPoints[floatIndex+2]);
-    }
+    VtArray<GfVec3f> points;
+    _GetRawPoints(geomMesh, &points);
 
-    VtArray<GfVec3f> extent(2);
     // Compute the extent using the raw points
-    UsdGeomPointBased::ComputeExtent(points, &extent);
+    VtArray<GfVec3f> extent;
+    _ComputeExtent(points, &extent);
 
     _SetAttribute(primSchema.GetPointsAttr(), &points, usdTime);
     _SetAttribute(primSchema.CreateExtentAttr(), &extent, usdTime);
 
-    // Get faceVertexIndices
-    unsigned int numFaceVertices = geomMesh.numFaceVertices(&status);
-    VtArray<int>     faceVertexCounts(numPolygons);
-    VtArray<int>     faceVertexIndices(numFaceVertices);
-    MIntArray mayaFaceVertexIndices; // used in loop below
-    unsigned int curFaceVertexIndex = 0;
-    for (unsigned int i = 0; i < numPolygons; i++) {
-        geomMesh.getPolygonVertices(i, mayaFaceVertexIndices);
-        faceVertexCounts[i] = mayaFaceVertexIndices.length();
-        for (unsigned int j=0; j < mayaFaceVertexIndices.length(); j++) {
-            faceVertexIndices[ curFaceVertexIndex ] = mayaFaceVertexIndices[j]; // push_back
-            curFaceVertexIndex++;
-        }
-    }
-    _SetAttribute(primSchema.GetFaceVertexCountsAttr(), &faceVertexCounts, usdTime);
-    _SetAttribute(primSchema.GetFaceVertexIndicesAttr(), &faceVertexIndices, usdTime);
+    // Get faceVertexCounts and faceVertexIndices. These (and the other
+    // topology-dependent attributes below, which are only authored at the
+    // default time) are skipped if the topology is unchanged since the
+    // previous time sample.
+    const bool topologyChanged = _WriteTopology(geomMesh, usdTime, primSchema);
 
     // Read subdiv scheme tagging. If not set, we default to defaultMeshScheme
     // flag (this is specified by the job args but defaults to catmullClark).
@@ -273,7 +341,9 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(
     if (sdScheme.IsEmpty()) {
         sdScheme = _GetExportArgs().defaultMeshScheme;
     }
-    primSchema.CreateSubdivisionSchemeAttr(VtValue(sdScheme), true);
+    if (topologyChanged) {
+        primSchema.CreateSubdivisionSchemeAttr(VtValue(sdScheme), true);
+    }
 
     if (sdScheme == UsdGeomTokens->none) {
         // Polygonal mesh - export normals.
@@ -294,7 +364,7 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(
                 primSchema.SetNormalsInterpolation(normalInterp);
             }
         }
-    } else {
+    } else if (topologyChanged) {
         // Subdivision surface - export subdiv-specific attributes.
         TfToken sdInterpBound = UsdMayaMeshUtil::GetSubdivInterpBoundary(
             finalMesh);
@@ -314,7 +384,10 @@ PxrUsdTranslators_MeshWriter::writeMeshAttrs(
     }
 
     // Holes - we treat InvisibleFaces as holes
-    MUintArray mayaHoles = finalMesh.getInvisibleFaces();
+    MUintArray mayaHoles;
+    if (topologyChanged) {
+        mayaHoles = finalMesh.getInvisibleFaces();
+    }
     if (mayaHoles.length() > 0) {
         VtArray<int> subdHoles(mayaHoles.length());
         for (unsigned int i=0; i < mayaHoles.length(); i++) {
@@ -558,6 +631,54 @@ PxrUsdTranslators_MeshWriter::ExportsGprims() const
     return true;
 }
 
+bool
+PxrUsdTranslators_MeshWriter::_WriteTopology(
+        const MFnMesh& geomMesh,
+        const UsdTimeCode& usdTime,
+        UsdGeomMesh& primSchema)
+{
+    VtIntArray faceVertexCounts;
+    VtIntArray faceVertexIndices;
+    _GetMeshTopology(geomMesh, &faceVertexCounts, &faceVertexIndices);
+
+    const uint64_t topologyHash =
+        _HashMeshTopology(faceVertexCounts, faceVertexIndices);
+    if (_hasTopology && topologyHash == _topologyHash) {
+        return false;
+    }
+
+    const UsdAttribute countsAttr = primSchema.GetFaceVertexCountsAttr();
+    const UsdAttribute indicesAttr = primSchema.GetFaceVertexIndicesAttr();
+
+    if (!_hasTopology) {
+        // The first topology is authored at the default time, even for an
+        // animated mesh, and the time of its first sample is kept in case the
+        // topology changes later.
+        _SetAttribute(countsAttr, &faceVertexCounts);
+        _SetAttribute(indicesAttr, &faceVertexIndices);
+        _firstTopologyTime = usdTime;
+        _hasTopology = true;
+    } else {
+        if (!_isTopologyAnimated) {
+            // The topology is changing for the first time, so the default
+            // topology is also authored as a time sample at the first time,
+            // since time samples take precedence over the default value.
+            VtIntArray defaultCounts;
+            VtIntArray defaultIndices;
+            countsAttr.Get(&defaultCounts, UsdTimeCode::Default());
+            indicesAttr.Get(&defaultIndices, UsdTimeCode::Default());
+            countsAttr.Set(defaultCounts, _firstTopologyTime);
+            indicesAttr.Set(defaultIndices, _firstTopologyTime);
+            _isTopologyAnimated = true;
+        }
+        _SetAttribute(countsAttr, &faceVertexCounts, usdTime);
+        _SetAttribute(indicesAttr, &faceVertexIndices, usdTime);
+    }
+
+    _topologyHash = topologyHash;
+    return true;
+}
+
 bool
 PxrUsdTranslators_MeshWriter::_IsMeshAnimated() const
 {
@@ -38,6 +38,7 @@
 #include <maya/MFnMesh.h>
 #include <maya/MString.h>
 
+#include <cstdint>
 #include <set>
 #include <string>
 
@@ -67,6 +68,16 @@ private:
     bool isMeshValid();
     void assignSubDivTagsToUSDPrim(MFnMesh& meshFn, UsdGeomMesh& primSchema);
 
+    /// Writes the face vertex counts and indices of \p geomMesh, unless they
+    /// are the same as the topology written at the previous time sample.
+    /// The first topology is written at the default time. If the topology
+    /// changes afterwards, it is written as a time sample at \p usdTime.
+    /// Returns true if the topology was written.
+    bool _WriteTopology(
+            const MFnMesh& geomMesh,
+            const UsdTimeCode& usdTime,
+            UsdGeomMesh& primSchema);
+
     /// Writes skeleton skinning data for the mesh if it has skin clusters.
     /// This method will internally determine, based on the job export args,
     /// whether the prim has skinning data and whether it is eligible for
@@ -196,6 +207,16 @@ private:
     /// Input mesh before any skeletal deformations, cached between iterations.
     MObject _skelInputMesh;
 
+    /// Hash of the most recently written topology, so that identical
+    /// topology is not rebuilt and rewritten at every time sample.
+    uint64_t _topologyHash;
+    bool _hasTopology;
+
+    /// Time at which the first topology was written, and whether the
+    /// topology has since changed over time.
+    UsdTimeCode _firstTopologyTime;
+    bool _isTopologyAnimated;
+
     /// Set of color sets that should be excluded.
     /// Intermediate processes may alter this set prior to writeMeshAttrs().
     std::set<std::string> _excludeColorSets;
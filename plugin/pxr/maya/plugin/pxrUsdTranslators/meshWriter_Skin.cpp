@@ -24,6 +24,7 @@
 
 #include "pxr/base/gf/matrix4d.h"
 #include "pxr/base/tf/staticTokens.h"
+#include "pxr/base/work/loops.h"
 #include "pxr/usd/usdGeom/mesh.h"
 #include "pxr/usd/usdSkel/bindingAPI.h"
 #include "pxr/usd/usdSkel/root.h"
@@ -34,10 +35,13 @@
 #include <maya/MDoubleArray.h>
 #include <maya/MFnSingleIndexedComponent.h>
 #include <maya/MFnSkinCluster.h>
+#include <maya/MIntArray.h>
 #include <maya/MItDependencyGraph.h>
 #include <maya/MMatrix.h>
 
+#include <algorithm>
 #include <ostream>
+#include <vector>
 
 
 PXR_NAMESPACE_OPEN_SCOPE
@@ -155,6 +159,19 @@ _GetRootJoint(const std::vector<MDagPath>& jointDagPaths)
     return uniqueRoot;
 }
 
+/// The maximum number of weights read from the skinCluster in a single
+/// MFnSkinCluster::getWeights() call. Vertices are read in ranges whose
+/// (vertices x influences) weight block fits in this budget, so that the full
+/// vertices-by-influences weight matrix is never allocated.
+static constexpr size_t _MaxWeightsPerRange = 1u << 22;
+
+/// Returns true if \p weight is large enough to be written to USD.
+static bool
+_IsNonZeroWeight(const float weight)
+{
+    return !GfIsClose(weight, 0.0, 1e-8);
+}
+
 /// Gets skin weights, and compresses them into the form expected by
 /// UsdSkelBindingAPI, which allows us to omit zero-weight influences from the
 /// joint weights list.
@@ -178,51 +195,118 @@ _GetCompressedSkinWeights(
         return 0;
     }
 
-    // Get all of the weights from the skinCluster in one batch.
-    unsigned int numVertices = mesh.numVertices();
-    MFnSingleIndexedComponent components;
-    components.create(MFn::kMeshVertComponent);
-    components.setCompleteData(numVertices);
+    const unsigned int numVertices = mesh.numVertices();
+    MDagPathArray influenceObjects;
+    const unsigned int numInfluences =
+        skinCluster.influenceObjects(influenceObjects);
+    if (numVertices == 0 || numInfluences == 0) {
+        return 0;
+    }
+
+    // Rather than getting all of the weights from the skinCluster in one
+    // batch, which requires a dense (numVertices x numInfluences) array, get
+    // them a range of vertices at a time, and only keep the non-zero weights.
+    // The non-zero weights of vertex v are stored in
+    // [offsets[v], offsets[v+1]) of the sparse index and weight arrays.
+    const unsigned int verticesPerRange = static_cast<unsigned int>(
+        std::max<size_t>(_MaxWeightsPerRange/numInfluences, 1u));
+
+    std::vector<size_t> offsets(numVertices + 1, 0);
+    std::vector<int> sparseIndices;
+    std::vector<float> sparseWeights;
+    MIntArray vertexIndices;
     MDoubleArray weights;
-    unsigned int numInfluences;
-    skinCluster.getWeights(
-            outputDagPath, components.object(), weights, numInfluences);
+    for (unsigned int start = 0; start < numVertices;
+            start += verticesPerRange) {
+        const unsigned int end =
+            std::min(start + verticesPerRange, numVertices);
+
+        vertexIndices.setLength(end - start);
+        for (unsigned int vert = start; vert < end; ++vert) {
+            vertexIndices[vert - start] = vert;
+        }
+        MFnSingleIndexedComponent components;
+        components.create(MFn::kMeshVertComponent);
+        components.addElements(vertexIndices);
+
+        unsigned int rangeInfluences;
+        status = skinCluster.getWeights(
+                outputDagPath, components.object(), weights, rangeInfluences);
+        CHECK_MSTATUS_AND_RETURN(status, 0);
+        if (weights.length() != (end - start)*rangeInfluences) {
+            TF_RUNTIME_ERROR(
+                    "Unexpected number of weights read from skinCluster '%s'",
+                    skinCluster.name().asChar());
+            return 0;
+        }
+
+        // Only touch the raw storage from the worker threads.
+        const double* rangeWeights = &weights[0];
+
+        // Count the non-zero weights of each vertex.
+        WorkParallelForN(end - start,
+            [&](size_t begin, size_t finish) {
+                for (size_t i = begin; i < finish; ++i) {
+                    const double* vertWeights = rangeWeights + i*rangeInfluences;
+                    size_t influenceCount = 0;
+                    for (unsigned int j = 0; j < rangeInfluences; ++j) {
+                        if (_IsNonZeroWeight(vertWeights[j])) {
+                            influenceCount++;
+                        }
+                    }
+                    offsets[start + i + 1] = influenceCount;
+                }
+            });
+        for (unsigned int vert = start; vert < end; ++vert) {
+            offsets[vert + 1] += offsets[vert];
+        }
+
+        // Gather the non-zero weights of the range.
+        sparseIndices.resize(offsets[end]);
+        sparseWeights.resize(offsets[end]);
+        WorkParallelForN(end - start,
+            [&](size_t begin, size_t finish) {
+                for (size_t i = begin; i < finish; ++i) {
+                    const double* vertWeights = rangeWeights + i*rangeInfluences;
+                    size_t outputOffset = offsets[start + i];
+                    for (unsigned int j = 0; j < rangeInfluences; ++j) {
+                        const float weight = vertWeights[j];
+                        if (_IsNonZeroWeight(weight)) {
+                            sparseIndices[outputOffset] = j;
+                            sparseWeights[outputOffset] = weight;
+                            outputOffset++;
+                        }
+                    }
+                }
+            });
+    }
 
     // Determine how many influence/weight "slots" we actually need per point.
     // For example, if there are the joints /a, /a/b, and /a/c, but each point
     // only has non-zero weighting for a single joint, then we only need one
     // slot instead of three.
-    int maxInfluenceCount = 0;
+    size_t maxInfluenceCount = 0;
     for (unsigned int vert = 0; vert < numVertices; ++vert) {
-        // Looping through each vertex.
-        const unsigned int offset = vert * numInfluences;
-        int influenceCount = 0;
-        for (unsigned int i = 0; i < numInfluences; ++i) {
-            // Looping through each weight for vertex.
-            if (weights[offset + i] != 0.0) {
-                influenceCount++;
-            }
-        }
-        maxInfluenceCount = std::max(maxInfluenceCount, influenceCount);
+        maxInfluenceCount =
+            std::max(maxInfluenceCount, offsets[vert + 1] - offsets[vert]);
     }
 
     usdJointIndices->assign(maxInfluenceCount * numVertices, 0);
     usdJointWeights->assign(maxInfluenceCount * numVertices, 0.0);
-    for (unsigned int vert = 0; vert < numVertices; ++vert) {
-        // Looping through each vertex.
-        const unsigned int inputOffset = vert * numInfluences;
-        int outputOffset = vert * maxInfluenceCount;
-        for (unsigned int i = 0; i < numInfluences; ++i) {
-            // Looping through each weight for vertex.
-            float weight = weights[inputOffset + i];
-            if (!GfIsClose(weight, 0.0, 1e-8)) {
-                (*usdJointIndices)[outputOffset] = i;
-                (*usdJointWeights)[outputOffset] = weight;
-                outputOffset++;
+    int* jointIndices = usdJointIndices->data();
+    float* jointWeights = usdJointWeights->data();
+    WorkParallelForN(numVertices,
+        [&](size_t begin, size_t finish) {
+            for (size_t vert = begin; vert < finish; ++vert) {
+                std::copy(sparseIndices.begin() + offsets[vert],
+                          sparseIndices.begin() + offsets[vert + 1],
+                          jointIndices + vert * maxInfluenceCount);
+                std::copy(sparseWeights.begin() + offsets[vert],
+                          sparseWeights.begin() + offsets[vert + 1],
+                          jointWeights + vert * maxInfluenceCount);
             }
-        }
-    }
-    return maxInfluenceCount;
+        });
+    return static_cast<int>(maxInfluenceCount);
 }
 
 
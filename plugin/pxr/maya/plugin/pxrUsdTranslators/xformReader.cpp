@@ -14,8 +14,10 @@
 // limitations under the License.
 //
 #include "pxr/pxr.h"
+#include "usdMaya/primReader.h"
 #include "usdMaya/primReaderRegistry.h"
 #include "usdMaya/translatorUtil.h"
+#include "usdMaya/translatorXformable.h"
 
 #include "pxr/usd/usd/prim.h"
 #include "pxr/usd/usdGeom/xform.h"
@@ -26,19 +28,67 @@ PXR_NAMESPACE_OPEN_SCOPE
 
 
 
-PXRUSDMAYA_DEFINE_READER(UsdGeomXform, args, context)
+/// Prim reader for xforms.
+/// The xform samples are gathered in Prefetch(), so that the (potentially
+/// many) time samples of animated transforms can be read in parallel with
+/// the other prims being imported.
+class PxrUsdTranslators_XformReader : public UsdMayaPrimReader
 {
-    const UsdPrim& usdPrim = args.GetUsdPrim();
+public:
+    PxrUsdTranslators_XformReader(const UsdMayaPrimReaderArgs& args)
+        : UsdMayaPrimReader(args) {}
+
+    ~PxrUsdTranslators_XformReader() override {}
+
+    void Prefetch() override;
+
+    bool Read(UsdMayaPrimReaderContext* context) override;
+
+private:
+    UsdMayaTranslatorXformable::XformSamples _xformSamples;
+};
+
+TF_REGISTRY_FUNCTION_WITH_TAG(UsdMayaPrimReaderRegistry, UsdGeomXform) {
+    UsdMayaPrimReaderRegistry::Register<UsdGeomXform>(
+        [](const UsdMayaPrimReaderArgs& args)
+        {
+            return UsdMayaPrimReaderSharedPtr(
+                new PxrUsdTranslators_XformReader(args));
+        });
+}
+
+void
+PxrUsdTranslators_XformReader::Prefetch()
+{
+    UsdMayaTranslatorXformable::ReadSamples(
+            UsdGeomXformable(_GetArgs().GetUsdPrim()),
+            _GetArgs(),
+            &_xformSamples);
+}
+
+bool
+PxrUsdTranslators_XformReader::Read(UsdMayaPrimReaderContext* context)
+{
+    const UsdPrim& usdPrim = _GetArgs().GetUsdPrim();
+    if (!_xformSamples.isRead) {
+        Prefetch();
+    }
+
     MObject parentNode = context->GetMayaNode(usdPrim.GetPath().GetParentPath(), true);
 
     MStatus status;
     MObject mayaNode;
-    return UsdMayaTranslatorUtil::CreateTransformNode(usdPrim,
-                                                         parentNode,
-                                                         args,
-                                                         context,
-                                                         &status,
-                                                         &mayaNode);
+    const bool success = UsdMayaTranslatorUtil::CreateTransformNode(
+            usdPrim,
+            _xformSamples,
+            parentNode,
+            _GetArgs(),
+            context,
+            &status,
+            &mayaNode);
+
+    _xformSamples = UsdMayaTranslatorXformable::XformSamples();
+    return success;
 }
 
 PXR_NAMESPACE_CLOSE_SCOPE